@@ -49,6 +49,7 @@ public class AIAssistant : ModuleRules
 				"Slate",
 				"SlateCore",
 				"ApplicationCore",
+				"DirectoryWatcher",
 				"WebBrowser"
 			}
 			);
@@ -8,11 +8,14 @@
 #include "HAL/PlatformApplicationMisc.h"
 #include "Framework/Application/SlateApplication.h"
 
+#include "Core/AIAssistantConfigService.h"
+#include "Core/AIAssistantStartupTimeline.h"
 #include "UI/AIAssistantCommands.h"
 #include "UI/AIAssistantInputProcessor.h"
 #include "UI/AIAssistantSlateQuerier.h"
 #include "UI/AIAssistantStyle.h"
 #include "UI/AIAssistantWebBrowser.h"
+#include "UI/AIAssistantWebBrowserPool.h"
 
 #define LOCTEXT_NAMESPACE "FAIAssistantModule"
 
@@ -60,8 +63,15 @@ static const FName AIAssistantTabName("AIAssistant");
 		.SetIcon(FSlateIcon("AIAssistantStyle","AIAssistant.OpenPluginWindow"));
 
 	
+	UE::AIAssistant::SlateQuerier::RegisterItemExtractors();
+
 	InputProcessor = MakeShared<FAIAssistantInputProcessor>(PluginCommands);
 
+	// Pick up changes to the assistant configuration without restarting the editor.
+	UE::AIAssistant::FConfigService::Get().StartWatching();
+
+	WebBrowserPool = MakeUnique<FAIAssistantWebBrowserPool>();
+
 	// Some scenarios, like commandlets, don't have slate initialized
 	if (FSlateApplication::IsInitialized())
 	{
@@ -78,6 +88,12 @@ static const FName AIAssistantTabName("AIAssistant");
 	}
 	InputProcessor.Reset();
 
+	UE::AIAssistant::SlateQuerier::UnregisterItemExtractors();
+
+	WebBrowserPool.Reset();
+
+	UE::AIAssistant::FConfigService::Get().StopWatching();
+
 	
 	UToolMenus::UnRegisterStartupCallback(this);
 
@@ -107,12 +123,14 @@ void FAIAssistantModule::OnSlateQuery()
 
 TSharedPtr<SAIAssistantWebBrowser> FAIAssistantModule::GetAIAssistantWebBrowserWidget() 
 {
-	return AIAssistantWebBrowserWidget;
+	// The pool owns the browser so a closed browser isn't kept alive, or reachable, from here.
+	return WebBrowserPool.IsValid() ? WebBrowserPool->GetActive() : nullptr;
 }
 
 
 void FAIAssistantModule::ShowContextMenu(const FString& SelectedString, const FVector2f& ClientLocation) const
 {
+	const TSharedPtr<SAIAssistantWebBrowser> AIAssistantWebBrowserWidget = WebBrowserPool.IsValid() ? WebBrowserPool->GetActive() : nullptr;
 	if (!AIAssistantWebBrowserWidget.IsValid())
 	{
 		return;
@@ -185,17 +203,35 @@ void FAIAssistantModule::RegisterMenus()
 
 TSharedRef<SDockTab> FAIAssistantModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
-	AIAssistantWebBrowserWidget = SNew(SAIAssistantWebBrowser);
+	// Time how long it takes for the assistant to accept the first message from this tab. A prewarmed browser already started a
+	// session with the browser's milestones, so that session continues, unless it already ended.
+	UE::AIAssistant::FStartupTimeline& StartupTimeline = UE::AIAssistant::FStartupTimeline::Get();
+	if (!WebBrowserPool->HasPrewarmed() || !StartupTimeline.MarkMilestone(UE::AIAssistant::FStartupTimeline::EMilestone::TabSpawned))
+	{
+		StartupTimeline.BeginSession();
+		(void)StartupTimeline.MarkMilestone(UE::AIAssistant::FStartupTimeline::EMilestone::TabSpawned);
+	}
+
+	// Reuse the browser from a previously closed tab, if any, so the web application doesn't reload.
+	const TSharedRef<SAIAssistantWebBrowser> AIAssistantWebBrowserWidget = WebBrowserPool->Acquire();
 	
 	
 	TSharedRef<SDockTab> DockTabWidget = SNew(SDockTab)
 		.TabRole(ETabRole::NomadTab)
-		.OnTabClosed_Lambda([this](TSharedRef<SDockTab>) -> void
+		.OnTabClosed_Lambda([this, AIAssistantWebBrowserWidget](TSharedRef<SDockTab>) -> void
 		{
-			AIAssistantWebBrowserWidget->OnClosed();			
+			// The tab can outlive the module when the editor shuts down.
+			if (WebBrowserPool.IsValid())
+			{
+				WebBrowserPool->Release(AIAssistantWebBrowserWidget);
+			}
+			else
+			{
+				AIAssistantWebBrowserWidget->OnClosed();
+			}
 		})
 		[
-			AIAssistantWebBrowserWidget.ToSharedRef()
+			AIAssistantWebBrowserWidget
 		];
 
 	
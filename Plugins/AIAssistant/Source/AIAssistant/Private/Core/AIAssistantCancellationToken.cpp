@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantCancellationToken.h"
+
+#include "Async/UniqueLock.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace UE::AIAssistant
+{
+	void FCancellationToken::Cancel()
+	{
+		TMap<FCallbackId, TUniqueFunction<void()>> CallbacksToCall;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			if (bIsCanceled)
+			{
+				return;
+			}
+			bIsCanceled = true;
+			CallbacksToCall = MoveTemp(Callbacks);
+			Callbacks.Reset();
+		}
+		// NOTE: Callbacks are called without holding the lock so they can access the token.
+		for (auto& CallbackIdAndCallback : CallbacksToCall)
+		{
+			CallbackIdAndCallback.Value();
+		}
+	}
+
+	bool FCancellationToken::IsCanceled() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return bIsCanceled;
+	}
+
+	FCancellationToken::FCallbackId FCancellationToken::OnCanceled(
+		TUniqueFunction<void()>&& Callback)
+	{
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			if (!bIsCanceled)
+			{
+				const FCallbackId CallbackId = NextCallbackId++;
+				Callbacks.Add(CallbackId, MoveTemp(Callback));
+				return CallbackId;
+			}
+		}
+		Callback();
+		return 0;
+	}
+
+	void FCancellationToken::RemoveOnCanceled(FCallbackId CallbackId)
+	{
+		TUniqueFunction<void()> CallbackToDestroy;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			if (TUniqueFunction<void()>* Callback = Callbacks.Find(CallbackId))
+			{
+				CallbackToDestroy = MoveTemp(*Callback);
+				Callbacks.Remove(CallbackId);
+			}
+		}
+	}
+}
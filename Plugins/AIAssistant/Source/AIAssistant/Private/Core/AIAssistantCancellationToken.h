@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Map.h"
+#include "Templates/Function.h"
+
+namespace UE::AIAssistant
+{
+	// Token used to cancel one or more asynchronous operations.
+	//
+	// Operations register a callback with OnCanceled() that is called when Cancel() is called.
+	// Callbacks are called at most once, on the thread that calls Cancel().
+	class FCancellationToken
+	{
+	public:
+		// ID of a registered callback, zero is never a valid ID.
+		using FCallbackId = uint64;
+
+	public:
+		FCancellationToken() = default;
+
+		// Prevent copy.
+		FCancellationToken(const FCancellationToken&) = delete;
+		FCancellationToken& operator=(const FCancellationToken&) = delete;
+
+		// Cancel all operations associated with this token.
+		void Cancel();
+
+		// Whether Cancel() has been called.
+		bool IsCanceled() const;
+
+		// Register a callback that is called when this token is canceled. If the token has already
+		// been canceled the callback is called immediately and zero is returned.
+		FCallbackId OnCanceled(TUniqueFunction<void()>&& Callback);
+
+		// Remove a callback registered with OnCanceled().
+		void RemoveOnCanceled(FCallbackId CallbackId);
+
+	private:
+		mutable UE::FMutex Lock;  // Guards all state below
+		bool bIsCanceled = false;
+		TMap<FCallbackId, TUniqueFunction<void()>> Callbacks;
+		FCallbackId NextCallbackId = 1;
+	};
+}
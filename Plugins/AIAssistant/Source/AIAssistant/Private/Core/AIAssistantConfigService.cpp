@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantConfigService.h"
+
+#include "DirectoryWatcherModule.h"
+#include "HAL/FileManager.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	// Compare arrays of strings case sensitively.
+	static bool AreConfigStringsEqual(const TArray<FString>& Lhs, const TArray<FString>& Rhs)
+	{
+		if (Lhs.Num() != Rhs.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Lhs.Num(); ++Index)
+		{
+			if (!Lhs[Index].Equals(Rhs[Index], ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FConfigChange FConfigChange::Diff(
+		const FAIAssistantConfig& Previous, const FAIAssistantConfig& Current)
+	{
+		FConfigChange Change;
+		Change.bMainUrlChanged = !Previous.MainUrl.Equals(Current.MainUrl, ESearchCase::CaseSensitive);
+		Change.bAllowedUrlRegexesChanged =
+			!AreConfigStringsEqual(Previous.AllowedUrlRegexes, Current.AllowedUrlRegexes);
+		return Change;
+	}
+
+	FConfigService::FConfigService(TArray<FString> InSearchDirectories) :
+		SearchDirectories(MoveTemp(InSearchDirectories))
+	{
+	}
+
+	FConfigService::~FConfigService()
+	{
+		StopWatching();
+	}
+
+	FConfigService& FConfigService::Get()
+	{
+		static FConfigService ConfigService;
+		return ConfigService;
+	}
+
+	const FAIAssistantConfig& FConfigService::GetConfig()
+	{
+		if (!Config.IsSet())
+		{
+			Filename = FAIAssistantConfig::FindConfigFile(SearchDirectories);
+			Config.Emplace(FAIAssistantConfig::Load(Filename));
+		}
+		return *Config;
+	}
+
+	const FString& FConfigService::GetFilename()
+	{
+		(void)GetConfig();
+		return Filename;
+	}
+
+	FConfigChange FConfigService::Reload()
+	{
+		const FAIAssistantConfig PreviousConfig = GetConfig();
+		Filename = FAIAssistantConfig::FindConfigFile(SearchDirectories);
+		Config.Emplace(FAIAssistantConfig::Load(Filename));
+
+		const FConfigChange Change = FConfigChange::Diff(PreviousConfig, *Config);
+		if (Change.HasChanged())
+		{
+			UE_LOG(
+				LogAIAssistant, Display, TEXT("Reloaded AI assistant config from \"%s\"."),
+				*Filename);
+			ConfigChanged.Broadcast(*Config, Change);
+		}
+		return Change;
+	}
+
+	void FConfigService::StartWatching()
+	{
+		if (!WatchedDirectories.IsEmpty())
+		{
+			return;
+		}
+		FDirectoryWatcherModule& DirectoryWatcherModule =
+			FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+		if (!DirectoryWatcher)
+		{
+			return;
+		}
+		for (const FString& SearchDirectory : SearchDirectories)
+		{
+			// Directories that don't exist can't be watched.
+			if (!IFileManager::Get().DirectoryExists(*SearchDirectory))
+			{
+				continue;
+			}
+			FDelegateHandle Handle;
+			if (DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+					SearchDirectory,
+					IDirectoryWatcher::FDirectoryChanged::CreateRaw(
+						this, &FConfigService::OnDirectoryChanged),
+					Handle, IDirectoryWatcher::WatchOptions::IgnoreChangesInSubtree))
+			{
+				WatchedDirectories.Emplace(SearchDirectory, Handle);
+			}
+		}
+	}
+
+	void FConfigService::StopWatching()
+	{
+		if (WatchedDirectories.IsEmpty())
+		{
+			return;
+		}
+		FDirectoryWatcherModule* DirectoryWatcherModule =
+			FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		IDirectoryWatcher* DirectoryWatcher =
+			DirectoryWatcherModule ? DirectoryWatcherModule->Get() : nullptr;
+		if (DirectoryWatcher)
+		{
+			for (const TPair<FString, FDelegateHandle>& WatchedDirectory : WatchedDirectories)
+			{
+				(void)DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(
+					WatchedDirectory.Key, WatchedDirectory.Value);
+			}
+		}
+		WatchedDirectories.Reset();
+	}
+
+	void FConfigService::OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+	{
+		for (const FFileChangeData& FileChange : FileChanges)
+		{
+			if (FPaths::GetCleanFilename(FileChange.Filename)
+					.Equals(FAIAssistantConfig::DefaultFilename, ESearchCase::IgnoreCase))
+			{
+				// A file may be added in a directory that takes precedence so search again.
+				(void)Reload();
+				return;
+			}
+		}
+	}
+}
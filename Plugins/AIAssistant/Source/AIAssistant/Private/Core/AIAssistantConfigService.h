@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Delegates/Delegate.h"
+#include "Delegates/IDelegateInstance.h"
+#include "Misc/Optional.h"
+#include "Templates/Tuple.h"
+#include "Templates/UnrealTemplate.h"
+
+#include "Core/AIAssistantConfig.h"
+
+struct FFileChangeData;
+
+namespace UE::AIAssistant
+{
+	// Fields that differ between two configurations.
+	struct FConfigChange
+	{
+		bool bMainUrlChanged = false;
+		bool bAllowedUrlRegexesChanged = false;
+
+		// Whether any field changed.
+		bool HasChanged() const { return bMainUrlChanged || bAllowedUrlRegexesChanged; }
+
+		// Compare two configurations.
+		static FConfigChange Diff(const FAIAssistantConfig& Previous, const FAIAssistantConfig& Current);
+	};
+
+	// Provides the assistant configuration and reloads it when it changes on disk.
+	//
+	// The configuration file is found and parsed the first time the configuration is requested,
+	// rather than each time a browser is created. While watching, each existing search directory
+	// is watched, without subdirectories, so editing, adding or removing an AIAssistant.json file
+	// finds the file again, reparses it and, if any field changed, notifies subscribers of
+	// OnConfigChanged() with the fields that changed.
+	//
+	// This must only be used from the game thread.
+	class FConfigService : public FNoncopyable
+	{
+	public:
+		// Called with the new configuration and the fields that changed.
+		using FOnConfigChanged =
+			TMulticastDelegate<void(const FAIAssistantConfig&, const FConfigChange&)>;
+
+	public:
+		explicit FConfigService(
+			TArray<FString> InSearchDirectories = FAIAssistantConfig::GetDefaultSearchDirectories());
+		~FConfigService();
+
+		// Get the configuration shared by all assistant browsers.
+		static FConfigService& Get();
+
+		// Get the configuration, loading it if it hasn't been loaded.
+		const FAIAssistantConfig& GetConfig();
+
+		// Get the loaded configuration file, empty if the default configuration is used.
+		const FString& GetFilename();
+
+		// Find and load the configuration file again, notifying subscribers if it changed.
+		// Returns the fields that changed.
+		FConfigChange Reload();
+
+		// Start watching the search directories for changes.
+		void StartWatching();
+
+		// Stop watching the search directories.
+		void StopWatching();
+
+		// Get the delegate called when the configuration changes.
+		FOnConfigChanged& OnConfigChanged() { return ConfigChanged; }
+
+	private:
+		// Reload the configuration when a configuration file changes.
+		void OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	private:
+		const TArray<FString> SearchDirectories;
+		TOptional<FAIAssistantConfig> Config;
+		FString Filename;
+		FOnConfigChanged ConfigChanged;
+		// Watched directories and their watch handles.
+		TArray<TPair<FString, FDelegateHandle>> WatchedDirectories;
+	};
+}
@@ -2,74 +2,83 @@
 
 #include "AIAssistantConversationReadyExecutor.h"
 
-#include "Async/Mutex.h"
-#include "Async/UniqueLock.h"
-#include "Templates/Function.h"
+#include "HAL/IConsoleManager.h"
 #include "Templates/UnrealTemplate.h"
 
 namespace UE::AIAssistant
 {
+	// Maximum number of operations waiting for a conversation, zero is unbounded.
+	int32 ConversationMaxDeferredConsoleVariableValue = 64;
+
+	FAutoConsoleVariableRef ConversationMaxDeferredConsoleVariableRef(
+		TEXT("ai.assistant.conversation.maxdeferred"), ConversationMaxDeferredConsoleVariableValue,
+		TEXT("Maximum number of AI assistant conversation operations, such as messages, that wait ")
+		TEXT("for the assistant page to load. Zero is unbounded."));
+
+	// FReadinessScheduler::EOverflowPolicy of operations waiting for a conversation. Operations
+	// include sending the user's messages, so new operations are rejected and reported to the
+	// caller rather than silently dropping the oldest.
+	int32 ConversationDeferredOverflowPolicyConsoleVariableValue =
+		int32(FReadinessScheduler::EOverflowPolicy::Reject);
+
+	FAutoConsoleVariableRef ConversationDeferredOverflowPolicyConsoleVariableRef(
+		TEXT("ai.assistant.conversation.deferredoverflowpolicy"),
+		ConversationDeferredOverflowPolicyConsoleVariableValue,
+		TEXT("What to do with AI assistant conversation operations that exceed ")
+		TEXT("ai.assistant.conversation.maxdeferred. 0 drops the oldest operation, 1 (default) ")
+		TEXT("rejects the new operation."));
+
 	FConversationReadyExecutor::FConversationReadyExecutor(
-		FGetExecuteWhenReadyStateFunc&& GetExecuteWhenReadyStateFunc) :
-			GetExecuteWhenReadyStateDelegate(MoveTemp(GetExecuteWhenReadyStateFunc))
+		EPageState InitialPageState, FReadinessScheduler::FGetTimeSecondsFunc&& GetTimeSeconds) :
+			Scheduler(MoveTemp(GetTimeSeconds)),
+			PageLoaded(Scheduler.AddCondition(TEXT("PageLoaded"))),
+			AgentEnvironmentConfigured(
+				Scheduler.AddCondition(TEXT("AgentEnvironmentConfigured"), { PageLoaded })),
+			ConversationReady(
+				Scheduler.AddCondition(TEXT("ConversationReady"), { AgentEnvironmentConfigured }))
 	{
+		Scheduler.SetCapacity(
+			ConversationMaxDeferredConsoleVariableValue,
+			ConversationDeferredOverflowPolicyConsoleVariableValue ==
+				int32(FReadinessScheduler::EOverflowPolicy::Reject)
+				? FReadinessScheduler::EOverflowPolicy::Reject
+				: FReadinessScheduler::EOverflowPolicy::DropOldest);
+		// A conversation is ready unless it's being created.
+		(void)Scheduler.SetCondition(ConversationReady, true);
+		SetPageState(InitialPageState);
 	}
 
-	// Notify the executor that the agent environment has been configured.
-	void FConversationReadyExecutor::NotifyAgentEnvironmentConfigured()
+	void FConversationReadyExecutor::SetPageState(EPageState PageState)
 	{
+		(void)Scheduler.SetCondition(PageLoaded, PageState == EPageState::Execute);
+		if (PageState == EPageState::Reject)
 		{
-			UE::TUniqueLock Lock(StateMutex);
-			bConfiguredAgentEnvironment = true;
+			(void)Scheduler.Reject(PageLoaded);
 		}
-		UpdateExecuteWhenReady();
 	}
 
-	bool FConversationReadyExecutor::SetCreatingConversation(bool bNewCreatingConversation)
+	void FConversationReadyExecutor::NotifyAgentEnvironmentConfigured()
 	{
-		bool bPreviousCreatingConversation;
-		bool bCreatingNewConversation;
-		bool bCreatedNewConversation;
-		{
-			UE::TUniqueLock Lock(StateMutex);
-			bPreviousCreatingConversation = bCreatingConversation;
-			bCreatingConversation = bNewCreatingConversation;
-			bCreatingNewConversation = !bPreviousCreatingConversation && bCreatingConversation;
-			bCreatedNewConversation = bPreviousCreatingConversation && !bCreatingConversation;
-		}
-		if (bCreatingNewConversation)
-		{
-			ResetExecuteWhenReady();
-		}
-		if (bCreatedNewConversation)
-		{
-			UpdateExecuteWhenReady();
-		}
-		return bPreviousCreatingConversation;
+		(void)Scheduler.SetCondition(AgentEnvironmentConfigured, true);
 	}
 
-	FExecuteWhenReady::EExecuteWhenReadyState FConversationReadyExecutor::GetExecuteWhenReadyState()
+	bool FConversationReadyExecutor::SetCreatingConversation(bool bNewCreatingConversation)
 	{
-		if (GetExecuteWhenReadyStateDelegate)
+		const bool bPreviousCreatingConversation =
+			!Scheduler.SetCondition(ConversationReady, !bNewCreatingConversation);
+		// Operations against the previous conversation are discarded.
+		if (!bPreviousCreatingConversation && bNewCreatingConversation)
 		{
-			auto ExecuteWhenReadyState = GetExecuteWhenReadyStateDelegate();
-			if (ExecuteWhenReadyState != EExecuteWhenReadyState::Execute)
-			{
-				return ExecuteWhenReadyState;
-			}
+			(void)Scheduler.Reject(ConversationReady);
 		}
-		UE::TUniqueLock Lock(StateMutex);
-		return !bConfiguredAgentEnvironment || bCreatingConversation
-			? EExecuteWhenReadyState::Wait
-			: EExecuteWhenReadyState::Execute;
+		return bPreviousCreatingConversation;
 	}
 
 	void FConversationReadyExecutor::ClearExecutionQueueIfCreatingConversation()
 	{
-		UE::TUniqueLock Lock(StateMutex);
-		if (bCreatingConversation)
+		if (!Scheduler.IsConditionSet(ConversationReady))
 		{
-			ResetExecuteWhenReady();
+			(void)Scheduler.Reject(ConversationReady);
 		}
 	}
-}
\ No newline at end of file
+}
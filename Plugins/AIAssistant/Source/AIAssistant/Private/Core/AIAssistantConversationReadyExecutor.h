@@ -1,27 +1,43 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 #pragma once
 
-#include "Async/Mutex.h"
-#include "Templates/Function.h"
 #include "Templates/UnrealTemplate.h"
+#include "UObject/NameTypes.h"
 
 #include "AIAssistantExecuteWhenReady.h"
+#include "AIAssistantReadinessScheduler.h"
 
 namespace UE::AIAssistant
 {
 	// Handles enqueuing of operations against a conversation until it's ready to accept messages.
-	class FConversationReadyExecutor : public FExecuteWhenReady
+	//
+	// Readiness is a chain of conditions in a FReadinessScheduler: the assistant page is loaded,
+	// the agent environment is configured for the page and the conversation isn't being created.
+	// Operations are dispatched as soon as a notification makes the last of these ready.
+	//
+	// The number of waiting operations is bounded by the ai.assistant.conversation.maxdeferred
+	// console variable, see FReadinessScheduler::SetCapacity(). By default operations that exceed
+	// it are rejected, see ai.assistant.conversation.deferredoverflowpolicy.
+	class FConversationReadyExecutor
 	{
 	public:
-		using FGetExecuteWhenReadyStateFunc = TFunction<FExecuteWhenReady::EExecuteWhenReadyState()>;
+		// State of the assistant page, Execute when loaded, Wait while loading and Reject if the
+		// page failed to load which discards pending operations.
+		using EPageState = FExecuteWhenReady::EExecuteWhenReadyState;
 
 	public:
-		// Construct with a delegate that retrieves additional execution when ready state.
-		FConversationReadyExecutor(
-			FGetExecuteWhenReadyStateFunc&& GetExecuteWhenReadyStateDelegate =
-				FGetExecuteWhenReadyStateFunc());
+		// Construct with the initial state of the assistant page.
+		explicit FConversationReadyExecutor(
+			EPageState InitialPageState = EPageState::Execute,
+			FReadinessScheduler::FGetTimeSecondsFunc&& GetTimeSeconds =
+				FReadinessScheduler::FGetTimeSecondsFunc());
 
-		virtual ~FConversationReadyExecutor() = default;
+		// Prevent copy.
+		FConversationReadyExecutor(const FConversationReadyExecutor&) = delete;
+		FConversationReadyExecutor& operator=(const FConversationReadyExecutor&) = delete;
+
+		// Notify the executor that the state of the assistant page changed.
+		void SetPageState(EPageState PageState);
 
 		// Notify the executor that the agent environment has been configured.
 		void NotifyAgentEnvironmentConfigured();
@@ -29,24 +45,37 @@ namespace UE::AIAssistant
 		// Set the creating conversation flag returning the previous value.
 		bool SetCreatingConversation(bool bNewCreatingConversation);
 
+		// Call Callable when the conversation is ready. If CoalescingKey is set a waiting
+		// operation with the same key is replaced. Returns false if the operation was discarded
+		// as too many operations are waiting.
 		template<class CallableType>
-		void ExecuteWhenReady(CallableType&& Callable)
+		bool ExecuteWhenReady(CallableType&& Callable, FName CoalescingKey = NAME_None)
 		{
 			ClearExecutionQueueIfCreatingConversation();
-			FExecuteWhenReady::ExecuteWhenReady(Forward<CallableType>(Callable));
+			return Scheduler.ExecuteWhenReady(
+				{ ConversationReady }, FReadinessScheduler::FWork(Forward<CallableType>(Callable)),
+				CoalescingKey);
+		}
+
+		// Get the number of operations waiting for the conversation to be ready.
+		int32 GetNumDeferredExecutionFunctions() const { return Scheduler.GetNumPendingWork(); }
+
+		// Get the counts of operations discarded while waiting.
+		FReadinessScheduler::FQueueMetrics GetQueueMetrics() const
+		{
+			return Scheduler.GetQueueMetrics();
 		}
 
-	protected:
-		FExecuteWhenReady::EExecuteWhenReadyState GetExecuteWhenReadyState() override;
+		// Get the scheduler for time to ready of each condition.
+		const FReadinessScheduler& GetReadinessScheduler() const { return Scheduler; }
 
 	private:
 		void ClearExecutionQueueIfCreatingConversation();
 
 	private:
-		mutable UE::FMutex StateMutex;
-		bool bConfiguredAgentEnvironment = false;
-		bool bCreatingConversation = false;
-		FGetExecuteWhenReadyStateFunc GetExecuteWhenReadyStateDelegate;
-
+		FReadinessScheduler Scheduler;
+		const FReadinessScheduler::FConditionId PageLoaded;
+		const FReadinessScheduler::FConditionId AgentEnvironmentConfigured;
+		const FReadinessScheduler::FConditionId ConversationReady;
 	};
-}
\ No newline at end of file
+}
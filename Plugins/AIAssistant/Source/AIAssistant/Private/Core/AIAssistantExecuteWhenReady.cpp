@@ -3,8 +3,8 @@
 
 #include "AIAssistantExecuteWhenReady.h"
 
-#include "Misc/ScopeRWLock.h"
-#include <functional>
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
 
 
 UE::AIAssistant::FExecuteWhenReady::FExecuteWhenReady(FExecuteWhenReady&& Other) noexcept
@@ -21,34 +21,57 @@ UE::AIAssistant::FExecuteWhenReady& UE::AIAssistant::FExecuteWhenReady::operator
 }
 
 
+UE::AIAssistant::FExecuteWhenReady::~FExecuteWhenReady()
+{
+	ResetExecuteWhenReady();
+}
+
+
 void UE::AIAssistant::FExecuteWhenReady::Enqueue(FDeferredExecutionFunction&& DeferredExecutionFunction)
 {
-	if (GetExecuteWhenReadyState() == EExecuteWhenReadyState::Execute)
+	// Functions enqueued by a deferred function are always queued, so they run after it.
+	
+	const bool bIsDrainOwner = DrainOwnerThreadId.load() == FPlatformTLS::GetCurrentThreadId();
+
+	
+	// If nothing is waiting, execute now without queuing. Owning the drain while executing means functions enqueued meanwhile by other
+	// threads are queued behind this one.
+	
+	bool bUnusedIsNested;
+	if (!bIsDrainOwner && GetExecuteWhenReadyState() == EExecuteWhenReadyState::Execute &&
+		NumDeferredExecutionFunctions.load() == 0 && TryAcquireDrain(bUnusedIsNested))
 	{
-		DeferredExecutionFunction();
+		if (NumDeferredExecutionFunctions.load() == 0)
+		{
+			DeferredExecutionFunction();
+			ReleaseDrain(false);
+			Drain(true, false);
+			return;
+		}
+		ReleaseDrain(false);
 	}
-	else 
+
+	
+	FDeferredExecutionNode* Node = new FDeferredExecutionNode();
+	Node->Function = MoveTemp(DeferredExecutionFunction);
+	++NumDeferredExecutionFunctions;
+	Push(Node);
+
+	if (!bIsDrainOwner && GetExecuteWhenReadyState() == EExecuteWhenReadyState::Execute)
 	{
-		FWriteScopeLock WriteScopeLock(DeferredExecutionFunctionRWLock);
-		
-		DeferredExecutionFunctions.Add(MoveTemp(DeferredExecutionFunction));
+		Drain(true, false);
 	}
 }
 
 
 void UE::AIAssistant::FExecuteWhenReady::UpdateExecuteWhenReady()
 {
-	if (GetExecuteWhenReadyState() == EExecuteWhenReadyState::Execute)
+	const EExecuteWhenReadyState ExecuteWhenReadyState = GetExecuteWhenReadyState();
+	if (ExecuteWhenReadyState == EExecuteWhenReadyState::Execute)
 	{
-		FWriteScopeLock WriteScopeLock(DeferredExecutionFunctionRWLock);
-
-		for (TArray<FDeferredExecutionFunction> Functions = MoveTemp(DeferredExecutionFunctions);
-			FDeferredExecutionFunction& Function : Functions)
-		{
-			Function();
-		}
+		Drain(true, false);
 	}
-	else if (GetExecuteWhenReadyState() == EExecuteWhenReadyState::Reject)
+	else if (ExecuteWhenReadyState == EExecuteWhenReadyState::Reject)
 	{
 		ResetExecuteWhenReady();
 	}
@@ -57,17 +80,13 @@ void UE::AIAssistant::FExecuteWhenReady::UpdateExecuteWhenReady()
 
 void UE::AIAssistant::FExecuteWhenReady::ResetExecuteWhenReady()
 {
-	FWriteScopeLock WriteScopeLock(DeferredExecutionFunctionRWLock);
-
-	DeferredExecutionFunctions.Empty();
+	Drain(false, true);
 }
 
 
 int32 UE::AIAssistant::FExecuteWhenReady::GetNumDeferredExecutionFunctions() const
 {
-	FReadScopeLock ReadScopedLock(DeferredExecutionFunctionRWLock);
-
-	return DeferredExecutionFunctions.Num();
+	return NumDeferredExecutionFunctions.load();
 }
 
 
@@ -77,6 +96,137 @@ bool UE::AIAssistant::FExecuteWhenReady::IsExecuteWhenReadyPending() const
 }
 
 
+void UE::AIAssistant::FExecuteWhenReady::Push(FDeferredExecutionNode* Node)
+{
+	Node->Next.store(nullptr, std::memory_order_relaxed);
+	
+	// Between the exchange and linking the previous node, the consumer can't reach Node, see Pop().
+	
+	FDeferredExecutionNode* Previous = Head.exchange(Node, std::memory_order_acq_rel);
+	Previous->Next.store(Node, std::memory_order_release);
+}
+
+
+UE::AIAssistant::FExecuteWhenReady::FDeferredExecutionNode* UE::AIAssistant::FExecuteWhenReady::Pop()
+{
+	FDeferredExecutionNode* CurrentTail = Tail;
+	FDeferredExecutionNode* Next = CurrentTail->Next.load(std::memory_order_acquire);
+	
+	// Skip the stub.
+	
+	if (CurrentTail == &Stub)
+	{
+		if (!Next)
+		{
+			return nullptr;
+		}
+		Tail = Next;
+		CurrentTail = Next;
+		Next = Next->Next.load(std::memory_order_acquire);
+	}
+	
+	if (Next)
+	{
+		Tail = Next;
+		return CurrentTail;
+	}
+	
+	// The tail is the last node unless a producer has swapped the head but not linked it yet.
+	
+	if (CurrentTail != Head.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+	
+	// Push the stub behind the tail so that the tail can be removed.
+	
+	Push(&Stub);
+	Next = CurrentTail->Next.load(std::memory_order_acquire);
+	if (Next)
+	{
+		Tail = Next;
+		return CurrentTail;
+	}
+	return nullptr;
+}
+
+
+void UE::AIAssistant::FExecuteWhenReady::Drain(const bool bExecute, const bool bWait)
+{
+	for (;;)
+	{
+		bool bIsNested;
+		if (!TryAcquireDrain(bIsNested))
+		{
+			if (!bWait)
+			{
+				return; // ..the thread that owns the drain checks for more functions after it releases it
+			}
+			FPlatformProcess::YieldThread();
+			continue;
+		}
+
+		
+		bool bPopped = false;
+		while (!bExecute || GetExecuteWhenReadyState() == EExecuteWhenReadyState::Execute)
+		{
+			FDeferredExecutionNode* Node = Pop();
+			if (!Node)
+			{
+				break;
+			}
+			bPopped = true;
+			--NumDeferredExecutionFunctions;
+			
+			// Functions are called without holding anything other than the drain, so they can enqueue, update or reset.
+			
+			FDeferredExecutionFunction Function = MoveTemp(Node->Function);
+			delete Node;
+			if (bExecute)
+			{
+				Function();
+			}
+		}
+		ReleaseDrain(bIsNested);
+
+
+		// Functions pushed after the last pop would be missed as the threads that pushed them couldn't acquire the drain, so check again.
+		
+		if (bIsNested || NumDeferredExecutionFunctions.load() == 0 ||
+			(bExecute && GetExecuteWhenReadyState() != EExecuteWhenReadyState::Execute))
+		{
+			return;
+		}
+		if (!bPopped)
+		{
+			FPlatformProcess::YieldThread(); // ..another thread is part way through pushing
+		}
+	}
+}
+
+
+bool UE::AIAssistant::FExecuteWhenReady::TryAcquireDrain(bool& bOutIsNested)
+{
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+	bOutIsNested = DrainOwnerThreadId.load() == ThreadId;
+	if (bOutIsNested)
+	{
+		return true;
+	}
+	uint32 ExpectedThreadId = 0;
+	return DrainOwnerThreadId.compare_exchange_strong(ExpectedThreadId, ThreadId);
+}
+
+
+void UE::AIAssistant::FExecuteWhenReady::ReleaseDrain(const bool bIsNested)
+{
+	if (!bIsNested)
+	{
+		DrainOwnerThreadId.store(0);
+	}
+}
+
+
 void UE::AIAssistant::FExecuteWhenReady::MoveFrom(FExecuteWhenReady& Other) noexcept
 {
 	if (this == &Other)
@@ -85,19 +235,28 @@ void UE::AIAssistant::FExecuteWhenReady::MoveFrom(FExecuteWhenReady& Other) noex
 	}
 
 	
-	// Looks strange, but we're being extra careful to avoid a particular kind of deadlock, which would be SUPER HARD to debug. Use pointer values to
-	// find a consistent locking order - in the very unlikely case that one thread tries to move two of these classes, while another thread tries to
-	// move the same two classes at the same time but in the opposite order. This way, they can't both acquire a first lock that is the second lock
-	// of the other one, with both would ending up getting blocked trying to acquire their second lock. To enforce the lock order, make the lower
-	// pointer value always lock first, and the higher pointer value always lock second. (It's technically safest to use std::less for the
-	// comparison.)
-	
-	const bool bLockThisBeforeOther = std::less<const FExecuteWhenReady*>()(this, &Other); // ..see comment
-	FWriteScopeLock WriteScopeLock1((bLockThisBeforeOther ? this : &Other)->DeferredExecutionFunctionRWLock);
-	FWriteScopeLock WriteScopeLock2((bLockThisBeforeOther ? &Other : this)->DeferredExecutionFunctionRWLock);
+	// We want to move all functions, but the queue nodes are linked to each object's stub so they're transferred one at a time. Owning
+	// the other object's drain prevents its functions from being executed while they're moved. This object's drain isn't required as
+	// pushing is safe from any thread.
 
-
-	// We want to move everything, but are not allowed to move the lock.
+	ResetExecuteWhenReady();
 	
-	DeferredExecutionFunctions = MoveTemp(Other.DeferredExecutionFunctions);
+	bool bIsNested;
+	while (!Other.TryAcquireDrain(bIsNested))
+	{
+		FPlatformProcess::YieldThread();
+	}
+	while (Other.NumDeferredExecutionFunctions.load() > 0)
+	{
+		FDeferredExecutionNode* Node = Other.Pop();
+		if (!Node)
+		{
+			FPlatformProcess::YieldThread(); // ..another thread is part way through pushing
+			continue;
+		}
+		--Other.NumDeferredExecutionFunctions;
+		++NumDeferredExecutionFunctions;
+		Push(Node);
+	}
+	Other.ReleaseDrain(bIsNested);
 }
@@ -4,9 +4,9 @@
 #pragma once
 
 
+#include <atomic>
+
 #include "Templates/Function.h"
-#include "Containers/Array.h"
-#include "HAL/CriticalSection.h"
 
 
 //
@@ -36,7 +36,7 @@ namespace UE::AIAssistant
 
 		
 		FExecuteWhenReady() = default;
-		virtual ~FExecuteWhenReady() = default;
+		virtual ~FExecuteWhenReady();
 
 		// Disallow copies. (Unique functions in here are move-only.)
 		FExecuteWhenReady(const FExecuteWhenReady&) = delete;
@@ -82,11 +82,12 @@ namespace UE::AIAssistant
 		 * Calls and clears deferred execution functions if ready state is set to execute.
 		 * Clears deferred execution functions if ready state is set to reject.
 		 * Otherwise ignores deferred execution functions for now.
+		 * If another thread is already calling deferred execution functions, that thread calls any that are pending instead.
 		 */
 		void UpdateExecuteWhenReady();
 
 		/**
-		 * Clear deferred execution functions.
+		 * Clear deferred execution functions. If another thread is calling deferred execution functions, this waits until it has finished.
 		 */
 		void ResetExecuteWhenReady();
 
@@ -105,18 +106,51 @@ namespace UE::AIAssistant
 		
 
 	private:
-		
 
-		// Used during access/modification of deferred execution functions.
-		mutable FRWLock DeferredExecutionFunctionRWLock;
+
+		// Node in the queue of deferred execution functions.
+		struct FDeferredExecutionNode
+		{
+			std::atomic<FDeferredExecutionNode*> Next = nullptr;
+			FDeferredExecutionFunction Function;
+		};
 
 		// Either executes incoming deferred execution function if ready now, or saves it to execute when ready later.
 		void Enqueue(FDeferredExecutionFunction&& DeferredExecutionFunction);
 
-		// Deferred functions to execute in order, when we become ready to execute them.
-		TArray<FDeferredExecutionFunction> DeferredExecutionFunctions;
+		// Add a node to the queue, this can be called from any thread.
+		void Push(FDeferredExecutionNode* Node);
+
+		// Remove the oldest node from the queue, only the drain owner can call this. Returns null if the queue is empty or a node is
+		// still being pushed by another thread.
+		FDeferredExecutionNode* Pop();
+
+		// Call (bExecute = true) or discard deferred execution functions until the queue is empty. Only one thread drains the queue at a
+		// time, if another thread is draining and bWait is false this returns immediately and the other thread drains the queue.
+		void Drain(bool bExecute, bool bWait);
+
+		// Try to become the thread that drains the queue. bOutIsNested is set if the calling thread is already draining the queue, i.e a
+		// deferred execution function is enqueuing or updating.
+		bool TryAcquireDrain(bool& bOutIsNested);
+
+		// Release ownership of the drain acquired with TryAcquireDrain().
+		void ReleaseDrain(bool bIsNested);
 
 		// Used for custom moves.
 		void MoveFrom(FExecuteWhenReady& Other) noexcept;
+
+
+		// Deferred functions to execute in order, when we become ready to execute them. This is an intrusive multiple producer single
+		// consumer queue - any thread can push to Head while only the thread that owns the drain pops from Tail. Stub keeps the queue
+		// non-empty so that producers never touch Tail.
+		FDeferredExecutionNode Stub;
+		std::atomic<FDeferredExecutionNode*> Head = &Stub;
+		FDeferredExecutionNode* Tail = &Stub;
+
+		// Number of deferred execution functions in the queue.
+		std::atomic<int32> NumDeferredExecutionFunctions = 0;
+
+		// ID of the thread that owns the drain or zero if the queue isn't being drained.
+		std::atomic<uint32> DrainOwnerThreadId = 0;
 	};
 }
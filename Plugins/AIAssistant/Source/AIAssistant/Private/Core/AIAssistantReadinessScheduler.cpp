@@ -0,0 +1,350 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantReadinessScheduler.h"
+
+#include "Async/UniqueLock.h"
+#include "HAL/PlatformTime.h"
+#include "Math/NumericLimits.h"
+#include "Math/UnrealMathUtility.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	FReadinessScheduler::FReadinessScheduler(FGetTimeSecondsFunc&& InGetTimeSeconds) :
+		GetTimeSecondsFunc(MoveTemp(InGetTimeSeconds))
+	{
+	}
+
+	FReadinessScheduler::FConditionId FReadinessScheduler::AddCondition(
+		const FString& Name, TConstArrayView<FConditionId> Dependencies)
+	{
+		const double NowSeconds = GetTimeSeconds();
+		UE::TUniqueLock ScopeLock(Lock);
+		const FConditionId ConditionId = Conditions.Num();
+		FCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.Name = Name;
+		Condition.Dependencies.Append(Dependencies.GetData(), Dependencies.Num());
+		Condition.NotReadySinceSeconds = NowSeconds;
+		for (FConditionId Dependency : Dependencies)
+		{
+			check(Conditions.IsValidIndex(Dependency) && Dependency != ConditionId);
+			Conditions[Dependency].Dependents.Add(ConditionId);
+		}
+		return ConditionId;
+	}
+
+	bool FReadinessScheduler::SetCondition(FConditionId ConditionId, bool bIsSet)
+	{
+		bool bWasSet;
+		int32 NumReadyWork;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			check(Conditions.IsValidIndex(ConditionId));
+			FCondition& Condition = Conditions[ConditionId];
+			bWasSet = Condition.bIsSet;
+			if (bWasSet == bIsSet)
+			{
+				return bWasSet;
+			}
+			Condition.bIsSet = bIsSet;
+			TArray<uint64> ReadyWorkIds;
+			UpdateReadiness(ConditionId, ReadyWorkIds);
+			QueueReadyWork(ReadyWorkIds);
+			NumReadyWork = ReadyWorkIds.Num();
+		}
+		DispatchReadyWork(NumReadyWork);
+		return bWasSet;
+	}
+
+	bool FReadinessScheduler::IsConditionSet(FConditionId ConditionId) const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		check(Conditions.IsValidIndex(ConditionId));
+		return Conditions[ConditionId].bIsSet;
+	}
+
+	bool FReadinessScheduler::IsReady(FConditionId ConditionId) const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		check(Conditions.IsValidIndex(ConditionId));
+		return Conditions[ConditionId].bIsReady;
+	}
+
+	void FReadinessScheduler::SetCapacity(int32 InMaxPendingWork, EOverflowPolicy InOverflowPolicy)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		MaxPendingWork = FMath::Max(InMaxPendingWork, 0);
+		OverflowPolicy = InOverflowPolicy;
+	}
+
+	bool FReadinessScheduler::ExecuteWhenReady(
+		TConstArrayView<FConditionId> WorkConditions, FWork&& Work, FName CoalescingKey)
+	{
+		// Work is destroyed without holding the lock.
+		TArray<FPendingWork> DiscardedWork;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			FPendingWork NewWork;
+			NewWork.Conditions.Append(WorkConditions.GetData(), WorkConditions.Num());
+			NewWork.CoalescingKey = CoalescingKey;
+			NewWork.Work = MoveTemp(Work);
+			if (!CoalescingKey.IsNone())
+			{
+				if (const uint64* CoalescedWorkId = PendingWorkByCoalescingKey.Find(CoalescingKey))
+				{
+					DiscardedWork.Add(RemovePendingWork(*CoalescedWorkId));
+					++QueueMetrics.NumCoalesced;
+				}
+			}
+			for (FConditionId ConditionId : WorkConditions)
+			{
+				check(Conditions.IsValidIndex(ConditionId));
+				if (!Conditions[ConditionId].bIsReady)
+				{
+					++NewWork.NumNotReady;
+				}
+			}
+			if (NewWork.NumNotReady == 0)
+			{
+				ReadyWork.Add(MoveTemp(NewWork));
+			}
+			else
+			{
+				if (MaxPendingWork > 0 && PendingWork.Num() >= MaxPendingWork)
+				{
+					if (OverflowPolicy == EOverflowPolicy::Reject)
+					{
+						++QueueMetrics.NumRejected;
+						UE_LOG(
+							LogAIAssistant, Warning,
+							TEXT("Rejected deferred work as %d items are waiting."), MaxPendingWork);
+						DiscardedWork.Add(MoveTemp(NewWork));
+						return false;
+					}
+					// IDs increase so the oldest work has the lowest ID.
+					uint64 OldestWorkId = TNumericLimits<uint64>::Max();
+					for (const auto& WorkIdAndWork : PendingWork)
+					{
+						OldestWorkId = FMath::Min(OldestWorkId, WorkIdAndWork.Key);
+					}
+					++QueueMetrics.NumDropped;
+					UE_LOG(
+						LogAIAssistant, Warning,
+						TEXT("Dropped the oldest deferred work as %d items are waiting."),
+						MaxPendingWork);
+					DiscardedWork.Add(RemovePendingWork(OldestWorkId));
+				}
+				const uint64 WorkId = NextWorkId++;
+				for (FConditionId ConditionId : NewWork.Conditions)
+				{
+					Conditions[ConditionId].WaitingWork.Add(WorkId);
+				}
+				if (!CoalescingKey.IsNone())
+				{
+					PendingWorkByCoalescingKey.Add(CoalescingKey, WorkId);
+				}
+				PendingWork.Add(WorkId, MoveTemp(NewWork));
+				return true;
+			}
+		}
+		DispatchReadyWork(1);
+		return true;
+	}
+
+	int32 FReadinessScheduler::Reject(FConditionId ConditionId)
+	{
+		// Work is destroyed without holding the lock.
+		TArray<FPendingWork> RejectedWork;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			check(Conditions.IsValidIndex(ConditionId));
+			TArray<bool> IsRejected;
+			IsRejected.SetNumZeroed(Conditions.Num());
+			TArray<FConditionId, TInlineAllocator<8>> ConditionsToVisit;
+			ConditionsToVisit.Add(ConditionId);
+			while (!ConditionsToVisit.IsEmpty())
+			{
+				const FConditionId RejectedConditionId = ConditionsToVisit.Pop(EAllowShrinking::No);
+				if (IsRejected[RejectedConditionId])
+				{
+					continue;
+				}
+				IsRejected[RejectedConditionId] = true;
+				FCondition& Condition = Conditions[RejectedConditionId];
+				ConditionsToVisit.Append(Condition.Dependents);
+				const TArray<uint64> WaitingWork = MoveTemp(Condition.WaitingWork);
+				for (uint64 WorkId : WaitingWork)
+				{
+					RejectedWork.Add(RemovePendingWork(WorkId));
+				}
+			}
+
+			// Work that is ready but hasn't been dispatched yet is also rejected.
+			for (int32 Index = ReadyWork.Num() - 1; Index >= 0; --Index)
+			{
+				const bool bDependsOnRejected = ReadyWork[Index].Conditions.ContainsByPredicate(
+					[&IsRejected](FConditionId WorkConditionId) -> bool
+					{
+						return IsRejected[WorkConditionId];
+					});
+				if (bDependsOnRejected)
+				{
+					RejectedWork.Add(MoveTemp(ReadyWork[Index]));
+					ReadyWork.RemoveAt(Index, EAllowShrinking::No);
+				}
+			}
+		}
+		return RejectedWork.Num();
+	}
+
+	int32 FReadinessScheduler::GetNumPendingWork() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return PendingWork.Num() + ReadyWork.Num();
+	}
+
+	FReadinessScheduler::FQueueMetrics FReadinessScheduler::GetQueueMetrics() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return QueueMetrics;
+	}
+
+	TArray<FReadinessScheduler::FConditionTiming> FReadinessScheduler::GetConditionTimings() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		TArray<FConditionTiming> Timings;
+		Timings.Reserve(Conditions.Num());
+		for (const FCondition& Condition : Conditions)
+		{
+			FConditionTiming& Timing = Timings.AddDefaulted_GetRef();
+			Timing.Name = Condition.Name;
+			Timing.bIsReady = Condition.bIsReady;
+			Timing.NumTimesReady = Condition.NumTimesReady;
+			Timing.TimeToReadySeconds = Condition.TimeToReadySeconds;
+		}
+		return Timings;
+	}
+
+	FString FReadinessScheduler::FormatConditionTimings(const TArray<FConditionTiming>& Timings)
+	{
+		FString Table = FString::Printf(
+			TEXT("%-32s %6s %8s %14s\n"),
+			TEXT("Condition"), TEXT("Ready"), TEXT("Times"), TEXT("TimeToReady(ms)"));
+		for (const FConditionTiming& Timing : Timings)
+		{
+			Table += FString::Printf(
+				TEXT("%-32s %6s %8d %14s\n"),
+				*Timing.Name, Timing.bIsReady ? TEXT("yes") : TEXT("no"), Timing.NumTimesReady,
+				Timing.TimeToReadySeconds.IsSet()
+					? *FString::Printf(TEXT("%.2f"), *Timing.TimeToReadySeconds * 1000.0)
+					: TEXT("-"));
+		}
+		return Table;
+	}
+
+	FReadinessScheduler::FPendingWork FReadinessScheduler::RemovePendingWork(uint64 WorkId)
+	{
+		FPendingWork Work = PendingWork.FindAndRemoveChecked(WorkId);
+		for (FConditionId ConditionId : Work.Conditions)
+		{
+			Conditions[ConditionId].WaitingWork.RemoveSingle(WorkId);
+		}
+		if (!Work.CoalescingKey.IsNone())
+		{
+			PendingWorkByCoalescingKey.Remove(Work.CoalescingKey);
+		}
+		return Work;
+	}
+
+	void FReadinessScheduler::UpdateReadiness(
+		FConditionId ConditionId, TArray<uint64>& OutReadyWorkIds)
+	{
+		// Readiness only changes in one direction when a single condition changes so each
+		// condition transitions at most once.
+		const double NowSeconds = GetTimeSeconds();
+		TArray<FConditionId, TInlineAllocator<8>> ConditionsToVisit;
+		ConditionsToVisit.Add(ConditionId);
+		while (!ConditionsToVisit.IsEmpty())
+		{
+			FCondition& Condition = Conditions[ConditionsToVisit.Pop(EAllowShrinking::No)];
+			bool bIsReady = Condition.bIsSet;
+			for (FConditionId Dependency : Condition.Dependencies)
+			{
+				bIsReady = bIsReady && Conditions[Dependency].bIsReady;
+			}
+			if (bIsReady == Condition.bIsReady)
+			{
+				continue;
+			}
+			Condition.bIsReady = bIsReady;
+			ConditionsToVisit.Append(Condition.Dependents);
+
+			if (!bIsReady)
+			{
+				Condition.NotReadySinceSeconds = NowSeconds;
+				for (uint64 WorkId : Condition.WaitingWork)
+				{
+					++PendingWork[WorkId].NumNotReady;
+				}
+				continue;
+			}
+
+			const double TimeToReadySeconds = NowSeconds - Condition.NotReadySinceSeconds;
+			Condition.TimeToReadySeconds = TimeToReadySeconds;
+			++Condition.NumTimesReady;
+			UE_LOG(
+				LogAIAssistant, Verbose, TEXT("Readiness condition %s ready after %.2fms."),
+				*Condition.Name, TimeToReadySeconds * 1000.0);
+			TRACE_BOOKMARK(TEXT("AIAssistant %s ready"), *Condition.Name);
+			for (uint64 WorkId : Condition.WaitingWork)
+			{
+				if (--PendingWork[WorkId].NumNotReady == 0)
+				{
+					OutReadyWorkIds.Add(WorkId);
+				}
+			}
+		}
+	}
+
+	void FReadinessScheduler::QueueReadyWork(TArray<uint64>& ReadyWorkIds)
+	{
+		ReadyWorkIds.Sort();
+		for (uint64 WorkId : ReadyWorkIds)
+		{
+			ReadyWork.Add(RemovePendingWork(WorkId));
+		}
+	}
+
+	void FReadinessScheduler::DispatchReadyWork(int32 NumReadyWork)
+	{
+		// Each queued function calls the oldest ready work rather than a specific item, so work
+		// is called in the order it was added to ReadyWork even when threads queue functions in a
+		// different order. Functions left over after rejected work was removed call nothing.
+		for (int32 Index = 0; Index < NumReadyWork; ++Index)
+		{
+			ReadyWorkQueue.ExecuteWhenReady([this]() -> void { CallOldestReadyWork(); });
+		}
+	}
+
+	void FReadinessScheduler::CallOldestReadyWork()
+	{
+		FPendingWork WorkToCall;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			if (ReadyWork.IsEmpty())
+			{
+				return;
+			}
+			WorkToCall = MoveTemp(ReadyWork[0]);
+			ReadyWork.RemoveAt(0, EAllowShrinking::No);
+		}
+		WorkToCall.Work();
+	}
+
+	double FReadinessScheduler::GetTimeSeconds() const
+	{
+		return GetTimeSecondsFunc ? GetTimeSecondsFunc() : FPlatformTime::Seconds();
+	}
+}
@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
+#include "UObject/NameTypes.h"
+
+#include "Core/AIAssistantExecuteWhenReady.h"
+
+namespace UE::AIAssistant
+{
+	// Defers work until the named conditions it depends upon are ready.
+	//
+	// Conditions form a directed acyclic graph, a condition is ready when it has been set and all
+	// of the conditions it depends upon are ready. Work added with ExecuteWhenReady() is
+	// dispatched, in the order it was added, as soon as all of its conditions are ready. Rather
+	// than polling, each condition tracks the work waiting on it and each work item counts its
+	// conditions that aren't ready, so a change only visits the conditions and work it affects.
+	//
+	// The time each condition takes to become ready, from when it was added or last stopped being
+	// ready, is available from GetConditionTimings(), logged and added as an Unreal Insights
+	// bookmark.
+	//
+	// The number of work items waiting on conditions can be bounded with SetCapacity(), work that
+	// would exceed the capacity either replaces the oldest waiting work or is rejected. Work added
+	// with a coalescing key replaces waiting work with the same key, regardless of capacity, so
+	// redundant updates collapse to the latest one.
+	//
+	// All methods are thread safe. Ready work is dispatched through an FExecuteWhenReady queue, so
+	// it's called one item at a time without holding any locks and can call back into the
+	// scheduler, work that becomes ready while another thread is dispatching is called by that
+	// thread.
+	class FReadinessScheduler
+	{
+	public:
+		// Index of a condition returned by AddCondition().
+		using FConditionId = int32;
+
+		// Deferred work.
+		using FWork = TUniqueFunction<void()>;
+
+		// Function that returns the current time in seconds.
+		using FGetTimeSecondsFunc = TFunction<double()>;
+
+		// What to do with work that would exceed the capacity.
+		enum class EOverflowPolicy : uint8
+		{
+			// Discard the oldest waiting work.
+			DropOldest = 0,
+			// Discard the new work.
+			Reject,
+		};
+
+		// Counts of work discarded without being called.
+		struct FQueueMetrics
+		{
+			// Waiting work discarded by EOverflowPolicy::DropOldest.
+			uint64 NumDropped = 0;
+			// New work discarded by EOverflowPolicy::Reject.
+			uint64 NumRejected = 0;
+			// Waiting work replaced by work with the same coalescing key.
+			uint64 NumCoalesced = 0;
+		};
+
+		// Time to ready of a condition.
+		struct FConditionTiming
+		{
+			FString Name;
+			// Whether the condition is currently ready.
+			bool bIsReady = false;
+			// Number of times the condition became ready.
+			int32 NumTimesReady = 0;
+			// Seconds the condition last took to become ready, unset if it has never been ready.
+			TOptional<double> TimeToReadySeconds;
+		};
+
+	public:
+		explicit FReadinessScheduler(FGetTimeSecondsFunc&& InGetTimeSeconds = FGetTimeSecondsFunc());
+
+		// Prevent copy.
+		FReadinessScheduler(const FReadinessScheduler&) = delete;
+		FReadinessScheduler& operator=(const FReadinessScheduler&) = delete;
+
+		// Add a condition that is initially not set. Dependencies must have been added previously,
+		// which guarantees the graph is acyclic.
+		FConditionId AddCondition(const FString& Name, TConstArrayView<FConditionId> Dependencies = {});
+
+		// Set or clear a condition dispatching any work that becomes ready.
+		// Returns whether the condition was previously set.
+		bool SetCondition(FConditionId ConditionId, bool bIsSet);
+
+		// Whether a condition has been set, regardless of its dependencies.
+		bool IsConditionSet(FConditionId ConditionId) const;
+
+		// Whether a condition and all of its dependencies are set.
+		bool IsReady(FConditionId ConditionId) const;
+
+		// Set the maximum number of work items waiting on conditions, zero is unbounded. Reducing
+		// the capacity doesn't discard work that is already waiting.
+		void SetCapacity(int32 InMaxPendingWork, EOverflowPolicy InOverflowPolicy);
+
+		// Call Work when all Conditions are ready, if they're already ready Work is called before
+		// this returns unless work is being dispatched by another thread. If CoalescingKey is set
+		// waiting work with the same key is discarded. Returns false if Work was discarded due to
+		// the capacity.
+		bool ExecuteWhenReady(
+			TConstArrayView<FConditionId> Conditions, FWork&& Work, FName CoalescingKey = NAME_None);
+
+		// Discard work that depends upon a condition or any condition that depends upon it.
+		// Returns the number of work items discarded.
+		int32 Reject(FConditionId ConditionId);
+
+		// Get the number of work items waiting to be dispatched.
+		int32 GetNumPendingWork() const;
+
+		// Get the counts of discarded work.
+		FQueueMetrics GetQueueMetrics() const;
+
+		// Get the time to ready of each condition in the order they were added.
+		TArray<FConditionTiming> GetConditionTimings() const;
+
+		// Format condition timings as a table.
+		static FString FormatConditionTimings(const TArray<FConditionTiming>& Timings);
+
+	private:
+		// Node in the graph.
+		struct FCondition
+		{
+			FString Name;
+			TArray<FConditionId> Dependencies;
+			TArray<FConditionId> Dependents;
+			// IDs of pending work that requires this condition.
+			TArray<uint64> WaitingWork;
+			bool bIsSet = false;
+			bool bIsReady = false;
+			// Time the condition was added or last stopped being ready.
+			double NotReadySinceSeconds = 0.0;
+			int32 NumTimesReady = 0;
+			TOptional<double> TimeToReadySeconds;
+		};
+
+		// Work waiting on conditions.
+		struct FPendingWork
+		{
+			TArray<FConditionId, TInlineAllocator<4>> Conditions;
+			// Number of Conditions that aren't ready.
+			int32 NumNotReady = 0;
+			FName CoalescingKey;
+			FWork Work;
+		};
+
+		// Remove work waiting on conditions. Lock must be held.
+		FPendingWork RemovePendingWork(uint64 WorkId);
+
+		// Update the readiness of a condition and the conditions that depend upon it, adding the
+		// IDs of work whose conditions are now all ready to OutReadyWorkIds. Lock must be held.
+		void UpdateReadiness(FConditionId ConditionId, TArray<uint64>& OutReadyWorkIds);
+
+		// Move pending work to ReadyWork in the order it was added. Lock must be held.
+		void QueueReadyWork(TArray<uint64>& ReadyWorkIds);
+
+		// Dispatch NumReadyWork items added to ReadyWork. Lock must not be held.
+		void DispatchReadyWork(int32 NumReadyWork);
+
+		// Call the oldest item in ReadyWork, if any.
+		void CallOldestReadyWork();
+
+		// Get the current time.
+		double GetTimeSeconds() const;
+
+		// Queue that is always ready, used to call ReadyWork one item at a time.
+		class FReadyWorkQueue final : public FExecuteWhenReady
+		{
+		public:
+			virtual EExecuteWhenReadyState GetExecuteWhenReadyState() override
+			{
+				return EExecuteWhenReadyState::Execute;
+			}
+		};
+
+	private:
+		FGetTimeSecondsFunc GetTimeSecondsFunc;
+		mutable UE::FMutex Lock;  // Guards all members below.
+		TArray<FCondition> Conditions;
+		TMap<uint64, FPendingWork> PendingWork;
+		uint64 NextWorkId = 0;
+		// IDs of waiting work by coalescing key.
+		TMap<FName, uint64> PendingWorkByCoalescingKey;
+		int32 MaxPendingWork = 0;
+		EOverflowPolicy OverflowPolicy = EOverflowPolicy::DropOldest;
+		FQueueMetrics QueueMetrics;
+		// Work whose conditions are ready in the order it's called.
+		TArray<FPendingWork> ReadyWork;
+		// Not guarded by Lock. Declared last so it's destroyed, discarding its functions, first.
+		FReadyWorkQueue ReadyWorkQueue;
+	};
+}
@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantStartupTimeline.h"
+
+#include "Async/UniqueLock.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	FAutoConsoleCommandWithArgsAndOutputDevice StartupHistoryConsoleCommand(
+		TEXT("ai.assistant.startup.history"),
+		TEXT("Print the milestones of the last N AI assistant startups, from spawning the tab to ")
+		TEXT("the first message being accepted, in milliseconds. Prints all retained startups if N ")
+		TEXT("isn't specified."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda(
+			[](const TArray<FString>& Args, FOutputDevice& Output) -> void
+			{
+				int32 MaxNumSessions = FStartupTimeline::MaxSessions;
+				if (Args.Num() > 0)
+				{
+					LexFromString(MaxNumSessions, *Args[0]);
+				}
+				FString History;
+				for (const FStartupTimeline::FSession& Session :
+					FStartupTimeline::Get().GetSessions(MaxNumSessions))
+				{
+					History += FStartupTimeline::FormatSession(Session) + TEXT("\n");
+				}
+				Output.Log(
+					LogAIAssistant.GetCategoryName(), ELogVerbosity::Display,
+					History.IsEmpty() ? TEXT("No AI assistant startups recorded.") : *History);
+			}));
+
+	FStartupTimeline& FStartupTimeline::Get()
+	{
+		static FStartupTimeline Timeline;
+		return Timeline;
+	}
+
+	void FStartupTimeline::BeginSession(double NowSeconds)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		EndSession();
+		CurrentSession.Emplace().StartSeconds = NowSeconds;
+	}
+
+	bool FStartupTimeline::MarkMilestone(EMilestone Milestone, double NowSeconds)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		if (!CurrentSession.IsSet())
+		{
+			return false;
+		}
+		TOptional<double>& MilestoneSeconds = CurrentSession->MilestoneSeconds[int32(Milestone)];
+		if (MilestoneSeconds.IsSet())
+		{
+			return false;
+		}
+		MilestoneSeconds = NowSeconds - CurrentSession->StartSeconds;
+		TRACE_BOOKMARK(TEXT("AIAssistant startup %s"), GetMilestoneName(Milestone));
+		UE_LOG(
+			LogAIAssistant, Verbose, TEXT("AI assistant startup reached %s after %.1f ms."),
+			GetMilestoneName(Milestone), *MilestoneSeconds * 1000.0);
+
+		if (Milestone == EMilestone::FirstMessageAccepted)
+		{
+			EndSession();
+		}
+		return true;
+	}
+
+	TArray<FStartupTimeline::FSession> FStartupTimeline::GetSessions(int32 MaxNumSessions) const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		TArray<FSession> AllSessions = Sessions;
+		if (CurrentSession.IsSet())
+		{
+			AllSessions.Add(*CurrentSession);
+		}
+		const int32 NumSessions = FMath::Clamp(MaxNumSessions, 0, AllSessions.Num());
+		return TArray<FSession>(AllSessions.GetData() + AllSessions.Num() - NumSessions, NumSessions);
+	}
+
+	FString FStartupTimeline::FormatSession(const FSession& Session)
+	{
+		FString Line;
+		for (int32 Index = 0; Index < int32(EMilestone::Count); ++Index)
+		{
+			const TOptional<double>& MilestoneSeconds = Session.MilestoneSeconds[Index];
+			Line += FString::Printf(
+				TEXT("%s%s="), Line.IsEmpty() ? TEXT("") : TEXT(" "),
+				GetMilestoneName(EMilestone(Index)));
+			Line += MilestoneSeconds.IsSet()
+				? FString::Printf(TEXT("%.1fms"), *MilestoneSeconds * 1000.0)
+				: FString(TEXT("-"));
+		}
+		return Line;
+	}
+
+	const TCHAR* FStartupTimeline::GetMilestoneName(EMilestone Milestone)
+	{
+		switch (Milestone)
+		{
+			case EMilestone::TabSpawned:
+				return TEXT("TabSpawned");
+			case EMilestone::BrowserWindowCreated:
+				return TEXT("BrowserWindowCreated");
+			case EMilestone::LoadStarted:
+				return TEXT("LoadStarted");
+			case EMilestone::LoadCompleted:
+				return TEXT("LoadCompleted");
+			case EMilestone::AgentEnvironmentAdded:
+				return TEXT("AgentEnvironmentAdded");
+			case EMilestone::AgentEnvironmentConfigured:
+				return TEXT("AgentEnvironmentConfigured");
+			case EMilestone::FirstMessageAccepted:
+				return TEXT("FirstMessageAccepted");
+			default:
+				return TEXT("Unknown");
+		}
+	}
+
+	void FStartupTimeline::EndSession()
+	{
+		if (!CurrentSession.IsSet())
+		{
+			return;
+		}
+		UE_LOG(
+			LogAIAssistant, Display, TEXT("AI assistant startup: %s"),
+			*FormatSession(*CurrentSession));
+		if (Sessions.Num() == MaxSessions)
+		{
+			Sessions.RemoveAt(0);
+		}
+		Sessions.Add(MoveTemp(*CurrentSession));
+		CurrentSession.Reset();
+	}
+}
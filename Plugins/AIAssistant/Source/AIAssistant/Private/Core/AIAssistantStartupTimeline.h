@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/StaticArray.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Optional.h"
+
+namespace UE::AIAssistant
+{
+	// Records when each phase of starting the assistant completes, from spawning its tab to the
+	// first message being accepted by the web application.
+	//
+	// A session starts when the tab is spawned, or when the browser is prewarmed without a tab in
+	// which case the tab later spawned for the prewarmed browser is recorded in the same session.
+	// Only the first occurrence of each milestone in a session is recorded and milestones outside
+	// of a session are ignored. A session ends when the first message is accepted or when the next
+	// session starts, at which point a one line summary is logged and the session is added to a
+	// bounded history that can be printed with the ai.assistant.startup.history console command.
+	// Each milestone is also added as an Unreal Insights bookmark.
+	//
+	// Milestones aren't reached in a session if the browser was reused from a previous tab, so
+	// those sessions only time sending the first message.
+	//
+	// All methods are thread safe.
+	class FStartupTimeline
+	{
+	public:
+		// Milestones in the order they're expected to be reached.
+		enum class EMilestone : uint8
+		{
+			// The assistant tab was spawned.
+			TabSpawned = 0,
+			// The CEF browser window was created.
+			BrowserWindowCreated,
+			// The browser started loading the assistant page.
+			LoadStarted,
+			// The browser finished loading the assistant page.
+			LoadCompleted,
+			// The web application added the agent environment.
+			AgentEnvironmentAdded,
+			// The agent environment was set so conversations can start.
+			AgentEnvironmentConfigured,
+			// The web application accepted the first message.
+			FirstMessageAccepted,
+			Count,
+		};
+
+		// Milestones reached by a session.
+		struct FSession
+		{
+			// When the session started.
+			double StartSeconds = 0.0;
+			// Seconds from the start of the session to each milestone that was reached.
+			TStaticArray<TOptional<double>, int32(EMilestone::Count)> MilestoneSeconds{InPlace};
+
+			// Get the time a milestone was reached relative to the start of the session.
+			const TOptional<double>& GetMilestoneSeconds(EMilestone Milestone) const
+			{
+				return MilestoneSeconds[int32(Milestone)];
+			}
+		};
+
+		// Maximum number of sessions retained.
+		static constexpr int32 MaxSessions = 16;
+
+	public:
+		FStartupTimeline() = default;
+
+		// Get the timeline shared by all assistant browsers.
+		static FStartupTimeline& Get();
+
+		// End the current session, if any, and start a new one.
+		void BeginSession(double NowSeconds = FPlatformTime::Seconds());
+
+		// Record a milestone in the current session.
+		// Returns whether the milestone was recorded, false if there is no session or the
+		// milestone was already reached.
+		bool MarkMilestone(EMilestone Milestone, double NowSeconds = FPlatformTime::Seconds());
+
+		// Get up to the last MaxNumSessions sessions, oldest first, including the current session.
+		TArray<FSession> GetSessions(int32 MaxNumSessions = MaxSessions) const;
+
+		// Format a session as a single line, milestones that weren't reached are shown as "-".
+		static FString FormatSession(const FSession& Session);
+
+		// Get the name of a milestone.
+		static const TCHAR* GetMilestoneName(EMilestone Milestone);
+
+	private:
+		// Log the current session and add it to the history.
+		void EndSession();
+
+	private:
+		mutable UE::FMutex Lock;  // Guards all members.
+		TOptional<FSession> CurrentSession;
+		// Ended sessions, oldest first.
+		TArray<FSession> Sessions;
+	};
+}
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantTimerWheel.h"
+
+#include "Async/UniqueLock.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/AssertionMacros.h"
+
+namespace UE::AIAssistant
+{
+	FTimerWheel::FTimerWheel(double InTickIntervalSeconds) :
+		TickIntervalSeconds(InTickIntervalSeconds)
+	{
+		check(TickIntervalSeconds > 0.0);
+	}
+
+	FTimerWheel::FTimerId FTimerWheel::Schedule(double DelaySeconds, FCallback&& Callback)
+	{
+		const double DelayTicks = FMath::CeilToDouble(
+			FMath::Max(DelaySeconds, 0.0) / TickIntervalSeconds);
+		return ScheduleTicks(
+			DelayTicks >= double(MaxDelayTicks) ? MaxDelayTicks : uint64(DelayTicks),
+			MoveTemp(Callback));
+	}
+
+	FTimerWheel::FTimerId FTimerWheel::ScheduleTicks(uint64 DelayTicks, FCallback&& Callback)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		const FTimerId TimerId = NextTimerId++;
+		// Timers always expire on a future tick.
+		const uint64 ExpiryTick = CurrentTick + FMath::Clamp<uint64>(DelayTicks, 1, MaxDelayTicks);
+		Timers.Add(TimerId, FTimer{ ExpiryTick, MoveTemp(Callback) });
+		TArray<FTimerId> UnusedExpired;
+		InsertTimer(TimerId, ExpiryTick, UnusedExpired);
+		check(UnusedExpired.IsEmpty());
+		return TimerId;
+	}
+
+	bool FTimerWheel::Cancel(FTimerId TimerId)
+	{
+		FCallback CallbackToDestroy;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			FTimer* Timer = Timers.Find(TimerId);
+			if (!Timer)
+			{
+				return false;
+			}
+			CallbackToDestroy = MoveTemp(Timer->Callback);
+			Timers.Remove(TimerId);
+		}
+		// NOTE: The callback is destroyed without holding the lock as it may own objects that
+		// call back into this object when destroyed.
+		return true;
+	}
+
+	int32 FTimerWheel::Advance(double DeltaSeconds)
+	{
+		uint64 NumTicks = 0;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			UnconsumedSeconds += FMath::Max(DeltaSeconds, 0.0);
+			const double WholeTicks = FMath::FloorToDouble(UnconsumedSeconds / TickIntervalSeconds);
+			UnconsumedSeconds -= WholeTicks * TickIntervalSeconds;
+			NumTicks = uint64(WholeTicks);
+		}
+		return AdvanceTicks(NumTicks);
+	}
+
+	int32 FTimerWheel::AdvanceTicks(uint64 NumTicks)
+	{
+		TArray<FTimerId> Expired;
+		{
+			UE::TUniqueLock ScopeLock(Lock);
+			for (uint64 Index = 0; Index < NumTicks; ++Index)
+			{
+				// Skip ticks when nothing is scheduled. Slots may still contain the IDs of canceled
+				// timers but as IDs are never reused they're ignored when their slot is processed.
+				if (Timers.IsEmpty())
+				{
+					CurrentTick += NumTicks - Index;
+					break;
+				}
+				Tick(Expired);
+			}
+		}
+		return RunExpired(Expired);
+	}
+
+	int32 FTimerWheel::GetNumTimers() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return Timers.Num();
+	}
+
+	uint64 FTimerWheel::GetCurrentTick() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return CurrentTick;
+	}
+
+	void FTimerWheel::InsertTimer(FTimerId TimerId, uint64 ExpiryTick, TArray<FTimerId>& Expired)
+	{
+		if (ExpiryTick <= CurrentTick)
+		{
+			Expired.Add(TimerId);
+			return;
+		}
+		const uint64 DelayTicks = ExpiryTick - CurrentTick;
+		int32 Level = 0;
+		while (Level < NumLevels - 1 && DelayTicks >= (uint64(1) << (NumSlotsLog2 * (Level + 1))))
+		{
+			++Level;
+		}
+		const int32 Slot = int32((ExpiryTick >> (NumSlotsLog2 * Level)) & (NumSlots - 1));
+		Slots[Level][Slot].Add(TimerId);
+	}
+
+	void FTimerWheel::Tick(TArray<FTimerId>& Expired)
+	{
+		++CurrentTick;
+
+		// Find the highest level that wrapped around on this tick.
+		int32 HighestLevelToCascade = 0;
+		while (HighestLevelToCascade < NumLevels - 1 &&
+			((CurrentTick >> (NumSlotsLog2 * HighestLevelToCascade)) & (NumSlots - 1)) == 0)
+		{
+			++HighestLevelToCascade;
+		}
+
+		// Redistribute timers from higher levels to lower levels, starting from the top.
+		for (int32 Level = HighestLevelToCascade; Level > 0; --Level)
+		{
+			const int32 Slot = int32((CurrentTick >> (NumSlotsLog2 * Level)) & (NumSlots - 1));
+			TArray<FTimerId> TimersToCascade = MoveTemp(Slots[Level][Slot]);
+			Slots[Level][Slot].Reset();
+			for (FTimerId TimerId : TimersToCascade)
+			{
+				if (const FTimer* Timer = Timers.Find(TimerId))
+				{
+					InsertTimer(TimerId, Timer->ExpiryTick, Expired);
+				}
+			}
+		}
+
+		TArray<FTimerId>& ExpiredSlot = Slots[0][CurrentTick & (NumSlots - 1)];
+		for (FTimerId TimerId : ExpiredSlot)
+		{
+			if (Timers.Contains(TimerId))
+			{
+				Expired.Add(TimerId);
+			}
+		}
+		ExpiredSlot.Reset();
+	}
+
+	int32 FTimerWheel::RunExpired(const TArray<FTimerId>& Expired)
+	{
+		int32 NumRun = 0;
+		for (FTimerId TimerId : Expired)
+		{
+			FCallback Callback;
+			{
+				UE::TUniqueLock ScopeLock(Lock);
+				// The timer may have been canceled by a previous callback.
+				FTimer* Timer = Timers.Find(TimerId);
+				if (!Timer)
+				{
+					continue;
+				}
+				Callback = MoveTemp(Timer->Callback);
+				Timers.Remove(TimerId);
+			}
+			Callback();
+			++NumRun;
+		}
+		return NumRun;
+	}
+}
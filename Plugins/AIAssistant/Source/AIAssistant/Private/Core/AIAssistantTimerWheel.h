@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/Function.h"
+
+namespace UE::AIAssistant
+{
+	// Hierarchical timer wheel that runs callbacks after a delay.
+	//
+	// Time is quantized into fixed length ticks. Timers due within NumSlots ticks are stored in
+	// the first level, each subsequent level covers NumSlots times the range of the previous
+	// level. When a level wraps around, the timers in the next slot of the level above are
+	// redistributed to lower levels. This makes scheduling, canceling and advancing O(1) for each
+	// timer regardless of the number of pending timers.
+	//
+	// Time is advanced explicitly using Advance() so the wheel can be driven by any clock, for
+	// example the editor's core ticker. All methods are thread safe and callbacks are executed
+	// without holding any locks so they can schedule or cancel timers.
+	class FTimerWheel
+	{
+	public:
+		// ID of a timer, zero is never a valid ID.
+		using FTimerId = uint64;
+
+		// Function called when a timer expires.
+		using FCallback = TUniqueFunction<void()>;
+
+		// Number of slots in each level.
+		static constexpr int32 NumSlotsLog2 = 6;
+		static constexpr int32 NumSlots = 1 << NumSlotsLog2;
+		// Number of levels in the wheel.
+		static constexpr int32 NumLevels = 4;
+		// Maximum delay of a timer in ticks, longer delays are clamped to this value.
+		static constexpr uint64 MaxDelayTicks = (uint64(1) << (NumSlotsLog2 * NumLevels)) - 1;
+
+	public:
+		explicit FTimerWheel(double TickIntervalSeconds = 0.05);
+
+		// Prevent copy.
+		FTimerWheel(const FTimerWheel&) = delete;
+		FTimerWheel& operator=(const FTimerWheel&) = delete;
+
+		// Run Callback after DelaySeconds, rounded up to the next tick.
+		// Returns the ID of the timer that can be used to cancel it.
+		FTimerId Schedule(double DelaySeconds, FCallback&& Callback);
+
+		// Run Callback after DelayTicks ticks, a delay of zero runs the callback on the next tick.
+		FTimerId ScheduleTicks(uint64 DelayTicks, FCallback&& Callback);
+
+		// Cancel a timer returning true if it was pending.
+		bool Cancel(FTimerId TimerId);
+
+		// Advance time by DeltaSeconds running the callbacks of all timers that expire.
+		// Returns the number of callbacks that were run.
+		int32 Advance(double DeltaSeconds);
+
+		// Advance time by NumTicks ticks running the callbacks of all timers that expire.
+		// Returns the number of callbacks that were run.
+		int32 AdvanceTicks(uint64 NumTicks);
+
+		// Get the number of pending timers.
+		int32 GetNumTimers() const;
+
+		// Get the number of ticks that have elapsed.
+		uint64 GetCurrentTick() const;
+
+		// Get the duration of a tick.
+		double GetTickIntervalSeconds() const { return TickIntervalSeconds; }
+
+	private:
+		// Pending timer.
+		struct FTimer
+		{
+			// Tick the timer expires on.
+			uint64 ExpiryTick = 0;
+			FCallback Callback;
+		};
+
+		// Add a timer to the slot for its expiry tick or to Expired if it has expired.
+		// Lock must be held.
+		void InsertTimer(FTimerId TimerId, uint64 ExpiryTick, TArray<FTimerId>& Expired);
+
+		// Advance one tick adding timers that expire to Expired.
+		// Lock must be held.
+		void Tick(TArray<FTimerId>& Expired);
+
+		// Run the callbacks of expired timers. Lock must not be held.
+		int32 RunExpired(const TArray<FTimerId>& Expired);
+
+	private:
+		const double TickIntervalSeconds;
+
+		mutable UE::FMutex Lock;  // Guards all state below
+		// Pending timers by ID.
+		TMap<FTimerId, FTimer> Timers;
+		// IDs of timers in each slot of each level. Canceled timers are removed lazily when
+		// their slot is processed.
+		TArray<FTimerId> Slots[NumLevels][NumSlots];
+		// Number of ticks that have elapsed.
+		uint64 CurrentTick = 0;
+		// Time that has not been consumed by a whole tick.
+		double UnconsumedSeconds = 0.0;
+		// ID of the next timer.
+		FTimerId NextTimerId = 1;
+	};
+}
@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantUrlAllowList.h"
+
+#include "Math/UnrealMathUtility.h"
+#include "Misc/Char.h"
+#include "Misc/CString.h"
+
+namespace UE::AIAssistant
+{
+	FUrlAllowList::FUrlAllowList(const TArray<FString>& Regexes, int32 CacheCapacity) :
+		Cache(FMath::Max(CacheCapacity, 1))
+	{
+		(void)Update(Regexes);
+	}
+
+	bool FUrlAllowList::IsAllowed(const FString& Url)
+	{
+		const bool bIsCacheable = Url.Len() <= MaxCachedUrlLength;
+		if (bIsCacheable)
+		{
+			if (const bool* bIsCachedAllowed = Cache.FindAndTouch(Url))
+			{
+				return *bIsCachedAllowed;
+			}
+		}
+		const bool bIsAllowed = MatchesLiteralPattern(Url) || MatchesRegexPattern(Url);
+		if (bIsCacheable)
+		{
+			Cache.Add(Url, bIsAllowed);
+		}
+		return bIsAllowed;
+	}
+
+	int32 FUrlAllowList::Update(const TArray<FString>& Regexes)
+	{
+		TArray<FRegexPattern> PreviousRegexPatterns = MoveTemp(RegexPatterns);
+		TArray<FString> PreviousRegexPatternStrings = MoveTemp(RegexPatternStrings);
+		RegexPatterns.Reset();
+		RegexPatternStrings.Reset();
+		TrieNodes.Reset();
+		TrieNodes.AddDefaulted();
+		NumLiteralPatterns = 0;
+		Cache.Empty(Cache.Max());
+
+		int32 NumCompiled = 0;
+		for (const FString& Regex : Regexes)
+		{
+			const TOptional<TTuple<FString, bool>> Literal = ParseLiteralPattern(Regex);
+			if (Literal.IsSet())
+			{
+				AddLiteralPattern(Literal->Get<0>(), Literal->Get<1>());
+				continue;
+			}
+			// Patterns are case sensitive so they're compared case sensitively.
+			const int32 PreviousIndex = PreviousRegexPatternStrings.IndexOfByPredicate(
+				[&Regex](const FString& PreviousRegex) -> bool
+				{
+					return PreviousRegex.Equals(Regex, ESearchCase::CaseSensitive);
+				});
+			if (PreviousIndex != INDEX_NONE)
+			{
+				RegexPatterns.Emplace(PreviousRegexPatterns[PreviousIndex]);
+			}
+			else
+			{
+				RegexPatterns.Emplace(Regex);
+				++NumCompiled;
+			}
+			RegexPatternStrings.Emplace(Regex);
+		}
+		return NumCompiled;
+	}
+
+	TOptional<TTuple<FString, bool>> FUrlAllowList::ParseLiteralPattern(const FString& Regex)
+	{
+		static const TCHAR* Metacharacters = TEXT(".*+?()[]{}^$|\\");
+		static const TCHAR* Quantifiers = TEXT("*+?{");
+
+		if (!Regex.StartsWith(TEXT("^"), ESearchCase::CaseSensitive))
+		{
+			return {};
+		}
+		FString Literal;
+		int32 Index = 1;
+		while (Index < Regex.Len())
+		{
+			const TCHAR Character = Regex[Index];
+			if (Character == TEXT('\\'))
+			{
+				// Escaped letters and digits are classes, anchors or backreferences.
+				if (Index + 1 == Regex.Len() || FChar::IsAlnum(Regex[Index + 1]))
+				{
+					return {};
+				}
+				Literal.AppendChar(Regex[Index + 1]);
+				Index += 2;
+			}
+			else if (FCString::Strchr(Metacharacters, Character))
+			{
+				break;
+			}
+			else
+			{
+				Literal.AppendChar(Character);
+				++Index;
+			}
+			// A quantified character makes the pattern match more than one literal.
+			if (Index < Regex.Len() && FCString::Strchr(Quantifiers, Regex[Index]))
+			{
+				return {};
+			}
+		}
+
+		const FStringView Remainder = FStringView(Regex).RightChop(Index);
+		if (Remainder.IsEmpty() || Remainder == TEXTVIEW(".*") || Remainder == TEXTVIEW(".*$"))
+		{
+			return MakeTuple(MoveTemp(Literal), true);
+		}
+		if (Remainder == TEXTVIEW("$"))
+		{
+			return MakeTuple(MoveTemp(Literal), false);
+		}
+		return {};
+	}
+
+	void FUrlAllowList::AddLiteralPattern(const FString& Literal, bool bIsPrefix)
+	{
+		int32 NodeIndex = 0;
+		for (const TCHAR Character : Literal)
+		{
+			int32 ChildIndex = FindChildNode(NodeIndex, Character);
+			if (ChildIndex == INDEX_NONE)
+			{
+				ChildIndex = TrieNodes.AddDefaulted();
+				TrieNodes[NodeIndex].Children.Emplace(Character, ChildIndex);
+			}
+			NodeIndex = ChildIndex;
+		}
+		if (bIsPrefix)
+		{
+			TrieNodes[NodeIndex].bMatchesPrefix = true;
+		}
+		else
+		{
+			TrieNodes[NodeIndex].bMatchesExact = true;
+		}
+		++NumLiteralPatterns;
+	}
+
+	int32 FUrlAllowList::FindChildNode(int32 NodeIndex, TCHAR Character) const
+	{
+		for (const TPair<TCHAR, int32>& Child : TrieNodes[NodeIndex].Children)
+		{
+			if (Child.Key == Character)
+			{
+				return Child.Value;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	bool FUrlAllowList::MatchesLiteralPattern(const FString& Url) const
+	{
+		int32 NodeIndex = 0;
+		for (const TCHAR Character : Url)
+		{
+			if (TrieNodes[NodeIndex].bMatchesPrefix)
+			{
+				return true;
+			}
+			NodeIndex = FindChildNode(NodeIndex, Character);
+			if (NodeIndex == INDEX_NONE)
+			{
+				return false;
+			}
+		}
+		return TrieNodes[NodeIndex].bMatchesPrefix || TrieNodes[NodeIndex].bMatchesExact;
+	}
+
+	bool FUrlAllowList::MatchesRegexPattern(const FString& Url) const
+	{
+		for (const FRegexPattern& Pattern : RegexPatterns)
+		{
+			if (FRegexMatcher(Pattern, Url).FindNext())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
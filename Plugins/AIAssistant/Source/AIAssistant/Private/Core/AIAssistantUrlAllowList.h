@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/LruCache.h"
+#include "Containers/UnrealString.h"
+#include "Internationalization/Regex.h"
+#include "Misc/Optional.h"
+#include "Templates/Tuple.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace UE::AIAssistant
+{
+	// Determines whether a URL matches any regular expression in an allow-list.
+	//
+	// Most allowed URL patterns are an anchored literal prefix like
+	// ^https://dev\.epicgames\.com/community/api/.* or an escaped URL like
+	// ^https://dev\.epicgames\.com/community/assistant/embedded$, so those patterns are compiled
+	// into a character trie that is walked once per URL instead of running a regular expression
+	// per pattern. The remaining patterns are matched with regular expressions, each compiled
+	// once. Matching through the trie assumes URLs don't contain line terminators.
+	//
+	// Navigation checks the same URLs repeatedly, e.g a redirect checks the page that started
+	// it, so recent decisions are kept in a small LRU cache. Long URLs, such as data URLs, aren't
+	// cached.
+	//
+	// This isn't thread safe.
+	class FUrlAllowList : public FNoncopyable
+	{
+	public:
+		// Default number of decisions cached.
+		static constexpr int32 DefaultCacheCapacity = 64;
+		// Longest URL that is cached.
+		static constexpr int32 MaxCachedUrlLength = 2048;
+
+	public:
+		explicit FUrlAllowList(
+			const TArray<FString>& Regexes, int32 CacheCapacity = DefaultCacheCapacity);
+
+		// Determine whether a URL matches any of the allowed patterns.
+		bool IsAllowed(const FString& Url);
+
+		// Replace the allowed patterns. Regular expressions that were already allowed are reused
+		// rather than compiled again. Returns the number of regular expressions compiled.
+		int32 Update(const TArray<FString>& Regexes);
+
+		// Get the number of patterns compiled into the trie.
+		int32 GetNumLiteralPatterns() const { return NumLiteralPatterns; }
+
+		// Get the number of patterns matched with regular expressions.
+		int32 GetNumRegexPatterns() const { return RegexPatterns.Num(); }
+
+		// Extract the literal of a regular expression that is an anchored literal optionally
+		// followed by .* or $. The returned bool is true if the literal is a prefix, false if the
+		// URL must equal the literal. Returns an unset value for any other regular expression.
+		static TOptional<TTuple<FString, bool>> ParseLiteralPattern(const FString& Regex);
+
+	private:
+		struct FTrieNode
+		{
+			// Character and index of each child node.
+			TArray<TPair<TCHAR, int32>> Children;
+			// Whether URLs that start with the characters leading to this node are allowed.
+			bool bMatchesPrefix = false;
+			// Whether URLs that equal the characters leading to this node are allowed.
+			bool bMatchesExact = false;
+		};
+
+	private:
+		// Add a literal pattern to the trie.
+		void AddLiteralPattern(const FString& Literal, bool bIsPrefix);
+
+		// Find the child of a node for a character, returns INDEX_NONE if it isn't found.
+		int32 FindChildNode(int32 NodeIndex, TCHAR Character) const;
+
+		// Match a URL against the trie.
+		bool MatchesLiteralPattern(const FString& Url) const;
+
+		// Match a URL against the regular expressions.
+		bool MatchesRegexPattern(const FString& Url) const;
+
+	private:
+		// Trie of literal patterns, the first node is the root.
+		TArray<FTrieNode> TrieNodes;
+		int32 NumLiteralPatterns = 0;
+		TArray<FRegexPattern> RegexPatterns;
+		// Source of each of RegexPatterns.
+		TArray<FString> RegexPatternStrings;
+		// Recent decisions by URL.
+		TLruCache<FString, bool> Cache;
+	};
+}
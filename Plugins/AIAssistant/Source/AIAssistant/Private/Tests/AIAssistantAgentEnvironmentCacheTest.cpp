@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#include "AIAssistantTestFlags.h"
+#include "WebAPI/AIAssistantAgentEnvironmentCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Get a unique cache filename that doesn't exist.
+static FString GetTemporaryAgentEnvironmentCacheFilename()
+{
+	return FPaths::Combine(
+		FPaths::ProjectSavedDir(), TEXT("Temp"), FGuid::NewGuid().ToString() + TEXT(".json"));
+}
+
+// Create an agent environment handle.
+static FAgentEnvironmentHandle CreateTestAgentEnvironmentHandle(const TCHAR* Id)
+{
+	FAgentEnvironmentHandle Handle;
+	Handle.Id.Id = Id;
+	Handle.Hash.Algorithm = TEXT("sha256");
+	Handle.Hash.Hash = FString(Id) + TEXT("hash");
+	return Handle;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantAgentEnvironmentCacheTestHash,
+	"AI.Assistant.AgentEnvironmentCache.Hash",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantAgentEnvironmentCacheTestHash::RunTest(const FString& UnusedParameters)
+{
+	FAgentEnvironment Ue;
+	Ue.Descriptor.EnvironmentName = TEXT("UE");
+	Ue.Descriptor.EnvironmentVersion = TEXT("5.6");
+	FAgentEnvironment Uefn = Ue;
+	Uefn.Descriptor.EnvironmentName = TEXT("UEFN");
+
+	const FString UeHash = FAgentEnvironmentCache::HashAgentEnvironment(Ue);
+	(void)TestFalse(TEXT("NotEmpty"), UeHash.IsEmpty());
+	(void)TestEqual(TEXT("Stable"), FAgentEnvironmentCache::HashAgentEnvironment(Ue), UeHash);
+	(void)TestNotEqual(
+		TEXT("Different"), FAgentEnvironmentCache::HashAgentEnvironment(Uefn), UeHash);
+	(void)TestNotEqual(
+		TEXT("DifferentBackends"),
+		FAgentEnvironmentCache::GetCacheUser(TEXT("user"), TEXT("https://a")),
+		FAgentEnvironmentCache::GetCacheUser(TEXT("user"), TEXT("https://b")));
+	(void)TestNotEqual(
+		TEXT("DifferentUsers"),
+		FAgentEnvironmentCache::GetCacheUser(TEXT("first"), TEXT("https://a")),
+		FAgentEnvironmentCache::GetCacheUser(TEXT("second"), TEXT("https://a")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantAgentEnvironmentCacheTestAddFindRemove,
+	"AI.Assistant.AgentEnvironmentCache.AddFindRemove",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantAgentEnvironmentCacheTestAddFindRemove::RunTest(const FString& UnusedParameters)
+{
+	FAgentEnvironmentCache Cache(FString{});
+	(void)TestFalse(TEXT("FindMissing"), Cache.Find(TEXT("env"), TEXT("user")).IsSet());
+
+	Cache.Add(TEXT("env"), TEXT("user"), CreateTestAgentEnvironmentHandle(TEXT("1")));
+	Cache.Add(TEXT("env"), TEXT("other"), CreateTestAgentEnvironmentHandle(TEXT("2")));
+	Cache.Add(TEXT("env"), TEXT("user"), CreateTestAgentEnvironmentHandle(TEXT("3")));
+	(void)TestEqual(TEXT("Num"), Cache.Num(), 2);
+
+	const TOptional<FAgentEnvironmentHandle> Handle = Cache.Find(TEXT("env"), TEXT("user"));
+	(void)TestTrue(TEXT("Find"), Handle.IsSet());
+	if (Handle.IsSet())
+	{
+		(void)TestEqual(TEXT("Id"), Handle->Id.Id, TEXT("3"));
+		(void)TestEqual(TEXT("Hash"), Handle->Hash.Hash, TEXT("3hash"));
+	}
+
+	(void)TestTrue(TEXT("Remove"), Cache.Remove(TEXT("env"), TEXT("user")));
+	(void)TestFalse(TEXT("RemoveAgain"), Cache.Remove(TEXT("env"), TEXT("user")));
+	(void)TestFalse(TEXT("FindRemoved"), Cache.Find(TEXT("env"), TEXT("user")).IsSet());
+	(void)TestTrue(TEXT("FindOther"), Cache.Find(TEXT("env"), TEXT("other")).IsSet());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantAgentEnvironmentCacheTestEvict,
+	"AI.Assistant.AgentEnvironmentCache.Evict",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantAgentEnvironmentCacheTestEvict::RunTest(const FString& UnusedParameters)
+{
+	FAgentEnvironmentCache Cache(FString{});
+	for (int32 Index = 0; Index <= FAgentEnvironmentCache::MaxEntries; ++Index)
+	{
+		Cache.Add(
+			FString::FromInt(Index), TEXT("user"), CreateTestAgentEnvironmentHandle(TEXT("id")));
+	}
+	(void)TestEqual(TEXT("Num"), Cache.Num(), FAgentEnvironmentCache::MaxEntries);
+	(void)TestFalse(TEXT("OldestEvicted"), Cache.Find(TEXT("0"), TEXT("user")).IsSet());
+	(void)TestTrue(
+		TEXT("NewestKept"),
+		Cache.Find(FString::FromInt(FAgentEnvironmentCache::MaxEntries), TEXT("user")).IsSet());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantAgentEnvironmentCacheTestPersist,
+	"AI.Assistant.AgentEnvironmentCache.Persist",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantAgentEnvironmentCacheTestPersist::RunTest(const FString& UnusedParameters)
+{
+	const FString Filename = GetTemporaryAgentEnvironmentCacheFilename();
+	{
+		FAgentEnvironmentCache Cache(Filename);
+		(void)TestEqual(TEXT("NumInitial"), Cache.Num(), 0);
+		Cache.Add(TEXT("env"), TEXT("user"), CreateTestAgentEnvironmentHandle(TEXT("1")));
+	}
+	{
+		FAgentEnvironmentCache Cache(Filename);
+		const TOptional<FAgentEnvironmentHandle> Handle = Cache.Find(TEXT("env"), TEXT("user"));
+		(void)TestTrue(TEXT("FindLoaded"), Handle.IsSet());
+		if (Handle.IsSet())
+		{
+			(void)TestEqual(TEXT("Id"), Handle->Id.Id, TEXT("1"));
+			(void)TestEqual(TEXT("Algorithm"), Handle->Hash.Algorithm, TEXT("sha256"));
+		}
+	}
+
+	// Invalid files are ignored.
+	(void)TestTrue(TEXT("WriteInvalid"), FFileHelper::SaveStringToFile(TEXT("{"), *Filename));
+	AddExpectedMessage(TEXT("Ignoring invalid agent environment cache"), ELogVerbosity::Warning);
+	{
+		FAgentEnvironmentCache Cache(Filename);
+		(void)TestEqual(TEXT("NumInvalid"), Cache.Num(), 0);
+	}
+	(void)IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
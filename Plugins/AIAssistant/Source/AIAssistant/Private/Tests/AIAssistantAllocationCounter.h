@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AssertionMacros.h"
+
+namespace UE::AIAssistant
+{
+	// Counts heap allocations made by the calling thread while in scope.
+	//
+	// This installs a proxy in front of GMalloc that forwards all requests and counts allocations
+	// made by the thread that created the counter. The proxy is never destroyed as other threads
+	// may still be calling through it after it has been uninstalled.
+	// NOTE: This is only intended to be used by benchmarks.
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter()
+		{
+			FCountingMalloc& CountingMalloc = FCountingMalloc::Get();
+			check(GMalloc != &CountingMalloc);
+			CountingMalloc.NumAllocations = 0;
+			CountingMalloc.CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+			CountingMalloc.InnerMalloc = GMalloc;
+			GMalloc = &CountingMalloc;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			FCountingMalloc& CountingMalloc = FCountingMalloc::Get();
+			GMalloc = CountingMalloc.InnerMalloc;
+			// InnerMalloc is left set so that any in flight calls on other threads can complete.
+			CountingMalloc.CountingThreadId = 0;
+		}
+
+		// Number of allocations and reallocations made by this thread since construction.
+		uint64 GetNumAllocations() const { return FCountingMalloc::Get().NumAllocations; }
+
+	private:
+		class FCountingMalloc : public FMalloc
+		{
+		public:
+			static FCountingMalloc& Get()
+			{
+				static FCountingMalloc* Instance = new FCountingMalloc();
+				return *Instance;
+			}
+
+			void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->Malloc(Count, Alignment);
+			}
+
+			void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->TryMalloc(Count, Alignment);
+			}
+
+			void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->Realloc(Original, Count, Alignment);
+			}
+
+			void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->TryRealloc(Original, Count, Alignment);
+			}
+
+			void Free(void* Original) override { InnerMalloc->Free(Original); }
+
+			SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+			{
+				return InnerMalloc->QuantizeSize(Count, Alignment);
+			}
+
+			bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+			{
+				return InnerMalloc->GetAllocationSize(Original, SizeOut);
+			}
+
+			void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+
+			void SetupTLSCachesOnCurrentThread() override
+			{
+				InnerMalloc->SetupTLSCachesOnCurrentThread();
+			}
+
+			void ClearAndDisableTLSCachesOnCurrentThread() override
+			{
+				InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+			}
+
+			bool IsInternallyThreadSafe() const override
+			{
+				return InnerMalloc->IsInternallyThreadSafe();
+			}
+
+			bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+
+			const TCHAR* GetDescriptiveName() override { return TEXT("AIAssistantCountingMalloc"); }
+
+		private:
+			void CountAllocation()
+			{
+				if (FPlatformTLS::GetCurrentThreadId() == CountingThreadId)
+				{
+					++NumAllocations;
+				}
+			}
+
+		public:
+			// Allocator requests are forwarded to.
+			FMalloc* InnerMalloc = nullptr;
+			// Thread allocations are counted for.
+			uint32 CountingThreadId = 0;
+			// Number of allocations made by CountingThreadId.
+			uint64 NumAllocations = 0;
+		};
+	};
+}
@@ -9,6 +9,7 @@
 #include "HAL/FileManager.h"
 #include "Utils/Utility.h"
 #include "Core/AIAssistantConfig.h"
+#include "Core/AIAssistantConfigService.h"
 #include "Tests/AIAssistantTestFlags.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -215,4 +216,61 @@ bool FAIAssistantConfigTestIgnoresAdditionalFields::RunTest(const FString& Unuse
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConfigTestServiceReload,
+	"AI.Assistant.Config.ServiceReload",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConfigTestServiceReload::RunTest(const FString& UnusedParameters)
+{
+	using UE::AIAssistant::FConfigChange;
+	using UE::AIAssistant::FConfigService;
+
+	const FTemporaryDirectory TemporaryDirectory;
+	const FString ConfigFilename(FPaths::Combine(*TemporaryDirectory, FAIAssistantConfig::DefaultFilename));
+	FConfigService ConfigService(TArray<FString>{ *TemporaryDirectory });
+	(void)TestEqual(TEXT("DefaultMainUrl"), ConfigService.GetConfig().MainUrl, FAIAssistantConfig::DefaultMainUrl);
+	(void)TestTrue(TEXT("NoFile"), ConfigService.GetFilename().IsEmpty());
+
+	int32 NumChanges = 0;
+	FConfigChange LastChange;
+	ConfigService.OnConfigChanged().AddLambda(
+		[&NumChanges, &LastChange](const FAIAssistantConfig&, const FConfigChange& Change) -> void
+		{
+			++NumChanges;
+			LastChange = Change;
+		});
+
+	verify(
+		FFileHelper::SaveStringToFile(
+			FString(TEXT(R"json({"main_url": "https://localhost/assistant"})json")),
+			*ConfigFilename));
+	FConfigChange Change = ConfigService.Reload();
+	(void)TestTrue(TEXT("MainUrlChanged"), Change.bMainUrlChanged);
+	(void)TestFalse(TEXT("AllowedUrlRegexesUnchanged"), Change.bAllowedUrlRegexesChanged);
+	(void)TestEqual(TEXT("MainUrl"), ConfigService.GetConfig().MainUrl, TEXT("https://localhost/assistant"));
+	(void)TestEqual(TEXT("Filename"), ConfigService.GetFilename(), ConfigFilename);
+
+	// Reloading an unchanged file doesn't notify subscribers.
+	(void)TestFalse(TEXT("Unchanged"), ConfigService.Reload().HasChanged());
+	(void)TestEqual(TEXT("NumChanges"), NumChanges, 1);
+
+	verify(
+		FFileHelper::SaveStringToFile(
+			FString(TEXT(R"json({"main_url": "https://localhost/assistant", "allowed_url_regexes": ["^https://a\\.com/"]})json")),
+			*ConfigFilename));
+	Change = ConfigService.Reload();
+	(void)TestFalse(TEXT("MainUrlUnchanged"), Change.bMainUrlChanged);
+	(void)TestTrue(TEXT("AllowedUrlRegexesChanged"), Change.bAllowedUrlRegexesChanged);
+	(void)TestEqual(TEXT("NumChangesAfterRegexes"), NumChanges, 2);
+	(void)TestTrue(TEXT("LastChange"), LastChange.bAllowedUrlRegexesChanged);
+
+	// Removing the file restores the default config.
+	verify(IFileManager::Get().Delete(*ConfigFilename));
+	Change = ConfigService.Reload();
+	(void)TestTrue(TEXT("RemovedMainUrlChanged"), Change.bMainUrlChanged);
+	(void)TestEqual(TEXT("RemovedMainUrl"), ConfigService.GetConfig().MainUrl, FAIAssistantConfig::DefaultMainUrl);
+	return true;
+}
+
 #endif  // WITH_DEV_AUTOMATION_TESTS
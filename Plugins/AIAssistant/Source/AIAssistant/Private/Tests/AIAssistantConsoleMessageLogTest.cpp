@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "UI/AIAssistantConsoleMessageLog.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConsoleMessageLogTestFold,
+	"AI.Assistant.ConsoleMessageLog.Fold",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConsoleMessageLogTestFold::RunTest(const FString& UnusedParameters)
+{
+	using ESeverity = EWebBrowserConsoleLogSeverity;
+
+	FConsoleMessageLog Log;
+	(void)TestTrue(TEXT("First"), Log.Add(ESeverity::Info, TEXT("tick"), TEXT("app.js"), 1, 0.0));
+	(void)TestFalse(TEXT("Repeat"), Log.Add(ESeverity::Info, TEXT("tick"), TEXT("app.js"), 1, 0.1));
+	(void)TestFalse(TEXT("RepeatAgain"), Log.Add(ESeverity::Info, TEXT("tick"), TEXT("app.js"), 1, 0.2));
+	(void)TestTrue(TEXT("OtherLine"), Log.Add(ESeverity::Info, TEXT("tick"), TEXT("app.js"), 2, 0.3));
+	(void)TestTrue(TEXT("OtherSeverity"), Log.Add(ESeverity::Warning, TEXT("tick"), TEXT("app.js"), 2, 0.4));
+
+	const TArray<FConsoleMessageLog::FMessage> Messages = Log.GetMessages();
+	if (TestEqual(TEXT("NumMessages"), Messages.Num(), 3))
+	{
+		(void)TestEqual(TEXT("NumRepeats"), Messages[0].NumRepeats, 3);
+		(void)TestEqual(TEXT("Seconds"), Messages[0].Seconds, 0.0);
+		(void)TestEqual(TEXT("NotRepeated"), Messages[1].NumRepeats, 1);
+	}
+	(void)TestEqual(TEXT("NumSuppressed"), Log.GetNumSuppressed(), uint64(2));
+	(void)TestTrue(TEXT("Format"), Log.Format().Contains(TEXT("Info - 'tick' @ app.js:1 (x3)")));
+
+	Log.Reset();
+	(void)TestEqual(TEXT("NumAfterReset"), Log.GetMessages().Num(), 0);
+	(void)TestEqual(TEXT("NumSuppressedAfterReset"), Log.GetNumSuppressed(), uint64(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConsoleMessageLogTestRateLimit,
+	"AI.Assistant.ConsoleMessageLog.RateLimit",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConsoleMessageLogTestRateLimit::RunTest(const FString& UnusedParameters)
+{
+	using ESeverity = EWebBrowserConsoleLogSeverity;
+
+	FConsoleMessageLog::FSettings Settings;
+	Settings.MaxLinesPerSecond = 2.0f;
+	Settings.MaxBurstLines = 3.0f;
+	FConsoleMessageLog Log(Settings);
+
+	int32 NumLogged = 0;
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		NumLogged += Log.Add(ESeverity::Info, FString::FromInt(Index), TEXT(""), 0, 1.0) ? 1 : 0;
+	}
+	(void)TestEqual(TEXT("Burst"), NumLogged, 3);
+	(void)TestEqual(TEXT("NumSuppressed"), Log.GetNumSuppressed(), uint64(7));
+	(void)TestEqual(TEXT("AllCaptured"), Log.GetMessages().Num(), 10);
+
+	// Each severity has its own budget so errors are still logged.
+	(void)TestTrue(TEXT("Error"), Log.Add(ESeverity::Error, TEXT("error"), TEXT(""), 0, 1.0));
+
+	// The budget refills over time.
+	(void)TestTrue(TEXT("Refilled"), Log.Add(ESeverity::Info, TEXT("later"), TEXT(""), 0, 1.5));
+	(void)TestFalse(TEXT("Exhausted"), Log.Add(ESeverity::Info, TEXT("later again"), TEXT(""), 0, 1.5));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConsoleMessageLogTestRingBuffer,
+	"AI.Assistant.ConsoleMessageLog.RingBuffer",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConsoleMessageLogTestRingBuffer::RunTest(const FString& UnusedParameters)
+{
+	FConsoleMessageLog::FSettings Settings;
+	Settings.Capacity = 3;
+	FConsoleMessageLog Log(Settings);
+	for (int32 Index = 0; Index < 5; ++Index)
+	{
+		(void)Log.Add(
+			EWebBrowserConsoleLogSeverity::Info, FString::FromInt(Index), TEXT(""), 0, double(Index));
+	}
+	const TArray<FConsoleMessageLog::FMessage> Messages = Log.GetMessages();
+	if (TestEqual(TEXT("NumMessages"), Messages.Num(), 3))
+	{
+		(void)TestEqual(TEXT("Oldest"), Messages[0].Message, TEXT("2"));
+		(void)TestEqual(TEXT("Middle"), Messages[1].Message, TEXT("3"));
+		(void)TestEqual(TEXT("Newest"), Messages[2].Message, TEXT("4"));
+	}
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,7 @@
 
 #include "Core/AIAssistantConversationReadyExecutor.h"
 #include "Core/AIAssistantExecuteWhenReady.h"
+#include "Core/AIAssistantReadinessScheduler.h"
 #include "AIAssistantTestFlags.h"
 
 using namespace UE::AIAssistant;
@@ -100,36 +101,32 @@ bool FAIAssistantConversationReadyExecutorOnlyExecuteLastAfterConversationCreate
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
-	FAIAssistantConversationReadyExecutorDelegateReadyStateTest,
-	"AI.Assistant.ConversationReadyExecutor.DelegateReadyState",
+	FAIAssistantConversationReadyExecutorPageStateTest,
+	"AI.Assistant.ConversationReadyExecutor.PageState",
 	AIAssistantTest::Flags);
 
-bool FAIAssistantConversationReadyExecutorDelegateReadyStateTest::RunTest(
+bool FAIAssistantConversationReadyExecutorPageStateTest::RunTest(
 	const FString& UnusedParameters)
 {
-	FExecuteWhenReady::EExecuteWhenReadyState ExecuteWhenReadyState =
-		FExecuteWhenReady::EExecuteWhenReadyState::Wait;
 	FConversationReadyExecutor ConversationReadyExecutor(
-		[&ExecuteWhenReadyState]() -> FExecuteWhenReady::EExecuteWhenReadyState
-		{
-			return ExecuteWhenReadyState;
-		});
+		FConversationReadyExecutor::EPageState::Wait);
 	ConversationReadyExecutor.NotifyAgentEnvironmentConfigured();
 
 	const FString LastExecutionNothing = TEXT("Nothing");
 	FString LastExecution = LastExecutionNothing;
 	ConversationReadyExecutor.ExecuteWhenReady(
 		[&LastExecution]() -> void { LastExecution = TEXT("First"); });
-	(void)TestEqual(TEXT("Should wait on the delegate"), LastExecution, LastExecutionNothing);
+	(void)TestEqual(TEXT("Should wait on the page"), LastExecution, LastExecutionNothing);
 
-	ExecuteWhenReadyState = FExecuteWhenReady::EExecuteWhenReadyState::Reject;
-	ConversationReadyExecutor.UpdateExecuteWhenReady();
+	ConversationReadyExecutor.SetPageState(FConversationReadyExecutor::EPageState::Reject);
 	(void)TestEqual(
 		TEXT("Pending execution should be cleared from the queue."),
 		LastExecution, LastExecutionNothing);
+	(void)TestEqual(
+		TEXT("No pending execution"), ConversationReadyExecutor.GetNumDeferredExecutionFunctions(), 0);
 
-	ExecuteWhenReadyState = FExecuteWhenReady::EExecuteWhenReadyState::Execute;
-	const FString LastExecutionLast = TEXT("Nothing");
+	ConversationReadyExecutor.SetPageState(FConversationReadyExecutor::EPageState::Execute);
+	const FString LastExecutionLast = TEXT("Last");
 	ConversationReadyExecutor.ExecuteWhenReady(
 		[&LastExecution, &LastExecutionLast]() -> void
 		{
@@ -141,4 +138,68 @@ bool FAIAssistantConversationReadyExecutorDelegateReadyStateTest::RunTest(
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConversationReadyExecutorTimeToReadyTest,
+	"AI.Assistant.ConversationReadyExecutor.TimeToReady",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConversationReadyExecutorTimeToReadyTest::RunTest(
+	const FString& UnusedParameters)
+{
+	double NowSeconds = 10.0;
+	FConversationReadyExecutor ConversationReadyExecutor(
+		FConversationReadyExecutor::EPageState::Wait,
+		[&NowSeconds]() -> double { return NowSeconds; });
+	NowSeconds = 11.0;
+	ConversationReadyExecutor.SetPageState(FConversationReadyExecutor::EPageState::Execute);
+	NowSeconds = 13.0;
+	ConversationReadyExecutor.NotifyAgentEnvironmentConfigured();
+
+	const TArray<FReadinessScheduler::FConditionTiming> Timings =
+		ConversationReadyExecutor.GetReadinessScheduler().GetConditionTimings();
+	(void)TestEqual(TEXT("NumTimings"), Timings.Num(), 3);
+	if (Timings.Num() == 3)
+	{
+		(void)TestEqual(TEXT("PageLoaded"), Timings[0].TimeToReadySeconds.Get(0.0), 1.0);
+		(void)TestEqual(
+			TEXT("AgentEnvironmentConfigured"), Timings[1].TimeToReadySeconds.Get(0.0), 3.0);
+		(void)TestEqual(TEXT("ConversationReady"), Timings[2].TimeToReadySeconds.Get(0.0), 3.0);
+		(void)TestTrue(TEXT("ConversationReadyIsReady"), Timings[2].bIsReady);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantConversationReadyExecutorRejectOverflowTest,
+	"AI.Assistant.ConversationReadyExecutor.RejectOverflow",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantConversationReadyExecutorRejectOverflowTest::RunTest(
+	const FString& UnusedParameters)
+{
+	FConversationReadyExecutor ConversationReadyExecutor;
+	TArray<int32> Executed;
+	int32 NumQueued = 0;
+	// By default operations beyond the capacity are rejected rather than dropping the oldest.
+	AddExpectedMessage(TEXT("Rejected deferred work"), ELogVerbosity::Warning);
+	for (int32 Index = 0; Index < 1024; ++Index)
+	{
+		if (!ConversationReadyExecutor.ExecuteWhenReady(
+				[&Executed, Index]() -> void { Executed.Add(Index); }))
+		{
+			break;
+		}
+		++NumQueued;
+	}
+	(void)TestTrue(TEXT("Rejected an operation"), NumQueued < 1024);
+	const FReadinessScheduler::FQueueMetrics Metrics = ConversationReadyExecutor.GetQueueMetrics();
+	(void)TestEqual(TEXT("NumRejected"), Metrics.NumRejected, uint64(1));
+	(void)TestEqual(TEXT("NumDropped"), Metrics.NumDropped, uint64(0));
+
+	ConversationReadyExecutor.NotifyAgentEnvironmentConfigured();
+	(void)TestEqual(TEXT("NumExecuted"), Executed.Num(), NumQueued);
+	(void)TestTrue(TEXT("Oldest executed"), !Executed.IsEmpty() && Executed[0] == 0);
+	return true;
+}
+
 #endif
\ No newline at end of file
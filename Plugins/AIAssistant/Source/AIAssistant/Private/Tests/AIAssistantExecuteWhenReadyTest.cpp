@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 	
 
+#include "Async/Async.h"
+#include "Containers/Array.h"
+#include "Templates/Tuple.h"
+
 #include "AIAssistantFakeExecuteWhenReady.h"
 #include "AIAssistantTestFlags.h"
 
@@ -118,4 +122,134 @@ bool AIAssistantExecuteWhenReadyTestIgnore::RunTest(const FString& UnusedParamet
 }
 
 
+// Test that deferred functions can enqueue more work and update without deadlocking, and that work enqueued by a deferred function runs
+// after it, in order.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	AIAssistantExecuteWhenReadyTestReentrant,
+	"AI.Assistant.ExecuteWhenReady.Reentrant",
+	AIAssistantTest::Flags);
+
+bool AIAssistantExecuteWhenReadyTestReentrant::RunTest(const FString& UnusedParameters)
+{
+	FFakeExecuteWhenReady FakeExecuteWhenReady(FFakeExecuteWhenReady::ExecuteWhenStateHitsValue);
+	TArray<int32> ExecutionOrder;
+
+	FakeExecuteWhenReady.ExecuteWhenReady([&FakeExecuteWhenReady, &ExecutionOrder]()
+		{
+			ExecutionOrder.Add(0);
+			FakeExecuteWhenReady.ExecuteWhenReady([&ExecutionOrder]() { ExecutionOrder.Add(2); });
+			FakeExecuteWhenReady.UpdateExecuteWhenReady();
+		});
+	FakeExecuteWhenReady.ExecuteWhenReady([&ExecutionOrder]() { ExecutionOrder.Add(1); });
+	TestEqual("DeferredExecutionFunctionCount", FakeExecuteWhenReady.GetNumDeferredExecutionFunctions(), 2);
+
+	FakeExecuteWhenReady.SetFakeStateCount(FFakeExecuteWhenReady::FakeStateTransitionCount);
+	FakeExecuteWhenReady.UpdateExecuteWhenReady();
+
+	TestEqual("DeferredExecutionFunctionCount", FakeExecuteWhenReady.GetNumDeferredExecutionFunctions(), 0);
+	if (TestEqual("ExecutionCount", ExecutionOrder.Num(), 3))
+	{
+		for (int32 Index = 0; Index < ExecutionOrder.Num(); Index++)
+		{
+			TestEqual("ExecutionOrder", ExecutionOrder[Index], Index);
+		}
+	}
+
+	// When ready, functions enqueued by a deferred function also run immediately, after it.
+
+	ExecutionOrder.Reset();
+	FakeExecuteWhenReady.ExecuteWhenReady([&FakeExecuteWhenReady, &ExecutionOrder]()
+		{
+			FakeExecuteWhenReady.ExecuteWhenReady([&ExecutionOrder]() { ExecutionOrder.Add(1); });
+			ExecutionOrder.Add(0);
+		});
+	if (TestEqual("ImmediateExecutionCount", ExecutionOrder.Num(), 2))
+	{
+		TestEqual("ImmediateExecutionOrder0", ExecutionOrder[0], 0);
+		TestEqual("ImmediateExecutionOrder1", ExecutionOrder[1], 1);
+	}
+	
+	return true;
+}
+
+
+// Stress test enqueuing from many threads while ready, so that functions are drained by whichever thread owns the drain. Functions from each
+// thread must run in the order they were enqueued, exactly once and never concurrently.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	AIAssistantExecuteWhenReadyTestStress,
+	"AI.Assistant.ExecuteWhenReady.Stress",
+	AIAssistantTest::Flags);
+
+bool AIAssistantExecuteWhenReadyTestStress::RunTest(const FString& UnusedParameters)
+{
+	constexpr int32 NumThreads = 8;
+	constexpr int32 NumFunctionsPerThread = 5000;
+
+	for (const bool bReadyWhileEnqueuing : { false, true })
+	{
+		FFakeExecuteWhenReady FakeExecuteWhenReady(FFakeExecuteWhenReady::ExecuteWhenStateHitsValue);
+		if (bReadyWhileEnqueuing)
+		{
+			FakeExecuteWhenReady.SetFakeStateCount(FFakeExecuteWhenReady::FakeStateTransitionCount);
+		}
+
+		// Only the thread that owns the drain executes functions so this is not synchronized, concurrent execution shows up as lost or
+		// out of order entries.
+		TArray<TPair<int32, int32>> Executed;
+		Executed.Reserve(NumThreads * NumFunctionsPerThread * 2);
+		int32 NumExecuting = 0;
+		int32 MaxNumExecuting = 0;
+
+		TArray<TFuture<void>> Producers;
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+		{
+			Producers.Add(Async(EAsyncExecution::Thread,
+				[&FakeExecuteWhenReady, &Executed, &NumExecuting, &MaxNumExecuting, ThreadIndex]()
+				{
+					for (int32 Sequence = 0; Sequence < NumFunctionsPerThread; Sequence++)
+					{
+						FakeExecuteWhenReady.ExecuteWhenReady(
+							[&Executed, &NumExecuting, &MaxNumExecuting, ThreadIndex, Sequence]()
+							{
+								MaxNumExecuting = FMath::Max(MaxNumExecuting, ++NumExecuting);
+								Executed.Emplace(ThreadIndex, Sequence);
+								--NumExecuting;
+							});
+						if (Sequence % 64 == 0)
+						{
+							FakeExecuteWhenReady.UpdateExecuteWhenReady();
+						}
+					}
+				}));
+		}
+		for (TFuture<void>& Producer : Producers)
+		{
+			Producer.Wait();
+		}
+
+		FakeExecuteWhenReady.SetFakeStateCount(FFakeExecuteWhenReady::FakeStateTransitionCount);
+		FakeExecuteWhenReady.UpdateExecuteWhenReady();
+
+		TestEqual("DeferredExecutionFunctionCount", FakeExecuteWhenReady.GetNumDeferredExecutionFunctions(), 0);
+		TestEqual("MaxNumExecuting", MaxNumExecuting, 1);
+		if (!TestEqual("ExecutedCount", Executed.Num(), NumThreads * NumFunctionsPerThread))
+		{
+			continue;
+		}
+		TArray<int32> NextSequence;
+		NextSequence.SetNumZeroed(NumThreads);
+		bool bInOrder = true;
+		for (const TPair<int32, int32>& Entry : Executed)
+		{
+			bInOrder &= Entry.Value == NextSequence[Entry.Key]++;
+		}
+		TestTrue("InOrder", bInOrder);
+	}
+	
+	return true;
+}
+
+
 #endif
@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/ValueOrError.h"
+
+#include "AIAssistantFakeWebJavaScriptDelegateBinder.h"
+#include "AIAssistantFakeWebJavaScriptExecutor.h"
+#include "AIAssistantWebJavaScriptResultDelegateAccessor.h"
+#include "WebAPI/AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	class FTestWebApi : public FWebApi
+	{
+	public:
+		struct FExecutedAsyncFunction {
+			FString FunctionName;
+			FString Arguments;
+			FHandlerId HandlerId;
+		};
+
+	public:
+		using FWebApi::FWebApi;
+		virtual ~FTestWebApi() = default;
+
+		// Ensure a JavaScript function was called with the specified arguments.
+		bool TestExpectAsyncFunctionCall(
+			FAutomationTestBase& TestCase,
+			const TCHAR* FunctionName,
+			const TCHAR* Arguments = TEXT("")) const
+		{
+			if (!TestCase.TestEqual(FunctionName, 1, ExecutedAsyncFunctions.Num()))
+			{
+				return false;
+			}
+
+			const auto& ExecutedAsyncFunction = ExecutedAsyncFunctions[0];
+			bool bCalled;
+			bCalled = TestCase.TestEqual(
+				FString::Printf(TEXT("%s_Called"), FunctionName),
+				ExecutedAsyncFunction.FunctionName, FunctionName);
+			bCalled = TestCase.TestEqual(
+				FString::Printf(TEXT("%s_Args"), FunctionName),
+				ExecutedAsyncFunction.Arguments, Arguments) && bCalled;
+			return bCalled;
+		}
+
+		// If possible, get the value of a result as JSON.  If the value cannot be converted to JSON
+		// return an empty string.
+		template<typename ValueType>
+		FString GetValueOrEmptyString(const TValueOrError<ValueType, FString>& ValueOrError)
+		{
+			return ValueOrError.GetValue().ToJson(false);
+		}
+
+		template<>
+		FString GetValueOrEmptyString<void>(const TValueOrError<void, FString>& UnusedValueOrError)
+		{
+			return FString();
+		}
+
+		// Ensure a JavaScript function was called with the specified arguments and complete it
+		// with ResultJson as a result of error if bResultJsonIsError is true.
+		template<typename ResultFutureType>
+		bool TestExpectAsyncFunctionCallAndComplete(
+			FAutomationTestBase& TestCase,
+			const TCHAR* FunctionName,
+			const TCHAR* Arguments,
+			ResultFutureType& ResultFuture,
+			const TCHAR* ResultJson,
+			bool bResultJsonIsError)
+		{
+			if (!TestExpectAsyncFunctionCall(TestCase, FunctionName, Arguments) || 
+				!TestCase.TestFalse(
+					FString::Printf(TEXT("%s_CompleteBeforeHandler"), FunctionName),
+					ResultFuture.IsReady()))
+			{
+				return false;
+			}
+		
+			FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+				*WebJavaScriptResultDelegate,
+				ExecutedAsyncFunctions[0].HandlerId,
+				ResultJson, bResultJsonIsError);
+
+			if (!TestCase.TestTrue(
+					FString::Printf(TEXT("%s_CompleteAfterHandler"), FunctionName),
+					ResultFuture.IsReady()))
+			{
+				return false;
+			}
+			const auto& Result = ResultFuture.Get();
+			bool bCompletedAsExpected;
+			bCompletedAsExpected = TestCase.TestEqual(
+				FString::Printf(TEXT("%s_ResultHasError"), FunctionName),
+				Result.HasError(), bResultJsonIsError);
+			bCompletedAsExpected = TestCase.TestEqual(
+				FString::Printf(TEXT("%s_HasExpectedResult"), FunctionName),
+				bResultJsonIsError ? Result.GetError() : GetValueOrEmptyString(Result),
+				ResultJson) && bCompletedAsExpected;
+			return bCompletedAsExpected;
+		}
+
+	protected:
+		void ExecuteAsyncFunction(
+			const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+			const FHandlerId& HandlerId) override
+		{
+			FWebApi::ExecuteAsyncFunction(FunctionName, Arguments, HandlerId);
+			ExecutedAsyncFunctions.Emplace(
+				FExecutedAsyncFunction{ FunctionName, Arguments.ToString(), HandlerId });
+		}
+
+	public:
+		TArray<FExecutedAsyncFunction> ExecutedAsyncFunctions;
+	};
+
+	struct FFakeWebApi
+	{
+		FFakeWebApi() : WebApi(WebJavaScriptExecutor, WebJavaScriptDelegateBinder) {}
+
+		FFakeWebJavaScriptExecutor WebJavaScriptExecutor;
+		FFakeWebJavaScriptDelegateBinder WebJavaScriptDelegateBinder;
+		FTestWebApi WebApi;
+
+		FTestWebApi& operator*() { return WebApi; }
+		FTestWebApi* operator->() { return &WebApi; }
+	};
+}
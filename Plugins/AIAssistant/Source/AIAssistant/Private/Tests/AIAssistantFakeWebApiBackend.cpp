@@ -0,0 +1,446 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantFakeWebApiBackend.h"
+
+#include "Containers/StringView.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/SharedPointer.h"
+
+#include "AIAssistantWebJavaScriptResultDelegateAccessor.h"
+
+namespace UE::AIAssistant
+{
+	const TCHAR* const FFakeWebApiBackend::WebApiObjectName = TEXT("window.eda");
+
+	// Find the character that closes the bracket or string literal at OpenIndex skipping nested
+	// brackets and string literals. Returns INDEX_NONE if it isn't closed.
+	static int32 FindFakeWebApiBackendClosingBracket(FStringView Text, int32 OpenIndex)
+	{
+		int32 Depth = 0;
+		TCHAR Quote = 0;
+		for (int32 Index = OpenIndex; Index < Text.Len(); ++Index)
+		{
+			const TCHAR Character = Text[Index];
+			if (Quote)
+			{
+				if (Character == TEXT('\\'))
+				{
+					++Index;
+				}
+				else if (Character == Quote)
+				{
+					Quote = 0;
+					if (Depth == 0)
+					{
+						return Index;
+					}
+				}
+				continue;
+			}
+			switch (Character)
+			{
+			case TEXT('"'):
+			case TEXT('\''):
+			case TEXT('`'):
+				Quote = Character;
+				break;
+			case TEXT('('):
+			case TEXT('['):
+			case TEXT('{'):
+				++Depth;
+				break;
+			case TEXT(')'):
+			case TEXT(']'):
+			case TEXT('}'):
+				if (--Depth == 0)
+				{
+					return Index;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// Split a list of arguments on commas that are not nested in brackets or strings.
+	static TArray<FStringView> SplitFakeWebApiBackendArguments(FStringView Arguments)
+	{
+		TArray<FStringView> Split;
+		int32 Start = 0;
+		for (int32 Index = 0; Index <= Arguments.Len(); ++Index)
+		{
+			if (Index == Arguments.Len() || Arguments[Index] == TEXT(','))
+			{
+				Split.Add(Arguments.Mid(Start, Index - Start).TrimStartAndEnd());
+				Start = Index + 1;
+				continue;
+			}
+			switch (Arguments[Index])
+			{
+			case TEXT('('):
+			case TEXT('['):
+			case TEXT('{'):
+			case TEXT('"'):
+			case TEXT('\''):
+			case TEXT('`'):
+			{
+				// Skip nested brackets and string literals.
+				const int32 CloseIndex = FindFakeWebApiBackendClosingBracket(Arguments, Index);
+				Index = CloseIndex == INDEX_NONE ? Arguments.Len() - 1 : CloseIndex;
+				break;
+			}
+			default:
+				break;
+			}
+		}
+		return Split;
+	}
+
+	FFakeWebApiBackend::FFakeWebApiBackend(
+		FFakeWebJavaScriptDelegateBinder& InDelegateBinder, int32 RandomSeed) :
+		DelegateBinder(InDelegateBinder),
+		RandomStream(RandomSeed),
+		TimerWheel(TickIntervalSeconds)
+	{
+	}
+
+	void FFakeWebApiBackend::SetFunctionBehavior(
+		const FString& FunctionName, const FFunctionBehavior& Behavior)
+	{
+		FunctionBehaviors.Add(FunctionName, Behavior);
+	}
+
+	void FFakeWebApiBackend::SetDefaultBehavior(const FFunctionBehavior& Behavior)
+	{
+		DefaultBehavior = Behavior;
+	}
+
+	FCodeExecutionResult FFakeWebApiBackend::Execute(const FString& JavaScriptText)
+	{
+		++Stats.NumScripts;
+		TArray<FParsedCall> Calls;
+		TArray<FParsedStreamControl> StreamControls;
+		ParseScript(JavaScriptText, Calls, StreamControls);
+		for (const FParsedStreamControl& StreamControl : StreamControls)
+		{
+			ApplyStreamControl(StreamControl);
+		}
+		for (FParsedCall& Call : Calls)
+		{
+			ScheduleCall(MoveTemp(Call));
+		}
+		return FCodeExecutionResult{ true };
+	}
+
+	void FFakeWebApiBackend::Advance(double DeltaSeconds)
+	{
+		(void)TimerWheel.Advance(DeltaSeconds);
+	}
+
+	bool FFakeWebApiBackend::RunUntilIdle(double MaxSeconds)
+	{
+		const uint64 MaxTicks = uint64(FMath::CeilToDouble(MaxSeconds / TickIntervalSeconds));
+		for (uint64 Tick = 0; Tick < MaxTicks && TimerWheel.GetNumTimers() > 0; ++Tick)
+		{
+			(void)TimerWheel.AdvanceTicks(1);
+		}
+		return TimerWheel.GetNumTimers() == 0;
+	}
+
+	int32 FFakeWebApiBackend::GetNumPendingCalls() const
+	{
+		return TimerWheel.GetNumTimers();
+	}
+
+	void FFakeWebApiBackend::ParseScript(
+		const FString& JavaScriptText, TArray<FParsedCall>& OutCalls,
+		TArray<FParsedStreamControl>& OutStreamControls)
+	{
+		static const FString StreamControlPrefix(TEXT("window.aiassistantstreams?.[\""));
+		static const FString StreamDeclarationPrefix(TEXT("streams[\""));
+		static const FString StreamDeclarationSuffix(TEXT("\"] = stream;"));
+		static const FString HandlerPrefix(TEXT("window.ue."));
+		static const FString StreamArgument(TEXT("stream"));
+		static const FString StreamArgumentWithSeparator(TEXT(", stream"));
+		const FString CallPrefix = FString(WebApiObjectName) + TEXT(".");
+		const FStringView Text(JavaScriptText);
+
+		// Handlers and the stream key of a streamed call are declared before the call.
+		TOptional<FParsedCall::FHandler> PendingChunkHandler;
+		FString PendingStreamKey;
+		int32 Position = 0;
+		while (Position < Text.Len())
+		{
+			auto FindNext = [&JavaScriptText, &Position](const FString& Prefix) -> int32
+				{
+					const int32 Index = JavaScriptText.Find(
+						Prefix, ESearchCase::CaseSensitive, ESearchDir::FromStart, Position);
+					return Index == INDEX_NONE ? MAX_int32 : Index;
+				};
+			const int32 StreamControlIndex = FindNext(StreamControlPrefix);
+			const int32 StreamDeclarationIndex = FindNext(StreamDeclarationPrefix);
+			const int32 HandlerIndex = FindNext(HandlerPrefix);
+			const int32 CallIndex = FindNext(CallPrefix);
+			const int32 NextIndex = FMath::Min(
+				FMath::Min(StreamControlIndex, StreamDeclarationIndex),
+				FMath::Min(HandlerIndex, CallIndex));
+			if (NextIndex == MAX_int32)
+			{
+				break;
+			}
+
+			if (NextIndex == StreamControlIndex)
+			{
+				// window.aiassistantstreams?.["<key>"]?.<control>;
+				const int32 KeyStart = NextIndex + StreamControlPrefix.Len();
+				int32 KeyEnd = JavaScriptText.Find(
+					TEXT("\"]?."), ESearchCase::CaseSensitive, ESearchDir::FromStart, KeyStart);
+				int32 ControlEnd = KeyEnd == INDEX_NONE
+					? INDEX_NONE
+					: JavaScriptText.Find(
+						TEXT(";"), ESearchCase::CaseSensitive, ESearchDir::FromStart, KeyEnd);
+				if (ControlEnd == INDEX_NONE)
+				{
+					break;
+				}
+				const int32 ControlStart = KeyEnd + 4;
+				OutStreamControls.Add(
+					FParsedStreamControl{
+						FString(Text.Mid(KeyStart, KeyEnd - KeyStart)),
+						FString(Text.Mid(ControlStart, ControlEnd - ControlStart)) });
+				Position = ControlEnd + 1;
+			}
+			else if (NextIndex == StreamDeclarationIndex)
+			{
+				// streams["<key>"] = stream;
+				const int32 KeyStart = NextIndex + StreamDeclarationPrefix.Len();
+				int32 KeyEnd;
+				if (!Text.RightChop(KeyStart).FindChar(TEXT('"'), KeyEnd))
+				{
+					break;
+				}
+				KeyEnd += KeyStart;
+				if (Text.RightChop(KeyEnd).StartsWith(StreamDeclarationSuffix))
+				{
+					PendingStreamKey = FString(Text.Mid(KeyStart, KeyEnd - KeyStart));
+				}
+				Position = KeyEnd + 1;
+			}
+			else if (NextIndex == HandlerIndex)
+			{
+				// window.ue.<object>.<function>(<index>, <generation>, JSON.stringify(<value>),
+				// <isError>);
+				const int32 ObjectStart = NextIndex + HandlerPrefix.Len();
+				int32 OpenIndex;
+				if (!Text.RightChop(ObjectStart).FindChar(TEXT('('), OpenIndex))
+				{
+					break;
+				}
+				OpenIndex += ObjectStart;
+				const int32 CloseIndex = FindFakeWebApiBackendClosingBracket(Text, OpenIndex);
+				if (CloseIndex == INDEX_NONE)
+				{
+					break;
+				}
+				Position = CloseIndex + 1;
+
+				const FStringView ObjectAndFunction = Text.Mid(ObjectStart, OpenIndex - ObjectStart);
+				int32 Separator;
+				if (!ObjectAndFunction.FindChar(TEXT('.'), Separator) ||
+					!ObjectAndFunction.RightChop(Separator + 1).Equals(
+						TEXT("HandleResult"), ESearchCase::IgnoreCase))
+				{
+					continue;
+				}
+				const TArray<FStringView> Arguments = SplitFakeWebApiBackendArguments(
+					Text.Mid(OpenIndex + 1, CloseIndex - OpenIndex - 1));
+				static const FStringView StringifyPrefix(TEXT("JSON.stringify("));
+				if (Arguments.Num() != 4 || !Arguments[2].StartsWith(StringifyPrefix) ||
+					!Arguments[2].EndsWith(TEXT(')')))
+				{
+					continue;
+				}
+				const FStringView Value =
+					Arguments[2].Mid(StringifyPrefix.Len(), Arguments[2].Len() - StringifyPrefix.Len() - 1);
+				const FParsedCall::FHandler Handler{
+					FString(ObjectAndFunction.Left(Separator)),
+					FHandlerId{
+						FCString::Atoi(*FString(Arguments[0])),
+						FCString::Atoi(*FString(Arguments[1])) } };
+				if (Value.Equals(TEXT("chunk")))
+				{
+					PendingChunkHandler = Handler;
+				}
+				else if (!OutCalls.IsEmpty())
+				{
+					FParsedCall& Call = OutCalls.Last();
+					TOptional<FParsedCall::FHandler>& CallHandler =
+						Arguments[3].Equals(TEXT("true")) ? Call.ErrorHandler : Call.ResultHandler;
+					// Errors are handled in two places, both refer to the same handler.
+					if (!CallHandler.IsSet())
+					{
+						CallHandler = Handler;
+					}
+				}
+			}
+			else
+			{
+				// window.eda.<function>(<arguments>)
+				const int32 FunctionStart = NextIndex + CallPrefix.Len();
+				int32 OpenIndex;
+				if (!Text.RightChop(FunctionStart).FindChar(TEXT('('), OpenIndex))
+				{
+					break;
+				}
+				OpenIndex += FunctionStart;
+				const int32 CloseIndex = FindFakeWebApiBackendClosingBracket(Text, OpenIndex);
+				if (CloseIndex == INDEX_NONE)
+				{
+					break;
+				}
+				Position = CloseIndex + 1;
+
+				FParsedCall& Call = OutCalls.Emplace_GetRef();
+				Call.FunctionName = FString(Text.Mid(FunctionStart, OpenIndex - FunctionStart));
+				Call.Arguments = FString(Text.Mid(OpenIndex + 1, CloseIndex - OpenIndex - 1));
+				if (!PendingStreamKey.IsEmpty())
+				{
+					// Remove the stream argument appended to streamed calls.
+					if (Call.Arguments.EndsWith(StreamArgumentWithSeparator))
+					{
+						Call.Arguments.LeftChopInline(StreamArgumentWithSeparator.Len());
+					}
+					else if (Call.Arguments == StreamArgument)
+					{
+						Call.Arguments.Reset();
+					}
+					Call.StreamKey = MoveTemp(PendingStreamKey);
+					Call.ChunkHandler = MoveTemp(PendingChunkHandler);
+					PendingStreamKey.Reset();
+					PendingChunkHandler.Reset();
+				}
+			}
+		}
+	}
+
+	const FFakeWebApiBackend::FFunctionBehavior& FFakeWebApiBackend::GetFunctionBehavior(
+		const FString& FunctionName) const
+	{
+		const FFunctionBehavior* Behavior = FunctionBehaviors.Find(FunctionName);
+		return Behavior ? *Behavior : DefaultBehavior;
+	}
+
+	void FFakeWebApiBackend::ScheduleCall(FParsedCall&& Call)
+	{
+		++Stats.NumCalls;
+		const FFunctionBehavior& Behavior = GetFunctionBehavior(Call.FunctionName);
+		const double LatencySeconds =
+			Behavior.LatencySeconds +
+			RandomStream.FRandRange(0.0f, float(Behavior.LatencyJitterSeconds));
+		if (!Call.StreamKey.IsEmpty())
+		{
+			Streams.Add(Call.StreamKey, FStream());
+		}
+		TSharedRef<FParsedCall> SharedCall = MakeShared<FParsedCall>(MoveTemp(Call));
+		(void)TimerWheel.Schedule(
+			LatencySeconds,
+			[this, SharedCall]() -> void
+			{
+				StepStream(SharedCall, 0);
+			});
+	}
+
+	void FFakeWebApiBackend::StepStream(TSharedRef<FParsedCall> Call, int32 ChunkIndex)
+	{
+		const FFunctionBehavior& Behavior = GetFunctionBehavior(Call->FunctionName);
+		FStream* Stream = Call->ChunkHandler.IsSet() ? Streams.Find(Call->StreamKey) : nullptr;
+		if (Stream && !Stream->bCancelled && ChunkIndex < Behavior.NumChunks)
+		{
+			// While paused, wait until the stream is resumed.
+			if (!Stream->bPaused)
+			{
+				++Stats.NumChunks;
+				CallHandler(
+					*Call->ChunkHandler,
+					FString::Printf(TEXT(R"json({"index":%d})json"), ChunkIndex), false);
+				++ChunkIndex;
+			}
+			(void)TimerWheel.Schedule(
+				Behavior.ChunkIntervalSeconds,
+				[this, Call, ChunkIndex]() -> void
+				{
+					StepStream(Call, ChunkIndex);
+				});
+			return;
+		}
+		if (!Call->StreamKey.IsEmpty())
+		{
+			Streams.Remove(Call->StreamKey);
+		}
+		CompleteCall(*Call);
+	}
+
+	void FFakeWebApiBackend::CompleteCall(const FParsedCall& Call)
+	{
+		const FFunctionBehavior& Behavior = GetFunctionBehavior(Call.FunctionName);
+		const bool bIsError =
+			Behavior.ErrorProbability > 0.0f && RandomStream.FRand() < Behavior.ErrorProbability;
+		if (bIsError)
+		{
+			++Stats.NumErrors;
+			if (Call.ErrorHandler.IsSet())
+			{
+				CallHandler(*Call.ErrorHandler, Behavior.ErrorJson, true);
+			}
+		}
+		else
+		{
+			++Stats.NumResults;
+			if (Call.ResultHandler.IsSet())
+			{
+				CallHandler(*Call.ResultHandler, Behavior.ResultJson, false);
+			}
+		}
+	}
+
+	void FFakeWebApiBackend::CallHandler(
+		const FParsedCall::FHandler& Handler, const FString& Json, bool bIsError)
+	{
+		const FFakeWebJavaScriptDelegateBinder::BoundObject* Bound =
+			DelegateBinder.BoundObjects.Find(Handler.ObjectName);
+		UAIAssistantWebJavaScriptResultDelegate* ResultDelegate =
+			Bound ? Cast<UAIAssistantWebJavaScriptResultDelegate>(Bound->Object.Get()) : nullptr;
+		if (!ResultDelegate)
+		{
+			++Stats.NumUndeliverable;
+			return;
+		}
+		FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+			*ResultDelegate, Handler.HandlerId, Json, bIsError);
+	}
+
+	void FFakeWebApiBackend::ApplyStreamControl(const FParsedStreamControl& StreamControl)
+	{
+		++Stats.NumStreamControls;
+		FStream* Stream = Streams.Find(StreamControl.StreamKey);
+		if (!Stream)
+		{
+			return;
+		}
+		if (StreamControl.Control == TEXT("cancel()"))
+		{
+			Stream->bCancelled = true;
+			Stream->bPaused = false;
+		}
+		else if (StreamControl.Control == TEXT("setPaused(true)"))
+		{
+			Stream->bPaused = true;
+		}
+		else if (StreamControl.Control == TEXT("setPaused(false)"))
+		{
+			Stream->bPaused = false;
+		}
+	}
+}
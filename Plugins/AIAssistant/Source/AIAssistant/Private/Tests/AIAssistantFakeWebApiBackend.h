@@ -0,0 +1,189 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Math/RandomStream.h"
+#include "Misc/Optional.h"
+
+#include "AIAssistantFakeWebJavaScriptDelegateBinder.h"
+#include "Core/AIAssistantTimerWheel.h"
+#include "Utils/ICodeExecutor.h"
+#include "WebAPI/AIAssistantWebApi.h"
+#include "WebAPI/AIAssistantWebJavaScriptResultDelegate.h"
+
+namespace UE::AIAssistant
+{
+	// In-process stand-in for the web assistant (window.eda) that answers the calls FWebApi
+	// makes without a browser.
+	//
+	// Scripts passed to Execute() are parsed to find calls of window.eda functions and the
+	// handlers their results are sent to. Each call is answered after a simulated latency by
+	// calling the handler on the object bound to the delegate binder, the same way the browser
+	// calls back into UAIAssistantWebJavaScriptResultDelegate. Streamed calls receive chunks and
+	// respond to the pause / resume / cancel requests FWebApiStream sends.
+	//
+	// Simulated time only advances when Advance() or RunUntilIdle() is called. This object must
+	// only be used from the game thread.
+	class FFakeWebApiBackend : public ICodeExecutor
+	{
+	public:
+		using FHandlerId = UAIAssistantWebJavaScriptResultDelegate::FHandlerId;
+
+		// Simulated behavior of a window.eda function.
+		struct FFunctionBehavior
+		{
+			// Time between a call being executed and its result being sent.
+			double LatencySeconds = 0.0;
+			// Maximum random time added to LatencySeconds.
+			double LatencyJitterSeconds = 0.0;
+			// Probability (0 - 1) of a call failing with ErrorJson.
+			float ErrorProbability = 0.0f;
+			// Result of a successful call.
+			FString ResultJson = TEXT("null");
+			// Result of a failed call.
+			FString ErrorJson = TEXT(R"json("error")json");
+			// Number of chunks sent to a streamed call before the result.
+			int32 NumChunks = 0;
+			// Time between chunks.
+			double ChunkIntervalSeconds = 0.0;
+		};
+
+		// Counters of the traffic between FWebApi and this object.
+		struct FStats
+		{
+			// Number of scripts passed to Execute().
+			uint64 NumScripts = 0;
+			// Number of function calls found in the scripts.
+			uint64 NumCalls = 0;
+			// Number of results and errors sent.
+			uint64 NumResults = 0;
+			uint64 NumErrors = 0;
+			// Number of stream chunks sent.
+			uint64 NumChunks = 0;
+			// Number of stream control requests received.
+			uint64 NumStreamControls = 0;
+			// Number of handler calls that could not be delivered as the handler's object
+			// was not bound.
+			uint64 NumUndeliverable = 0;
+		};
+
+		// Function call found in a script.
+		struct FParsedCall
+		{
+			// JavaScript reference to a result handler.
+			struct FHandler
+			{
+				// Name of the object bound to window.ue.
+				FString ObjectName;
+				FHandlerId HandlerId;
+			};
+
+			FString FunctionName;
+			// Arguments without the stream argument of streamed calls.
+			FString Arguments;
+			TOptional<FHandler> ResultHandler;
+			TOptional<FHandler> ErrorHandler;
+			// Set for streamed calls.
+			TOptional<FHandler> ChunkHandler;
+			FString StreamKey;
+		};
+
+		// Request to control a stream found in a script.
+		struct FParsedStreamControl
+		{
+			FString StreamKey;
+			// Method called on the stream e.g "cancel()".
+			FString Control;
+		};
+
+	public:
+		// Handler objects are resolved through DelegateBinder.
+		explicit FFakeWebApiBackend(
+			FFakeWebJavaScriptDelegateBinder& DelegateBinder, int32 RandomSeed = 0);
+		virtual ~FFakeWebApiBackend() = default;
+
+		// Set the behavior of a function, functions without a behavior use the default.
+		void SetFunctionBehavior(const FString& FunctionName, const FFunctionBehavior& Behavior);
+		void SetDefaultBehavior(const FFunctionBehavior& Behavior);
+
+		// Parse a script and schedule responses to the calls it contains.
+		FCodeExecutionResult Execute(const FString& JavaScriptText) override;
+
+		// Advance simulated time sending all responses that are due.
+		void Advance(double DeltaSeconds);
+
+		// Advance simulated time until there are no calls waiting for a response or
+		// MaxSeconds has elapsed. Returns true if all calls were answered.
+		bool RunUntilIdle(double MaxSeconds = 3600.0);
+
+		// Get the number of calls that are waiting for a response.
+		int32 GetNumPendingCalls() const;
+
+		FStats GetStats() const { return Stats; }
+
+		// Parse the calls and stream control requests in a script.
+		static void ParseScript(
+			const FString& JavaScriptText, TArray<FParsedCall>& OutCalls,
+			TArray<FParsedStreamControl>& OutStreamControls);
+
+	public:
+		// Name of the global object that implements the web API.
+		static const TCHAR* const WebApiObjectName;
+		// Duration of a tick of simulated time.
+		static constexpr double TickIntervalSeconds = 0.001;
+
+	private:
+		// State of a streamed call.
+		struct FStream
+		{
+			bool bPaused = false;
+			bool bCancelled = false;
+		};
+
+		// Get the behavior of a function.
+		const FFunctionBehavior& GetFunctionBehavior(const FString& FunctionName) const;
+
+		// Schedule the response to a call.
+		void ScheduleCall(FParsedCall&& Call);
+
+		// Send the next chunk of a stream or complete the call.
+		void StepStream(TSharedRef<FParsedCall> Call, int32 ChunkIndex);
+
+		// Complete a call with its result or error.
+		void CompleteCall(const FParsedCall& Call);
+
+		// Call a handler.
+		void CallHandler(
+			const FParsedCall::FHandler& Handler, const FString& Json, bool bIsError);
+
+		// Apply a stream control request.
+		void ApplyStreamControl(const FParsedStreamControl& StreamControl);
+
+	private:
+		FFakeWebJavaScriptDelegateBinder& DelegateBinder;
+		FRandomStream RandomStream;
+		FTimerWheel TimerWheel;
+		FFunctionBehavior DefaultBehavior;
+		TMap<FString, FFunctionBehavior> FunctionBehaviors;
+		TMap<FString, FStream> Streams;
+		FStats Stats;
+	};
+
+	// FWebApi connected to a FFakeWebApiBackend.
+	struct FWebApiWithFakeBackend
+	{
+		explicit FWebApiWithFakeBackend(int32 RandomSeed = 0) :
+			Backend(WebJavaScriptDelegateBinder, RandomSeed),
+			WebApi(Backend, WebJavaScriptDelegateBinder)
+		{
+			// Send calls to the backend as they're made so tests don't depend on the ticker.
+			WebApi.SetFlushPolicyOverride(FWebApi::EFlushPolicy::Immediate);
+		}
+
+		FFakeWebJavaScriptDelegateBinder WebJavaScriptDelegateBinder;
+		FFakeWebApiBackend Backend;
+		FWebApi WebApi;
+	};
+}
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantFakeWebApi.h"
+#include "AIAssistantFakeWebApiBackend.h"
+#include "AIAssistantTestFlags.h"
+#include "AIAssistantWebApiAccessor.h"
+#include "WebAPI/AIAssistantWebApi.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFakeWebApiBackendTestParseScript,
+	"AI.Assistant.FakeWebApiBackend.ParseScript",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFakeWebApiBackendTestParseScript::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	const TCHAR* Arguments = TEXT(R"json({"text":"window.ue.x(1, 2), \"quoted)\""})json");
+	const FString Script =
+		FWebApiAccessor::FormatFunctionCall(
+			*WebApi, TEXT("first"), Arguments, FWebApi::FHandlerId{ 3, 4 }) +
+		TEXT("window.aiassistantstreams?.[\"5_6\"]?.cancel();\n") +
+		FWebApiAccessor::FormatFunctionCall(*WebApi, TEXT("second"));
+
+	TArray<FFakeWebApiBackend::FParsedCall> Calls;
+	TArray<FFakeWebApiBackend::FParsedStreamControl> StreamControls;
+	FFakeWebApiBackend::ParseScript(Script, Calls, StreamControls);
+	if (!TestEqual(TEXT("NumCalls"), Calls.Num(), 2) ||
+		!TestEqual(TEXT("NumStreamControls"), StreamControls.Num(), 1))
+	{
+		return false;
+	}
+
+	const FFakeWebApiBackend::FParsedCall& First = Calls[0];
+	(void)TestEqual(TEXT("FirstFunctionName"), First.FunctionName, TEXT("first"));
+	(void)TestEqual(TEXT("FirstArguments"), First.Arguments, Arguments);
+	if (TestTrue(
+			TEXT("FirstHandlers"), First.ResultHandler.IsSet() && First.ErrorHandler.IsSet()))
+	{
+		(void)TestEqual(
+			TEXT("ResultHandlerObject"), First.ResultHandler->ObjectName,
+			UAIAssistantWebJavaScriptResultDelegate::Name);
+		(void)TestTrue(
+			TEXT("ResultHandlerId"),
+			First.ResultHandler->HandlerId == FWebApi::FHandlerId{ 3, 4 });
+		(void)TestTrue(
+			TEXT("ErrorHandlerId"),
+			First.ErrorHandler->HandlerId == FWebApi::FHandlerId{ 3, 4 });
+	}
+	(void)TestFalse(TEXT("FirstNotStreamed"), First.ChunkHandler.IsSet());
+
+	const FFakeWebApiBackend::FParsedCall& Second = Calls[1];
+	(void)TestEqual(TEXT("SecondFunctionName"), Second.FunctionName, TEXT("second"));
+	(void)TestEqual(TEXT("SecondArguments"), Second.Arguments, TEXT(""));
+	(void)TestFalse(TEXT("SecondHasNoHandler"), Second.ResultHandler.IsSet());
+
+	(void)TestEqual(TEXT("StreamKey"), StreamControls[0].StreamKey, TEXT("5_6"));
+	(void)TestEqual(TEXT("Control"), StreamControls[0].Control, TEXT("cancel()"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFakeWebApiBackendTestRoundTrip,
+	"AI.Assistant.FakeWebApiBackend.RoundTrip",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFakeWebApiBackendTestRoundTrip::RunTest(const FString& UnusedParameters)
+{
+	FWebApiWithFakeBackend WebApi;
+	FFakeWebApiBackend::FFunctionBehavior CreateConversationBehavior;
+	CreateConversationBehavior.LatencySeconds = 0.5;
+	WebApi.Backend.SetFunctionBehavior(TEXT("createConversation"), CreateConversationBehavior);
+	FFakeWebApiBackend::FFunctionBehavior AddAgentEnvironmentBehavior;
+	AddAgentEnvironmentBehavior.ResultJson =
+		TEXT(R"json({"id":{"id":"env"},"hash":{"algorithm":"sha256","hash":"abc"}})json");
+	WebApi.Backend.SetFunctionBehavior(TEXT("addAgentEnvironment"), AddAgentEnvironmentBehavior);
+
+	auto CreateConversationResult = WebApi.WebApi.CreateConversation();
+	auto AddAgentEnvironmentResult = WebApi.WebApi.AddAgentEnvironment(FAgentEnvironment());
+	(void)TestFalse(TEXT("NotAnsweredSynchronously"), AddAgentEnvironmentResult.IsReady());
+
+	WebApi.Backend.Advance(0.1);
+	(void)TestFalse(TEXT("CreateConversationPending"), CreateConversationResult.IsReady());
+	if (!TestTrue(TEXT("AddAgentEnvironmentComplete"), AddAgentEnvironmentResult.IsReady()) ||
+		!TestFalse(TEXT("AddAgentEnvironmentSucceeded"), AddAgentEnvironmentResult.Get().HasError()))
+	{
+		return false;
+	}
+	(void)TestEqual(
+		TEXT("AgentEnvironmentId"), AddAgentEnvironmentResult.Get().GetValue().Id.Id,
+		TEXT("env"));
+
+	(void)TestTrue(TEXT("RunUntilIdle"), WebApi.Backend.RunUntilIdle());
+	(void)TestTrue(
+		TEXT("CreateConversationComplete"),
+		CreateConversationResult.IsReady() && !CreateConversationResult.Get().HasError());
+
+	FFakeWebApiBackend::FFunctionBehavior FailingBehavior;
+	FailingBehavior.ErrorProbability = 1.0f;
+	FailingBehavior.ErrorJson = TEXT(R"json("backend unavailable")json");
+	WebApi.Backend.SetFunctionBehavior(TEXT("createConversation"), FailingBehavior);
+	auto FailedResult = WebApi.WebApi.CreateConversation();
+	(void)WebApi.Backend.RunUntilIdle();
+	if (TestTrue(TEXT("FailedComplete"), FailedResult.IsReady()) &&
+		TestTrue(TEXT("Failed"), FailedResult.Get().HasError()))
+	{
+		(void)TestEqual(
+			TEXT("Error"), FailedResult.Get().GetError(), FailingBehavior.ErrorJson);
+	}
+
+	const FFakeWebApiBackend::FStats Stats = WebApi.Backend.GetStats();
+	(void)TestEqual(TEXT("NumCalls"), Stats.NumCalls, uint64(3));
+	(void)TestEqual(TEXT("NumResults"), Stats.NumResults, uint64(2));
+	(void)TestEqual(TEXT("NumErrors"), Stats.NumErrors, uint64(1));
+	(void)TestEqual(TEXT("NumUndeliverable"), Stats.NumUndeliverable, uint64(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFakeWebApiBackendTestStreamBackpressure,
+	"AI.Assistant.FakeWebApiBackend.StreamBackpressure",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFakeWebApiBackendTestStreamBackpressure::RunTest(
+	const FString& UnusedParameters)
+{
+	FWebApiWithFakeBackend WebApi;
+	FFakeWebApiBackend::FFunctionBehavior Behavior;
+	Behavior.NumChunks = 6;
+	Behavior.ChunkIntervalSeconds = 0.01;
+	WebApi.Backend.SetFunctionBehavior(TEXT("addMessageToConversation"), Behavior);
+
+	FWebApiStreamOptions StreamOptions;
+	StreamOptions.Capacity = 8;
+	StreamOptions.PauseThreshold = 4;
+	StreamOptions.ResumeThreshold = 1;
+	TSharedRef<FWebApiStream> Stream = WebApi.WebApi.AddMessageToConversationWithStream(
+		FAddMessageToConversationOptions(), StreamOptions);
+	auto Completion = Stream->GetCompletionFuture();
+
+	// The backend stops producing while the stream is paused.
+	WebApi.Backend.Advance(1.0);
+	(void)TestTrue(TEXT("Paused"), Stream->IsPaused());
+	(void)TestEqual(TEXT("NumBufferedWhilePaused"), Stream->GetNumBufferedChunks(), 4);
+	(void)TestFalse(TEXT("PendingWhilePaused"), Completion.IsReady());
+
+	FString Chunk;
+	int32 NumDequeued = 0;
+	while (Stream->TryDequeueChunk(Chunk))
+	{
+		++NumDequeued;
+	}
+	(void)TestFalse(TEXT("Resumed"), Stream->IsPaused());
+
+	(void)TestTrue(TEXT("RunUntilIdle"), WebApi.Backend.RunUntilIdle());
+	while (Stream->TryDequeueChunk(Chunk))
+	{
+		++NumDequeued;
+	}
+	(void)TestEqual(TEXT("NumDequeued"), NumDequeued, Behavior.NumChunks);
+	(void)TestEqual(TEXT("LastChunk"), Chunk, TEXT(R"json({"index":5})json"));
+	(void)TestTrue(
+		TEXT("Complete"), Completion.IsReady() && !Completion.Get().HasError());
+	(void)TestEqual(TEXT("NumPauses"), Stream->GetStats().NumPauses, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFakeWebApiBackendTestStreamCancel,
+	"AI.Assistant.FakeWebApiBackend.StreamCancel",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFakeWebApiBackendTestStreamCancel::RunTest(const FString& UnusedParameters)
+{
+	FWebApiWithFakeBackend WebApi;
+	FFakeWebApiBackend::FFunctionBehavior Behavior;
+	Behavior.NumChunks = 1000;
+	Behavior.ChunkIntervalSeconds = 0.01;
+	WebApi.Backend.SetFunctionBehavior(TEXT("addMessageToConversation"), Behavior);
+
+	TSharedRef<FWebApiStream> Stream = WebApi.WebApi.AddMessageToConversationWithStream(
+		FAddMessageToConversationOptions());
+	WebApi.Backend.Advance(0.1);
+	Stream->Cancel();
+	(void)TestTrue(TEXT("RunUntilIdle"), WebApi.Backend.RunUntilIdle());
+
+	const FFakeWebApiBackend::FStats Stats = WebApi.Backend.GetStats();
+	(void)TestEqual(TEXT("NumStreamControls"), Stats.NumStreamControls, uint64(1));
+	(void)TestTrue(TEXT("StoppedProducing"), Stats.NumChunks < uint64(Behavior.NumChunks));
+	(void)TestEqual(
+		TEXT("NumRegisteredHandlers"),
+		FWebApiAccessor::GetJavaScriptResultDelegate(WebApi.WebApi).GetNumRegisteredHandlers(),
+		0);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "UI/AIAssistantFrameRateGovernor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFrameRateGovernorTestStates,
+	"AI.Assistant.FrameRateGovernor.States",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFrameRateGovernorTestStates::RunTest(const FString& UnusedParameters)
+{
+	using EState = FFrameRateGovernor::EState;
+
+	FFrameRateGovernor::FSettings Settings;
+	Settings.ActiveFrameRate = 30;
+	FFrameRateGovernor Governor(Settings, 0.0);
+	(void)TestEqual(TEXT("InitialState"), Governor.GetState(), EState::Active);
+	(void)TestEqual(TEXT("InitialFrameRate"), Governor.GetFrameRate(), 30);
+
+	FFrameRateGovernor::FInputs Inputs;
+	(void)TestFalse(TEXT("Unchanged"), Governor.Update(Inputs, 1.0));
+
+	Inputs.bIsApplicationActive = false;
+	(void)TestTrue(TEXT("BackgroundChanged"), Governor.Update(Inputs, 2.0));
+	(void)TestEqual(TEXT("Background"), Governor.GetState(), EState::Background);
+	(void)TestEqual(TEXT("BackgroundFrameRate"), Governor.GetFrameRate(), 0);
+
+	// Hidden takes priority over the application being in the background.
+	Inputs.bIsVisible = false;
+	(void)TestFalse(TEXT("HiddenUnchanged"), Governor.Update(Inputs, 3.0));
+	(void)TestEqual(TEXT("Hidden"), Governor.GetState(), EState::Hidden);
+
+	// A busy browser keeps rendering so responses aren't delayed.
+	Inputs.bIsBusy = true;
+	(void)TestTrue(TEXT("BusyChanged"), Governor.Update(Inputs, 4.0));
+	(void)TestEqual(TEXT("Busy"), Governor.GetState(), EState::Active);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFrameRateGovernorTestIdle,
+	"AI.Assistant.FrameRateGovernor.Idle",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFrameRateGovernorTestIdle::RunTest(const FString& UnusedParameters)
+{
+	using EState = FFrameRateGovernor::EState;
+
+	{
+		FFrameRateGovernor Governor(FFrameRateGovernor::FSettings{}, 0.0);
+		(void)Governor.Update(FFrameRateGovernor::FInputs{}, 1000.0);
+		(void)TestEqual(TEXT("IdleDisabled"), Governor.GetState(), EState::Active);
+	}
+
+	FFrameRateGovernor::FSettings Settings;
+	Settings.IdlePauseSeconds = 10.0;
+	FFrameRateGovernor Governor(Settings, 0.0);
+	FFrameRateGovernor::FInputs Inputs;
+	(void)Governor.Update(Inputs, 9.0);
+	(void)TestEqual(TEXT("BeforeIdle"), Governor.GetState(), EState::Active);
+	(void)Governor.Update(Inputs, 10.0);
+	(void)TestEqual(TEXT("Idle"), Governor.GetState(), EState::Idle);
+
+	// Input resumes rendering and restarts the idle timeout.
+	Inputs.bHasUserInput = true;
+	(void)Governor.Update(Inputs, 11.0);
+	(void)TestEqual(TEXT("Input"), Governor.GetState(), EState::Active);
+	Inputs.bHasUserInput = false;
+	(void)Governor.Update(Inputs, 20.0);
+	(void)TestEqual(TEXT("AfterInput"), Governor.GetState(), EState::Active);
+	(void)Governor.Update(Inputs, 21.0);
+	(void)TestEqual(TEXT("IdleAgain"), Governor.GetState(), EState::Idle);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantFrameRateGovernorTestStateStats,
+	"AI.Assistant.FrameRateGovernor.StateStats",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantFrameRateGovernorTestStateStats::RunTest(const FString& UnusedParameters)
+{
+	using EState = FFrameRateGovernor::EState;
+
+	FFrameRateGovernor Governor(FFrameRateGovernor::FSettings{}, 0.0);
+	FFrameRateGovernor::FInputs Hidden;
+	Hidden.bIsVisible = false;
+	(void)Governor.Update(Hidden, 2.0);
+	(void)Governor.Update(FFrameRateGovernor::FInputs{}, 5.0);
+	(void)Governor.Update(Hidden, 6.0);
+
+	const FFrameRateGovernor::FStateStats Active = Governor.GetStateStats(EState::Active, 7.0);
+	(void)TestEqual(TEXT("ActiveSeconds"), Active.Seconds, 3.0);
+	(void)TestEqual(TEXT("ActiveEntered"), Active.NumEntered, 2);
+	// The current visit is included.
+	const FFrameRateGovernor::FStateStats HiddenStats = Governor.GetStateStats(EState::Hidden, 7.0);
+	(void)TestEqual(TEXT("HiddenSeconds"), HiddenStats.Seconds, 4.0);
+	(void)TestEqual(TEXT("HiddenEntered"), HiddenStats.NumEntered, 2);
+	(void)TestEqual(TEXT("IdleEntered"), Governor.GetStateStats(EState::Idle, 7.0).NumEntered, 0);
+	(void)TestTrue(TEXT("FormatStats"), Governor.FormatStats(7.0).Contains(TEXT("State: Hidden")));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "UI/AIAssistantHoverDwell.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantHoverDwellTestDwell,
+	"AI.Assistant.HoverDwell.Dwell",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantHoverDwellTestDwell::RunTest(const FString& UnusedParameters)
+{
+	FHoverDwell::FSettings Settings;
+	Settings.DwellSeconds = 0.5;
+	Settings.MaxRestingDistance = 2.0f;
+	FHoverDwell Dwell(Settings);
+
+	// Moving never dwells.
+	for (int32 Sample = 0; Sample < 10; ++Sample)
+	{
+		(void)TestFalse(TEXT("Moving"), Dwell.Update(FVector2f(float(Sample) * 10.0f, 0.0f), double(Sample)));
+	}
+
+	// Resting, including small movements, dwells once.
+	(void)TestFalse(TEXT("Rest"), Dwell.Update(FVector2f(100.0f, 100.0f), 10.0));
+	(void)TestFalse(TEXT("Resting"), Dwell.Update(FVector2f(101.0f, 101.0f), 10.4));
+	(void)TestFalse(TEXT("NotDwelled"), Dwell.HasDwelled());
+	(void)TestTrue(TEXT("Dwell"), Dwell.Update(FVector2f(100.0f, 101.0f), 10.5));
+	(void)TestTrue(TEXT("Dwelled"), Dwell.HasDwelled());
+	(void)TestFalse(TEXT("Once"), Dwell.Update(FVector2f(100.0f, 100.0f), 11.0));
+
+	// Moving away starts a new rest.
+	(void)TestFalse(TEXT("MovedAway"), Dwell.Update(FVector2f(110.0f, 100.0f), 12.0));
+	(void)TestFalse(TEXT("NewRest"), Dwell.HasDwelled());
+	(void)TestTrue(TEXT("DwellAgain"), Dwell.Update(FVector2f(110.0f, 100.0f), 12.5));
+
+	// Restarting the rest without moving dwells again.
+	Dwell.Restart(13.0);
+	(void)TestFalse(TEXT("Restarted"), Dwell.HasDwelled());
+	(void)TestFalse(TEXT("RestartedResting"), Dwell.Update(FVector2f(110.0f, 100.0f), 13.2));
+	(void)TestTrue(TEXT("DwellAfterRestart"), Dwell.Update(FVector2f(110.0f, 100.0f), 13.5));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
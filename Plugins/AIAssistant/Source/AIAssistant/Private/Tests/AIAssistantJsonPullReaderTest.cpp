@@ -0,0 +1,387 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantAllocationCounter.h"
+#include "AIAssistantTestFlags.h"
+#include "AIAssistantWebApiAccessor.h"
+#include "Utils/AIAssistantJsonPullReader.h"
+#include "WebAPI/AIAssistantWebApi.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantJsonPullReaderTestReadValues,
+	"AI.Assistant.JsonPullReader.ReadValues",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantJsonPullReaderTestReadValues::RunTest(const FString& UnusedParameters)
+{
+	const FString Json(TEXT(
+		R"json( { "string": "a\"b\\c\/\n\t\u00e9\ud83d\ude00", "number": -12.5e1, )json"
+		R"json("true": true, "false": false, "null": null, "array": [1, [], {}], )json"
+		R"json("nested": {"k\u0065y": "value"} } )json"));
+	FJsonPullReader Reader(Json);
+	FString StringValue;
+	double NumberValue = 0.0;
+	bool bTrueValue = false;
+	bool bFalseValue = true;
+	int32 NumArrayElements = 0;
+	FString NestedValue;
+	const bool bSuccess = Reader.ReadObject(
+		[&](FStringView FieldName) -> bool
+		{
+			if (FieldName == TEXTVIEW("string"))
+			{
+				return Reader.ReadString(StringValue);
+			}
+			if (FieldName == TEXTVIEW("number"))
+			{
+				return Reader.ReadNumber(NumberValue);
+			}
+			if (FieldName == TEXTVIEW("true"))
+			{
+				return Reader.ReadBool(bTrueValue);
+			}
+			if (FieldName == TEXTVIEW("false"))
+			{
+				return Reader.ReadBool(bFalseValue);
+			}
+			if (FieldName == TEXTVIEW("null"))
+			{
+				return Reader.ReadNull();
+			}
+			if (FieldName == TEXTVIEW("array"))
+			{
+				(void)TestTrue(TEXT("BeginArray"), Reader.BeginArray());
+				while (Reader.NextElement())
+				{
+					++NumArrayElements;
+					(void)Reader.SkipValue();
+				}
+				return !Reader.HasError();
+			}
+			if (FieldName == TEXTVIEW("nested"))
+			{
+				return Reader.ReadObject(
+					[&](FStringView NestedFieldName) -> bool
+					{
+						// The escaped field name is unescaped.
+						(void)TestEqual(TEXT("NestedFieldName"), FString(NestedFieldName), TEXT("key"));
+						return Reader.ReadString(NestedValue);
+					});
+			}
+			return false;
+		});
+	(void)TestTrue(TEXT("Success"), bSuccess && Reader.ReadEnd());
+	(void)TestEqual(TEXT("ErrorMessage"), Reader.GetErrorMessage(), TEXT(""));
+
+	FString ExpectedString(TEXT("a\"b\\c/\n\t"));
+	ExpectedString.AppendChar(TCHAR(0xE9));
+	if constexpr (sizeof(TCHAR) == 2)
+	{
+		ExpectedString.AppendChar(TCHAR(0xD83D));
+		ExpectedString.AppendChar(TCHAR(0xDE00));
+	}
+	else
+	{
+		ExpectedString.AppendChar(TCHAR(0x1F600));
+	}
+	(void)TestEqual(TEXT("String"), StringValue, ExpectedString);
+	(void)TestEqual(TEXT("Number"), NumberValue, -125.0);
+	(void)TestTrue(TEXT("True"), bTrueValue);
+	(void)TestFalse(TEXT("False"), bFalseValue);
+	(void)TestEqual(TEXT("NumArrayElements"), NumArrayElements, 3);
+	(void)TestEqual(TEXT("Nested"), NestedValue, TEXT("value"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantJsonPullReaderTestErrorOffsets,
+	"AI.Assistant.JsonPullReader.ErrorOffsets",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantJsonPullReaderTestErrorOffsets::RunTest(const FString& UnusedParameters)
+{
+	struct FTestCase
+	{
+		const TCHAR* Json;
+		int32 ExpectedErrorOffset;
+	};
+	const FTestCase TestCases[] = {
+		{ TEXT(""), 0 },
+		{ TEXT("{"), 1 },
+		{ TEXT(R"json({"a" 1})json"), 5 },
+		{ TEXT(R"json({"a": 1 "b": 2})json"), 8 },
+		{ TEXT(R"json({"a": [1, 2,]})json"), 12 },
+		{ TEXT(R"json({"a": tru})json"), 6 },
+		{ TEXT(R"json({"a": "b\x"})json"), 8 },
+		{ TEXT(R"json({"a": "b\u12g4"})json"), 12 },
+		{ TEXT(R"json({"a": "unterminated})json"), 20 },
+		{ TEXT(R"json({"a": 01})json"), 7 },
+		{ TEXT(R"json({"a": -})json"), 7 },
+		{ TEXT(R"json({"a": 1.})json"), 8 },
+		{ TEXT(R"json({"a": 1} x)json"), 9 },
+	};
+	for (const FTestCase& TestCase : TestCases)
+	{
+		FJsonPullReader Reader(TestCase.Json);
+		const bool bSuccess = Reader.SkipValue() && Reader.ReadEnd();
+		(void)TestFalse(FString::Printf(TEXT("Success %s"), TestCase.Json), bSuccess);
+		(void)TestEqual(
+			FString::Printf(TEXT("ErrorOffset %s (%s)"), TestCase.Json, *Reader.GetErrorMessage()),
+			Reader.GetErrorOffset(), TestCase.ExpectedErrorOffset);
+	}
+
+	// Nesting is limited.
+	FString DeeplyNested;
+	for (int32 Index = 0; Index <= FJsonPullReader::MaxDepth; ++Index)
+	{
+		DeeplyNested.AppendChar(TEXT('['));
+	}
+	FJsonPullReader Reader(DeeplyNested);
+	(void)TestFalse(TEXT("DeeplyNested"), Reader.SkipValue());
+	(void)TestEqual(TEXT("DeeplyNestedOffset"), Reader.GetErrorOffset(), FJsonPullReader::MaxDepth);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantJsonPullReaderTestSkipDoesNotAllocate,
+	"AI.Assistant.JsonPullReader.SkipDoesNotAllocate",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantJsonPullReaderTestSkipDoesNotAllocate::RunTest(const FString& UnusedParameters)
+{
+	FString Json(TEXT(R"json({"id": "abc", "unknown": [)json"));
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		Json += TEXT(R"json({"text": "escaped \"\u00e9\" text", "values": [1, 2.5, true, null]},)json");
+	}
+	Json += TEXT(R"json({}], "ignored": {}})json");
+
+	FJsonPullReader Reader(Json);
+	FString Id;
+	Id.Reserve(16);
+	uint64 NumAllocations = 0;
+	bool bSuccess = false;
+	{
+		FScopedAllocationCounter AllocationCounter;
+		bSuccess = Reader.ReadObject(
+			[&Reader, &Id](FStringView FieldName) -> bool
+			{
+				return FieldName == TEXTVIEW("id") ? Reader.ReadString(Id) : Reader.SkipValue();
+			}) && Reader.ReadEnd();
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+	(void)TestTrue(TEXT("Success"), bSuccess);
+	(void)TestEqual(TEXT("Id"), Id, TEXT("abc"));
+	(void)TestTrue(TEXT("NumAllocations"), NumAllocations == 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantJsonPullReaderTestWebApiTypes,
+	"AI.Assistant.WebApi.ParseJson.PullReader",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantJsonPullReaderTestWebApiTypes::RunTest(const FString& UnusedParameters)
+{
+	{
+		auto Handle = FWebApiAccessor::ParseJsonIfNotVoid<FAgentEnvironmentHandle>(TEXT(
+			R"json({"id": {"id": "env"}, "extra": [{"a": 1}], )json"
+			R"json("HASH": {"algorithm": "sha256", "hash": "0123", "extra": null}})json"));
+		(void)TestTrue(TEXT("HandleHasValue"), Handle.HasValue());
+		if (Handle.HasValue())
+		{
+			(void)TestEqual(TEXT("Id"), Handle.GetValue().Id.Id, TEXT("env"));
+			(void)TestEqual(TEXT("Algorithm"), Handle.GetValue().Hash.Algorithm, TEXT("sha256"));
+			(void)TestEqual(TEXT("Hash"), Handle.GetValue().Hash.Hash, TEXT("0123"));
+		}
+	}
+	{
+		// Content that precedes its type is read once the type is known.
+		auto Options = FWebApiAccessor::ParseJsonIfNotVoid<FAddMessageToConversationOptions>(TEXT(
+			R"json({"conversationId": {"id": "conversation"}, "message": {)json"
+			R"json("date": "2025-01-02T03:04:05Z", "messageRole": "agent", "messageContent": [)json"
+			R"json({"content": {"text": "first"}, "contentType": "text", "visibleToUser": false},)json"
+			R"json({"contentType": "text", "content": {"text": "second"}}]}})json"));
+		(void)TestTrue(TEXT("OptionsHasValue"), Options.HasValue());
+		if (Options.HasValue())
+		{
+			const FAddMessageToConversationOptions& Value = Options.GetValue();
+			(void)TestTrue(TEXT("ConversationId"), Value.ConversationId.IsSet());
+			if (Value.ConversationId.IsSet())
+			{
+				(void)TestEqual(TEXT("ConversationIdValue"), Value.ConversationId->Id, TEXT("conversation"));
+			}
+			(void)TestTrue(TEXT("Date"), Value.Message.Date.IsSet());
+			if (Value.Message.Date.IsSet())
+			{
+				(void)TestTrue(TEXT("DateValue"), *Value.Message.Date == FDateTime(2025, 1, 2, 3, 4, 5));
+			}
+			(void)TestTrue(TEXT("MessageRole"), Value.Message.MessageRole == EMessageRole::Agent);
+			(void)TestEqual(TEXT("NumMessageContent"), Value.Message.MessageContent.Num(), 2);
+			const TCHAR* ExpectedText[] = { TEXT("first"), TEXT("second") };
+			const bool ExpectedVisibleToUser[] = { false, true };
+			for (int32 Index = 0; Index < FMath::Min(Value.Message.MessageContent.Num(), 2); ++Index)
+			{
+				const FMessageContent& Content = Value.Message.MessageContent[Index];
+				(void)TestTrue(TEXT("IsText"), Content.Content.IsType<FTextMessageContent>());
+				if (Content.Content.IsType<FTextMessageContent>())
+				{
+					(void)TestEqual(
+						TEXT("Text"), Content.Content.Get<FTextMessageContent>().Text,
+						ExpectedText[Index]);
+				}
+				(void)TestEqual(TEXT("VisibleToUser"), Content.bVisibleToUser, ExpectedVisibleToUser[Index]);
+			}
+		}
+	}
+	{
+		// Like FromJson() values of the wrong type are ignored.
+		auto Handle = FWebApiAccessor::ParseJsonIfNotVoid<FAgentEnvironmentHandle>(
+			TEXT(R"json({"id": {"id": 42}, "hash": "0123"})json"));
+		(void)TestTrue(TEXT("WrongTypeHasValue"), Handle.HasValue());
+		if (Handle.HasValue())
+		{
+			(void)TestTrue(TEXT("WrongTypeId"), Handle.GetValue().Id.Id.IsEmpty());
+			(void)TestTrue(TEXT("WrongTypeHash"), Handle.GetValue().Hash.Hash.IsEmpty());
+		}
+	}
+	{
+		// Errors report the offset of the invalid JSON.
+		auto Handle = FWebApiAccessor::ParseJsonIfNotVoid<FAgentEnvironmentHandle>(
+			TEXT(R"json({"id": {"id": "env"}"hash": {}})json"));
+		(void)TestTrue(TEXT("ErrorHasError"), Handle.HasError());
+		if (Handle.HasError())
+		{
+			(void)TestEqual(
+				TEXT("Error"), Handle.GetError(),
+				TEXT(R"json(Failed to parse at offset 20 (Expected ',' or '}'): {"id": {"id": "env"}"hash": {}})json"));
+		}
+	}
+	return true;
+}
+
+// Read Json into copies of Initial with FromJson() and ReadJson() then serialize both with ToJson().
+template<typename T>
+static bool ReadJsonPullReaderTestParity(
+	const FString& Json, const T& Initial, FString& OutFromJson, FString& OutReadJson)
+{
+	T FromJsonValue = Initial;
+	(void)FromJsonValue.FromJson(Json);
+	OutFromJson = FromJsonValue.ToJson(false);
+
+	T ReadJsonValue = Initial;
+	FJsonPullReader Reader(Json);
+	const bool bSuccess = ReadJson(Reader, ReadJsonValue) && Reader.ReadEnd();
+	OutReadJson = ReadJsonValue.ToJson(false);
+	return bSuccess;
+}
+
+// Check that FromJson() and ReadJson() read the same struct from Json.
+template<typename T>
+static void TestJsonPullReaderTestParity(
+	FAutomationTestBase& Test, const TCHAR* What, const FString& Json, const T& Initial)
+{
+	FString FromJson;
+	FString ReadJsonResult;
+	(void)Test.TestTrue(
+		FString::Printf(TEXT("%sReadJson"), What),
+		ReadJsonPullReaderTestParity(Json, Initial, FromJson, ReadJsonResult));
+	(void)Test.TestEqual(FString::Printf(TEXT("%sParity"), What), ReadJsonResult, FromJson);
+}
+
+// Check that FromJson() and ReadJson() read the struct serialized from Value with ToJson().
+template<typename T>
+static void TestJsonPullReaderTestRoundTrip(FAutomationTestBase& Test, const TCHAR* What, const T& Value)
+{
+	const FString Json = Value.ToJson(false);
+	FString FromJson;
+	FString ReadJsonResult;
+	(void)Test.TestTrue(
+		FString::Printf(TEXT("%sReadJson"), What),
+		ReadJsonPullReaderTestParity(Json, T(), FromJson, ReadJsonResult));
+	(void)Test.TestEqual(FString::Printf(TEXT("%sFromJson"), What), FromJson, Json);
+	(void)Test.TestEqual(FString::Printf(TEXT("%sParity"), What), ReadJsonResult, FromJson);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantJsonPullReaderTestWebApiParity,
+	"AI.Assistant.WebApi.ParseJson.Parity",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantJsonPullReaderTestWebApiParity::RunTest(const FString& UnusedParameters)
+{
+	FTextMessageContent TextMessageContent;
+	TextMessageContent.Text = TEXT("Hello \"world\"\n");
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("TextMessageContent"), TextMessageContent);
+
+	FMessageContent MessageContent;
+	MessageContent.ContentType = EMessageContentType::Text;
+	MessageContent.Content.Emplace<FTextMessageContent>(TextMessageContent);
+	MessageContent.bVisibleToUser = false;
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("MessageContent"), MessageContent);
+
+	FMessage Message;
+	Message.Date = FDateTime(2025, 1, 2, 3, 4, 5, 6);
+	Message.MessageRole = EMessageRole::Agent;
+	Message.MessageContent = { MessageContent, MessageContent };
+	Message.MessageContent[1].bVisibleToUser = true;
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("Message"), Message);
+
+	FConversationId ConversationId;
+	ConversationId.Id = TEXT("conversation");
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("ConversationId"), ConversationId);
+
+	FAddMessageToConversationOptions Options;
+	Options.ConversationId = ConversationId;
+	Options.Message = Message;
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AddMessageToConversationOptions"), Options);
+	Options.MessageId = TEXT("message");
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AddMessageToConversationOptionsMessageId"), Options);
+	Options.ConversationId.Reset();
+	Options.MessageId.Reset();
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AddMessageToConversationOptionsNoId"), Options);
+
+	FAgentEnvironmentDescriptor Descriptor;
+	Descriptor.EnvironmentName = TEXT("UE");
+	Descriptor.EnvironmentVersion = TEXT("5.7");
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AgentEnvironmentDescriptor"), Descriptor);
+
+	FAgentEnvironment Environment;
+	Environment.Descriptor = Descriptor;
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AgentEnvironment"), Environment);
+
+	FAgentEnvironmentHandle Handle;
+	Handle.Id.Id = TEXT("env");
+	Handle.Hash.Algorithm = TEXT("sha256");
+	Handle.Hash.Hash = TEXT("0123");
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AgentEnvironmentId"), Handle.Id);
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AgentEnvironmentHash"), Handle.Hash);
+	TestJsonPullReaderTestRoundTrip(*this, TEXT("AgentEnvironmentHandle"), Handle);
+
+	// Values of the wrong type leave fields unmodified.
+	TestJsonPullReaderTestParity(
+		*this, TEXT("WrongTypeHandle"),
+		TEXT(R"json({"id": {"id": 42}, "hash": [], "ID": {"id": true}})json"), Handle);
+	FAddMessageToConversationOptions WrongTypeOptions;
+	WrongTypeOptions.Message = Message;
+	TestJsonPullReaderTestParity(
+		*this, TEXT("WrongTypeOptions"),
+		TEXT(R"json({"conversationId": "conversation", "message": {)json"
+			 R"json("messageRole": true, "messageContent": {"contentType": "text"}}})json"),
+		WrongTypeOptions);
+	TestJsonPullReaderTestParity(
+		*this, TEXT("WrongTypeMessageContent"),
+		TEXT(R"json({"contentType": 1, "visibleToUser": "true", )json"
+			 R"json("content": {"text": 2}})json"),
+		MessageContent);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
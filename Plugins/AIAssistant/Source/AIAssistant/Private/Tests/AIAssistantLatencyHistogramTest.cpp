@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "WebAPI/AIAssistantLatencyHistogram.h"
+#include "WebAPI/AIAssistantWebApiMetrics.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantLatencyHistogramTestBuckets,
+	"AI.Assistant.WebApi.LatencyHistogram.Buckets",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantLatencyHistogramTestBuckets::RunTest(const FString& UnusedParameters)
+{
+	// Every bucket's bounds map back to the bucket and buckets are contiguous.
+	for (int32 BucketIndex = 0; BucketIndex < FLatencyHistogram::NumBuckets; ++BucketIndex)
+	{
+		const uint64 LowerBound = FLatencyHistogram::GetBucketLowerBound(BucketIndex);
+		const uint64 UpperBound = FLatencyHistogram::GetBucketUpperBound(BucketIndex);
+		if (!TestEqual(
+				FString::Printf(TEXT("LowerBound%d"), BucketIndex),
+				FLatencyHistogram::GetBucketIndex(LowerBound), BucketIndex) ||
+			!TestEqual(
+				FString::Printf(TEXT("UpperBound%d"), BucketIndex),
+				FLatencyHistogram::GetBucketIndex(UpperBound), BucketIndex) ||
+			!TestTrue(
+				FString::Printf(TEXT("RelativeError%d"), BucketIndex),
+				double(UpperBound - LowerBound) <=
+				double(LowerBound) / double(FLatencyHistogram::SubBucketHalfCount)))
+		{
+			return false;
+		}
+	}
+	(void)TestEqual(
+		TEXT("ClampMaxValue"), FLatencyHistogram::GetBucketIndex(~uint64(0)),
+		FLatencyHistogram::NumBuckets - 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantLatencyHistogramTestPercentiles,
+	"AI.Assistant.WebApi.LatencyHistogram.Percentiles",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantLatencyHistogramTestPercentiles::RunTest(const FString& UnusedParameters)
+{
+	FLatencyHistogram Histogram;
+	(void)TestEqual(TEXT("EmptyPercentile"), Histogram.GetValueAtPercentile(50.0), uint64(0));
+
+	for (uint64 Value = 1; Value <= 1000; ++Value)
+	{
+		Histogram.Record(Value * 1000);
+	}
+	(void)TestEqual(TEXT("Count"), Histogram.GetCount(), uint64(1000));
+	(void)TestEqual(TEXT("Max"), Histogram.GetMax(), uint64(1000000));
+	(void)TestEqual(TEXT("Mean"), Histogram.GetMean(), 500500.0);
+
+	// Percentiles are accurate to the width of a bucket.
+	const double MaxRelativeError = 1.0 / double(FLatencyHistogram::SubBucketHalfCount);
+	auto TestPercentile = [this, &Histogram, MaxRelativeError](double Percentile) -> void
+		{
+			const double Expected = Percentile * 10000.0;
+			const double Actual = double(Histogram.GetValueAtPercentile(Percentile));
+			(void)TestTrue(
+				FString::Printf(TEXT("P%.0f (%.0f vs %.0f)"), Percentile, Actual, Expected),
+				Actual >= Expected && Actual <= Expected * (1.0 + MaxRelativeError));
+		};
+	TestPercentile(50.0);
+	TestPercentile(95.0);
+	TestPercentile(99.0);
+	(void)TestEqual(TEXT("P100"), Histogram.GetValueAtPercentile(100.0), uint64(1000000));
+
+	Histogram.Reset();
+	(void)TestEqual(TEXT("CountAfterReset"), Histogram.GetCount(), uint64(0));
+	(void)TestEqual(TEXT("MaxAfterReset"), Histogram.GetMax(), uint64(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiMetricsTestRecordCalls,
+	"AI.Assistant.WebApi.Metrics.RecordCalls",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiMetricsTestRecordCalls::RunTest(const FString& UnusedParameters)
+{
+	FWebApiMetrics Metrics;
+	FWebApiMetrics::FFunctionMetrics& FunctionMetrics = Metrics.FindOrAdd(TEXT("test"));
+	(void)TestTrue(
+		TEXT("SameFunctionMetrics"), &Metrics.FindOrAdd(TEXT("test")) == &FunctionMetrics);
+
+	const uint64 FirstCall = FunctionMetrics.BeginCall();
+	const uint64 SecondCall = FunctionMetrics.BeginCall();
+	(void)FunctionMetrics.BeginCall();
+	FunctionMetrics.EndCall(FirstCall, false);
+	FunctionMetrics.EndCall(SecondCall, true);
+
+	const TArray<FWebApiMetrics::FFunctionSummary> Summaries = Metrics.GetSummaries();
+	if (!TestEqual(TEXT("NumSummaries"), Summaries.Num(), 1))
+	{
+		return false;
+	}
+	const FWebApiMetrics::FFunctionSummary& Summary = Summaries[0];
+	(void)TestEqual(TEXT("FunctionName"), Summary.FunctionName, TEXT("test"));
+	(void)TestEqual(TEXT("NumCalls"), Summary.NumCalls, uint64(2));
+	(void)TestEqual(TEXT("NumErrors"), Summary.NumErrors, uint64(1));
+	(void)TestEqual(TEXT("NumInFlight"), Summary.NumInFlight, 1);
+	(void)TestEqual(TEXT("ErrorRate"), Summary.GetErrorRate(), 0.5);
+	(void)TestTrue(
+		TEXT("FormatSummaries"),
+		FWebApiMetrics::FormatSummaries(Summaries).Contains(TEXT("test")));
+
+	Metrics.Reset();
+	(void)TestEqual(
+		TEXT("NumCallsAfterReset"), Metrics.GetSummaries()[0].NumCalls, uint64(0));
+	(void)TestEqual(
+		TEXT("NumInFlightAfterReset"), Metrics.GetSummaries()[0].NumInFlight, 1);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
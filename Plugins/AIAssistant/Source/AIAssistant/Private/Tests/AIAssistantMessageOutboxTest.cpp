@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "WebAPI/AIAssistantMessageOutbox.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Create a user message.
+static FAddMessageToConversationOptions CreateTestOutboxMessage(const TCHAR* Text)
+{
+	FAddMessageToConversationOptions Options;
+	Options.Message.MessageRole = EMessageRole::User;
+	FMessageContent& MessageContent = Options.Message.MessageContent.AddDefaulted_GetRef();
+	MessageContent.ContentType = EMessageContentType::Text;
+	MessageContent.Content.Emplace<FTextMessageContent>();
+	MessageContent.Content.Get<FTextMessageContent>().Text = Text;
+	return Options;
+}
+
+// Get the text of a message created by CreateTestOutboxMessage().
+static FString GetTestOutboxMessageText(const FMessageOutboxEntry& Entry)
+{
+	const TArray<FMessageContent>& MessageContent = Entry.Options.Message.MessageContent;
+	return MessageContent.Num() == 1 && MessageContent[0].Content.IsType<FTextMessageContent>()
+		? MessageContent[0].Content.Get<FTextMessageContent>().Text
+		: FString();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantMessageOutboxTestClaimAcknowledge,
+	"AI.Assistant.MessageOutbox.ClaimAcknowledge",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantMessageOutboxTestClaimAcknowledge::RunTest(const FString& UnusedParameters)
+{
+	FMessageOutbox Outbox;
+	const FString FirstId = Outbox.Add(CreateTestOutboxMessage(TEXT("first")));
+	const FString SecondId = Outbox.Add(CreateTestOutboxMessage(TEXT("second")));
+	(void)TestNotEqual(TEXT("UniqueIds"), FirstId, SecondId);
+
+	TArray<FMessageOutboxEntry> Claimed = Outbox.Claim();
+	(void)TestEqual(TEXT("NumClaimed"), Claimed.Num(), 2);
+	if (Claimed.Num() == 2)
+	{
+		(void)TestEqual(TEXT("First"), GetTestOutboxMessageText(Claimed[0]), TEXT("first"));
+		(void)TestEqual(TEXT("Second"), GetTestOutboxMessageText(Claimed[1]), TEXT("second"));
+		// The ID is sent with the message so the web app can discard duplicates.
+		(void)TestEqual(TEXT("FirstSentId"), Claimed[0].Options.MessageId.Get(FString()), FirstId);
+		(void)TestEqual(TEXT("SecondSentId"), Claimed[1].Options.MessageId.Get(FString()), SecondId);
+	}
+	(void)TestEqual(TEXT("NotClaimedTwice"), Outbox.Claim().Num(), 0);
+	(void)TestEqual(TEXT("NumUnclaimed"), Outbox.NumUnclaimed(), 0);
+
+	// A failed message is claimed again, a sent message is removed.
+	(void)TestTrue(TEXT("Release"), Outbox.Release(FirstId));
+	Outbox.Acknowledge(SecondId);
+	(void)TestEqual(TEXT("Num"), Outbox.Num(), 1);
+	Claimed = Outbox.Claim();
+	(void)TestEqual(TEXT("NumClaimedAgain"), Claimed.Num(), 1);
+	if (Claimed.Num() == 1)
+	{
+		(void)TestEqual(TEXT("ClaimedAgainId"), Claimed[0].MessageId, FirstId);
+	}
+
+	// Messages claimed by a closed page are claimed again.
+	Outbox.ReleaseAll();
+	(void)TestEqual(TEXT("NumClaimedAfterReleaseAll"), Outbox.Claim().Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantMessageOutboxTestDeduplicate,
+	"AI.Assistant.MessageOutbox.Deduplicate",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantMessageOutboxTestDeduplicate::RunTest(const FString& UnusedParameters)
+{
+	FMessageOutbox Outbox;
+	(void)TestTrue(TEXT("Add"), Outbox.Add(TEXT("id"), CreateTestOutboxMessage(TEXT("a"))));
+	(void)TestFalse(TEXT("AddPending"), Outbox.Add(TEXT("id"), CreateTestOutboxMessage(TEXT("a"))));
+	(void)Outbox.Claim();
+	Outbox.Acknowledge(TEXT("id"));
+	(void)TestEqual(TEXT("Num"), Outbox.Num(), 0);
+	(void)TestFalse(
+		TEXT("AddAcknowledged"), Outbox.Add(TEXT("id"), CreateTestOutboxMessage(TEXT("a"))));
+
+	// Unclaimed messages are discarded, claimed messages are kept.
+	(void)Outbox.Add(CreateTestOutboxMessage(TEXT("claimed")));
+	(void)Outbox.Claim();
+	(void)Outbox.Add(CreateTestOutboxMessage(TEXT("unclaimed")));
+	(void)TestEqual(TEXT("DiscardUnclaimed"), Outbox.DiscardUnclaimed(), 1);
+	(void)TestEqual(TEXT("NumAfterDiscard"), Outbox.Num(), 1);
+
+	AddExpectedMessage(TEXT("Discarding message"), ELogVerbosity::Warning);
+	for (int32 Index = 0; Index < FMessageOutbox::MaxEntries; ++Index)
+	{
+		(void)Outbox.Add(CreateTestOutboxMessage(TEXT("overflow")));
+	}
+	(void)TestEqual(TEXT("NumBounded"), Outbox.Num(), FMessageOutbox::MaxEntries);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantMessageOutboxTestMaxSendAttempts,
+	"AI.Assistant.MessageOutbox.MaxSendAttempts",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantMessageOutboxTestMaxSendAttempts::RunTest(const FString& UnusedParameters)
+{
+	FMessageOutbox Outbox;
+	const FString MessageId = Outbox.Add(CreateTestOutboxMessage(TEXT("failing")));
+	for (int32 Attempt = 1; Attempt < FMessageOutbox::MaxSendAttempts; ++Attempt)
+	{
+		(void)TestEqual(FString::Printf(TEXT("Claim%d"), Attempt), Outbox.Claim().Num(), 1);
+		(void)TestTrue(FString::Printf(TEXT("Release%d"), Attempt), Outbox.Release(MessageId));
+	}
+
+	// The last failed attempt discards the message.
+	const TArray<FMessageOutboxEntry> Claimed = Outbox.Claim();
+	(void)TestEqual(TEXT("NumClaimedLast"), Claimed.Num(), 1);
+	if (Claimed.Num() == 1)
+	{
+		(void)TestEqual(
+			TEXT("NumSendAttempts"), Claimed[0].NumSendAttempts, FMessageOutbox::MaxSendAttempts);
+	}
+	AddExpectedMessage(TEXT("Discarding message"), ELogVerbosity::Warning);
+	(void)TestFalse(TEXT("ReleaseLast"), Outbox.Release(MessageId));
+	(void)TestEqual(TEXT("Num"), Outbox.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantMessageOutboxTestAcknowledgeAfterRelease,
+	"AI.Assistant.MessageOutbox.AcknowledgeAfterRelease",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantMessageOutboxTestAcknowledgeAfterRelease::RunTest(const FString& UnusedParameters)
+{
+	FMessageOutbox Outbox;
+	const FString MessageId = Outbox.Add(CreateTestOutboxMessage(TEXT("sent")));
+	(void)Outbox.Claim();
+
+	// The page sending the message closed before it was acknowledged.
+	Outbox.ReleaseAll();
+	(void)TestEqual(TEXT("NumUnclaimedAfterReleaseAll"), Outbox.NumUnclaimed(), 1);
+
+	// The closed page's success arrives late.
+	Outbox.Acknowledge(MessageId);
+	(void)TestEqual(TEXT("Num"), Outbox.Num(), 0);
+	(void)TestEqual(TEXT("NumClaimed"), Outbox.Claim().Num(), 0);
+	(void)TestFalse(TEXT("Release"), Outbox.Release(MessageId));
+	(void)TestFalse(
+		TEXT("AddAcknowledged"), Outbox.Add(MessageId, CreateTestOutboxMessage(TEXT("sent"))));
+
+	// Only recent acknowledgements are remembered.
+	for (int32 Index = 0; Index < FMessageOutbox::MaxAcknowledgedMessageIds; ++Index)
+	{
+		Outbox.Acknowledge(FString::Printf(TEXT("other%d"), Index));
+	}
+	(void)TestTrue(
+		TEXT("AddForgotten"), Outbox.Add(MessageId, CreateTestOutboxMessage(TEXT("sent"))));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
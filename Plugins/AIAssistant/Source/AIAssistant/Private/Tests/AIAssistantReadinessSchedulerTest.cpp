@@ -0,0 +1,236 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Core/AIAssistantReadinessScheduler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestDependencies,
+	"AI.Assistant.ReadinessScheduler.Dependencies",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestDependencies::RunTest(const FString& UnusedParameters)
+{
+	// Diamond: Root <- Left, Right <- Leaf.
+	FReadinessScheduler Scheduler;
+	const auto Root = Scheduler.AddCondition(TEXT("Root"));
+	const auto Left = Scheduler.AddCondition(TEXT("Left"), { Root });
+	const auto Right = Scheduler.AddCondition(TEXT("Right"), { Root });
+	const auto Leaf = Scheduler.AddCondition(TEXT("Leaf"), { Left, Right });
+	(void)Scheduler.SetCondition(Left, true);
+	(void)Scheduler.SetCondition(Right, true);
+	(void)Scheduler.SetCondition(Leaf, true);
+	(void)TestFalse(TEXT("LeafWaitsOnRoot"), Scheduler.IsReady(Leaf));
+	(void)TestTrue(TEXT("LeafIsSet"), Scheduler.IsConditionSet(Leaf));
+
+	(void)TestFalse(TEXT("RootWasNotSet"), Scheduler.SetCondition(Root, true));
+	(void)TestTrue(TEXT("LeafReady"), Scheduler.IsReady(Leaf));
+
+	(void)Scheduler.SetCondition(Right, false);
+	(void)TestTrue(TEXT("LeftStillReady"), Scheduler.IsReady(Left));
+	(void)TestFalse(TEXT("LeafNotReady"), Scheduler.IsReady(Leaf));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestDispatch,
+	"AI.Assistant.ReadinessScheduler.Dispatch",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestDispatch::RunTest(const FString& UnusedParameters)
+{
+	FReadinessScheduler Scheduler;
+	const auto First = Scheduler.AddCondition(TEXT("First"));
+	const auto Second = Scheduler.AddCondition(TEXT("Second"));
+	const auto Dependent = Scheduler.AddCondition(TEXT("Dependent"), { First });
+	(void)Scheduler.SetCondition(Dependent, true);
+
+	FString Executed;
+	Scheduler.ExecuteWhenReady({ First, Second }, [&Executed]() -> void { Executed += TEXT("A"); });
+	Scheduler.ExecuteWhenReady({ Dependent }, [&Executed]() -> void { Executed += TEXT("B"); });
+	Scheduler.ExecuteWhenReady({ Second }, [&Executed]() -> void { Executed += TEXT("C"); });
+	Scheduler.ExecuteWhenReady({}, [&Executed]() -> void { Executed += TEXT("D"); });
+	(void)TestEqual(TEXT("NoConditions"), Executed, TEXT("D"));
+	(void)TestEqual(TEXT("NumPending"), Scheduler.GetNumPendingWork(), 3);
+
+	(void)Scheduler.SetCondition(First, true);
+	(void)TestEqual(TEXT("ThroughDependency"), Executed, TEXT("DB"));
+
+	// A condition that stops being ready again delays work.
+	(void)Scheduler.SetCondition(First, false);
+	(void)TestEqual(TEXT("NumPendingAfterClear"), Scheduler.GetNumPendingWork(), 2);
+	(void)Scheduler.SetCondition(Second, true);
+	(void)TestEqual(TEXT("OnlySecond"), Executed, TEXT("DBC"));
+
+	(void)Scheduler.SetCondition(First, true);
+	(void)TestEqual(TEXT("All"), Executed, TEXT("DBCA"));
+	(void)TestEqual(TEXT("NumPendingAll"), Scheduler.GetNumPendingWork(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestOrderAndReentrancy,
+	"AI.Assistant.ReadinessScheduler.OrderAndReentrancy",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestOrderAndReentrancy::RunTest(
+	const FString& UnusedParameters)
+{
+	FReadinessScheduler Scheduler;
+	const auto Ready = Scheduler.AddCondition(TEXT("Ready"));
+	TArray<int32> Executed;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		Scheduler.ExecuteWhenReady(
+			{ Ready },
+			[&Scheduler, &Executed, Ready, Index]() -> void
+			{
+				Executed.Add(Index);
+				// Work added while dispatching runs after the current work.
+				if (Index == 0)
+				{
+					Scheduler.ExecuteWhenReady(
+						{ Ready }, [&Executed]() -> void { Executed.Add(4); });
+				}
+			});
+	}
+	(void)Scheduler.SetCondition(Ready, true);
+	(void)TestTrue(TEXT("Order"), Executed == TArray<int32>({ 0, 1, 2, 3, 4 }));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestReject,
+	"AI.Assistant.ReadinessScheduler.Reject",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestReject::RunTest(const FString& UnusedParameters)
+{
+	FReadinessScheduler Scheduler;
+	const auto Root = Scheduler.AddCondition(TEXT("Root"));
+	const auto Dependent = Scheduler.AddCondition(TEXT("Dependent"), { Root });
+	const auto Other = Scheduler.AddCondition(TEXT("Other"));
+	(void)Scheduler.SetCondition(Dependent, true);
+
+	FString Executed;
+	Scheduler.ExecuteWhenReady({ Root }, [&Executed]() -> void { Executed += TEXT("A"); });
+	Scheduler.ExecuteWhenReady({ Dependent, Other }, [&Executed]() -> void { Executed += TEXT("B"); });
+	Scheduler.ExecuteWhenReady({ Other }, [&Executed]() -> void { Executed += TEXT("C"); });
+
+	(void)TestEqual(TEXT("RejectDependents"), Scheduler.Reject(Root), 2);
+	(void)TestEqual(TEXT("NumPending"), Scheduler.GetNumPendingWork(), 1);
+	(void)Scheduler.SetCondition(Root, true);
+	(void)Scheduler.SetCondition(Other, true);
+	(void)TestEqual(TEXT("OnlyOther"), Executed, TEXT("C"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestTimings,
+	"AI.Assistant.ReadinessScheduler.Timings",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestTimings::RunTest(const FString& UnusedParameters)
+{
+	double NowSeconds = 1.0;
+	FReadinessScheduler Scheduler([&NowSeconds]() -> double { return NowSeconds; });
+	const auto Condition = Scheduler.AddCondition(TEXT("Condition"));
+	NowSeconds = 1.5;
+	(void)Scheduler.SetCondition(Condition, true);
+	NowSeconds = 4.0;
+	(void)Scheduler.SetCondition(Condition, false);
+	NowSeconds = 4.25;
+	(void)Scheduler.SetCondition(Condition, true);
+
+	const TArray<FReadinessScheduler::FConditionTiming> Timings = Scheduler.GetConditionTimings();
+	(void)TestEqual(TEXT("NumTimings"), Timings.Num(), 1);
+	if (Timings.Num() == 1)
+	{
+		(void)TestEqual(TEXT("Name"), Timings[0].Name, TEXT("Condition"));
+		(void)TestTrue(TEXT("IsReady"), Timings[0].bIsReady);
+		(void)TestEqual(TEXT("NumTimesReady"), Timings[0].NumTimesReady, 2);
+		(void)TestEqual(TEXT("TimeToReady"), Timings[0].TimeToReadySeconds.Get(0.0), 0.25);
+	}
+	(void)TestTrue(
+		TEXT("Format"),
+		FReadinessScheduler::FormatConditionTimings(Timings).Contains(TEXT("250.00")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestCapacity,
+	"AI.Assistant.ReadinessScheduler.Capacity",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestCapacity::RunTest(const FString& UnusedParameters)
+{
+	for (const auto OverflowPolicy : {
+			FReadinessScheduler::EOverflowPolicy::DropOldest,
+			FReadinessScheduler::EOverflowPolicy::Reject })
+	{
+		const bool bDropOldest = OverflowPolicy == FReadinessScheduler::EOverflowPolicy::DropOldest;
+		FReadinessScheduler Scheduler;
+		const auto Ready = Scheduler.AddCondition(TEXT("Ready"));
+		Scheduler.SetCapacity(2, OverflowPolicy);
+		AddExpectedMessage(
+			bDropOldest ? TEXT("Dropped the oldest deferred work") : TEXT("Rejected deferred work"),
+			ELogVerbosity::Warning);
+
+		FString Executed;
+		for (const TCHAR* Item : { TEXT("A"), TEXT("B"), TEXT("C") })
+		{
+			const bool bAdded = Scheduler.ExecuteWhenReady(
+				{ Ready }, [&Executed, Item]() -> void { Executed += Item; });
+			(void)TestEqual(
+				FString::Printf(TEXT("Added %s"), Item), bAdded, bDropOldest || *Item != TEXT('C'));
+		}
+		(void)TestEqual(TEXT("NumPending"), Scheduler.GetNumPendingWork(), 2);
+
+		(void)Scheduler.SetCondition(Ready, true);
+		(void)TestEqual(TEXT("Executed"), Executed, bDropOldest ? TEXT("BC") : TEXT("AB"));
+
+		const FReadinessScheduler::FQueueMetrics Metrics = Scheduler.GetQueueMetrics();
+		(void)TestEqual(TEXT("NumDropped"), Metrics.NumDropped, uint64(bDropOldest ? 1 : 0));
+		(void)TestEqual(TEXT("NumRejected"), Metrics.NumRejected, uint64(bDropOldest ? 0 : 1));
+		(void)TestEqual(TEXT("NumCoalesced"), Metrics.NumCoalesced, uint64(0));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantReadinessSchedulerTestCoalesce,
+	"AI.Assistant.ReadinessScheduler.Coalesce",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantReadinessSchedulerTestCoalesce::RunTest(const FString& UnusedParameters)
+{
+	FReadinessScheduler Scheduler;
+	const auto Ready = Scheduler.AddCondition(TEXT("Ready"));
+	const FName Locale(TEXT("Locale"));
+	FString Executed;
+	Scheduler.ExecuteWhenReady({ Ready }, [&Executed]() -> void { Executed += TEXT("en "); }, Locale);
+	Scheduler.ExecuteWhenReady({ Ready }, [&Executed]() -> void { Executed += TEXT("message "); });
+	Scheduler.ExecuteWhenReady({ Ready }, [&Executed]() -> void { Executed += TEXT("fr "); }, Locale);
+	Scheduler.ExecuteWhenReady({ Ready }, [&Executed]() -> void { Executed += TEXT("de "); }, Locale);
+	(void)TestEqual(TEXT("NumPending"), Scheduler.GetNumPendingWork(), 2);
+	(void)TestEqual(TEXT("NumCoalesced"), Scheduler.GetQueueMetrics().NumCoalesced, uint64(2));
+
+	(void)Scheduler.SetCondition(Ready, true);
+	(void)TestEqual(TEXT("Executed"), Executed, TEXT("message de "));
+
+	// Keys are released once work is dispatched.
+	(void)Scheduler.SetCondition(Ready, false);
+	Scheduler.ExecuteWhenReady({ Ready }, [&Executed]() -> void { Executed += TEXT("es"); }, Locale);
+	(void)Scheduler.SetCondition(Ready, true);
+	(void)TestEqual(TEXT("ExecutedAgain"), Executed, TEXT("message de es"));
+	(void)TestEqual(TEXT("NumCoalescedAgain"), Scheduler.GetQueueMetrics().NumCoalesced, uint64(2));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
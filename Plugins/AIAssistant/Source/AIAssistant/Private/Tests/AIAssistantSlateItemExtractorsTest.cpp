@@ -0,0 +1,266 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SSpacer.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SNullWidget.h"
+
+#include "AIAssistantSlateItemExtractors.h"
+#include "AIAssistantTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Widget path of null widgets with the given types, the hovered widget can be a real widget.
+class FSlateItemExtractorsTestQuery : public ISlateItemQuery
+{
+public:
+	explicit FSlateItemExtractorsTestQuery(
+		TArray<FName> InWidgetTypes, TSharedRef<SWidget> InHoveredWidget = SNullWidget::NullWidget) :
+		WidgetTypes(MoveTemp(InWidgetTypes)), HoveredWidget(MoveTemp(InHoveredWidget)) {}
+
+	int32 GetNumWidgets() const override { return WidgetTypes.Num(); }
+	TSharedRef<SWidget> GetWidgetAt(int32 WidgetIndex) const override
+	{
+		return WidgetIndex == WidgetTypes.Num() - 1 ? HoveredWidget : SNullWidget::NullWidget;
+	}
+	FName GetWidgetTypeAt(int32 WidgetIndex) const override { return WidgetTypes[WidgetIndex]; }
+	int32 FindClosestWidget(FName WidgetType) const override { return WidgetTypes.FindLast(WidgetType); }
+	int32 FindFurthestWidget(FName WidgetType) const override { return WidgetTypes.Find(WidgetType); }
+	const FText& GetToolTipText() const override { return FText::GetEmpty(); }
+	FText FindChildText(const TSharedRef<SWidget>&) override { return FText(); }
+	TSharedPtr<SWidget> FindChildWidget(const TSharedRef<SWidget>&, FName) override { return nullptr; }
+
+private:
+	TArray<FName> WidgetTypes;
+	TSharedRef<SWidget> HoveredWidget;
+};
+
+// Extractor that records the widget index it was called with and names the item after itself.
+static FSlateItemExtractor MakeSlateItemExtractorsTestExtractor(
+	FName Name, TArray<FName> WidgetTypes, int32 Order, TArray<TPair<FName, int32>>& OutCalls)
+{
+	FSlateItemExtractor Extractor;
+	Extractor.Name = Name;
+	Extractor.WidgetTypes = MoveTemp(WidgetTypes);
+	Extractor.Order = Order;
+	Extractor.Extract = [Name, &OutCalls](ISlateItemQuery&, const FSlateItemMatch& Match, FSlateItem& InOutItem)
+	{
+		OutCalls.Emplace(Name, Match.WidgetIndex);
+		InOutItem.Name = FText::FromName(Name);
+		return true;
+	};
+	return Extractor;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantSlateItemExtractorsTestDispatch,
+	"AI.Assistant.SlateItemExtractors.Dispatch",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantSlateItemExtractorsTestDispatch::RunTest(const FString& UnusedParameters)
+{
+	TArray<TPair<FName, int32>> Calls;
+	FSlateItemExtractorRegistry Registry;
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Late"), { TEXT("SButton") }, 200, Calls));
+	(void)Registry.Register(MakeSlateItemExtractorsTestExtractor(
+		TEXT("Early"), { TEXT("SDockingArea"), TEXT("SButton") }, 100, Calls));
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Missing"), { TEXT("SGraphEditor") }, 0, Calls));
+
+	FSlateItemExtractorsTestQuery Query(
+		{ TEXT("SWindow"), TEXT("SDockingArea"), TEXT("SButton"), TEXT("SBorder"), TEXT("SButton") });
+	FSlateItem Item;
+	Registry.Extract(Query, Item);
+
+	// Each matched extractor runs once in order with the deepest widget of its types.
+	const TArray<TPair<FName, int32>> ExpectedCalls = {
+		{ TEXT("Early"), 4 },
+		{ TEXT("Late"), 4 },
+	};
+	(void)TestTrue(TEXT("Calls"), Calls == ExpectedCalls);
+	(void)TestEqual(TEXT("Name"), Item.Name.ToString(), FString(TEXT("Late")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantSlateItemExtractorsTestStats,
+	"AI.Assistant.SlateItemExtractors.Stats",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantSlateItemExtractorsTestStats::RunTest(const FString& UnusedParameters)
+{
+	TArray<TPair<FName, int32>> Calls;
+	FSlateItemExtractorRegistry Registry;
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Button"), { TEXT("SButton") }, 100, Calls));
+	const FDelegateHandle Handle = Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Border"), { TEXT("SBorder") }, 200, Calls));
+
+	FSlateItemExtractorsTestQuery Query({ TEXT("SWindow"), TEXT("SButton") });
+	FSlateItem Item;
+	Registry.Extract(Query, Item);
+	Registry.Extract(Query, Item);
+	// Queries that may not be used, e.g precomputed, aren't recorded.
+	Registry.Extract(Query, Item, false);
+
+	TArray<FSlateItemExtractorRegistry::FStats> Stats = Registry.GetStats();
+	if (TestEqual(TEXT("NumStats"), Stats.Num(), 2))
+	{
+		(void)TestEqual(TEXT("Name"), Stats[0].Name, FName(TEXT("Button")));
+		(void)TestEqual(TEXT("NumCalls"), Stats[0].NumCalls, 2);
+		(void)TestEqual(TEXT("NumExtractCalls"), Calls.Num(), 3);
+		(void)TestEqual(TEXT("NumDescribed"), Stats[0].NumDescribed, 2);
+		(void)TestTrue(TEXT("MaxSeconds"), Stats[0].MaxSeconds <= Stats[0].TotalSeconds);
+		(void)TestEqual(TEXT("UnmatchedNumCalls"), Stats[1].NumCalls, 0);
+	}
+
+	Registry.ResetStats();
+	Registry.Unregister(Handle);
+	Stats = Registry.GetStats();
+	if (TestEqual(TEXT("NumStatsUnregistered"), Stats.Num(), 1))
+	{
+		(void)TestEqual(TEXT("ResetName"), Stats[0].Name, FName(TEXT("Button")));
+		(void)TestEqual(TEXT("ResetNumCalls"), Stats[0].NumCalls, 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantSlateItemExtractorsTestHoveredWidgetChildren,
+	"AI.Assistant.SlateItemExtractors.HoveredWidgetChildren",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantSlateItemExtractorsTestHoveredWidgetChildren::RunTest(const FString& UnusedParameters)
+{
+	TSharedPtr<SWidget> LastBorder;
+	const TSharedRef<SHorizontalBox> HoveredWidget = SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()[SNew(SBorder)]
+		+ SHorizontalBox::Slot()[SNew(SSpacer)]
+		+ SHorizontalBox::Slot()[SAssignNew(LastBorder, SBorder)];
+
+	TArray<TPair<FName, int32>> Calls;
+	TSharedPtr<SWidget> MatchedBorder;
+	FSlateItemExtractorRegistry Registry;
+	FSlateItemExtractor ChildExtractor =
+		MakeSlateItemExtractorsTestExtractor(TEXT("Child"), { TEXT("SBorder") }, 100, Calls);
+	ChildExtractor.bMatchHoveredWidgetChildren = true;
+	ChildExtractor.Extract = [&Calls, &MatchedBorder](
+		ISlateItemQuery&, const FSlateItemMatch& Match, FSlateItem&)
+	{
+		Calls.Emplace(TEXT("Child"), Match.WidgetIndex);
+		MatchedBorder = Match.Widget;
+		return true;
+	};
+	(void)Registry.Register(MoveTemp(ChildExtractor));
+	FSlateItemExtractor PathExtractor =
+		MakeSlateItemExtractorsTestExtractor(TEXT("Path"), { TEXT("SSpacer") }, 200, Calls);
+	PathExtractor.bMatchHoveredWidgetChildren = true;
+	(void)Registry.Register(MoveTemp(PathExtractor));
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("NotOptedIn"), { TEXT("SBorder") }, 300, Calls));
+
+	FSlateItemExtractorsTestQuery Query(
+		{ TEXT("SWindow"), TEXT("SSpacer"), TEXT("SHorizontalBox") }, HoveredWidget);
+	FSlateItem Item;
+	Registry.Extract(Query, Item);
+
+	// Children only match extractors that opt in and have no widget of their types in the path,
+	// the last matching child is used.
+	const TArray<TPair<FName, int32>> ExpectedCalls = {
+		{ TEXT("Child"), INDEX_NONE },
+		{ TEXT("Path"), 1 },
+	};
+	(void)TestTrue(TEXT("Calls"), Calls == ExpectedCalls);
+	(void)TestTrue(TEXT("LastChild"), MatchedBorder == LastBorder);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantSlateItemExtractorsTestOrderTies,
+	"AI.Assistant.SlateItemExtractors.OrderTies",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantSlateItemExtractorsTestOrderTies::RunTest(const FString& UnusedParameters)
+{
+	TArray<TPair<FName, int32>> Calls;
+	FSlateItemExtractorRegistry Registry;
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("First"), { TEXT("SButton") }, 100, Calls));
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Second"), { TEXT("SButton") }, 100, Calls));
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Earlier"), { TEXT("SButton") }, 0, Calls));
+	(void)Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Third"), { TEXT("SButton") }, 100, Calls));
+
+	FSlateItemExtractorsTestQuery Query({ TEXT("SWindow"), TEXT("SButton") });
+	FSlateItem Item;
+	Registry.Extract(Query, Item);
+
+	// Extractors with the same order run in the order they were registered.
+	const TArray<TPair<FName, int32>> ExpectedCalls = {
+		{ TEXT("Earlier"), 1 },
+		{ TEXT("First"), 1 },
+		{ TEXT("Second"), 1 },
+		{ TEXT("Third"), 1 },
+	};
+	(void)TestTrue(TEXT("Calls"), Calls == ExpectedCalls);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantSlateItemExtractorsTestRegisterWhileExtracting,
+	"AI.Assistant.SlateItemExtractors.RegisterWhileExtracting",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantSlateItemExtractorsTestRegisterWhileExtracting::RunTest(const FString& UnusedParameters)
+{
+	TArray<TPair<FName, int32>> Calls;
+	FSlateItemExtractorRegistry Registry;
+	const FDelegateHandle RemovedHandle = Registry.Register(
+		MakeSlateItemExtractorsTestExtractor(TEXT("Removed"), { TEXT("SButton") }, 200, Calls));
+	FSlateItemExtractor Changer =
+		MakeSlateItemExtractorsTestExtractor(TEXT("Changer"), { TEXT("SButton") }, 100, Calls);
+	bool bChanged = false;
+	Changer.Extract = [&Registry, &Calls, &bChanged, RemovedHandle](
+		ISlateItemQuery&, const FSlateItemMatch& Match, FSlateItem&)
+	{
+		Calls.Emplace(TEXT("Changer"), Match.WidgetIndex);
+		if (!bChanged)
+		{
+			bChanged = true;
+			(void)Registry.Register(
+				MakeSlateItemExtractorsTestExtractor(TEXT("Added"), { TEXT("SButton") }, 0, Calls));
+			Registry.Unregister(RemovedHandle);
+		}
+		return true;
+	};
+	(void)Registry.Register(MoveTemp(Changer));
+
+	FSlateItemExtractorsTestQuery Query({ TEXT("SWindow"), TEXT("SButton") });
+	FSlateItem Item;
+	Registry.Extract(Query, Item);
+
+	// Changes made while extracting are applied once all of the extractors have run.
+	const TArray<TPair<FName, int32>> ExpectedFirstCalls = {
+		{ TEXT("Changer"), 1 },
+		{ TEXT("Removed"), 1 },
+	};
+	(void)TestTrue(TEXT("FirstCalls"), Calls == ExpectedFirstCalls);
+	(void)TestEqual(TEXT("NumStats"), Registry.GetStats().Num(), 2);
+
+	Calls.Reset();
+	Registry.Extract(Query, Item);
+	const TArray<TPair<FName, int32>> ExpectedSecondCalls = {
+		{ TEXT("Added"), 1 },
+		{ TEXT("Changer"), 1 },
+	};
+	(void)TestTrue(TEXT("SecondCalls"), Calls == ExpectedSecondCalls);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
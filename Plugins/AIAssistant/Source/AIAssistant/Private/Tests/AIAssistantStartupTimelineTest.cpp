@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Core/AIAssistantStartupTimeline.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantStartupTimelineTestMilestones,
+	"AI.Assistant.StartupTimeline.Milestones",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantStartupTimelineTestMilestones::RunTest(const FString& UnusedParameters)
+{
+	using EMilestone = FStartupTimeline::EMilestone;
+
+	FStartupTimeline Timeline;
+	(void)TestFalse(TEXT("NoSession"), Timeline.MarkMilestone(EMilestone::LoadStarted, 1.0));
+	(void)TestEqual(TEXT("NoSessions"), Timeline.GetSessions().Num(), 0);
+
+	Timeline.BeginSession(10.0);
+	(void)TestTrue(TEXT("TabSpawned"), Timeline.MarkMilestone(EMilestone::TabSpawned, 10.0));
+	(void)TestTrue(TEXT("LoadStarted"), Timeline.MarkMilestone(EMilestone::LoadStarted, 10.5));
+	// Only the first load of a session is recorded.
+	(void)TestFalse(TEXT("LoadStartedAgain"), Timeline.MarkMilestone(EMilestone::LoadStarted, 11.0));
+
+	TArray<FStartupTimeline::FSession> Sessions = Timeline.GetSessions();
+	(void)TestEqual(TEXT("InProgress"), Sessions.Num(), 1);
+	if (Sessions.Num() == 1)
+	{
+		(void)TestEqual(
+			TEXT("LoadStartedSeconds"),
+			Sessions[0].GetMilestoneSeconds(EMilestone::LoadStarted).Get(0.0), 0.5);
+		(void)TestFalse(
+			TEXT("LoadCompletedNotReached"),
+			Sessions[0].GetMilestoneSeconds(EMilestone::LoadCompleted).IsSet());
+	}
+
+	// Accepting the first message ends the session so later messages are ignored.
+	(void)TestTrue(TEXT("Accepted"), Timeline.MarkMilestone(EMilestone::FirstMessageAccepted, 12.0));
+	(void)TestFalse(TEXT("AcceptedAgain"), Timeline.MarkMilestone(EMilestone::FirstMessageAccepted, 13.0));
+	Sessions = Timeline.GetSessions();
+	(void)TestEqual(TEXT("Ended"), Sessions.Num(), 1);
+	if (Sessions.Num() == 1)
+	{
+		(void)TestEqual(
+			TEXT("Format"), FStartupTimeline::FormatSession(Sessions[0]),
+			FString(TEXT("TabSpawned=0.0ms BrowserWindowCreated=- LoadStarted=500.0ms ")
+				TEXT("LoadCompleted=- AgentEnvironmentAdded=- AgentEnvironmentConfigured=- ")
+				TEXT("FirstMessageAccepted=2000.0ms")));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantStartupTimelineTestHistory,
+	"AI.Assistant.StartupTimeline.History",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantStartupTimelineTestHistory::RunTest(const FString& UnusedParameters)
+{
+	FStartupTimeline Timeline;
+	for (int32 Index = 0; Index < FStartupTimeline::MaxSessions + 2; ++Index)
+	{
+		Timeline.BeginSession(double(Index));
+	}
+	TArray<FStartupTimeline::FSession> Sessions = Timeline.GetSessions();
+	(void)TestEqual(TEXT("NumSessions"), Sessions.Num(), FStartupTimeline::MaxSessions + 1);
+	if (Sessions.Num() > 0)
+	{
+		(void)TestEqual(TEXT("Oldest"), Sessions[0].StartSeconds, 1.0);
+		(void)TestEqual(
+			TEXT("Current"), Sessions.Last().StartSeconds,
+			double(FStartupTimeline::MaxSessions + 1));
+	}
+
+	Sessions = Timeline.GetSessions(2);
+	(void)TestEqual(TEXT("NumLast"), Sessions.Num(), 2);
+	if (Sessions.Num() == 2)
+	{
+		(void)TestEqual(
+			TEXT("LastOldest"), Sessions[0].StartSeconds, double(FStartupTimeline::MaxSessions));
+	}
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
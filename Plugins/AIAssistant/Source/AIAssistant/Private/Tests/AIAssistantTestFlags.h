@@ -12,6 +12,12 @@ namespace AIAssistantTest
 		EAutomationTestFlags::EditorContext |
 		EAutomationTestFlags::ProductFilter |
 		EAutomationTestFlags::CriticalPriority;
+
+	// Flags to use for benchmarks, these are only run when explicitly requested.
+	const auto BenchmarkFlags =
+		EAutomationTestFlags::EditorContext |
+		EAutomationTestFlags::PerfFilter |
+		EAutomationTestFlags::LowPriority;
 }  // namespace AIAssistantTest
 
 #endif  // WITH_DEV_AUTOMATION_TESTS
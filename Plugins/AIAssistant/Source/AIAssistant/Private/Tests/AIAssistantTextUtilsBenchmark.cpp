@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Internationalization/Regex.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Function.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Utils/AIAssistantTextUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Text of widgets under the cursor and below the widgets the Slate querier inspects.
+static const TCHAR* TextUtilsBenchmarkWidgetTexts[] = {
+	TEXT("Details"),
+	TEXT("Location"),
+	TEXT("0.0"),
+	TEXT("-1250.375"),
+	TEXT("100 %"),
+	TEXT("Static Mesh Component (StaticMeshComponent0)"),
+	TEXT("SM_Chair"),
+	TEXT("12"),
+	TEXT("Content Browser"),
+	TEXT("1,024 items (1 selected)"),
+	TEXT("Add Component"),
+	TEXT("60.00 FPS"),
+	TEXT("#!#"),
+	TEXT("\u30ec\u30d9\u30eb"),
+	TEXT("Transform"),
+	TEXT("3"),
+};
+
+// Queries and context sent to the assistant before white space is collapsed.
+static const TCHAR* TextUtilsBenchmarkQueries[] = {
+	TEXT("Explain the  \"Location\"  setting  in the  Details panel. "),
+	TEXT("I am working in  Outliner of   the Level Editor.  The Select tool is active for Selection mode.\n"),
+	TEXT("\tWhat is the\t\"Add Component\" button used for?\r\n"),
+	TEXT("  Answer concisely.  The user is asking about a widget in the Unreal Editor, not about Slate itself.  "),
+};
+
+// Measure the time to call Function on each string NumIterations times.
+static double RunTextUtilsBenchmark(
+	TConstArrayView<const TCHAR*> Strings, TFunctionRef<void(const FString&)> Function, int32 NumIterations)
+{
+	TArray<FString> InputStrings;
+	for (const TCHAR* String : Strings)
+	{
+		InputStrings.Emplace(String);
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const FString& String : InputStrings)
+		{
+			Function(String);
+		}
+	}
+	return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e9 /
+		double(NumIterations * InputStrings.Num());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTextUtilsBenchmarkContainsAsciiLetter,
+	"AI.Assistant.TextUtils.Benchmark.ContainsAsciiLetter",
+	AIAssistantTest::BenchmarkFlags);
+
+bool FAIAssistantTextUtilsBenchmarkContainsAsciiLetter::RunTest(const FString& UnusedParameters)
+{
+	static constexpr int32 NumIterations = 1000;
+	int32 NumMatches = 0;
+
+	// The Slate querier's check before the scanner, a pattern compiled per check.
+	auto ContainsLetterByRegex = [](const FString& Text) -> bool
+	{
+		const FRegexPattern AlphaPattern(TEXT("[A-Za-z]+"));
+		return FRegexMatcher(AlphaPattern, Text).FindNext();
+	};
+
+	bool bSameResults = true;
+	for (const TCHAR* Text : TextUtilsBenchmarkWidgetTexts)
+	{
+		bSameResults &=
+			TestEqual(Text, ContainsAsciiLetter(FStringView(Text)), ContainsLetterByRegex(Text));
+	}
+	if (!bSameResults)
+	{
+		return false;
+	}
+
+	const double RegexNanoseconds = RunTextUtilsBenchmark(
+		TextUtilsBenchmarkWidgetTexts,
+		[&NumMatches, &ContainsLetterByRegex](const FString& Text)
+		{ NumMatches += ContainsLetterByRegex(Text) ? 1 : 0; },
+		NumIterations);
+	const double ScannerNanoseconds = RunTextUtilsBenchmark(
+		TextUtilsBenchmarkWidgetTexts,
+		[&NumMatches](const FString& Text) { NumMatches += ContainsAsciiLetter(Text) ? 1 : 0; },
+		NumIterations);
+
+	AddInfo(FString::Printf(TEXT("Regex: %.1f ns/string"), RegexNanoseconds));
+	AddInfo(FString::Printf(TEXT("Scanner: %.1f ns/string (%d matches)"), ScannerNanoseconds, NumMatches));
+	return TestTrue(TEXT("Faster"), ScannerNanoseconds < RegexNanoseconds);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTextUtilsBenchmarkCollapseWhiteSpace,
+	"AI.Assistant.TextUtils.Benchmark.CollapseWhiteSpace",
+	AIAssistantTest::BenchmarkFlags);
+
+bool FAIAssistantTextUtilsBenchmarkCollapseWhiteSpace::RunTest(const FString& UnusedParameters)
+{
+	static constexpr int32 NumIterations = 1000;
+	int32 NumCharacters = 0;
+
+	// The Slate querier's white space cleanup before the scanner.
+	auto CollapseWhiteSpaceByRegex = [](const FString& Text) -> FString
+	{
+		static const FRegexPattern WhiteSpacePattern(TEXT("(\\S+)"));
+		FString CleanString;
+		FRegexMatcher Matcher(WhiteSpacePattern, Text);
+		while (Matcher.FindNext())
+		{
+			if (!CleanString.IsEmpty())
+			{
+				CleanString += TEXT(" ");
+			}
+			CleanString += Matcher.GetCaptureGroup(1);
+		}
+		return CleanString;
+	};
+
+	bool bSameResults = true;
+	for (const TCHAR* Text : TextUtilsBenchmarkQueries)
+	{
+		bSameResults &= TestEqual(Text, CollapseWhiteSpace(Text), CollapseWhiteSpaceByRegex(Text));
+	}
+	if (!bSameResults)
+	{
+		return false;
+	}
+
+	const double RegexNanoseconds = RunTextUtilsBenchmark(
+		TextUtilsBenchmarkQueries,
+		[&NumCharacters, &CollapseWhiteSpaceByRegex](const FString& Text)
+		{ NumCharacters += CollapseWhiteSpaceByRegex(Text).Len(); },
+		NumIterations);
+	const double ScannerNanoseconds = RunTextUtilsBenchmark(
+		TextUtilsBenchmarkQueries,
+		[&NumCharacters](const FString& Text) { NumCharacters += CollapseWhiteSpace(Text).Len(); },
+		NumIterations);
+
+	AddInfo(FString::Printf(TEXT("Regex: %.1f ns/string"), RegexNanoseconds));
+	AddInfo(FString::Printf(TEXT("Scanner: %.1f ns/string (%d characters)"), ScannerNanoseconds, NumCharacters));
+	return TestTrue(TEXT("Faster"), ScannerNanoseconds < RegexNanoseconds);
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
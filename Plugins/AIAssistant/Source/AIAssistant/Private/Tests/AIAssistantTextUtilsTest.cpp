@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Utils/AIAssistantTextUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTextUtilsTestContainsAsciiLetter,
+	"AI.Assistant.TextUtils.ContainsAsciiLetter",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTextUtilsTestContainsAsciiLetter::RunTest(const FString& UnusedParameters)
+{
+	(void)TestTrue(TEXT("Word"), ContainsAsciiLetter(TEXTVIEW("Details")));
+	(void)TestTrue(TEXT("Upper"), ContainsAsciiLetter(TEXTVIEW("1.0 X")));
+	(void)TestTrue(TEXT("Lower"), ContainsAsciiLetter(TEXTVIEW("12 z")));
+	(void)TestTrue(TEXT("FText"), ContainsAsciiLetter(FText::FromString(TEXT("Location"))));
+	(void)TestFalse(TEXT("Empty"), ContainsAsciiLetter(FStringView()));
+	(void)TestFalse(TEXT("EmptyFText"), ContainsAsciiLetter(FText::GetEmpty()));
+	(void)TestFalse(TEXT("Number"), ContainsAsciiLetter(TEXTVIEW("-12.50 %")));
+	// Characters next to the letters in ASCII.
+	(void)TestFalse(TEXT("Punctuation"), ContainsAsciiLetter(TEXTVIEW("@[`{")));
+	// Like [A-Za-z], letters outside ASCII don't count.
+	(void)TestFalse(TEXT("NonAscii"), ContainsAsciiLetter(TEXTVIEW("\u00e9\u00c0\u0391")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTextUtilsTestCollapseWhiteSpace,
+	"AI.Assistant.TextUtils.CollapseWhiteSpace",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTextUtilsTestCollapseWhiteSpace::RunTest(const FString& UnusedParameters)
+{
+	(void)TestEqual(TEXT("Unchanged"), CollapseWhiteSpace(TEXTVIEW("a b")), FString(TEXT("a b")));
+	(void)TestEqual(
+		TEXT("Runs"), CollapseWhiteSpace(TEXTVIEW("  What is\t\tthe \r\n Details  panel? ")),
+		FString(TEXT("What is the Details panel?")));
+	(void)TestEqual(TEXT("Empty"), CollapseWhiteSpace(FStringView()), FString());
+	(void)TestEqual(TEXT("OnlyWhiteSpace"), CollapseWhiteSpace(TEXTVIEW(" \t\n ")), FString());
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
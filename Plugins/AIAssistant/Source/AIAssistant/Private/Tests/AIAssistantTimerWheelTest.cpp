@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/Array.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Core/AIAssistantCancellationToken.h"
+#include "Core/AIAssistantTimerWheel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTimerWheelTestExpire,
+	"AI.Assistant.TimerWheel.Expire",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTimerWheelTestExpire::RunTest(const FString& UnusedParameters)
+{
+	FTimerWheel TimerWheel;
+	TArray<uint64> ExpiredOnTicks;
+	auto Schedule = [&TimerWheel, &ExpiredOnTicks](uint64 DelayTicks) -> void
+		{
+			(void)TimerWheel.ScheduleTicks(
+				DelayTicks,
+				[&TimerWheel, &ExpiredOnTicks]() -> void
+				{
+					ExpiredOnTicks.Add(TimerWheel.GetCurrentTick());
+				});
+		};
+	// Cover each level of the wheel.
+	const uint64 Delays[] = { 0, 1, 63, 64, 65, 4095, 4096, 300000 };
+	for (uint64 Delay : Delays)
+	{
+		Schedule(Delay);
+	}
+	(void)TestEqual(TEXT("NumTimers"), TimerWheel.GetNumTimers(), int32(UE_ARRAY_COUNT(Delays)));
+
+	(void)TestEqual(TEXT("NumRun"), TimerWheel.AdvanceTicks(300000), int32(UE_ARRAY_COUNT(Delays)));
+	const uint64 ExpectedExpiredOnTicks[] = { 1, 1, 63, 64, 65, 4095, 4096, 300000 };
+	if (TestEqual(
+			TEXT("NumExpired"), ExpiredOnTicks.Num(), int32(UE_ARRAY_COUNT(ExpectedExpiredOnTicks))))
+	{
+		for (int32 Index = 0; Index < ExpiredOnTicks.Num(); ++Index)
+		{
+			(void)TestEqual(
+				FString::Printf(TEXT("ExpiredOnTick%d"), Index), ExpiredOnTicks[Index],
+				ExpectedExpiredOnTicks[Index]);
+		}
+	}
+	(void)TestEqual(TEXT("NumTimersAfterExpiry"), TimerWheel.GetNumTimers(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTimerWheelTestAdvanceSeconds,
+	"AI.Assistant.TimerWheel.AdvanceSeconds",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTimerWheelTestAdvanceSeconds::RunTest(const FString& UnusedParameters)
+{
+	FTimerWheel TimerWheel(0.25);
+	int32 NumExpired = 0;
+	(void)TimerWheel.Schedule(1.0, [&NumExpired]() -> void { ++NumExpired; });
+
+	// Partial ticks accumulate.
+	for (int32 Index = 0; Index < 7; ++Index)
+	{
+		(void)TimerWheel.Advance(0.125);
+	}
+	(void)TestEqual(TEXT("PendingBeforeDelay"), NumExpired, 0);
+	(void)TimerWheel.Advance(0.125);
+	(void)TestEqual(TEXT("ExpiredAfterDelay"), NumExpired, 1);
+	(void)TestEqual(TEXT("CurrentTick"), TimerWheel.GetCurrentTick(), uint64(4));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTimerWheelTestCancel,
+	"AI.Assistant.TimerWheel.Cancel",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTimerWheelTestCancel::RunTest(const FString& UnusedParameters)
+{
+	FTimerWheel TimerWheel;
+	int32 NumExpired = 0;
+	const FTimerWheel::FTimerId TimerId =
+		TimerWheel.ScheduleTicks(100, [&NumExpired]() -> void { ++NumExpired; });
+	(void)TestTrue(TEXT("Cancel"), TimerWheel.Cancel(TimerId));
+	(void)TestFalse(TEXT("CancelAgain"), TimerWheel.Cancel(TimerId));
+	(void)TimerWheel.AdvanceTicks(200);
+	(void)TestEqual(TEXT("NumExpired"), NumExpired, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTimerWheelTestScheduleFromCallback,
+	"AI.Assistant.TimerWheel.ScheduleFromCallback",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTimerWheelTestScheduleFromCallback::RunTest(const FString& UnusedParameters)
+{
+	FTimerWheel TimerWheel;
+	FTimerWheel::FTimerId OtherTimerId = 0;
+	int32 NumExpired = 0;
+	(void)TimerWheel.ScheduleTicks(
+		1,
+		[&]() -> void
+		{
+			++NumExpired;
+			// Cancel a timer that expires on the same tick and schedule a new one.
+			(void)TimerWheel.Cancel(OtherTimerId);
+			(void)TimerWheel.ScheduleTicks(1, [&NumExpired]() -> void { ++NumExpired; });
+		});
+	OtherTimerId = TimerWheel.ScheduleTicks(1, [&NumExpired]() -> void { NumExpired += 100; });
+
+	(void)TimerWheel.AdvanceTicks(1);
+	(void)TestEqual(TEXT("NumExpiredFirstTick"), NumExpired, 1);
+	(void)TimerWheel.AdvanceTicks(1);
+	(void)TestEqual(TEXT("NumExpiredSecondTick"), NumExpired, 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantCancellationTokenTestCancel,
+	"AI.Assistant.CancellationToken.Cancel",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantCancellationTokenTestCancel::RunTest(const FString& UnusedParameters)
+{
+	FCancellationToken CancellationToken;
+	int32 NumCalled = 0;
+	(void)CancellationToken.OnCanceled([&NumCalled]() -> void { ++NumCalled; });
+	const FCancellationToken::FCallbackId RemovedCallbackId =
+		CancellationToken.OnCanceled([&NumCalled]() -> void { NumCalled += 100; });
+	CancellationToken.RemoveOnCanceled(RemovedCallbackId);
+
+	CancellationToken.Cancel();
+	CancellationToken.Cancel();
+	(void)TestTrue(TEXT("IsCanceled"), CancellationToken.IsCanceled());
+	(void)TestEqual(TEXT("NumCalled"), NumCalled, 1);
+
+	(void)TestEqual(
+		TEXT("CallbackIdAfterCancel"),
+		CancellationToken.OnCanceled([&NumCalled]() -> void { ++NumCalled; }),
+		FCancellationToken::FCallbackId(0));
+	(void)TestEqual(TEXT("CalledImmediately"), NumCalled, 2);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
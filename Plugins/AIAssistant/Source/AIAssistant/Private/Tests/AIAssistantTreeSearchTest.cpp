@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Utils/AIAssistantTreeSearch.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Complete tree where each node has TreeSearchTestNumChildren children, node N's children are
+// N * TreeSearchTestNumChildren + 1 onwards.
+static constexpr int32 TreeSearchTestNumChildren = 3;
+
+// Search a tree of NumNodes nodes recording the visited nodes.
+static ETreeSearchResult SearchTreeSearchTestTree(
+	int32 NumNodes, FTreeSearchBudget& Budget, TArray<int32>& OutVisited,
+	TFunction<ETreeSearchVisit(int32)> Visit = nullptr)
+{
+	return SearchTree(
+		0, Budget,
+		[NumNodes](int32 Node)
+		{
+			const int32 FirstChild = Node * TreeSearchTestNumChildren + 1;
+			return FMath::Clamp(NumNodes - FirstChild, 0, TreeSearchTestNumChildren);
+		},
+		[](int32 Node, int32 ChildIndex) { return Node * TreeSearchTestNumChildren + 1 + ChildIndex; },
+		[&OutVisited, &Visit](int32 Node)
+		{
+			OutVisited.Add(Node);
+			return Visit ? Visit(Node) : ETreeSearchVisit::Continue;
+		});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTreeSearchTestOrder,
+	"AI.Assistant.TreeSearch.Order",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTreeSearchTestOrder::RunTest(const FString& UnusedParameters)
+{
+	FTreeSearchBudget Budget;
+	TArray<int32> Visited;
+	(void)TestEqual(
+		TEXT("Completed"), SearchTreeSearchTestTree(8, Budget, Visited), ETreeSearchResult::Completed);
+	(void)TestTrue(TEXT("PreOrder"), Visited == TArray<int32>{ 0, 1, 4, 5, 6, 2, 7, 3 });
+	(void)TestEqual(TEXT("NumNodes"), Budget.GetNumNodes(), 8);
+	(void)TestFalse(TEXT("NotExhausted"), Budget.IsExhausted());
+
+	Visited.Reset();
+	(void)TestEqual(
+		TEXT("Skipped"),
+		SearchTreeSearchTestTree(
+			8, Budget, Visited,
+			[](int32 Node) { return Node == 1 ? ETreeSearchVisit::SkipChildren : ETreeSearchVisit::Continue; }),
+		ETreeSearchResult::Completed);
+	(void)TestTrue(TEXT("SkippedChildren"), Visited == TArray<int32>{ 0, 1, 2, 7, 3 });
+
+	Visited.Reset();
+	(void)TestEqual(
+		TEXT("Stopped"),
+		SearchTreeSearchTestTree(
+			8, Budget, Visited,
+			[](int32 Node) { return Node == 6 ? ETreeSearchVisit::Stop : ETreeSearchVisit::Continue; }),
+		ETreeSearchResult::Stopped);
+	(void)TestTrue(TEXT("StoppedAt"), Visited == TArray<int32>{ 0, 1, 4, 5, 6 });
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantTreeSearchTestBudget,
+	"AI.Assistant.TreeSearch.Budget",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantTreeSearchTestBudget::RunTest(const FString& UnusedParameters)
+{
+	FTreeSearchBudget Budget(/*InMaxNodes=*/10);
+	TArray<int32> Visited;
+	(void)TestEqual(
+		TEXT("Exhausted"), SearchTreeSearchTestTree(100000, Budget, Visited),
+		ETreeSearchResult::BudgetExhausted);
+	(void)TestEqual(TEXT("NumVisited"), Visited.Num(), 10);
+	(void)TestEqual(TEXT("NumNodes"), Budget.GetNumNodes(), 10);
+	(void)TestTrue(TEXT("IsExhausted"), Budget.IsExhausted());
+
+	// The budget is shared so later searches stop immediately.
+	Visited.Reset();
+	(void)TestEqual(
+		TEXT("StillExhausted"), SearchTreeSearchTestTree(2, Budget, Visited),
+		ETreeSearchResult::BudgetExhausted);
+	(void)TestEqual(TEXT("NoneVisited"), Visited.Num(), 0);
+
+	// A deep tree doesn't need a deep call stack.
+	FTreeSearchBudget Unlimited;
+	int32 NumVisited = 0;
+	(void)TestEqual(
+		TEXT("Deep"),
+		SearchTree(
+			0, Unlimited, [](int32 Node) { return Node < 100000 ? 1 : 0; },
+			[](int32 Node, int32) { return Node + 1; },
+			[&NumVisited](int32)
+			{
+				++NumVisited;
+				return ETreeSearchVisit::Continue;
+			}),
+		ETreeSearchResult::Completed);
+	(void)TestEqual(TEXT("DeepNumVisited"), NumVisited, 100001);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
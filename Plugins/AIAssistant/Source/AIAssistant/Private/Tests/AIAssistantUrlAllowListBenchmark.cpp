@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Internationalization/Regex.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Function.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Core/AIAssistantConfig.h"
+#include "Core/AIAssistantUrlAllowList.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Navigations, in order, while signing in to the assistant. Each navigation is checked and, as
+// redirects are checked again against the page that started them, the page is listed again
+// after each redirect.
+static const TCHAR* UrlAllowListBenchmarkNavigationTrace[] = {
+	TEXT("https://dev.epicgames.com/community/assistant/embedded"),
+	TEXT("https://dev.epicgames.com/community/api/user_identity/login?return_to=%2Fcommunity%2Fassistant%2Fembedded"),
+	TEXT("https://www.epicgames.com/id/login?redirectUrl=https%3A%2F%2Fdev.epicgames.com%2Fcommunity%2Fapi%2Fuser_identity%2Fcallback&client_id=0a1b2c3d4e5f"),
+	TEXT("https://www.epicgames.com/id/login/epic?lang=en-US&redirect_uri=https%3A%2F%2Fdev.epicgames.com%2Fcommunity%2Fapi%2Fuser_identity%2Fcallback"),
+	TEXT("https://newassets.hcaptcha.com/captcha/v1/a1b2c3d/static/hcaptcha.html#frame=checkbox&id=0f1e2d3c4b&host=www.epicgames.com"),
+	TEXT("data:text/html;charset=utf-8,%3Chtml%3E%3Cbody%3E%3C%2Fbody%3E%3C%2Fhtml%3E"),
+	TEXT("https://www.epicgames.com/id/api/redirect?clientId=0a1b2c3d4e5f&responseType=code"),
+	TEXT("https://www.epicgames.com/id/login?redirectUrl=https%3A%2F%2Fdev.epicgames.com%2Fcommunity%2Fapi%2Fuser_identity%2Fcallback&client_id=0a1b2c3d4e5f"),
+	TEXT("https://dev.epicgames.com/community/api/user_identity/callback?code=9f8e7d6c5b4a3928"),
+	TEXT("https://www.epicgames.com/id/login?redirectUrl=https%3A%2F%2Fdev.epicgames.com%2Fcommunity%2Fapi%2Fuser_identity%2Fcallback&client_id=0a1b2c3d4e5f"),
+	TEXT("https://dev.epicgames.com/community/assistant/embedded"),
+	TEXT("https://dev.epicgames.com/community/api/user_identity/login?return_to=%2Fcommunity%2Fassistant%2Fembedded"),
+	TEXT("https://dev.epicgames.com/documentation/en-us/unreal-engine/actors-in-unreal-engine"),
+	TEXT("https://dev.epicgames.com/community/assistant/embedded"),
+	TEXT("https://forums.unrealengine.com/t/collision-components/123456"),
+	TEXT("https://dev.epicgames.com/community/assistant/embedded"),
+};
+
+// Measure the time to check each URL in the navigation trace NumIterations times.
+static double RunUrlAllowListBenchmark(TFunctionRef<bool(const FString&)> IsAllowed, int32 NumIterations)
+{
+	TArray<FString> Urls;
+	for (const TCHAR* Url : UrlAllowListBenchmarkNavigationTrace)
+	{
+		Urls.Emplace(Url);
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const FString& Url : Urls)
+		{
+			(void)IsAllowed(Url);
+		}
+	}
+	return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e9 /
+		double(NumIterations * Urls.Num());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantUrlAllowListBenchmarkNavigationTrace,
+	"AI.Assistant.UrlAllowList.Benchmark.NavigationTrace",
+	AIAssistantTest::BenchmarkFlags);
+
+bool FAIAssistantUrlAllowListBenchmarkNavigationTrace::RunTest(const FString& UnusedParameters)
+{
+	static constexpr int32 NumIterations = 1000;
+	const FAIAssistantConfig Config = FAIAssistantConfig::Load(FString());
+	const TArray<FRegexPattern> RegexPatterns = Config.GetAllowedUrlRegexPatterns();
+	FUrlAllowList AllowList(Config.GetAllAllowedUrlRegexes());
+	FUrlAllowList UncachedAllowList(Config.GetAllAllowedUrlRegexes(), /*CacheCapacity=*/1);
+
+	// SAIAssistantWebBrowser::CanLoadUrl() before the allow-list was compiled.
+	auto IsAllowedByRegexPatterns = [&RegexPatterns](const FString& Url) -> bool
+	{
+		for (const FRegexPattern& Pattern : RegexPatterns)
+		{
+			if (FRegexMatcher(Pattern, Url).FindNext())
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	bool bSameDecisions = true;
+	for (const TCHAR* Url : UrlAllowListBenchmarkNavigationTrace)
+	{
+		bSameDecisions &= TestEqual(Url, AllowList.IsAllowed(Url), IsAllowedByRegexPatterns(Url));
+	}
+	if (!bSameDecisions)
+	{
+		return false;
+	}
+
+	const double RegexNanoseconds = RunUrlAllowListBenchmark(IsAllowedByRegexPatterns, NumIterations);
+	const double UncachedNanoseconds = RunUrlAllowListBenchmark(
+		[&UncachedAllowList](const FString& Url) -> bool { return UncachedAllowList.IsAllowed(Url); },
+		NumIterations);
+	const double AllowListNanoseconds = RunUrlAllowListBenchmark(
+		[&AllowList](const FString& Url) -> bool { return AllowList.IsAllowed(Url); },
+		NumIterations);
+
+	AddInfo(FString::Printf(TEXT("Regex per pattern: %.1f ns/url"), RegexNanoseconds));
+	AddInfo(FString::Printf(
+		TEXT("Allow-list (%d literal, %d regex patterns) without cache: %.1f ns/url"),
+		UncachedAllowList.GetNumLiteralPatterns(), UncachedAllowList.GetNumRegexPatterns(),
+		UncachedNanoseconds));
+	AddInfo(FString::Printf(TEXT("Allow-list: %.1f ns/url"), AllowListNanoseconds));
+	return TestTrue(TEXT("Faster"), AllowListNanoseconds < RegexNanoseconds);
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Internationalization/Regex.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Core/AIAssistantUrlAllowList.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantUrlAllowListTestParseLiteralPattern,
+	"AI.Assistant.UrlAllowList.ParseLiteralPattern",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantUrlAllowListTestParseLiteralPattern::RunTest(const FString& UnusedParameters)
+{
+	struct FTestCase
+	{
+		const TCHAR* Regex;
+		const TCHAR* ExpectedLiteral;  // nullptr if the regex isn't a literal pattern.
+		bool bExpectedIsPrefix;
+	};
+	const FTestCase TestCases[] = {
+		{ TEXT(R"regex(^data:.*)regex"), TEXT("data:"), true },
+		{ TEXT(R"regex(^https://www\.epicgames\.com/id/.*)regex"), TEXT("https://www.epicgames.com/id/"), true },
+		{ TEXT(R"regex(^https://a\.com/b$)regex"), TEXT("https://a.com/b"), false },
+		{ TEXT(R"regex(^https://a\.com/)regex"), TEXT("https://a.com/"), true },
+		{ TEXT(R"regex(^https://a\.com/.*$)regex"), TEXT("https://a.com/"), true },
+		{ TEXT(R"regex(https://a\.com/)regex"), nullptr, false },
+		{ TEXT(R"regex(^https?://a\.com/)regex"), nullptr, false },
+		{ TEXT(R"regex(^https://a\.com/\d+)regex"), nullptr, false },
+		{ TEXT(R"regex(^https://(a|b)\.com/)regex"), nullptr, false },
+		{ TEXT(R"regex(^https://a.com/)regex"), nullptr, false },
+		{ TEXT(R"regex(^https://a\.com/\)regex"), nullptr, false },
+	};
+	for (const FTestCase& TestCase : TestCases)
+	{
+		const TOptional<TTuple<FString, bool>> Literal =
+			FUrlAllowList::ParseLiteralPattern(TestCase.Regex);
+		if (!TestEqual(TestCase.Regex, Literal.IsSet(), TestCase.ExpectedLiteral != nullptr) ||
+			!Literal.IsSet())
+		{
+			continue;
+		}
+		(void)TestEqual(TestCase.Regex, Literal->Get<0>(), FString(TestCase.ExpectedLiteral));
+		(void)TestEqual(TestCase.Regex, Literal->Get<1>(), TestCase.bExpectedIsPrefix);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantUrlAllowListTestMatchesRegex,
+	"AI.Assistant.UrlAllowList.MatchesRegex",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantUrlAllowListTestMatchesRegex::RunTest(const FString& UnusedParameters)
+{
+	const TArray<FString> Regexes = {
+		TEXT(R"regex(^https://dev\.epicgames\.com/community/assistant/embedded$)regex"),
+		TEXT(R"regex(^data:.*)regex"),
+		TEXT(R"regex(^https://www\.epicgames\.com/id/.*)regex"),
+		TEXT(R"regex(^https://www\.epicgames\.com/idp$)regex"),
+		TEXT(R"regex(^https://[a-z]+\.example\.com/)regex"),
+		TEXT(R"regex(/callback\?code=)regex"),
+	};
+	const TCHAR* Urls[] = {
+		TEXT("https://dev.epicgames.com/community/assistant/embedded"),
+		TEXT("https://dev.epicgames.com/community/assistant/embedded?x=1"),
+		TEXT("https://dev.epicgames.com/community/assistant"),
+		TEXT("data:text/html,hello"),
+		TEXT("https://www.epicgames.com/id/login?redirectUrl=x"),
+		TEXT("https://www.epicgames.com/id"),
+		TEXT("https://www.epicgames.com/idp"),
+		TEXT("https://www.epicgames.com/idp/x"),
+		TEXT("https://sso.example.com/authorize"),
+		TEXT("https://SSO.example.com/authorize"),
+		TEXT("https://other.com/callback?code=123"),
+		TEXT("https://other.com/"),
+		TEXT(""),
+	};
+
+	FUrlAllowList AllowList(Regexes, /*CacheCapacity=*/2);
+	(void)TestEqual(TEXT("NumLiteralPatterns"), AllowList.GetNumLiteralPatterns(), 4);
+	(void)TestEqual(TEXT("NumRegexPatterns"), AllowList.GetNumRegexPatterns(), 2);
+
+	// Check twice so that decisions are also read from the cache.
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		for (const TCHAR* Url : Urls)
+		{
+			bool bExpected = false;
+			for (const FString& Regex : Regexes)
+			{
+				bExpected |= FRegexMatcher(FRegexPattern(Regex), Url).FindNext();
+			}
+			(void)TestEqual(Url, AllowList.IsAllowed(Url), bExpected);
+		}
+	}
+
+	FUrlAllowList Empty(TArray<FString>{});
+	(void)TestFalse(TEXT("Empty"), Empty.IsAllowed(TEXT("https://www.epicgames.com/")));
+	FUrlAllowList Everything(TArray<FString>{ TEXT("^") });
+	(void)TestTrue(TEXT("Everything"), Everything.IsAllowed(TEXT("https://www.epicgames.com/")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantUrlAllowListTestUpdate,
+	"AI.Assistant.UrlAllowList.Update",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantUrlAllowListTestUpdate::RunTest(const FString& UnusedParameters)
+{
+	FUrlAllowList AllowList(TArray<FString>{
+		TEXT(R"regex(^https://a\.com/)regex"), TEXT(R"regex(^https://[a-z]+\.b\.com/)regex") });
+	(void)TestTrue(TEXT("AllowedBefore"), AllowList.IsAllowed(TEXT("https://a.com/x")));
+
+	// Only the new regular expression is compiled, the trie is rebuilt and the cache is cleared.
+	(void)TestEqual(
+		TEXT("NumCompiled"),
+		AllowList.Update(TArray<FString>{
+			TEXT(R"regex(^https://c\.com/)regex"), TEXT(R"regex(^https://[a-z]+\.b\.com/)regex"),
+			TEXT(R"regex(^https://[a-z]+\.d\.com/)regex") }),
+		1);
+	(void)TestEqual(TEXT("NumLiteralPatterns"), AllowList.GetNumLiteralPatterns(), 1);
+	(void)TestEqual(TEXT("NumRegexPatterns"), AllowList.GetNumRegexPatterns(), 2);
+	(void)TestFalse(TEXT("RemovedLiteral"), AllowList.IsAllowed(TEXT("https://a.com/x")));
+	(void)TestTrue(TEXT("AddedLiteral"), AllowList.IsAllowed(TEXT("https://c.com/x")));
+	(void)TestTrue(TEXT("KeptRegex"), AllowList.IsAllowed(TEXT("https://x.b.com/")));
+	(void)TestTrue(TEXT("AddedRegex"), AllowList.IsAllowed(TEXT("https://x.d.com/")));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Future.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Tuple.h"
+#include "Templates/ValueOrError.h"
+
+#include "WebAPI/AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	class FWebApiAccessor
+	{
+	public:
+		static FString FormatFunctionCall(
+			FWebApi& WebApi, const TCHAR* FunctionName, const TCHAR* Arguments = TEXT(""),
+			const FWebApi::FHandlerId& HandlerId = FWebApi::FHandlerId())
+		{
+			return WebApi.FormatFunctionCall(FunctionName, Arguments, HandlerId);
+		}
+
+		// Format JavaScript for result and error handler function calls.
+		static TPair<FString, FString> FormatResultAndErrorHandlers(
+			const FWebApi::FHandlerId& HandlerId)
+		{
+			TPair<FString, FString> Handlers;
+			UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+				Handlers.Key, HandlerId, TEXT("result"), false);
+			UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+				Handlers.Value, HandlerId, TEXT("error"), true);
+			return Handlers;
+		}
+		
+		static UAIAssistantWebJavaScriptResultDelegate& GetJavaScriptResultDelegate(
+			FWebApi& WebApi)
+		{
+			return *WebApi.WebJavaScriptResultDelegate;
+		}
+
+		static TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult> ExecuteFunction(
+			FWebApi& WebApi, const TCHAR* FunctionName, const FWebApiCallOptions& CallOptions)
+		{
+			return WebApi.ExecuteFunction(FunctionName, TEXT(""), CallOptions);
+		}
+
+		static FTimerWheel& GetTimerWheel(FWebApi& WebApi)
+		{
+			return *WebApi.TimerWheel;
+		}
+
+		template<typename JsonSerializableReturnType>
+		static TValueOrError<JsonSerializableReturnType, FString> ParseJsonIfNotVoid(
+			const FString& Json)
+		{
+			return FWebApi::ParseJsonIfNotVoid<JsonSerializableReturnType>(Json);
+		}
+	};
+}
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "Utils/AIAssistantJsonStringWriter.h"
+#include "WebAPI/AIAssistantWebApi.h"
+#include "WebAPI/AIAssistantWebApiArguments.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Create a message that exercises string escaping and variant serialization.
+static FAddMessageToConversationOptions CreateWebApiArgumentsTestMessage()
+{
+	FTextMessageContent TextContent;
+	TextContent.Text = TEXT("Line \"one\"\n\tLine two \\ {braces} é中");
+	FMessageContent MessageContent;
+	MessageContent.ContentType = EMessageContentType::Text;
+	MessageContent.Content.Set<FTextMessageContent>(TextContent);
+	MessageContent.bVisibleToUser = false;
+	FAddMessageToConversationOptions Options;
+	Options.ConversationId.Emplace();
+	Options.ConversationId->Id = TEXT("conversation");
+	Options.Message.MessageRole = EMessageRole::User;
+	Options.Message.MessageContent.Add(MessageContent);
+	return Options;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiArgumentsTestJson,
+	"AI.Assistant.WebApi.Arguments.Json",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiArgumentsTestJson::RunTest(const FString& UnusedParameters)
+{
+	const FAddMessageToConversationOptions Options = CreateWebApiArgumentsTestMessage();
+	const FString Expected = Options.ToJson(false);
+	const FWebApiArguments Arguments(Options);
+	(void)TestEqual(TEXT("Len"), Arguments.Len(), Expected.Len());
+	(void)TestEqual(TEXT("GetJsonLength"), GetJsonLength(Options), Expected.Len());
+	(void)TestEqual(TEXT("ToString"), Arguments.ToString(), Expected);
+
+	FString Output(TEXT("prefix("));
+	Arguments.AppendTo(Output);
+	(void)TestEqual(TEXT("AppendTo"), Output, FString(TEXT("prefix(")) + Expected);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiArgumentsTestText,
+	"AI.Assistant.WebApi.Arguments.Text",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiArgumentsTestText::RunTest(const FString& UnusedParameters)
+{
+	const FWebApiArguments Empty;
+	(void)TestEqual(TEXT("EmptyLen"), Empty.Len(), 0);
+	(void)TestEqual(TEXT("EmptyToString"), Empty.ToString(), TEXT(""));
+
+	const FWebApiArguments Arguments(TEXT("1, \"two\""));
+	(void)TestEqual(TEXT("Len"), Arguments.Len(), 9);
+	(void)TestEqual(TEXT("ToString"), Arguments.ToString(), TEXT("1, \"two\""));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
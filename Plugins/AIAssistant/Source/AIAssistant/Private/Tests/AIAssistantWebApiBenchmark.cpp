@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Function.h"
+
+#include "AIAssistantAllocationCounter.h"
+#include "AIAssistantFakeWebApi.h"
+#include "AIAssistantTestFlags.h"
+#include "AIAssistantWebApiAccessor.h"
+#include "WebAPI/AIAssistantWebApi.h"
+#include "WebAPI/AIAssistantWebJavaScriptResultDelegate.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Cost of formatting a script.
+struct FWebApiFormatBenchmarkResult
+{
+	double NanosecondsPerCall = 0.0;
+	double AllocationsPerCall = 0.0;
+};
+
+// FWebApi::FormatFunctionCall() implemented with FString::Format(), as it was before the call
+// template was parsed once on startup.
+static FString FormatWebApiFunctionCallWithStringFormat(
+	const TCHAR* FunctionName, const TCHAR* Arguments, const FWebApi::FHandlerId& HandlerId)
+{
+	static const FString FunctionCallFormatTemplate = TEXT(R"js(
+try {
+  Promise.resolve({WebApiObjectName}.{FunctionName}({Arguments})).then(
+    (result) => {
+      {NotifyHandlerOfResult}
+    },
+    (error) => {
+      {NotifyHandlerOfError}
+    });
+} catch (error) {
+  {NotifyHandlerOfError}
+}
+)js");
+	const FString HandlerFormat = FString::Printf(
+		TEXT(R"js(window.ue.%s.handleresult(%d, %d, JSON.stringify({0}), {1});)js"),
+		*UAIAssistantWebJavaScriptResultDelegate::Name, HandlerId.Index, HandlerId.Generation);
+	const FString NotifyHandlerOfResult =
+		FString::Format(*HandlerFormat, { TEXT("result"), TEXT("false") });
+	const FString NotifyHandlerOfError =
+		FString::Format(*HandlerFormat, { TEXT("error"), TEXT("true") });
+	return FString::Format(
+		*FunctionCallFormatTemplate,
+		{
+			{ TEXT("WebApiObjectName"), TEXT("window.eda") },
+			{ TEXT("FunctionName"), FunctionName },
+			{ TEXT("Arguments"), Arguments },
+			{ TEXT("NotifyHandlerOfResult"), NotifyHandlerOfResult },
+			{ TEXT("NotifyHandlerOfError"), NotifyHandlerOfError },
+		});
+}
+
+// Measure the time and number of allocations to format a script NumIterations times.
+static FWebApiFormatBenchmarkResult RunWebApiFormatBenchmark(
+	TFunctionRef<FString()> Format, int32 NumIterations)
+{
+	// Warm up any lazily initialized state.
+	(void)Format();
+
+	FWebApiFormatBenchmarkResult Result;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		(void)Format();
+	}
+	Result.NanosecondsPerCall =
+		FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e9 /
+		double(NumIterations);
+
+	// Allocations are counted separately so the counter doesn't affect timing.
+	FScopedAllocationCounter AllocationCounter;
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		(void)Format();
+	}
+	Result.AllocationsPerCall =
+		double(AllocationCounter.GetNumAllocations()) / double(NumIterations);
+	return Result;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiBenchmarkFormatFunctionCall,
+	"AI.Assistant.WebApi.Benchmark.FormatFunctionCall",
+	AIAssistantTest::BenchmarkFlags);
+
+bool FAIAssistantWebApiBenchmarkFormatFunctionCall::RunTest(const FString& UnusedParameters)
+{
+	static constexpr int32 NumIterations = 10000;
+	FFakeWebApi WebApi;
+	const FWebApi::FHandlerId HandlerId{ 42, 7 };
+	const TCHAR* FunctionName = TEXT("addMessageToConversation");
+	const TCHAR* Arguments = TEXT(
+		R"json({"message":{"messageRole":"user","messageContent":[{"contentType":"text",)json"
+		R"json("content":{"text":"How do I add a collision component to an actor?"},)json"
+		R"json("visibleToUser":true}]}})json");
+
+	const FString Expected = FormatWebApiFunctionCallWithStringFormat(FunctionName, Arguments, HandlerId);
+	if (!TestEqual(
+			TEXT("SameScript"),
+			FWebApiAccessor::FormatFunctionCall(*WebApi, FunctionName, Arguments, HandlerId),
+			Expected))
+	{
+		return false;
+	}
+
+	const FWebApiFormatBenchmarkResult Before = RunWebApiFormatBenchmark(
+		[&]() -> FString
+		{
+			return FormatWebApiFunctionCallWithStringFormat(FunctionName, Arguments, HandlerId);
+		},
+		NumIterations);
+	const FWebApiFormatBenchmarkResult After = RunWebApiFormatBenchmark(
+		[&]() -> FString
+		{
+			return FWebApiAccessor::FormatFunctionCall(*WebApi, FunctionName, Arguments, HandlerId);
+		},
+		NumIterations);
+
+	AddInfo(FString::Printf(
+		TEXT("FString::Format: %.1f ns/call, %.2f allocations/call"),
+		Before.NanosecondsPerCall, Before.AllocationsPerCall));
+	AddInfo(FString::Printf(
+		TEXT("Call template: %.1f ns/call, %.2f allocations/call"),
+		After.NanosecondsPerCall, After.AllocationsPerCall));
+	return TestTrue(
+		TEXT("FewerAllocations"), After.AllocationsPerCall < Before.AllocationsPerCall);
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "WebAPI/AIAssistantWebApiCallTemplate.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Render a template replacing each slot with "<SlotIndex>".
+static FString RenderCallTemplateWithSlotIndices(const FWebApiCallTemplate& CallTemplate)
+{
+	FString Output;
+	CallTemplate.Render(
+		Output,
+		[](FString& SlotOutput, int32 SlotIndex) -> void
+		{
+			SlotOutput.Appendf(TEXT("<%d>"), SlotIndex);
+		});
+	return Output;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiCallTemplateTestRenderSlots,
+	"AI.Assistant.WebApi.CallTemplate.RenderSlots",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiCallTemplateTestRenderSlots::RunTest(const FString& UnusedParameters)
+{
+	const FWebApiCallTemplate CallTemplate(
+		TEXT("{Object}.{Function}({Args}); {Function}"),
+		{ TEXT("Object"), TEXT("Function"), TEXT("Args") });
+	(void)TestEqual(
+		TEXT("Rendered"), RenderCallTemplateWithSlotIndices(CallTemplate),
+		TEXT("<0>.<1>(<2>); <1>"));
+	(void)TestEqual(TEXT("LiteralLength"), CallTemplate.GetLiteralLength(), 5);
+	(void)TestEqual(TEXT("ObjectCount"), CallTemplate.GetSlotCount(0), 1);
+	(void)TestEqual(TEXT("FunctionCount"), CallTemplate.GetSlotCount(1), 2);
+	(void)TestEqual(TEXT("ArgsCount"), CallTemplate.GetSlotCount(2), 1);
+	(void)TestEqual(TEXT("InvalidCount"), CallTemplate.GetSlotCount(3), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiCallTemplateTestUnknownSlotsAreLiterals,
+	"AI.Assistant.WebApi.CallTemplate.UnknownSlotsAreLiterals",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiCallTemplateTestUnknownSlotsAreLiterals::RunTest(
+	const FString& UnusedParameters)
+{
+	const FWebApiCallTemplate CallTemplate(
+		TEXT("if (x) { {Value} } {Other} {"), { TEXT("Value") });
+	(void)TestEqual(
+		TEXT("Rendered"), RenderCallTemplateWithSlotIndices(CallTemplate),
+		TEXT("if (x) { <0> } {Other} {"));
+	// Literals either side of the slot.
+	(void)TestEqual(TEXT("NumSegments"), CallTemplate.GetNumSegments(), 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiCallTemplateTestAppendsToOutput,
+	"AI.Assistant.WebApi.CallTemplate.AppendsToOutput",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiCallTemplateTestAppendsToOutput::RunTest(const FString& UnusedParameters)
+{
+	const FWebApiCallTemplate CallTemplate(TEXT("b{Slot}"), { TEXT("Slot") });
+	FString Output(TEXT("a"));
+	CallTemplate.Render(
+		Output,
+		[](FString& SlotOutput, int32 UnusedSlotIndex) -> void
+		{
+			SlotOutput.AppendChar(TEXT('c'));
+		});
+	return TestEqual(TEXT("Rendered"), Output, TEXT("abc"));
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Async/Future.h"
+#include "Containers/Array.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/ValueOrError.h"
+
+#include "AIAssistantFakeWebApiBackend.h"
+#include "AIAssistantTestFlags.h"
+#include "WebAPI/AIAssistantWebApi.h"
+#include "WebAPI/AIAssistantWebJavaScriptResultDelegate.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiSoakTestCallsAndStreams,
+	"AI.Assistant.WebApi.Benchmark.SoakCallsAndStreams",
+	AIAssistantTest::BenchmarkFlags);
+
+bool FAIAssistantWebApiSoakTestCallsAndStreams::RunTest(const FString& UnusedParameters)
+{
+	static constexpr int32 NumRounds = 100;
+	static constexpr int32 NumCallsPerRound = 100;
+	static constexpr int32 NumStreamsPerRound = 4;
+
+	const int32 InitialNumOutstandingHandlers =
+		UAIAssistantWebJavaScriptResultDelegate::GetNumOutstandingResultHandlers();
+	FWebApiWithFakeBackend WebApi(/* RandomSeed= */ 1234);
+	FFakeWebApiBackend::FFunctionBehavior CallBehavior;
+	CallBehavior.LatencySeconds = 0.005;
+	CallBehavior.LatencyJitterSeconds = 0.05;
+	CallBehavior.ErrorProbability = 0.1f;
+	WebApi.Backend.SetDefaultBehavior(CallBehavior);
+	FFakeWebApiBackend::FFunctionBehavior StreamBehavior = CallBehavior;
+	StreamBehavior.NumChunks = 50;
+	StreamBehavior.ChunkIntervalSeconds = 0.002;
+	WebApi.Backend.SetFunctionBehavior(TEXT("addMessageToConversation"), StreamBehavior);
+
+	uint64 NumCallErrors = 0;
+	uint64 NumChunksReceived = 0;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		TArray<TFuture<TValueOrError<void, FString>>> Results;
+		Results.Reserve(NumCallsPerRound);
+		for (int32 Call = 0; Call < NumCallsPerRound; ++Call)
+		{
+			Results.Add(WebApi.WebApi.CreateConversation());
+		}
+		TArray<TSharedRef<FWebApiStream>> Streams;
+		for (int32 StreamIndex = 0; StreamIndex < NumStreamsPerRound; ++StreamIndex)
+		{
+			TSharedRef<FWebApiStream> Stream = WebApi.WebApi.AddMessageToConversationWithStream(
+				FAddMessageToConversationOptions());
+			// Consume chunks as they arrive.
+			Stream->SetOnChunkAvailable(
+				[&NumChunksReceived](FWebApiStream& AvailableStream) -> void
+				{
+					FString Chunk;
+					while (AvailableStream.TryDequeueChunk(Chunk))
+					{
+						++NumChunksReceived;
+					}
+				});
+			Streams.Add(Stream);
+		}
+
+		if (!TestTrue(
+				FString::Printf(TEXT("Round%dIdle"), Round), WebApi.Backend.RunUntilIdle()))
+		{
+			return false;
+		}
+		for (const TFuture<TValueOrError<void, FString>>& Result : Results)
+		{
+			if (!TestTrue(FString::Printf(TEXT("Round%dComplete"), Round), Result.IsReady()))
+			{
+				return false;
+			}
+			NumCallErrors += Result.Get().HasError() ? 1 : 0;
+		}
+		for (const TSharedRef<FWebApiStream>& Stream : Streams)
+		{
+			(void)TestTrue(FString::Printf(TEXT("Round%dStreamComplete"), Round), Stream->IsComplete());
+		}
+	}
+	const double ElapsedSeconds =
+		FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	const FFakeWebApiBackend::FStats Stats = WebApi.Backend.GetStats();
+	const uint64 NumCalls = uint64(NumRounds) * (NumCallsPerRound + NumStreamsPerRound);
+	(void)TestEqual(TEXT("NumCalls"), Stats.NumCalls, NumCalls);
+	(void)TestEqual(TEXT("NumChunksReceived"), NumChunksReceived, Stats.NumChunks);
+	(void)TestTrue(TEXT("CallErrorsReported"), NumCallErrors <= Stats.NumErrors);
+	(void)TestEqual(TEXT("NumUndeliverable"), Stats.NumUndeliverable, uint64(0));
+	(void)TestEqual(
+		TEXT("NoLeakedHandlers"),
+		UAIAssistantWebJavaScriptResultDelegate::GetNumOutstandingResultHandlers(),
+		InitialNumOutstandingHandlers);
+
+	AddInfo(FString::Printf(
+		TEXT("%llu calls, %llu chunks, %llu errors in %.3f s (%.0f calls/s)"),
+		Stats.NumCalls, Stats.NumChunks, Stats.NumErrors, ElapsedSeconds,
+		double(Stats.NumCalls) / ElapsedSeconds));
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
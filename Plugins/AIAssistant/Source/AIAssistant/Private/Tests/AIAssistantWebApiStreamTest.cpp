@@ -0,0 +1,304 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/SharedPointer.h"
+
+#include "AIAssistantFakeWebApi.h"
+#include "AIAssistantTestFlags.h"
+#include "AIAssistantWebApiAccessor.h"
+#include "AIAssistantWebJavaScriptResultDelegateAccessor.h"
+#include "WebAPI/AIAssistantWebApi.h"
+#include "WebAPI/AIAssistantWebApiStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+// Send a chunk or completion result to a stream's handler.
+static void CallStreamHandler(
+	FFakeWebApi& WebApi, const FWebApiStream::FHandlerId& HandlerId, const TCHAR* Json,
+	bool bIsError = false)
+{
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi), HandlerId, Json, bIsError);
+}
+
+// Create a stream for a test message executing scripts immediately.
+static TSharedRef<FWebApiStream> CreateTestStream(
+	FFakeWebApi& WebApi, const FWebApiStreamOptions& StreamOptions = FWebApiStreamOptions())
+{
+	WebApi->SetFlushPolicyOverride(FWebApi::EFlushPolicy::Immediate);
+	FAddMessageToConversationOptions Options;
+	Options.Message.MessageRole = EMessageRole::User;
+	return WebApi->AddMessageToConversationWithStream(Options, StreamOptions);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestExecute,
+	"AI.Assistant.WebApi.Stream.Execute",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestExecute::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi);
+	if (!TestEqual(
+			TEXT("NumberOfScripts"), WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 1))
+	{
+		return false;
+	}
+	const FString& Script = WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText[0];
+	(void)TestTrue(
+		TEXT("PassesStream"),
+		Script.Contains(TEXT("window.eda.addMessageToConversation({")) &&
+		Script.Contains(TEXT("}, stream))")));
+	(void)TestTrue(
+		TEXT("RegistersStream"),
+		Script.Contains(FString::Printf(TEXT("streams[\"%s\"] = stream;"), *Stream->GetStreamKey())));
+	(void)TestTrue(
+		TEXT("ChunkHandler"),
+		Script.Contains(FString::Printf(
+			TEXT("handleresult(%d, %d, JSON.stringify(chunk), false);"),
+			Stream->GetChunkHandlerId().Index, Stream->GetChunkHandlerId().Generation)));
+	(void)TestEqual(
+		TEXT("RegisteredHandlers"),
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi).GetNumRegisteredHandlers(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestReceiveChunks,
+	"AI.Assistant.WebApi.Stream.ReceiveChunks",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestReceiveChunks::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi);
+	auto Completion = Stream->GetCompletionFuture();
+	int32 NumChunksAvailable = 0;
+	Stream->SetOnChunkAvailable(
+		[&NumChunksAvailable](FWebApiStream& UnusedStream) -> void { ++NumChunksAvailable; });
+
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT(R"json("Hello")json"));
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT(R"json(" world")json"));
+	(void)TestEqual(TEXT("NumChunksAvailable"), NumChunksAvailable, 2);
+	(void)TestEqual(TEXT("NumBufferedChunks"), Stream->GetNumBufferedChunks(), 2);
+	(void)TestFalse(TEXT("NotComplete"), Completion.IsReady());
+
+	CallStreamHandler(WebApi, Stream->GetCompletionHandlerId(), TEXT(""));
+	(void)TestTrue(TEXT("Complete"), Completion.IsReady() && Stream->IsComplete());
+	(void)TestFalse(TEXT("CompleteWithoutError"), Completion.Get().HasError());
+	(void)TestEqual(
+		TEXT("HandlersUnregistered"),
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi).GetNumRegisteredHandlers(), 0);
+
+	// Buffered chunks are still available after completion.
+	FString Chunk;
+	(void)TestTrue(TEXT("DequeueFirst"), Stream->TryDequeueChunk(Chunk));
+	(void)TestEqual(TEXT("FirstChunk"), Chunk, TEXT(R"json("Hello")json"));
+	(void)TestTrue(TEXT("DequeueSecond"), Stream->TryDequeueChunk(Chunk));
+	(void)TestEqual(TEXT("SecondChunk"), Chunk, TEXT(R"json(" world")json"));
+	(void)TestFalse(TEXT("DequeueEmpty"), Stream->TryDequeueChunk(Chunk));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestError,
+	"AI.Assistant.WebApi.Stream.Error",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestError::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi);
+	auto Completion = Stream->GetCompletionFuture();
+	CallStreamHandler(
+		WebApi, Stream->GetCompletionHandlerId(), TEXT(R"json("failed")json"), true);
+	if (!TestTrue(TEXT("Complete"), Completion.IsReady()))
+	{
+		return false;
+	}
+	const auto& Result = Completion.Get();
+	(void)TestTrue(TEXT("HasError"), Result.HasError());
+	(void)TestEqual(TEXT("Error"), Result.GetError(), TEXT(R"json("failed")json"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestBackpressure,
+	"AI.Assistant.WebApi.Stream.Backpressure",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestBackpressure::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	FWebApiStreamOptions StreamOptions;
+	StreamOptions.Capacity = 4;
+	StreamOptions.PauseThreshold = 3;
+	StreamOptions.ResumeThreshold = 1;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi, StreamOptions);
+	const TArray<FString>& Scripts = WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText;
+	const FString PauseScript = FString::Printf(
+		TEXT("window.aiassistantstreams?.[\"%s\"]?.setPaused(true);\n"), *Stream->GetStreamKey());
+	const FString ResumeScript = FString::Printf(
+		TEXT("window.aiassistantstreams?.[\"%s\"]?.setPaused(false);\n"), *Stream->GetStreamKey());
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	}
+	(void)TestFalse(TEXT("NotPausedBelowThreshold"), Stream->IsPaused());
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	(void)TestTrue(TEXT("PausedAtThreshold"), Stream->IsPaused());
+	(void)TestEqual(TEXT("PauseSent"), Scripts.Last(), PauseScript);
+
+	FString Chunk;
+	(void)Stream->TryDequeueChunk(Chunk);
+	(void)TestTrue(TEXT("PausedAboveResumeThreshold"), Stream->IsPaused());
+	(void)Stream->TryDequeueChunk(Chunk);
+	(void)TestFalse(TEXT("ResumedAtThreshold"), Stream->IsPaused());
+	(void)TestEqual(TEXT("ResumeSent"), Scripts.Last(), ResumeScript);
+
+	const FWebApiStream::FStats Stats = Stream->GetStats();
+	(void)TestEqual(TEXT("NumChunksReceived"), Stats.NumChunksReceived, uint64(3));
+	(void)TestEqual(TEXT("MaxBufferedChunks"), Stats.MaxBufferedChunks, 3);
+	(void)TestEqual(TEXT("NumPauses"), Stats.NumPauses, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestResumeFromWorkerThread,
+	"AI.Assistant.WebApi.Stream.ResumeFromWorkerThread",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestResumeFromWorkerThread::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	FWebApiStreamOptions StreamOptions;
+	StreamOptions.Capacity = 4;
+	StreamOptions.PauseThreshold = 2;
+	StreamOptions.ResumeThreshold = 1;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi, StreamOptions);
+	const TArray<FString>& Scripts = WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText;
+	const FString ResumeScript = FString::Printf(
+		TEXT("window.aiassistantstreams?.[\"%s\"]?.setPaused(false);\n"), *Stream->GetStreamKey());
+
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	(void)TestTrue(TEXT("Paused"), Stream->IsPaused());
+	const int32 NumScriptsBeforeDequeue = Scripts.Num();
+
+	// Dequeuing on a worker thread must not execute JavaScript on that thread.
+	const bool bDequeued = Async(
+		EAsyncExecution::Thread,
+		[Stream]() -> bool
+		{
+			FString Chunk;
+			return Stream->TryDequeueChunk(Chunk);
+		}).Get();
+	(void)TestTrue(TEXT("Dequeued"), bDequeued);
+	(void)TestFalse(TEXT("ResumedAtThreshold"), Stream->IsPaused());
+	(void)TestEqual(TEXT("ResumeDeferred"), Scripts.Num(), NumScriptsBeforeDequeue);
+
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	if (!TestEqual(TEXT("ResumeSent"), Scripts.Num(), NumScriptsBeforeDequeue + 1))
+	{
+		return false;
+	}
+	(void)TestEqual(TEXT("ResumeScript"), Scripts.Last(), ResumeScript);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestOverflow,
+	"AI.Assistant.WebApi.Stream.Overflow",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestOverflow::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	FWebApiStreamOptions StreamOptions;
+	StreamOptions.Capacity = 2;
+	StreamOptions.PauseThreshold = 2;
+	StreamOptions.ResumeThreshold = 0;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi, StreamOptions);
+	auto Completion = Stream->GetCompletionFuture();
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	}
+	if (!TestTrue(TEXT("Complete"), Completion.IsReady()))
+	{
+		return false;
+	}
+	(void)TestEqual(TEXT("Error"), Completion.Get().GetError(), FWebApiStream::OverflowError);
+	(void)TestEqual(TEXT("NumBufferedChunks"), Stream->GetNumBufferedChunks(), 2);
+	(void)TestTrue(
+		TEXT("CancelSent"),
+		WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Last().Contains(TEXT("cancel()")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestCancel,
+	"AI.Assistant.WebApi.Stream.Cancel",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestCancel::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	TSharedRef<FWebApiStream> Stream = CreateTestStream(WebApi);
+	auto Completion = Stream->GetCompletionFuture();
+	Stream->Cancel();
+	if (!TestTrue(TEXT("Complete"), Completion.IsReady()))
+	{
+		return false;
+	}
+	(void)TestEqual(
+		TEXT("Error"), Completion.Get().GetError(),
+		UAIAssistantWebJavaScriptResultDelegate::CanceledError);
+	(void)TestEqual(
+		TEXT("CancelSent"),
+		WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Last(),
+		FString::Printf(
+			TEXT("window.aiassistantstreams?.[\"%s\"]?.cancel();\n"), *Stream->GetStreamKey()));
+	(void)TestEqual(
+		TEXT("HandlersUnregistered"),
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi).GetNumRegisteredHandlers(), 0);
+
+	// Chunks received after cancelation are ignored.
+	CallStreamHandler(WebApi, Stream->GetChunkHandlerId(), TEXT("{}"));
+	(void)TestEqual(TEXT("NumBufferedChunks"), Stream->GetNumBufferedChunks(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiStreamTestOutlivesWebApi,
+	"AI.Assistant.WebApi.Stream.OutlivesWebApi",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiStreamTestOutlivesWebApi::RunTest(const FString& UnusedParameters)
+{
+	TSharedPtr<FWebApiStream> Stream;
+	TFuture<TValueOrError<void, FString>> Completion;
+	{
+		FFakeWebApi WebApi;
+		Stream = CreateTestStream(WebApi);
+		Completion = Stream->GetCompletionFuture();
+	}
+	if (!TestTrue(TEXT("Complete"), Completion.IsReady()))
+	{
+		return false;
+	}
+	(void)TestEqual(
+		TEXT("Error"), Completion.Get().GetError(),
+		UAIAssistantWebJavaScriptResultDelegate::CanceledError);
+	Stream->Cancel();
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
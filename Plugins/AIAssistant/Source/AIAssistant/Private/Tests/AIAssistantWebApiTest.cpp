@@ -2,162 +2,23 @@
 
 #include "Containers/Array.h"
 #include "Containers/UnrealString.h"
+#include "HAL/IConsoleManager.h"
 #include "Internationalization/Regex.h"
 #include "Misc/AutomationTest.h"
 #include "Templates/Tuple.h"
 
+#include "AIAssistantFakeWebApi.h"
 #include "AIAssistantFakeWebJavaScriptExecutor.h"
 #include "AIAssistantFakeWebJavaScriptDelegateBinder.h"
 #include "AIAssistantTestFlags.h"
 #include "WebAPI/AIAssistantWebApi.h"
+#include "AIAssistantWebApiAccessor.h"
 #include "AIAssistantWebJavaScriptResultDelegateAccessor.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
 using namespace UE::AIAssistant;
 
-class FTestWebApi : public FWebApi
-{
-public:
-	struct FExecutedAsyncFunction {
-		FString FunctionName;
-		FString Arguments;
-		FString HandlerId;
-	};
-
-public:
-	using FWebApi::FWebApi;
-	virtual ~FTestWebApi() = default;
-
-	// Ensure a JavaScript function was called with the specified arguments.
-	bool TestExpectAsyncFunctionCall(
-		FAutomationTestBase& TestCase,
-		const TCHAR* FunctionName,
-		const TCHAR* Arguments = TEXT("")) const
-	{
-		if (!TestCase.TestEqual(FunctionName, 1, ExecutedAsyncFunctions.Num()))
-		{
-			return false;
-		}
-
-		const auto& ExecutedAsyncFunction = ExecutedAsyncFunctions[0];
-		bool bCalled;
-		bCalled = TestCase.TestEqual(
-			FString::Printf(TEXT("%s_Called"), FunctionName),
-			ExecutedAsyncFunction.FunctionName, FunctionName);
-		bCalled = TestCase.TestEqual(
-			FString::Printf(TEXT("%s_Args"), FunctionName),
-			ExecutedAsyncFunction.Arguments, Arguments) && bCalled;
-		return bCalled;
-	}
-
-	// If possible, get the value of a result as JSON.  If the value cannot be converted to JSON
-	// return an empty string.
-	template<typename ValueType>
-	FString GetValueOrEmptyString(const TValueOrError<ValueType, FString>& ValueOrError)
-	{
-		return ValueOrError.GetValue().ToJson(false);
-	}
-
-	template<>
-	FString GetValueOrEmptyString<void>(const TValueOrError<void, FString>& UnusedValueOrError)
-	{
-		return FString();
-	}
-
-	// Ensure a JavaScript function was called with the specified arguments and complete it
-	// with ResultJson as a result of error if bResultJsonIsError is true.
-	template<typename ResultFutureType>
-	bool TestExpectAsyncFunctionCallAndComplete(
-		FAutomationTestBase& TestCase,
-		const TCHAR* FunctionName,
-		const TCHAR* Arguments,
-		ResultFutureType& ResultFuture,
-		const TCHAR* ResultJson,
-		bool bResultJsonIsError)
-	{
-		if (!TestExpectAsyncFunctionCall(TestCase, FunctionName, Arguments) || 
-			!TestCase.TestFalse(
-				FString::Printf(TEXT("%s_CompleteBeforeHandler"), FunctionName),
-				ResultFuture.IsReady()))
-		{
-			return false;
-		}
-		
-		FWebJavaScriptResultDelegateAccessor::CallHandleResult(
-			*WebJavaScriptResultDelegate,
-			ExecutedAsyncFunctions[0].HandlerId,
-			ResultJson, bResultJsonIsError);
-
-		if (!TestCase.TestTrue(
-				FString::Printf(TEXT("%s_CompleteAfterHandler"), FunctionName),
-				ResultFuture.IsReady()))
-		{
-			return false;
-		}
-		const auto& Result = ResultFuture.Get();
-		bool bCompletedAsExpected;
-		bCompletedAsExpected = TestCase.TestEqual(
-			FString::Printf(TEXT("%s_ResultHasError"), FunctionName),
-			Result.HasError(), bResultJsonIsError);
-		bCompletedAsExpected = TestCase.TestEqual(
-			FString::Printf(TEXT("%s_HasExpectedResult"), FunctionName),
-			bResultJsonIsError ? Result.GetError() : GetValueOrEmptyString(Result),
-			ResultJson) && bCompletedAsExpected;
-		return bCompletedAsExpected;
-	}
-
-protected:
-	void ExecuteAsyncFunction(
-		const TCHAR* FunctionName, const TCHAR* Arguments, const TCHAR* HandlerId) override
-	{
-		FWebApi::ExecuteAsyncFunction(FunctionName, Arguments, HandlerId);
-		ExecutedAsyncFunctions.Emplace(
-			FExecutedAsyncFunction{ FunctionName, Arguments, HandlerId });
-	}
-
-public:
-	TArray<FExecutedAsyncFunction> ExecutedAsyncFunctions;
-};
-
-struct FFakeWebApi
-{
-	FFakeWebApi() : WebApi(WebJavaScriptExecutor, WebJavaScriptDelegateBinder) {}
-
-	FFakeWebJavaScriptExecutor WebJavaScriptExecutor;
-	FFakeWebJavaScriptDelegateBinder WebJavaScriptDelegateBinder;
-	FTestWebApi WebApi;
-
-	FTestWebApi& operator*() { return WebApi; }
-	FTestWebApi* operator->() { return &WebApi; }
-};
-
-namespace UE::AIAssistant
-{
-	class FWebApiAccessor
-	{
-	public:
-		static FString FormatFunctionCall(
-			FWebApi& WebApi, const TCHAR* FunctionName, const TCHAR* Arguments = TEXT(""),
-			const FString& HandlerId = FString())
-		{
-			return WebApi.FormatFunctionCall(FunctionName, Arguments, HandlerId);
-		}
-
-		static TPair<FString, FString> FormatResultAndErrorHandlers(
-			FWebApi& WebApi, const FString& HandlerId)
-		{
-			return WebApi.FormatResultAndErrorHandlers(HandlerId);
-		}
-		
-		static UAIAssistantWebJavaScriptResultDelegate& GetJavaScriptResultDelegate(
-			FWebApi& WebApi)
-		{
-			return *WebApi.WebJavaScriptResultDelegate;
-		}
-	};
-}
-
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FAIAssistantWebApiTestFormatFunctionCallNoArgs,
 	"AI.Assistant.WebApi.FormatFunctionCallNoArgs",
@@ -210,33 +71,6 @@ try {
 )js"));
 }
 
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(
-	FAIAssistantWebApiTestFormatResultAndErrorHandlers,
-	"AI.Assistant.WebApi.FormatResultAndErrorHandlers",
-	AIAssistantTest::Flags);
-
-bool FAIAssistantWebApiTestFormatResultAndErrorHandlers::RunTest(
-	const FString& UnusedParameters)
-{
-	FFakeWebApi WebApi;
-	const FString FakeHandlerId = TEXT("foobar");
-	const auto Handlers = FWebApiAccessor::FormatResultAndErrorHandlers(*WebApi, FakeHandlerId);
-	const auto& JavaScriptResultDelegate = FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi);
-	(void)TestEqual(
-		TEXT("ResultHandler"),
-		Handlers.Key,
-		FString::Format(
-			*JavaScriptResultDelegate.FormatJavaScriptHandler(FakeHandlerId),
-			{ TEXT("result"), TEXT("false") }));
-	(void)TestEqual(
-		TEXT("ErrorHandler"),
-		Handlers.Value,
-		FString::Format(
-			*JavaScriptResultDelegate.FormatJavaScriptHandler(FakeHandlerId),
-			{ TEXT("error"), TEXT("true") }));
-	return true;
-}
-
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FAIAssistantWebApiTestFormatFunctionCallWithResultHandler,
 	"AI.Assistant.WebApi.FormatFunctionCallWithResultHandler",
@@ -246,8 +80,8 @@ bool FAIAssistantWebApiTestFormatFunctionCallWithResultHandler::RunTest(
 	const FString& UnusedParameters)
 {
 	FFakeWebApi WebApi;
-	const FString FakeHandlerId = TEXT("foobar");
-	const auto Handlers = FWebApiAccessor::FormatResultAndErrorHandlers(*WebApi, FakeHandlerId);
+	const FWebApi::FHandlerId FakeHandlerId{ 1, 2 };
+	const auto Handlers = FWebApiAccessor::FormatResultAndErrorHandlers(FakeHandlerId);
 	return TestEqual(
 		TEXT("FormatFunctionCallWithResultHandler"),
 		FWebApiAccessor::FormatFunctionCall(*WebApi, TEXT("test"), TEXT(""), FakeHandlerId),
@@ -299,9 +133,9 @@ bool FAIAssistantWebApiTestAddMessageToConversation::RunTest(const FString& Unus
 	MessageContent.ContentType = EMessageContentType::Text;
 	MessageContent.Content.Emplace<FTextMessageContent>();
 	MessageContent.Content.Get<FTextMessageContent>().Text = TEXT("Hello");
-	WebApi->AddMessageToConversation(Options);
-	return WebApi->TestExpectAsyncFunctionCall(
-		*this, TEXT("addMessageToConversation"), *Options.ToJson(false));
+	auto Result = WebApi->AddMessageToConversation(Options);
+	return WebApi->TestExpectAsyncFunctionCallAndComplete(
+		*this, TEXT("addMessageToConversation"), *Options.ToJson(false), Result, TEXT(""), false);
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
@@ -357,6 +191,23 @@ bool FAIAssistantWebApiTestSetAgentEnvironment::RunTest(const FString& UnusedPar
 		*this, TEXT("setAgentEnvironment"), *Id.ToJson(false));
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestGetCurrentUser,
+	"AI.Assistant.WebApi.GetCurrentUser",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestGetCurrentUser::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	auto Result = WebApi->GetCurrentUser();
+
+	FAssistantUser User;
+	User.Id = TEXT("fakeUser");
+
+	return WebApi->TestExpectAsyncFunctionCallAndComplete(
+		*this, TEXT("getCurrentUser"), TEXT(""), Result, *User.ToJson(false), false);
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FAIAssistantWebApiTestUpdateGlobalLocale,
 	"AI.Assistant.WebApi.UpdateGlobalLocale",
@@ -371,4 +222,253 @@ bool FAIAssistantWebApiTestUpdateGlobalLocale::RunTest(const FString& UnusedPara
 		*this, TEXT("updateGlobalLocale"), *FString::Printf(TEXT("\"%s\""), *LocaleFromSetting));
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestFlushPolicyImmediate,
+	"AI.Assistant.WebApi.FlushPolicyImmediate",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestFlushPolicyImmediate::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	WebApi->SetFlushPolicyOverride(FWebApi::EFlushPolicy::Immediate);
+	WebApi->UpdateGlobalLocale(TEXT("fr"));
+	WebApi->UpdateGlobalLocale(TEXT("de"));
+
+	(void)TestEqual(
+		TEXT("NumberOfExecutedScripts"), WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 2);
+	const FWebApi::FBatchStats BatchStats = WebApi->GetBatchStats();
+	(void)TestEqual(TEXT("NumFlushes"), BatchStats.NumFlushes, uint64(2));
+	(void)TestEqual(TEXT("LastCallsPerFlush"), BatchStats.LastCallsPerFlush, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestFlushPolicyEndOfFrame,
+	"AI.Assistant.WebApi.FlushPolicyEndOfFrame",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestFlushPolicyEndOfFrame::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	WebApi->SetFlushPolicyOverride(FWebApi::EFlushPolicy::EndOfFrame);
+	FAgentEnvironmentId Id;
+	Id.Id = TEXT("fakeId");
+	WebApi->SetAgentEnvironment(Id);
+	WebApi->UpdateGlobalLocale(TEXT("fr"));
+	(void)TestEqual(
+		TEXT("NothingExecutedBeforeFlush"),
+		WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 0);
+
+	WebApi->Flush();
+	if (!TestEqual(
+			TEXT("SingleScriptAfterFlush"),
+			WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 1) ||
+		!TestEqual(TEXT("NumberOfCalls"), WebApi->ExecutedAsyncFunctions.Num(), 2))
+	{
+		return false;
+	}
+
+	FString ExpectedScript;
+	for (const auto& ExecutedAsyncFunction : WebApi->ExecutedAsyncFunctions)
+	{
+		ExpectedScript += FWebApiAccessor::FormatFunctionCall(
+			*WebApi, *ExecutedAsyncFunction.FunctionName, *ExecutedAsyncFunction.Arguments,
+			ExecutedAsyncFunction.HandlerId);
+	}
+	(void)TestEqual(
+		TEXT("BatchedScript"), WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText[0],
+		ExpectedScript);
+
+	const FWebApi::FBatchStats BatchStats = WebApi->GetBatchStats();
+	(void)TestEqual(TEXT("NumFlushes"), BatchStats.NumFlushes, uint64(1));
+	(void)TestEqual(TEXT("NumCallsFlushed"), BatchStats.NumCallsFlushed, uint64(2));
+	(void)TestEqual(TEXT("LastCallsPerFlush"), BatchStats.LastCallsPerFlush, 2);
+
+	WebApi->Flush();
+	(void)TestEqual(
+		TEXT("EmptyFlushDoesNotExecute"),
+		WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestFlushPolicyChangedWhilePending,
+	"AI.Assistant.WebApi.FlushPolicyChangedWhilePending",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestFlushPolicyChangedWhilePending::RunTest(const FString& UnusedParameters)
+{
+	IConsoleVariable* FlushPolicyConsoleVariable =
+		IConsoleManager::Get().FindConsoleVariable(TEXT("ai.assistant.webapi.flushpolicy"));
+	if (!TestNotNull(TEXT("FlushPolicyConsoleVariable"), FlushPolicyConsoleVariable))
+	{
+		return false;
+	}
+	const int32 OriginalFlushPolicy = FlushPolicyConsoleVariable->GetInt();
+
+	FFakeWebApi WebApi;
+	FlushPolicyConsoleVariable->Set(static_cast<int32>(FWebApi::EFlushPolicy::EndOfFrame));
+	WebApi->UpdateGlobalLocale(TEXT("fr"));
+	FlushPolicyConsoleVariable->Set(static_cast<int32>(FWebApi::EFlushPolicy::Immediate));
+	WebApi->UpdateGlobalLocale(TEXT("de"));
+	FlushPolicyConsoleVariable->Set(OriginalFlushPolicy);
+
+	// The call batched before the policy changed runs first, in the same script.
+	if (!TestEqual(
+			TEXT("NumberOfExecutedScripts"),
+			WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 1))
+	{
+		return false;
+	}
+	const FString& Script = WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText[0];
+	const int32 BatchedIndex = Script.Find(TEXT("\"fr\""));
+	const int32 ImmediateIndex = Script.Find(TEXT("\"de\""));
+	(void)TestTrue(
+		TEXT("CallOrder"), BatchedIndex != INDEX_NONE && BatchedIndex < ImmediateIndex);
+	(void)TestEqual(TEXT("LastCallsPerFlush"), WebApi->GetBatchStats().LastCallsPerFlush, 2);
+
+	WebApi->Flush();
+	(void)TestEqual(
+		TEXT("NothingLeftPending"), WebApi.WebJavaScriptExecutor.ExecutedJavaScriptText.Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestExecuteFunctionTimeout,
+	"AI.Assistant.WebApi.ExecuteFunctionTimeout",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestExecuteFunctionTimeout::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	FTimerWheel& TimerWheel = FWebApiAccessor::GetTimerWheel(*WebApi);
+	auto& ResultDelegate = FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi);
+	FWebApiCallOptions CallOptions;
+	CallOptions.TimeoutSeconds = 1.0;
+	auto ResultFuture = FWebApiAccessor::ExecuteFunction(*WebApi, TEXT("test"), CallOptions);
+	(void)TestEqual(TEXT("NumTimers"), TimerWheel.GetNumTimers(), 1);
+
+	(void)TimerWheel.Advance(0.5);
+	(void)TestFalse(TEXT("PendingBeforeTimeout"), ResultFuture.IsReady());
+	(void)TimerWheel.Advance(0.6);
+	if (!TestTrue(TEXT("CompleteAfterTimeout"), ResultFuture.IsReady()))
+	{
+		return false;
+	}
+	(void)TestTrue(TEXT("ResultIsError"), ResultFuture.Get().bJsonIsError);
+	(void)TestEqual(
+		TEXT("ResultJson"), ResultFuture.Get().Json,
+		UAIAssistantWebJavaScriptResultDelegate::TimedOutError);
+	(void)TestEqual(
+		TEXT("NumRegisteredHandlers"), ResultDelegate.GetNumRegisteredHandlers(), 0);
+
+	// A late result is ignored.
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		ResultDelegate, WebApi->ExecutedAsyncFunctions[0].HandlerId, TEXT("{}"), false);
+	(void)TestEqual(
+		TEXT("ResultJsonAfterLateResult"), ResultFuture.Get().Json,
+		UAIAssistantWebJavaScriptResultDelegate::TimedOutError);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestExecuteFunctionCompleteCancelsTimeout,
+	"AI.Assistant.WebApi.ExecuteFunctionCompleteCancelsTimeout",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestExecuteFunctionCompleteCancelsTimeout::RunTest(
+	const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	FTimerWheel& TimerWheel = FWebApiAccessor::GetTimerWheel(*WebApi);
+	auto CancellationToken = MakeShared<FCancellationToken>();
+	FWebApiCallOptions CallOptions;
+	CallOptions.TimeoutSeconds = 1.0;
+	CallOptions.CancellationToken = CancellationToken;
+	auto ResultFuture = FWebApiAccessor::ExecuteFunction(*WebApi, TEXT("test"), CallOptions);
+
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi),
+		WebApi->ExecutedAsyncFunctions[0].HandlerId, TEXT("\"done\""), false);
+	if (!TestTrue(TEXT("Complete"), ResultFuture.IsReady()))
+	{
+		return false;
+	}
+	(void)TestFalse(TEXT("ResultIsError"), ResultFuture.Get().bJsonIsError);
+	(void)TestEqual(TEXT("NumTimers"), TimerWheel.GetNumTimers(), 0);
+
+	// Canceling after completion has no effect.
+	CancellationToken->Cancel();
+	(void)TestEqual(TEXT("ResultJson"), ResultFuture.Get().Json, TEXT("\"done\""));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestExecuteFunctionCancel,
+	"AI.Assistant.WebApi.ExecuteFunctionCancel",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestExecuteFunctionCancel::RunTest(const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	auto CancellationToken = MakeShared<FCancellationToken>();
+	FWebApiCallOptions CallOptions;
+	CallOptions.CancellationToken = CancellationToken;
+	auto ResultFuture = FWebApiAccessor::ExecuteFunction(*WebApi, TEXT("test"), CallOptions);
+	(void)TestFalse(TEXT("PendingBeforeCancel"), ResultFuture.IsReady());
+
+	CancellationToken->Cancel();
+	if (!TestTrue(TEXT("CompleteAfterCancel"), ResultFuture.IsReady()))
+	{
+		return false;
+	}
+	(void)TestTrue(TEXT("ResultIsError"), ResultFuture.Get().bJsonIsError);
+	(void)TestEqual(
+		TEXT("ResultJson"), ResultFuture.Get().Json,
+		UAIAssistantWebJavaScriptResultDelegate::CanceledError);
+	(void)TestEqual(
+		TEXT("NumTimers"), FWebApiAccessor::GetTimerWheel(*WebApi).GetNumTimers(), 0);
+
+	// Calls made with a canceled token are not sent.
+	auto CanceledResultFuture =
+		FWebApiAccessor::ExecuteFunction(*WebApi, TEXT("test"), CallOptions);
+	(void)TestTrue(TEXT("CanceledCallComplete"), CanceledResultFuture.IsReady());
+	(void)TestEqual(TEXT("NumCalls"), WebApi->ExecutedAsyncFunctions.Num(), 1);
+	(void)TestEqual(
+		TEXT("NumRegisteredHandlers"),
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi).GetNumRegisteredHandlers(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebApiTestExecuteFunctionRecordsMetrics,
+	"AI.Assistant.WebApi.ExecuteFunctionRecordsMetrics",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebApiTestExecuteFunctionRecordsMetrics::RunTest(
+	const FString& UnusedParameters)
+{
+	FFakeWebApi WebApi;
+	const TCHAR* FunctionName = TEXT("metricsTest");
+	FWebApiMetrics::FFunctionMetrics& FunctionMetrics =
+		FWebApiMetrics::Get().FindOrAdd(FunctionName);
+	const uint64 NumCalls = FunctionMetrics.NumCalls;
+	const uint64 NumErrors = FunctionMetrics.NumErrors;
+	const int32 NumInFlight = FunctionMetrics.NumInFlight;
+
+	auto ResultFuture =
+		FWebApiAccessor::ExecuteFunction(*WebApi, FunctionName, FWebApiCallOptions());
+	(void)TestEqual(TEXT("InFlight"), FunctionMetrics.NumInFlight.load(), NumInFlight + 1);
+
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		FWebApiAccessor::GetJavaScriptResultDelegate(*WebApi),
+		WebApi->ExecutedAsyncFunctions[0].HandlerId, TEXT("\"failed\""), true);
+	(void)TestTrue(TEXT("Complete"), ResultFuture.IsReady());
+	(void)TestEqual(TEXT("NumCalls"), FunctionMetrics.NumCalls.load(), NumCalls + 1);
+	(void)TestEqual(TEXT("NumErrors"), FunctionMetrics.NumErrors.load(), NumErrors + 1);
+	(void)TestEqual(
+		TEXT("InFlightAfterComplete"), FunctionMetrics.NumInFlight.load(), NumInFlight);
+	return true;
+}
+
 #endif  // WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/SharedPointer.h"
+
+#include "AIAssistantTestFlags.h"
+#include "UI/AIAssistantWebBrowser.h"
+#include "UI/AIAssistantWebBrowserPool.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebBrowserPoolTestClosePooledDestroysBrowser,
+	"AI.Assistant.WebBrowserPool.ClosePooledDestroysBrowser",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebBrowserPoolTestClosePooledDestroysBrowser::RunTest(const FString& UnusedParameters)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddInfo(TEXT("Skipped as Slate isn't initialized."));
+		return true;
+	}
+
+	IConsoleVariable* PoolConsoleVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.assistant.browser.pool"));
+	if (!TestNotNull(TEXT("PoolConsoleVariable"), PoolConsoleVariable))
+	{
+		return false;
+	}
+	const bool bOriginalPoolEnabled = PoolConsoleVariable->GetBool();
+	PoolConsoleVariable->Set(true);
+
+	FAIAssistantWebBrowserPool WebBrowserPool;
+	WebBrowserPool.ClosePooled();
+
+	TWeakPtr<SAIAssistantWebBrowser> WeakWebBrowser;
+	{
+		const TSharedRef<SAIAssistantWebBrowser> WebBrowser = WebBrowserPool.Acquire();
+		WeakWebBrowser = WebBrowser;
+		(void)TestTrue(TEXT("ActiveWhileAcquired"), WebBrowserPool.GetActive() == WebBrowser);
+
+		WebBrowserPool.Release(WebBrowser);
+		(void)TestFalse(TEXT("NotActiveWhenReleased"), WebBrowserPool.GetActive().IsValid());
+		(void)TestTrue(TEXT("Pooled"), WebBrowserPool.HasPooled());
+	}
+	(void)TestTrue(TEXT("KeptAliveByPool"), WeakWebBrowser.IsValid());
+
+	// This is what happens when memory is trimmed.
+	WebBrowserPool.ClosePooled();
+	(void)TestFalse(TEXT("NotPooled"), WebBrowserPool.HasPooled());
+	(void)TestFalse(TEXT("Destroyed"), WeakWebBrowser.IsValid());
+
+	PoolConsoleVariable->Set(bOriginalPoolEnabled);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebBrowserPoolTestPrewarm,
+	"AI.Assistant.WebBrowserPool.Prewarm",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebBrowserPoolTestPrewarm::RunTest(const FString& UnusedParameters)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddInfo(TEXT("Skipped as Slate isn't initialized."));
+		return true;
+	}
+
+	FAIAssistantWebBrowserPool WebBrowserPool;
+	WebBrowserPool.ClosePooled();
+	(void)TestFalse(TEXT("NotPrewarmedInitially"), WebBrowserPool.HasPrewarmed());
+
+	WebBrowserPool.Prewarm();
+	(void)TestTrue(TEXT("Prewarmed"), WebBrowserPool.HasPrewarmed());
+
+	const TSharedRef<SAIAssistantWebBrowser> WebBrowser = WebBrowserPool.Acquire();
+	(void)TestFalse(TEXT("NotPrewarmedOnceAcquired"), WebBrowserPool.HasPrewarmed());
+
+	// A browser parked by a tab was already shown.
+	WebBrowserPool.Release(WebBrowser);
+	(void)TestFalse(TEXT("NotPrewarmedOnceReleased"), WebBrowserPool.HasPrewarmed());
+
+	WebBrowserPool.ClosePooled();
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -1,9 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 #pragma once
 
-#include "Containers/Map.h"
 #include "Containers/UnrealString.h"
-#include "Templates/SharedPointer.h"
 
 #include "WebAPI/AIAssistantWebJavaScriptResultDelegate.h"
 
@@ -15,16 +13,11 @@ namespace UE::AIAssistant
 		// Call Delegate.HandleResult().
 		static void CallHandleResult(
 			UAIAssistantWebJavaScriptResultDelegate& Delegate,
-			const FString& HandlerId, const FString& ResultJson, bool bResultJsonIsError)
+			const UAIAssistantWebJavaScriptResultDelegate::FHandlerId& HandlerId,
+			const FString& ResultJson, bool bResultJsonIsError)
 		{
-			Delegate.HandleResult(HandlerId, ResultJson, bResultJsonIsError);
-		}
-
-		static const TMap<
-			FString, TSharedPtr<UAIAssistantWebJavaScriptResultDelegate::FResultHandler>>&
-			GetResultHandlersById(UAIAssistantWebJavaScriptResultDelegate& Delegate)
-		{
-			return Delegate.ResultHandlersById;
+			Delegate.HandleResult(
+				HandlerId.Index, HandlerId.Generation, ResultJson, bResultJsonIsError);
 		}
 	};
 }
\ No newline at end of file
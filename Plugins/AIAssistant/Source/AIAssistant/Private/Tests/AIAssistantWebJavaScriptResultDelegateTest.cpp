@@ -46,12 +46,12 @@ bool FAIAssistantWebJavaScriptResultDelegateTestRegisterResultHandler::RunTest(
 	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
 		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
 
-	FString HandlerId = ResultDelegate->RegisterResultHandler(
+	const auto HandlerId = ResultDelegate->RegisterResultHandler(
 		[](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&) -> bool
 		{
 			return true;
 		});
-	(void)TestNotEqual(TEXT("HandlerId"), TEXT(""), HandlerId);
+	(void)TestTrue(TEXT("HandlerId"), HandlerId.IsValid());
 	return true;
 }
 
@@ -70,7 +70,7 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCallResultHandler::RunTest(
 	{
 		const FString ExpectedJsonResult = TEXT("{'answer': 42}");
 		bool bCalledHandler = false;
-		FString HandlerId = ResultDelegate->RegisterResultHandler(
+		const auto HandlerId = ResultDelegate->RegisterResultHandler(
 			[this, &ExpectedJsonResult, bExpectedJsonResultIsError, &bCalledHandler](
 				UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&
 				ResultHandlerContext) -> bool
@@ -104,7 +104,7 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCallResultHandlerOnce::RunTest(
 		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
 
 	bool bWasCalled = false;
-	FString HandlerId = ResultDelegate->RegisterResultHandler(
+	const auto HandlerId = ResultDelegate->RegisterResultHandler(
 		[&bWasCalled](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&) -> bool
 		{
 			bWasCalled = true;
@@ -112,16 +112,14 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCallResultHandlerOnce::RunTest(
 		});
 	(void)TestEqual(
 		TEXT("NumberOfHandlers"), 1,
-		FWebJavaScriptResultDelegateAccessor::GetResultHandlersById(
-			*ResultDelegate).Num());
+		ResultDelegate->GetNumRegisteredHandlers());
 
 	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
 		*ResultDelegate, HandlerId, TEXT(""), false);
 	(void)TestTrue(TEXT("HandlerCalled"), bWasCalled);
 	(void)TestEqual(
 		TEXT("NumberOfHandlers"), 0,
-		FWebJavaScriptResultDelegateAccessor::GetResultHandlersById(
-			*ResultDelegate).Num());
+		ResultDelegate->GetNumRegisteredHandlers());
 	return true;
 }
 
@@ -137,7 +135,7 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCallResultHandlerMultiple::RunTe
 		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
 
 	int NumberOfCalls = 0;
-	FString HandlerId = ResultDelegate->RegisterResultHandler(
+	const auto HandlerId = ResultDelegate->RegisterResultHandler(
 		[&NumberOfCalls](
 			UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&) mutable -> bool
 		{
@@ -156,28 +154,40 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCallResultHandlerMultiple::RunTe
 
 	(void)TestEqual(
 		TEXT("NumberOfHandlers"), 1,
-		FWebJavaScriptResultDelegateAccessor::GetResultHandlersById(
-			*ResultDelegate).Num());
+		ResultDelegate->GetNumRegisteredHandlers());
 	return true;
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
-	FAIAssistantWebJavaScriptResultDelegateTestFormatJavaScriptHandler,
-	"AI.Assistant.WebJavaScriptResultDelegate.FormatJavaScriptHandler",
+	FAIAssistantWebJavaScriptResultDelegateTestAppendJavaScriptHandler,
+	"AI.Assistant.WebJavaScriptResultDelegate.AppendJavaScriptHandler",
 	AIAssistantTest::Flags);
 
-bool FAIAssistantWebJavaScriptResultDelegateTestFormatJavaScriptHandler::RunTest(
+bool FAIAssistantWebJavaScriptResultDelegateTestAppendJavaScriptHandler::RunTest(
 	const FString& UnusedParameters)
 {
-	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
-		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
-	FString HandlerId = TEXT("fake_handler_id");
+	const UAIAssistantWebJavaScriptResultDelegate::FHandlerId HandlerId{ 12, 34 };
+	FString Result;
+	UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+		Result, HandlerId, TEXT("result"), false);
+	(void)TestEqual(
+		TEXT("Result"),
+		TEXT(
+			R"js(window.ue.aiassistantresultdelegate.handleresult)js"
+			R"js((12, 34, JSON.stringify(result), false);)js"),
+		Result);
+	FString Error;
+	UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+		Error, HandlerId, TEXT("error"), true);
 	(void)TestEqual(
-		TEXT("JavaScript"),
+		TEXT("Error"),
 		TEXT(
 			R"js(window.ue.aiassistantresultdelegate.handleresult)js"
-			R"js(("fake_handler_id", JSON.stringify({0}), {1});)js"),
-		ResultDelegate->FormatJavaScriptHandler(HandlerId));
+			R"js((12, 34, JSON.stringify(error), true);)js"),
+		Error);
+	(void)TestTrue(
+		TEXT("Length"),
+		Result.Len() <= UAIAssistantWebJavaScriptResultDelegate::GetJavaScriptHandlerLength(6));
 	return true;
 }
 
@@ -191,9 +201,11 @@ bool FAIAssistantWebJavaScriptResultDelegateTestRegisterResultHandlerForFuture::
 {
 	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
 		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
-	TPair<FString, TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>> ResultHandle =
+	TPair<
+		UAIAssistantWebJavaScriptResultDelegate::FHandlerId,
+		TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>> ResultHandle =
 		ResultDelegate->RegisterResultHandlerForFuture();
-	(void)TestNotEqual(TEXT("HandlerId"), TEXT(""), ResultHandle.Key);
+	(void)TestTrue(TEXT("HandlerId"), ResultHandle.Key.IsValid());
 	(void)TestFalse(TEXT("FutureNotReady"), ResultHandle.Value.IsReady());
 	
 	const FString FakeResultJson(TEXT("result"));
@@ -220,7 +232,9 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCompleteAllPendingPromises::RunT
 	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
 		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
 	ResultDelegate->Bind(Binder);
-	TPair<FString, TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>> ResultHandle =
+	TPair<
+		UAIAssistantWebJavaScriptResultDelegate::FHandlerId,
+		TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>> ResultHandle =
 		ResultDelegate->RegisterResultHandlerForFuture();
 
 	// Use Unbind() to force clean up of pending promises as we can't force destruction of the
@@ -237,4 +251,128 @@ bool FAIAssistantWebJavaScriptResultDelegateTestCompleteAllPendingPromises::RunT
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebJavaScriptResultDelegateTestIgnoreStaleHandlerId,
+	"AI.Assistant.WebJavaScriptResultDelegate.IgnoreStaleHandlerId",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebJavaScriptResultDelegateTestIgnoreStaleHandlerId::RunTest(
+	const FString& UnusedParameters)
+{
+	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
+		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
+
+	const auto StaleHandle = ResultDelegate->RegisterResultHandlerForFuture();
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		*ResultDelegate, StaleHandle.Key, TEXT("first"), false);
+
+	// The new handler reuses the slot of the completed handler.
+	int32 NumberOfCalls = 0;
+	const auto HandlerId = ResultDelegate->RegisterResultHandler(
+		[&NumberOfCalls](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&) -> bool
+		{
+			++NumberOfCalls;
+			return false;
+		});
+	(void)TestEqual(TEXT("ReusedSlot"), HandlerId.Index, StaleHandle.Key.Index);
+	(void)TestNotEqual(
+		TEXT("NewGeneration"), HandlerId.Generation, StaleHandle.Key.Generation);
+
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		*ResultDelegate, StaleHandle.Key, TEXT("stale"), false);
+	(void)TestEqual(TEXT("StaleIdIgnored"), NumberOfCalls, 0);
+
+	for (const UAIAssistantWebJavaScriptResultDelegate::FHandlerId& ForgedHandlerId :
+			{
+				UAIAssistantWebJavaScriptResultDelegate::FHandlerId{ -1, 1 },
+				UAIAssistantWebJavaScriptResultDelegate::FHandlerId{ HandlerId.Index + 1, 1 },
+				UAIAssistantWebJavaScriptResultDelegate::FHandlerId{ HandlerId.Index, 0 },
+			})
+	{
+		FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+			*ResultDelegate, ForgedHandlerId, TEXT("forged"), false);
+	}
+	(void)TestEqual(TEXT("ForgedIdIgnored"), NumberOfCalls, 0);
+
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		*ResultDelegate, HandlerId, TEXT("current"), false);
+	(void)TestEqual(TEXT("CurrentIdCalled"), NumberOfCalls, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebJavaScriptResultDelegateTestIgnoreGuessedHandlerId,
+	"AI.Assistant.WebJavaScriptResultDelegate.IgnoreGuessedHandlerId",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebJavaScriptResultDelegateTestIgnoreGuessedHandlerId::RunTest(
+	const FString& UnusedParameters)
+{
+	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
+		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
+
+	// Page script can see the ID of its own call and try to derive the ID of the next one.
+	const auto SeenHandle = ResultDelegate->RegisterResultHandlerForFuture();
+	int32 NumberOfCalls = 0;
+	const auto HandlerId = ResultDelegate->RegisterResultHandler(
+		[&NumberOfCalls](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&&) -> bool
+		{
+			++NumberOfCalls;
+			return false;
+		});
+	(void)TestEqual(TEXT("NextSlot"), HandlerId.Index, SeenHandle.Key.Index + 1);
+
+	const int32 SeenGeneration = SeenHandle.Key.Generation;
+	for (const int32 GuessedGeneration :
+			{ SeenGeneration, SeenGeneration + 1, SeenGeneration - 1, 1, 2, 3 })
+	{
+		// There is a 1 in 2^31 chance that a guess is right.
+		if (GuessedGeneration != HandlerId.Generation)
+		{
+			FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+				*ResultDelegate,
+				UAIAssistantWebJavaScriptResultDelegate::FHandlerId{
+					HandlerId.Index, GuessedGeneration },
+				TEXT("guessed"), false);
+		}
+	}
+	(void)TestEqual(TEXT("GuessedIdIgnored"), NumberOfCalls, 0);
+
+	FWebJavaScriptResultDelegateAccessor::CallHandleResult(
+		*ResultDelegate, HandlerId, TEXT("current"), false);
+	(void)TestEqual(TEXT("CurrentIdCalled"), NumberOfCalls, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWebJavaScriptResultDelegateTestUnregisterResultHandler,
+	"AI.Assistant.WebJavaScriptResultDelegate.UnregisterResultHandler",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWebJavaScriptResultDelegateTestUnregisterResultHandler::RunTest(
+	const FString& UnusedParameters)
+{
+	TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> ResultDelegate(
+		NewObject<UAIAssistantWebJavaScriptResultDelegate>());
+	auto ResultHandle = ResultDelegate->RegisterResultHandlerForFuture();
+	(void)TestEqual(
+		TEXT("NumberOfHandlersBefore"), ResultDelegate->GetNumRegisteredHandlers(), 1);
+
+	(void)TestTrue(
+		TEXT("Unregistered"), ResultDelegate->UnregisterResultHandler(ResultHandle.Key));
+	(void)TestFalse(
+		TEXT("UnregisteredTwice"), ResultDelegate->UnregisterResultHandler(ResultHandle.Key));
+	(void)TestEqual(
+		TEXT("NumberOfHandlersAfter"), ResultDelegate->GetNumRegisteredHandlers(), 0);
+
+	(void)TestTrue(TEXT("FutureIsReady"), ResultHandle.Value.IsReady());
+	auto Result = ResultHandle.Value.Consume();
+	(void)TestEqual(
+		TEXT("FutureIsCanceled"),
+		UAIAssistantWebJavaScriptResultDelegate::CanceledError,
+		Result.Json);
+	(void)TestTrue(TEXT("FutureHasError"), Result.bJsonIsError);
+	return true;
+}
+
 #endif  // WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "AIAssistantTestFlags.h"
+#include "UI/AIAssistantWidgetPathIndex.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace UE::AIAssistant;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWidgetPathIndexTestRoles,
+	"AI.Assistant.WidgetPathIndex.Roles",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWidgetPathIndexTestRoles::RunTest(const FString& UnusedParameters)
+{
+	for (int32 RoleIndex = 0; RoleIndex < int32(EWidgetRole::Unclassified); ++RoleIndex)
+	{
+		const EWidgetRole Role = EWidgetRole(RoleIndex);
+		const FName WidgetType = FWidgetPathIndex::GetWidgetType(Role);
+		(void)TestTrue(TEXT("HasWidgetType"), !WidgetType.IsNone());
+		(void)TestEqual(WidgetType.ToString(), FWidgetPathIndex::GetRole(WidgetType), Role);
+	}
+	(void)TestEqual(
+		TEXT("Breadcrumb"), FWidgetPathIndex::GetRole(TEXT("SBreadcrumbTrail<FNavigationCrumb>")),
+		EWidgetRole::BreadcrumbTrail);
+	(void)TestEqual(
+		TEXT("Unclassified"), FWidgetPathIndex::GetRole(TEXT("SBorder")), EWidgetRole::Unclassified);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAIAssistantWidgetPathIndexTestFind,
+	"AI.Assistant.WidgetPathIndex.Find",
+	AIAssistantTest::Flags);
+
+bool FAIAssistantWidgetPathIndexTestFind::RunTest(const FString& UnusedParameters)
+{
+	const FName WidgetTypes[] = {
+		TEXT("SWindow"),
+		TEXT("SDockingArea"),
+		TEXT("SDockingTabStack"),
+		TEXT("SDockingArea"),
+		TEXT("SDockingTabStack"),
+		TEXT("SButton"),
+		TEXT("SBorder"),
+		TEXT("SButton"),
+		TEXT("STextBlock"),
+	};
+	const FWidgetPathIndex Index(WidgetTypes);
+	(void)TestEqual(TEXT("Num"), Index.Num(), int32(UE_ARRAY_COUNT(WidgetTypes)));
+	(void)TestEqual(TEXT("RoleAt"), Index.GetRoleAt(2), EWidgetRole::DockingTabStack);
+	(void)TestEqual(TEXT("UnclassifiedAt"), Index.GetRoleAt(0), EWidgetRole::Unclassified);
+	(void)TestEqual(TEXT("TypeAt"), Index.GetTypeAt(0), FName(TEXT("SWindow")));
+
+	(void)TestEqual(TEXT("ClosestDockingArea"), Index.FindClosest(EWidgetRole::DockingArea), 3);
+	(void)TestEqual(TEXT("FurthestDockingArea"), Index.FindFurthest(EWidgetRole::DockingArea), 1);
+	(void)TestEqual(TEXT("ClosestTabStack"), Index.FindClosest(EWidgetRole::DockingTabStack), 4);
+	(void)TestEqual(TEXT("ClosestButton"), Index.FindClosest(EWidgetRole::Button), 7);
+	(void)TestEqual(TEXT("FurthestButton"), Index.FindFurthest(EWidgetRole::Button), 5);
+	(void)TestEqual(TEXT("Missing"), Index.FindClosest(EWidgetRole::GraphEditor), INDEX_NONE);
+	(void)TestEqual(TEXT("MissingFurthest"), Index.FindFurthest(EWidgetRole::GraphEditor), INDEX_NONE);
+	(void)TestEqual(TEXT("Unclassified"), Index.FindClosest(EWidgetRole::Unclassified), INDEX_NONE);
+
+	const FWidgetPathIndex Empty(TConstArrayView<FName>{});
+	(void)TestEqual(TEXT("EmptyNum"), Empty.Num(), 0);
+	(void)TestEqual(TEXT("EmptyFind"), Empty.FindClosest(EWidgetRole::Button), INDEX_NONE);
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
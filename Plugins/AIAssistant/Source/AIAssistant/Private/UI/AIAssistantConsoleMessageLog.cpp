@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantConsoleMessageLog.h"
+
+#include "Math/UnrealMathUtility.h"
+
+namespace UE::AIAssistant
+{
+	FConsoleMessageLog::FConsoleMessageLog(const FSettings& InSettings) :
+		Settings(FSettings{
+			FMath::Max(InSettings.Capacity, 1), FMath::Max(InSettings.MaxLinesPerSecond, 0.0f),
+			FMath::Max(InSettings.MaxBurstLines, 1.0f) })
+	{
+		Messages.Reserve(Settings.Capacity);
+		Reset();
+	}
+
+	bool FConsoleMessageLog::Add(
+		EWebBrowserConsoleLogSeverity Severity, const FString& Message, const FString& Source,
+		int32 Line, double NowSeconds)
+	{
+		if (!Messages.IsEmpty())
+		{
+			FMessage& PreviousMessage =
+				Messages[(NextIndex + Settings.Capacity - 1) % Settings.Capacity];
+			if (PreviousMessage.Severity == Severity && PreviousMessage.Line == Line &&
+				PreviousMessage.Message.Equals(Message, ESearchCase::CaseSensitive) &&
+				PreviousMessage.Source.Equals(Source, ESearchCase::CaseSensitive))
+			{
+				++PreviousMessage.NumRepeats;
+				++NumSuppressed;
+				return false;
+			}
+		}
+
+		FMessage NewMessage{ NowSeconds, Severity, Message, Source, Line };
+		if (Messages.Num() < Settings.Capacity)
+		{
+			Messages.Add(MoveTemp(NewMessage));
+		}
+		else
+		{
+			Messages[NextIndex] = MoveTemp(NewMessage);
+		}
+		NextIndex = (NextIndex + 1) % Settings.Capacity;
+
+		if (!TryConsumeLine(Severity, NowSeconds))
+		{
+			++NumSuppressed;
+			return false;
+		}
+		return true;
+	}
+
+	TArray<FConsoleMessageLog::FMessage> FConsoleMessageLog::GetMessages() const
+	{
+		TArray<FMessage> OrderedMessages;
+		OrderedMessages.Reserve(Messages.Num());
+		// Until the buffer is full the oldest message is the first.
+		const int32 OldestIndex = Messages.Num() < Settings.Capacity ? 0 : NextIndex;
+		for (int32 Offset = 0; Offset < Messages.Num(); ++Offset)
+		{
+			OrderedMessages.Add(Messages[(OldestIndex + Offset) % Messages.Num()]);
+		}
+		return OrderedMessages;
+	}
+
+	void FConsoleMessageLog::Reset()
+	{
+		Messages.Reset();
+		NextIndex = 0;
+		NumSuppressed = 0;
+		for (FLineBudget& LineBudget : LineBudgets)
+		{
+			LineBudget.Lines = Settings.MaxBurstLines;
+			LineBudget.LastUpdateSeconds = 0.0;
+		}
+	}
+
+	FString FConsoleMessageLog::Format() const
+	{
+		FString Text = FString::Printf(
+			TEXT("%d JavaScript console messages, %llu not written to the log.\n"), Messages.Num(),
+			NumSuppressed);
+		for (const FMessage& Message : GetMessages())
+		{
+			Text += FString::Printf(
+				TEXT("[%.3f] %s - '%s' @ %s:%d"), Message.Seconds, GetSeverityName(Message.Severity),
+				*Message.Message, *Message.Source, Message.Line);
+			if (Message.NumRepeats > 1)
+			{
+				Text += FString::Printf(TEXT(" (x%d)"), Message.NumRepeats);
+			}
+			Text += TEXT("\n");
+		}
+		return Text;
+	}
+
+	const TCHAR* FConsoleMessageLog::GetSeverityName(EWebBrowserConsoleLogSeverity Severity)
+	{
+		switch (Severity)
+		{
+			case EWebBrowserConsoleLogSeverity::Verbose:
+				return TEXT("Verbose");
+			case EWebBrowserConsoleLogSeverity::Debug:
+				return TEXT("Debug");
+			case EWebBrowserConsoleLogSeverity::Info:
+				return TEXT("Info");
+			case EWebBrowserConsoleLogSeverity::Warning:
+				return TEXT("Warning");
+			case EWebBrowserConsoleLogSeverity::Error:
+				return TEXT("Error");
+			case EWebBrowserConsoleLogSeverity::Fatal:
+				return TEXT("Fatal");
+			default:
+				return TEXT("Log");
+		}
+	}
+
+	bool FConsoleMessageLog::TryConsumeLine(EWebBrowserConsoleLogSeverity Severity, double NowSeconds)
+	{
+		const int32 SeverityIndex = FMath::Clamp(int32(Severity), 0, NumSeverities - 1);
+		FLineBudget& LineBudget = LineBudgets[SeverityIndex];
+		// Refill the budget for the time since it was last updated.
+		const double ElapsedSeconds = FMath::Max(NowSeconds - LineBudget.LastUpdateSeconds, 0.0);
+		LineBudget.Lines = float(FMath::Min(
+			double(Settings.MaxBurstLines),
+			double(LineBudget.Lines) + ElapsedSeconds * double(Settings.MaxLinesPerSecond)));
+		LineBudget.LastUpdateSeconds = NowSeconds;
+		if (LineBudget.Lines < 1.0f)
+		{
+			return false;
+		}
+		LineBudget.Lines -= 1.0f;
+		return true;
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/StaticArray.h"
+#include "Containers/UnrealString.h"
+#include "IWebBrowserWindow.h"
+
+namespace UE::AIAssistant
+{
+	// Captures the JavaScript console messages of the assistant page.
+	//
+	// The most recent messages are kept in a fixed size ring buffer, a message that repeats the
+	// previous message is folded into it by counting the repeat. Add() returns whether a message
+	// should also be written to the output log, which is limited per severity so that a burst of
+	// log messages from the page can't flood the output log or hide errors. Folded and rate
+	// limited messages are counted as suppressed, all captured messages can be formatted with
+	// Format().
+	//
+	// This isn't thread safe, CEF reports console messages on the game thread.
+	class FConsoleMessageLog
+	{
+	public:
+		struct FSettings
+		{
+			// Number of messages retained.
+			int32 Capacity = 256;
+			// Messages of each severity written to the output log per second.
+			float MaxLinesPerSecond = 10.0f;
+			// Messages of each severity that can be written to the output log in a burst.
+			float MaxBurstLines = 20.0f;
+		};
+
+		// A captured message.
+		struct FMessage
+		{
+			// When the message was first reported.
+			double Seconds = 0.0;
+			EWebBrowserConsoleLogSeverity Severity = EWebBrowserConsoleLogSeverity::Default;
+			FString Message;
+			FString Source;
+			int32 Line = 0;
+			// Number of times the message was reported in a row.
+			int32 NumRepeats = 1;
+		};
+
+	public:
+		explicit FConsoleMessageLog(const FSettings& InSettings = FSettings());
+
+		// Capture a message reported at NowSeconds.
+		// Returns whether the message should be written to the output log.
+		bool Add(
+			EWebBrowserConsoleLogSeverity Severity, const FString& Message, const FString& Source,
+			int32 Line, double NowSeconds);
+
+		// Get the captured messages, oldest first.
+		TArray<FMessage> GetMessages() const;
+
+		// Get the number of messages that weren't written to the output log.
+		uint64 GetNumSuppressed() const { return NumSuppressed; }
+
+		// Remove all captured messages.
+		void Reset();
+
+		// Format the captured messages, one per line.
+		FString Format() const;
+
+		// Get the name of a severity.
+		static const TCHAR* GetSeverityName(EWebBrowserConsoleLogSeverity Severity);
+
+	private:
+		// Take a token from the rate limit of a severity, returns false if there are none.
+		bool TryConsumeLine(EWebBrowserConsoleLogSeverity Severity, double NowSeconds);
+
+	private:
+		static constexpr int32 NumSeverities = int32(EWebBrowserConsoleLogSeverity::Fatal) + 1;
+
+		// Rate limit of a severity.
+		struct FLineBudget
+		{
+			float Lines = 0.0f;
+			double LastUpdateSeconds = 0.0;
+		};
+
+	private:
+		const FSettings Settings;
+		// Ring buffer of messages, grows up to Settings.Capacity.
+		TArray<FMessage> Messages;
+		// Index in Messages of the next message to write.
+		int32 NextIndex = 0;
+		TStaticArray<FLineBudget, NumSeverities> LineBudgets;
+		uint64 NumSuppressed = 0;
+	};
+}
@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantFrameRateGovernor.h"
+
+namespace UE::AIAssistant
+{
+	FFrameRateGovernor::FFrameRateGovernor(const FSettings& InSettings, double NowSeconds) :
+		Settings(InSettings),
+		StateEnteredSeconds(NowSeconds),
+		LastActivitySeconds(NowSeconds),
+		StateStats(InPlace)
+	{
+		StateStats[int32(State)].NumEntered = 1;
+	}
+
+	bool FFrameRateGovernor::Update(const FInputs& Inputs, double NowSeconds)
+	{
+		// While busy the browser keeps rendering even if it isn't visible, as a hidden page's
+		// timers are throttled which would slow down handling of the response.
+		if (Inputs.bIsBusy || Inputs.bHasUserInput)
+		{
+			LastActivitySeconds = NowSeconds;
+		}
+
+		EState NewState = EState::Active;
+		if (Inputs.bIsBusy)
+		{
+			NewState = EState::Active;
+		}
+		else if (!Inputs.bIsVisible)
+		{
+			NewState = EState::Hidden;
+		}
+		else if (!Inputs.bIsApplicationActive)
+		{
+			NewState = EState::Background;
+		}
+		else if (Settings.IdlePauseSeconds > 0.0 &&
+			NowSeconds - LastActivitySeconds >= Settings.IdlePauseSeconds)
+		{
+			NewState = EState::Idle;
+		}
+
+		const int32 PreviousFrameRate = GetFrameRate();
+		SetState(NewState, NowSeconds);
+		return GetFrameRate() != PreviousFrameRate;
+	}
+
+	int32 FFrameRateGovernor::GetFrameRate(EState InState) const
+	{
+		return InState == EState::Active ? Settings.ActiveFrameRate : 0;
+	}
+
+	FFrameRateGovernor::FStateStats FFrameRateGovernor::GetStateStats(
+		EState InState, double NowSeconds) const
+	{
+		FStateStats Stats = StateStats[int32(InState)];
+		if (InState == State)
+		{
+			Stats.Seconds += NowSeconds - StateEnteredSeconds;
+		}
+		return Stats;
+	}
+
+	FString FFrameRateGovernor::FormatStats(double NowSeconds) const
+	{
+		FString Table = FString::Printf(
+			TEXT("State: %s, frame rate: %d\n%-12s %10s %8s\n"),
+			GetStateName(State), GetFrameRate(), TEXT("State"), TEXT("Seconds"),
+			TEXT("Entered"));
+		for (int32 Index = 0; Index < int32(EState::Count); ++Index)
+		{
+			const FStateStats Stats = GetStateStats(EState(Index), NowSeconds);
+			Table += FString::Printf(
+				TEXT("%-12s %10.1f %8d\n"), GetStateName(EState(Index)), Stats.Seconds,
+				Stats.NumEntered);
+		}
+		return Table;
+	}
+
+	const TCHAR* FFrameRateGovernor::GetStateName(EState InState)
+	{
+		switch (InState)
+		{
+			case EState::Active:
+				return TEXT("Active");
+			case EState::Idle:
+				return TEXT("Idle");
+			case EState::Background:
+				return TEXT("Background");
+			case EState::Hidden:
+				return TEXT("Hidden");
+			default:
+				return TEXT("Unknown");
+		}
+	}
+
+	void FFrameRateGovernor::SetState(EState NewState, double NowSeconds)
+	{
+		if (NewState == State)
+		{
+			return;
+		}
+		StateStats[int32(State)].Seconds += NowSeconds - StateEnteredSeconds;
+		++StateStats[int32(NewState)].NumEntered;
+		State = NewState;
+		StateEnteredSeconds = NowSeconds;
+	}
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/StaticArray.h"
+#include "Containers/UnrealString.h"
+
+namespace UE::AIAssistant
+{
+	// Decides how often the assistant's off-screen browser renders.
+	//
+	// The browser renders at the full rate while it's busy (loading or running web API calls) or
+	// the user is interacting with it. Rendering is paused when the browser isn't visible, when
+	// the editor isn't the active application and, if enabled, when the browser has been idle for
+	// a while. Pausing is the only reduced rate as IWebBrowserWindow can't change the frame rate
+	// of a browser once it's created.
+	//
+	// The governor only makes decisions, the caller samples its inputs periodically and applies
+	// the frame rate. Time spent in each state is recorded for diagnostics.
+	class FFrameRateGovernor
+	{
+	public:
+		// Rendering state, ordered by priority.
+		enum class EState : uint8
+		{
+			// Rendering at the full rate.
+			Active = 0,
+			// Paused as the browser is visible but has had no activity.
+			Idle,
+			// Paused as the editor isn't the active application.
+			Background,
+			// Paused as the browser isn't visible.
+			Hidden,
+			Count,
+		};
+
+		struct FSettings
+		{
+			// Frame rate while rendering.
+			int32 ActiveFrameRate = 60;
+			// Seconds without activity before rendering is paused, zero disables pausing when idle.
+			double IdlePauseSeconds = 0.0;
+		};
+
+		// Inputs sampled by the caller.
+		struct FInputs
+		{
+			// Whether the browser is shown on screen.
+			bool bIsVisible = true;
+			// Whether the editor is the active application.
+			bool bIsApplicationActive = true;
+			// Whether the user is interacting with the browser, e.g hovering or focused.
+			bool bHasUserInput = false;
+			// Whether the browser is loading or streaming a response.
+			bool bIsBusy = false;
+		};
+
+		// Time spent in a state.
+		struct FStateStats
+		{
+			// Total seconds spent in the state including the current visit.
+			double Seconds = 0.0;
+			// Number of times the state was entered.
+			int32 NumEntered = 0;
+		};
+
+	public:
+		explicit FFrameRateGovernor(const FSettings& InSettings, double NowSeconds);
+
+		// Update the state from the inputs sampled at NowSeconds.
+		// Returns whether the frame rate changed.
+		bool Update(const FInputs& Inputs, double NowSeconds);
+
+		// Get the current state.
+		EState GetState() const { return State; }
+
+		// Get the frame rate of the current state, zero when rendering is paused.
+		int32 GetFrameRate() const { return GetFrameRate(State); }
+
+		// Get the frame rate of a state.
+		int32 GetFrameRate(EState InState) const;
+
+		// Get the time spent in a state up to NowSeconds.
+		FStateStats GetStateStats(EState InState, double NowSeconds) const;
+
+		// Get the settings.
+		const FSettings& GetSettings() const { return Settings; }
+
+		// Format the current state and the time spent in each state.
+		FString FormatStats(double NowSeconds) const;
+
+		// Get the name of a state.
+		static const TCHAR* GetStateName(EState InState);
+
+	private:
+		// Enter a state at NowSeconds.
+		void SetState(EState NewState, double NowSeconds);
+
+	private:
+		const FSettings Settings;
+		EState State = EState::Active;
+		// When State was entered.
+		double StateEnteredSeconds = 0.0;
+		// When the browser was last busy or had user input.
+		double LastActivitySeconds = 0.0;
+		// Time spent in each state excluding the current visit.
+		TStaticArray<FStateStats, int32(EState::Count)> StateStats;
+	};
+}
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantHoverDwell.h"
+
+namespace UE::AIAssistant
+{
+	FHoverDwell::FHoverDwell(const FSettings& InSettings) : Settings(InSettings)
+	{
+	}
+
+	bool FHoverDwell::Update(const FVector2f& CursorPosition, double NowSeconds)
+	{
+		if (!bHasRestPosition ||
+			FVector2f::DistSquared(CursorPosition, RestPosition) >
+				Settings.MaxRestingDistance * Settings.MaxRestingDistance)
+		{
+			RestPosition = CursorPosition;
+			bHasRestPosition = true;
+			Restart(NowSeconds);
+			return false;
+		}
+		if (bHasDwelled || NowSeconds - RestStartSeconds < Settings.DwellSeconds)
+		{
+			return false;
+		}
+		bHasDwelled = true;
+		return true;
+	}
+
+	void FHoverDwell::Restart(double NowSeconds)
+	{
+		RestStartSeconds = NowSeconds;
+		bHasDwelled = false;
+	}
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Math/Vector2D.h"
+
+namespace UE::AIAssistant
+{
+	// Detects when the cursor comes to rest.
+	//
+	// The caller samples the cursor every frame, while the cursor moves each sample is a single
+	// distance check. Once the cursor has stayed within a few pixels for the dwell time the dwell
+	// is reported, once per rest, so that work for the hovered widget is only done when the user
+	// pauses on it.
+	class FHoverDwell
+	{
+	public:
+		struct FSettings
+		{
+			// Seconds the cursor has to rest before the dwell is reported.
+			double DwellSeconds = 0.3;
+			// Pixels the cursor can move from where it came to rest while resting.
+			float MaxRestingDistance = 2.0f;
+		};
+
+	public:
+		explicit FHoverDwell(const FSettings& InSettings = FSettings());
+
+		// Sample the cursor position at NowSeconds.
+		// Returns true when the cursor has rested for the dwell time, once per rest.
+		bool Update(const FVector2f& CursorPosition, double NowSeconds);
+
+		// Start a new rest at the current position, e.g. after input that may change what is
+		// under the cursor.
+		void Restart(double NowSeconds);
+
+		// Whether the dwell has been reported for the current rest.
+		bool HasDwelled() const { return bHasDwelled; }
+
+		const FSettings& GetSettings() const { return Settings; }
+
+	private:
+		FSettings Settings;
+		// Where and when the cursor came to rest.
+		FVector2f RestPosition = FVector2f::ZeroVector;
+		double RestStartSeconds = 0.0;
+		bool bHasRestPosition = false;
+		bool bHasDwelled = false;
+	};
+}
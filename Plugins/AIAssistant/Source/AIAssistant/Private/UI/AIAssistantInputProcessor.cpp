@@ -3,6 +3,8 @@
 
 #include "AIAssistantInputProcessor.h"
 
+#include "AIAssistantSlateQuerier.h"
+
 #include "IDetailsView.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "Toolkits/BaseToolkit.h"
@@ -28,6 +30,8 @@ FAIAssistantInputProcessor::FAIAssistantInputProcessor(const TSharedPtr<FUIComma
 /*virtual*/ void FAIAssistantInputProcessor::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor)
 {
 	// Required to make this class non-abstract. No Super call available.
+
+	UE::AIAssistant::SlateQuerier::UpdateHoverQuery();
 }
 
 
@@ -35,14 +39,36 @@ FAIAssistantInputProcessor::FAIAssistantInputProcessor(const TSharedPtr<FUIComma
 {
 	// See all NOTE_AI_ASSISTANT_INPUT_PROCESSOR.
 	
+	bool bHandled = false;
 	if (const TSharedPtr<FUICommandList> PinnedCommands = Commands.Pin())
 	{
-		return PinnedCommands->ProcessCommandBindings(KeyEvent);
+		bHandled = PinnedCommands->ProcessCommandBindings(KeyEvent);
 	}
-	else
+
+	// After the commands, so the query hotkey can still use the precomputed query. The hotkey's modifiers are pressed first
+	// so they're ignored.
+	if (!KeyEvent.GetKey().IsModifierKey())
 	{
-		return false;
+		UE::AIAssistant::SlateQuerier::InvalidateHoverQuery();
 	}
+
+	return bHandled;
+}
+
+
+/*virtual*/ bool FAIAssistantInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) /*override*/
+{
+	UE::AIAssistant::SlateQuerier::InvalidateHoverQuery();
+
+	return false;
+}
+
+
+/*virtual*/ bool FAIAssistantInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& WheelEvent, const FPointerEvent* GestureEvent) /*override*/
+{
+	UE::AIAssistant::SlateQuerier::InvalidateHoverQuery();
+
+	return false;
 }
 
 
@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantSlateItemExtractors.h"
+
+#include "Algo/StableSort.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Layout/Children.h"
+#include "Misc/Optional.h"
+#include "Misc/OutputDevice.h"
+#include "Templates/UnrealTemplate.h"
+#include "Widgets/SWidget.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	static FAutoConsoleCommandWithArgsAndOutputDevice SlateItemExtractorsStatsConsoleCommand(
+		TEXT("ai.assistant.slatequerier.extractors.stats"),
+		TEXT("Print the calls and time of each extractor that describes the item under the cursor for AI assistant queries. ")
+		TEXT("Pass 'reset' to clear them."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda(
+			[](const TArray<FString>& Args, FOutputDevice& Output)
+			{
+				FSlateItemExtractorRegistry& Registry = FSlateItemExtractorRegistry::Get();
+				Output.Log(
+					LogAIAssistant.GetCategoryName(), ELogVerbosity::Display, Registry.FormatStats());
+				if (Args.Contains(TEXT("reset")))
+				{
+					Registry.ResetStats();
+				}
+			}));
+
+	FSlateItemExtractorRegistry& FSlateItemExtractorRegistry::Get()
+	{
+		static FSlateItemExtractorRegistry Registry;
+		return Registry;
+	}
+
+	FDelegateHandle FSlateItemExtractorRegistry::Register(FSlateItemExtractor Extractor)
+	{
+		FRegisteredExtractor Registered;
+		Registered.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+		Registered.Stats.Name = Extractor.Name;
+		Registered.Extractor = MoveTemp(Extractor);
+		const FDelegateHandle Handle = Registered.Handle;
+		if (bIsExtracting)
+		{
+			DeferredRegistrations.Add(MoveTemp(Registered));
+			return Handle;
+		}
+		Extractors.Add(MoveTemp(Registered));
+		Algo::StableSortBy(
+			Extractors, [](const FRegisteredExtractor& Other) { return Other.Extractor.Order; });
+		UpdateExtractorsByWidgetType();
+		return Handle;
+	}
+
+	void FSlateItemExtractorRegistry::Unregister(FDelegateHandle Handle)
+	{
+		const auto HasHandle = [Handle](const FRegisteredExtractor& Registered)
+		{
+			return Registered.Handle == Handle;
+		};
+		if (bIsExtracting)
+		{
+			if (DeferredRegistrations.RemoveAll(HasHandle) == 0)
+			{
+				DeferredUnregistrations.Add(Handle);
+			}
+			return;
+		}
+		if (Extractors.RemoveAll(HasHandle) > 0)
+		{
+			UpdateExtractorsByWidgetType();
+		}
+	}
+
+	void FSlateItemExtractorRegistry::Extract(
+		ISlateItemQuery& Query, FSlateItem& InOutItem, bool bRecordStats)
+	{
+		if (Extractors.IsEmpty() || Query.GetNumWidgets() == 0)
+		{
+			return;
+		}
+
+		// Extractors, possibly from other modules, may register or unregister extractors. That's
+		// deferred until the outermost extraction ends so Extractors isn't changed while it's
+		// iterated.
+		{
+			TGuardValue<bool> ExtractingGuard(bIsExtracting, true);
+			ExtractMatches(Query, InOutItem, bRecordStats);
+		}
+		if (!bIsExtracting)
+		{
+			ApplyDeferredChanges();
+		}
+	}
+
+	void FSlateItemExtractorRegistry::ExtractMatches(
+		ISlateItemQuery& Query, FSlateItem& InOutItem, bool bRecordStats)
+	{
+		// Find the deepest match of each extractor with one lookup per widget.
+		TArray<TOptional<FSlateItemMatch>, TInlineAllocator<16>> Matches;
+		Matches.SetNum(Extractors.Num());
+		const int32 HoveredWidgetIndex = Query.GetNumWidgets() - 1;
+		for (int32 WidgetIndex = HoveredWidgetIndex; WidgetIndex >= 0; --WidgetIndex)
+		{
+			if (const TArray<int32>* ExtractorIndices =
+					ExtractorsByWidgetType.Find(Query.GetWidgetTypeAt(WidgetIndex)))
+			{
+				for (const int32 ExtractorIndex : *ExtractorIndices)
+				{
+					if (!Matches[ExtractorIndex].IsSet())
+					{
+						Matches[ExtractorIndex].Emplace(
+							FSlateItemMatch{ Query.GetWidgetAt(WidgetIndex), WidgetIndex });
+					}
+				}
+			}
+		}
+
+		// Disabled entries contain their block, so extractors that opt in match the children of the hovered widget
+		// when there's no widget of their types in the path. The last matching child is used.
+		const TSharedRef<SWidget> HoveredWidget = Query.GetWidgetAt(HoveredWidgetIndex);
+		FChildren* HoveredWidgetChildren = HoveredWidget->GetChildren();
+		for (int32 ChildIndex = 0; HoveredWidgetChildren && ChildIndex < HoveredWidgetChildren->Num();
+			 ++ChildIndex)
+		{
+			const TSharedRef<SWidget> Child = HoveredWidgetChildren->GetChildAt(ChildIndex);
+			const TArray<int32>* ExtractorIndices = ExtractorsByWidgetType.Find(Child->GetType());
+			if (!ExtractorIndices)
+			{
+				continue;
+			}
+			for (const int32 ExtractorIndex : *ExtractorIndices)
+			{
+				TOptional<FSlateItemMatch>& Match = Matches[ExtractorIndex];
+				if (Extractors[ExtractorIndex].Extractor.bMatchHoveredWidgetChildren &&
+					(!Match.IsSet() || Match->WidgetIndex == INDEX_NONE))
+				{
+					Match.Emplace(FSlateItemMatch{ Child, INDEX_NONE });
+				}
+			}
+		}
+
+		for (int32 ExtractorIndex = 0; ExtractorIndex < Extractors.Num(); ++ExtractorIndex)
+		{
+			if (!Matches[ExtractorIndex].IsSet())
+			{
+				continue;
+			}
+			FRegisteredExtractor& Registered = Extractors[ExtractorIndex];
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			const bool bDescribed = Registered.Extractor.Extract(Query, *Matches[ExtractorIndex], InOutItem);
+			const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+			if (!bRecordStats)
+			{
+				continue;
+			}
+
+			++Registered.Stats.NumCalls;
+			Registered.Stats.NumDescribed += bDescribed ? 1 : 0;
+			Registered.Stats.TotalSeconds += Seconds;
+			Registered.Stats.MaxSeconds = FMath::Max(Registered.Stats.MaxSeconds, Seconds);
+		}
+	}
+
+	TArray<FSlateItemExtractorRegistry::FStats> FSlateItemExtractorRegistry::GetStats() const
+	{
+		TArray<FStats> Stats;
+		Stats.Reserve(Extractors.Num());
+		for (const FRegisteredExtractor& Registered : Extractors)
+		{
+			Stats.Add(Registered.Stats);
+		}
+		return Stats;
+	}
+
+	void FSlateItemExtractorRegistry::ResetStats()
+	{
+		for (FRegisteredExtractor& Registered : Extractors)
+		{
+			Registered.Stats = FStats{ Registered.Extractor.Name };
+		}
+	}
+
+	FString FSlateItemExtractorRegistry::FormatStats() const
+	{
+		FString Text = FString::Printf(TEXT("%d Slate item extractors.\n"), Extractors.Num());
+		for (const FRegisteredExtractor& Registered : Extractors)
+		{
+			const FStats& Stats = Registered.Stats;
+			Text += FString::Printf(
+				TEXT("%s (order %d): %d calls, %d described, %.3f ms total, %.3f ms max\n"),
+				*Stats.Name.ToString(), Registered.Extractor.Order, Stats.NumCalls, Stats.NumDescribed,
+				Stats.TotalSeconds * 1000.0, Stats.MaxSeconds * 1000.0);
+		}
+		return Text;
+	}
+
+	void FSlateItemExtractorRegistry::ApplyDeferredChanges()
+	{
+		if (DeferredRegistrations.IsEmpty() && DeferredUnregistrations.IsEmpty())
+		{
+			return;
+		}
+		Extractors.RemoveAll(
+			[this](const FRegisteredExtractor& Registered)
+			{
+				return DeferredUnregistrations.Contains(Registered.Handle);
+			});
+		Extractors.Append(MoveTemp(DeferredRegistrations));
+		DeferredRegistrations.Reset();
+		DeferredUnregistrations.Reset();
+		Algo::StableSortBy(
+			Extractors, [](const FRegisteredExtractor& Other) { return Other.Extractor.Order; });
+		UpdateExtractorsByWidgetType();
+	}
+
+	void FSlateItemExtractorRegistry::UpdateExtractorsByWidgetType()
+	{
+		ExtractorsByWidgetType.Reset();
+		for (int32 ExtractorIndex = 0; ExtractorIndex < Extractors.Num(); ++ExtractorIndex)
+		{
+			for (const FName& WidgetType : Extractors[ExtractorIndex].Extractor.WidgetTypes)
+			{
+				ExtractorsByWidgetType.FindOrAdd(WidgetType).AddUnique(ExtractorIndex);
+			}
+		}
+	}
+}
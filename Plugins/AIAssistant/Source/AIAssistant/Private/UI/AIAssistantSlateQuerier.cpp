@@ -4,7 +4,6 @@
 #include "AIAssistantSlateQuerier.h"
 
 #include "EditorModes.h"
-#include "Internationalization/Regex.h"
 #include "LevelEditorSubsystem.h"
 #include "EditorModeManager.h"
 #include "IDetailsView.h"
@@ -18,14 +17,74 @@
 #include "Widgets/Docking/SDockTab.h"
 #include "SGraphNode.h"
 #include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Core/AIAssistantLog.h"
 #include "Core/AIAssistantSubsystem.h"
+#include "AIAssistantHoverDwell.h"
+#include "AIAssistantSlateItemExtractors.h"
 #include "AIAssistantWebBrowser.h"
+#include "AIAssistantWidgetPathIndex.h"
+#include "Utils/AIAssistantTextUtils.h"
+#include "Utils/AIAssistantTreeSearch.h"
+
+
+using UE::AIAssistant::EWidgetRole;
+using UE::AIAssistant::ETreeSearchVisit;
+using UE::AIAssistant::FTreeSearchBudget;
+using UE::AIAssistant::FWidgetPathIndex;
 
 
 #define LOCTEXT_NAMESPACE "FAIAssistantSlateQuerier"
 
 
+//
+// Console Variables
+//
+
+
+// Widgets visited by the searches below a widget for a single query.
+static int32 AIAssistantSlateQuerierMaxSearchWidgets = 20000;
+
+static FAutoConsoleVariableRef AIAssistantSlateQuerierMaxSearchWidgetsConsoleVariableRef(
+	TEXT("ai.assistant.slatequerier.maxsearchwidgets"), AIAssistantSlateQuerierMaxSearchWidgets,
+	TEXT("Maximum number of widgets the AI assistant visits when searching below the widgets under the cursor for a query, 0 for ")
+	TEXT("no limit. Once reached the query is sent with the context found so far."));
+
+// Time the searches below a widget can take for a single query.
+static float AIAssistantSlateQuerierMaxSearchMilliseconds = 20.0f;
+
+static FAutoConsoleVariableRef AIAssistantSlateQuerierMaxSearchMillisecondsConsoleVariableRef(
+	TEXT("ai.assistant.slatequerier.maxsearchmilliseconds"), AIAssistantSlateQuerierMaxSearchMilliseconds,
+	TEXT("Maximum milliseconds the AI assistant spends searching below the widgets under the cursor for a query, 0 for no limit. ")
+	TEXT("Once reached the query is sent with the context found so far."));
+
+// Whether the query is generated while the cursor rests on a widget, rather than when it's requested.
+static bool bAIAssistantSlateQuerierPrecompute = false;
+
+static FAutoConsoleVariableRef AIAssistantSlateQuerierPrecomputeConsoleVariableRef(
+	TEXT("ai.assistant.slatequerier.precompute"), bAIAssistantSlateQuerierPrecompute,
+	TEXT("Whether the AI assistant generates the query about the widget under the cursor once the cursor rests on it, so that ")
+	TEXT("the query hotkey answers without searching the widgets."));
+
+// Time the searches below a widget can take for a query generated while the cursor rests.
+static float AIAssistantSlateQuerierPrecomputeMaxSearchMilliseconds = 2.0f;
+
+static FAutoConsoleVariableRef AIAssistantSlateQuerierPrecomputeMaxSearchMillisecondsConsoleVariableRef(
+	TEXT("ai.assistant.slatequerier.precomputemaxsearchmilliseconds"), AIAssistantSlateQuerierPrecomputeMaxSearchMilliseconds,
+	TEXT("Maximum milliseconds the AI assistant spends searching below the widgets under the cursor when generating the query ")
+	TEXT("while the cursor rests, 0 for no limit. Once reached the query is discarded and generated again when the hotkey is ")
+	TEXT("pressed, using ai.assistant.slatequerier.maxsearchmilliseconds."));
+
+// Seconds the cursor has to rest on a widget before the query about it is generated.
+static float AIAssistantSlateQuerierPrecomputeDwellSeconds = 0.3f;
+
+static FAutoConsoleVariableRef AIAssistantSlateQuerierPrecomputeDwellSecondsConsoleVariableRef(
+	TEXT("ai.assistant.slatequerier.precomputedwellseconds"), AIAssistantSlateQuerierPrecomputeDwellSeconds,
+	TEXT("Seconds the cursor has to rest on a widget before the AI assistant generates the query about it, when ")
+	TEXT("ai.assistant.slatequerier.precompute is enabled."));
+
+
 //
 // FAIAssistantSlateQueryContext
 //
@@ -41,136 +100,176 @@ struct FAIAssistantSlateQueryContext
 	bool bIsUIWidget = false;
 	bool bIsObject = false;
 	bool bInOutliner = false;
+	// Whether the query is generated ahead of the hotkey while the cursor rests, so may never be used.
+	bool bIsPrecompute = false;
 
 	FText GeneratedQuery = FText();
 	FText GeneratedContext = FText();
 	FText GeneratedQueryInstructions = FText();
+
+	// Shared by all searches below widgets so that a huge widget tree can't stall the query.
+	FTreeSearchBudget SearchBudget = FTreeSearchBudget(
+		AIAssistantSlateQuerierMaxSearchWidgets, AIAssistantSlateQuerierMaxSearchMilliseconds / 1000.0);
+};
+
+
+//
+// FAIAssistantSlateQuery
+//
+// The messages sent to AI Assistant for a query.
+//
+
+
+struct FAIAssistantSlateQuery
+{
+	FString VisiblePrompt;
+	FString HiddenContext;
 };
 
 
+//
+// FAIAssistantPrecomputedSlateQuery
+//
+// The query generated while the cursor rested on a widget. It's used by the query hotkey if the widget is still under the
+// cursor, and discarded when the cursor moves or there's input that may change what the query describes.
+//
+
+
+struct FAIAssistantPrecomputedSlateQuery
+{
+	TWeakPtr<SWidget> HoveredWidget;
+	bool bHadToolTip = false;
+	double Seconds = 0.0;
+	TOptional<FAIAssistantSlateQuery> Query;
+	// Whether the searches finished within the precompute budget, otherwise the hotkey generates the query again.
+	bool bIsComplete = false;
+};
+
+
+static UE::AIAssistant::FHoverDwell AIAssistantSlateQuerierHoverDwell;
+
+static TOptional<FAIAssistantPrecomputedSlateQuery> AIAssistantSlateQuerierPrecomputedQuery;
+
+
 //
 // Statics
 //
 
 
-static TSharedRef<SWidget> FindClosestWidgetOfType(const FWidgetPath& WidgetPathToTest, const FName& WidgetType)
+static TSharedRef<SWidget> GetIndexedWidget(const FWidgetPath& WidgetPathToTest, int32 WidgetIndex)
 {
-	for (int32 WidgetIndex = WidgetPathToTest.Widgets.Num() - 1; WidgetIndex >= 0; --WidgetIndex)
-	{
-		const FArrangedWidget* ArrangedWidget = &WidgetPathToTest.Widgets[WidgetIndex];
-		const TSharedRef<SWidget>& ThisWidget = ArrangedWidget->Widget;
-		if (ThisWidget->GetType() == WidgetType)
-		{
-			return ThisWidget;
-		}
-	}
-	
-	return SNullWidget::NullWidget;
+	return WidgetIndex == INDEX_NONE ? SNullWidget::NullWidget : WidgetPathToTest.Widgets[WidgetIndex].Widget;
 }
 
 
-static TSharedRef<SWidget> FindFirstWidgetOfType(const FWidgetPath& WidgetPathToTest, const FName& WidgetType)
+static TSharedRef<SWidget> FindClosestWidgetOfType(const FWidgetPath& WidgetPathToTest, const FWidgetPathIndex& WidgetPathIndex, EWidgetRole WidgetRole)
 {
-	for (int32 WidgetIndex = 0; WidgetIndex < WidgetPathToTest.Widgets.Num(); WidgetIndex++)
-	{
-		const FArrangedWidget* ArrangedWidget = &WidgetPathToTest.Widgets[WidgetIndex];
-		const TSharedRef<SWidget>& ThisWidget = ArrangedWidget->Widget;
-		if (ThisWidget->GetType() == WidgetType)
+	return GetIndexedWidget(WidgetPathToTest, WidgetPathIndex.FindClosest(WidgetRole));
+}
+
+
+static TSharedRef<SWidget> FindFirstWidgetOfType(const FWidgetPath& WidgetPathToTest, const FWidgetPathIndex& WidgetPathIndex, EWidgetRole WidgetRole)
+{
+	return GetIndexedWidget(WidgetPathToTest, WidgetPathIndex.FindFurthest(WidgetRole));
+}
+
+
+// Visit a widget's descendants depth first, skipping subtrees that aren't visible.
+template <typename VisitType>
+static void SearchDescendantWidgets(const TSharedRef<SWidget>& RootWidget, bool bVisitRoot, FTreeSearchBudget& SearchBudget, VisitType&& Visit)
+{
+	(void)UE::AIAssistant::SearchTree(
+		RootWidget, SearchBudget,
+		[](const TSharedRef<SWidget>& Widget) { return Widget->GetChildren()->Num(); },
+		[](const TSharedRef<SWidget>& Widget, int32 ChildIndex) { return Widget->GetChildren()->GetChildAt(ChildIndex); },
+		[&RootWidget, bVisitRoot, &Visit](const TSharedRef<SWidget>& Widget)
 		{
-			return ThisWidget;
-		}
-	}
-	
-	return SNullWidget::NullWidget;
+			if (Widget == RootWidget)
+			{
+				return bVisitRoot ? Visit(Widget) : ETreeSearchVisit::Continue;
+			}
+			if (!Widget->GetVisibility().IsVisible())
+			{
+				return ETreeSearchVisit::SkipChildren;
+			}
+			return Visit(Widget);
+		});
 }
 
 
-static void FindChildWidgetsOfType(TArray<TSharedRef<SWidget>>& OutWidgets, TSharedPtr<SWidget> WidgetToTest, const FName& WidgetType)
+static void FindChildWidgetsOfType(TArray<TSharedRef<SWidget>>& OutWidgets, TSharedPtr<SWidget> WidgetToTest, const FName& WidgetType, FTreeSearchBudget& SearchBudget)
 {
 	if (WidgetToTest.IsValid())
 	{
-		for (int32 ChildIdx = 0; ChildIdx < WidgetToTest->GetChildren()->Num(); ChildIdx++)
-		{
-			TSharedRef<SWidget> ThisWidget = WidgetToTest->GetChildren()->GetChildAt(ChildIdx);
-			if (ThisWidget->GetType() == WidgetType)
+		SearchDescendantWidgets(WidgetToTest.ToSharedRef(), false, SearchBudget,
+			[&OutWidgets, &WidgetType](const TSharedRef<SWidget>& ThisWidget)
 			{
-				OutWidgets.Add(ThisWidget);
-			}
-			FindChildWidgetsOfType(OutWidgets, ThisWidget.ToSharedPtr(), WidgetType);
-		}
+				if (ThisWidget->GetType() == WidgetType)
+				{
+					OutWidgets.Add(ThisWidget);
+				}
+				return ETreeSearchVisit::Continue;
+			});
 	}
 }
 
 
-static TSharedRef<SWidget> FindChildWidgetOfType(const TSharedPtr<SWidget> WidgetToTest, const FName& WidgetType)
+static TSharedRef<SWidget> FindChildWidgetOfType(const TSharedPtr<SWidget> WidgetToTest, const FName& WidgetType, FTreeSearchBudget& SearchBudget)
 {
+	TSharedRef<SWidget> OutWidget = SNullWidget::NullWidget;
 	if (WidgetToTest.IsValid())
 	{
-		for (int32 ChildIdx = 0; ChildIdx < WidgetToTest->GetChildren()->Num(); ChildIdx++)
-		{
-			TSharedRef<SWidget> ThisWidget = WidgetToTest->GetChildren()->GetChildAt(ChildIdx);
-			if (ThisWidget->GetType() == WidgetType)
+		SearchDescendantWidgets(WidgetToTest.ToSharedRef(), false, SearchBudget,
+			[&OutWidget, &WidgetType](const TSharedRef<SWidget>& ThisWidget)
 			{
-				return ThisWidget;
-			}
-			else
-			{
-				TSharedRef<SWidget> ChildWidget = FindChildWidgetOfType(ThisWidget.ToSharedPtr(), WidgetType);
-				if (ChildWidget->GetType() == WidgetType)
+				if (ThisWidget->GetType() == WidgetType)
 				{
-					return ChildWidget;
+					OutWidget = ThisWidget;
+					return ETreeSearchVisit::Stop;
 				}
-			}
-		}
+				return ETreeSearchVisit::Continue;
+			});
 	}
 	
-	return SNullWidget::NullWidget;
+	return OutWidget;
 }
 
 
-static FText FindChildWidgetWithText(const TSharedPtr<SWidget> WidgetToTest)
+static FText FindChildWidgetWithText(const TSharedPtr<SWidget> WidgetToTest, FTreeSearchBudget& SearchBudget)
 {
 	// get all children and see if any are text widgets.
 	// refuse any that only contain numbers (they're probably just values)
-	const FRegexPattern AlphaPattern(TEXT("[A-Za-z]+"));
+	FText OutText = FText();
 	if (WidgetToTest.IsValid())
 	{
-		if (WidgetToTest->GetType() == "STextBlock")
-		{
-			TSharedRef<STextBlock> TextBlock = StaticCastSharedRef<STextBlock>(WidgetToTest.ToSharedRef());
-			const FText WidgetText = TextBlock->GetText();
-			if (!WidgetText.IsEmpty())
+		SearchDescendantWidgets(WidgetToTest.ToSharedRef(), true, SearchBudget,
+			[&OutText](const TSharedRef<SWidget>& ThisWidget)
 			{
-				FRegexMatcher AlphaMatcher(AlphaPattern, WidgetText.ToString());
-				if (AlphaMatcher.FindNext())
+				if (ThisWidget->GetType() == "STextBlock")
 				{
-					return WidgetText;
+					const FText& WidgetText = StaticCastSharedRef<STextBlock>(ThisWidget)->GetText();
+					if (UE::AIAssistant::ContainsAsciiLetter(WidgetText))
+					{
+						OutText = WidgetText;
+						return ETreeSearchVisit::Stop;
+					}
 				}
-			}
-		}
-		for (int32 ChildIdx = 0; ChildIdx < WidgetToTest->GetChildren()->Num(); ChildIdx++)
-		{
-			TSharedRef<SWidget> ThisWidget = WidgetToTest->GetChildren()->GetChildAt(ChildIdx);
-			const FText ChildText = FindChildWidgetWithText(ThisWidget.ToSharedPtr());
-			if (!ChildText.IsEmpty())
-			{
-				return ChildText;
-			}
-		}
+				return ETreeSearchVisit::Continue;
+			});
 	}
 	
-	return FText();
+	return OutText;
 }
 
 
-static FText FindCurrentToolTipText()
+static FText FindCurrentToolTipText(FTreeSearchBudget& SearchBudget)
 {
 	for (const TArray<TSharedRef<SWindow>> AllWindows = FSlateApplication::Get().GetTopLevelWindows();
 		const TSharedRef<SWindow>& ThisWindow : AllWindows)
 	{
 		if (ThisWindow->GetType() == EWindowType::ToolTip && ThisWindow->IsVisible())
 		{
-			return FindChildWidgetWithText(ThisWindow);
+			return FindChildWidgetWithText(ThisWindow, SearchBudget);
 		}
 	}
 	
@@ -178,15 +277,15 @@ static FText FindCurrentToolTipText()
 }
 
 
-static TSharedRef<SWidget> FindClosestMenuItem(const FWidgetPath& WidgetPath)
+static TSharedRef<SWidget> FindClosestMenuItem(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex)
 {
 	if (WidgetPath.IsValid())
 	{
 		// is it a menu item? Look up for an SMenuEntryBlock or SWidgetBlock.
-		TSharedRef<SWidget> MenuItemBlock = FindClosestWidgetOfType(WidgetPath, "SMenuEntryBlock");
+		TSharedRef<SWidget> MenuItemBlock = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::MenuEntryBlock);
 		if (MenuItemBlock->GetType() == "SNullWidgetContent")
 		{
-			MenuItemBlock = FindClosestWidgetOfType(WidgetPath, "SWidgetBlock");
+			MenuItemBlock = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::WidgetBlock);
 		}
 		// disabled menu items *contain* the menu entry block
 		if (MenuItemBlock->GetType() == "SNullWidgetContent")
@@ -213,9 +312,9 @@ static TSharedRef<SWidget> FindClosestMenuItem(const FWidgetPath& WidgetPath)
 }
 
 
-static FWidgetPath FindContextWidgetPath(const FWidgetPath& WidgetPath)
+static TOptional<FWidgetPath> FindMenuHostWidgetPath(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex)
 {
-	if (const TSharedRef<SWidget> MenuItem = FindClosestMenuItem(WidgetPath);
+	if (const TSharedRef<SWidget> MenuItem = FindClosestMenuItem(WidgetPath, WidgetPathIndex);
 		MenuItem->GetType() != "SNullWidgetContent")
 	{
 		TSharedPtr<SWidget> RootWidget = FSlateApplication::Get().GetMenuHostWidget();
@@ -226,16 +325,16 @@ static FWidgetPath FindContextWidgetPath(const FWidgetPath& WidgetPath)
 			return OutWidgetPath;
 		}
 	}
-	return WidgetPath;
+	return TOptional<FWidgetPath>();
 }
 
 
-static FText GenerateModeToolContext(const FWidgetPath& WidgetPath)
+static FText GenerateModeToolContext(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex)
 {
 	FText OutContext = FText();
 
 	// if we're in a level editor mode, include which tool is active
-	TSharedRef<SWidget> LevelEditor = FindClosestWidgetOfType(WidgetPath, "SLevelEditor");
+	TSharedRef<SWidget> LevelEditor = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::LevelEditor);
 	if (LevelEditor->GetType() != "SNullWidgetContent")
 	{
 		FText ToolString;
@@ -270,304 +369,396 @@ static FText GenerateModeToolContext(const FWidgetPath& WidgetPath)
 }
 
 
-static FText FindItemName(const FWidgetPath& WidgetPath, FAIAssistantSlateQueryContext& SlateQueryContext)
+//
+// FAIAssistantSlateItemQuery
+//
+// The widget path under the cursor as seen by the Slate item extractors.
+//
+
+
+class FAIAssistantSlateItemQuery : public UE::AIAssistant::ISlateItemQuery
 {
-	FText OutName = FText();
-	FText OutDescriptor = LOCTEXT("ItemDescriptor_Generic", "control");
-	TSet<FName> ButtonTypes = TSet<FName>({
-		"SButton",
-		"SPrimaryButton",
-		"SCheckbox"
-		});
+public:
+	FAIAssistantSlateItemQuery(const FWidgetPath& InWidgetPath, const FWidgetPathIndex& InWidgetPathIndex, FAIAssistantSlateQueryContext& InSlateQueryContext) :
+		WidgetPath(InWidgetPath), WidgetPathIndex(InWidgetPathIndex), SlateQueryContext(InSlateQueryContext)
+	{
+	}
 
-	FText ChildText = FText();
+	/*virtual*/ int32 GetNumWidgets() const /*override*/
+	{
+		return WidgetPathIndex.Num();
+	}
 
-	if (!WidgetPath.IsValid())
+	/*virtual*/ TSharedRef<SWidget> GetWidgetAt(int32 WidgetIndex) const /*override*/
 	{
-		return OutName;
+		return WidgetPath.Widgets[WidgetIndex].Widget;
 	}
 
-	// Is it a graph node?
-	// Look up for an SGraphEditor and then down for an SGraphPanel. Whatever is the child of that SGraphPanel is our SGraphNode.
-	// Note that this rests on the assumption that SGraphPanel only contains children that are SGraphNodes. This assumption is also
-	// made in the code of SGraphPanel itself.
-	TSharedPtr<SGraphEditor> GraphEditor;
-	for (int32 WidgetIndex = WidgetPath.Widgets.Num() - 1; WidgetIndex >= 0; --WidgetIndex)
+	/*virtual*/ FName GetWidgetTypeAt(int32 WidgetIndex) const /*override*/
 	{
-		const FArrangedWidget* ArrangedWidget = &WidgetPath.Widgets[WidgetIndex];
-		const TSharedRef<SWidget>& ThisWidget = ArrangedWidget->Widget;
-		if (ThisWidget->GetType() == "SGraphEditor")
+		return WidgetPathIndex.GetTypeAt(WidgetIndex);
+	}
+
+	/*virtual*/ int32 FindClosestWidget(FName WidgetType) const /*override*/
+	{
+		if (const EWidgetRole WidgetRole = FWidgetPathIndex::GetRole(WidgetType); WidgetRole != EWidgetRole::Unclassified)
 		{
-			for (int32 EditorDescendantIndex = WidgetIndex; EditorDescendantIndex < WidgetPath.Widgets.Num(); EditorDescendantIndex++)
+			return WidgetPathIndex.FindClosest(WidgetRole);
+		}
+		for (int32 WidgetIndex = WidgetPathIndex.Num() - 1; WidgetIndex >= 0; --WidgetIndex)
+		{
+			if (WidgetPathIndex.GetTypeAt(WidgetIndex) == WidgetType)
 			{
-				const FArrangedWidget* DescendantArrangedWidget = &WidgetPath.Widgets[EditorDescendantIndex];
-				const TSharedRef<SWidget>& ThisDescendantWidget = DescendantArrangedWidget->Widget;
-				if (ThisDescendantWidget->GetType() == "SGraphPanel" && (EditorDescendantIndex + 1 < WidgetPath.Widgets.Num()))
-				{
-					const FArrangedWidget* NodeArrangedWidget = &WidgetPath.Widgets[EditorDescendantIndex+1];
-					const TSharedRef<SWidget>& ThisNodeWidget = NodeArrangedWidget->Widget;
-					if (ThisNodeWidget->GetType() == "SNiagaraOverviewStackNode")
-					{
-						// Niagara emitters don't typically have useful node names
-						continue;
-					}
-					const TSharedPtr<SGraphNode> AsGraphNode = StaticCastSharedPtr<SGraphNode>(ThisNodeWidget.ToSharedPtr());
-					OutName = AsGraphNode->GetNodeObj()->GetNodeTitle(ENodeTitleType::MenuTitle);
-					OutDescriptor = LOCTEXT("ItemDescriptor_GraphNode", "graph node");
-					SlateQueryContext.LastPickedWidget = ThisNodeWidget.ToSharedPtr();
-				}
+				return WidgetIndex;
 			}
 		}
+		return INDEX_NONE;
 	}
 
-
-	// Is it a button? Look up for an SButton and then down for the text.
-	TSharedPtr<SWidget> Button;
-	for (int32 WidgetIndex = WidgetPath.Widgets.Num() - 1; WidgetIndex >= 0; --WidgetIndex)
+	/*virtual*/ int32 FindFurthestWidget(FName WidgetType) const /*override*/
 	{
-		const FArrangedWidget* ArrangedWidget = &WidgetPath.Widgets[WidgetIndex];
-		const TSharedRef<SWidget>& ThisWidget = ArrangedWidget->Widget;
-		if (ButtonTypes.Contains(ThisWidget->GetType()))
+		if (const EWidgetRole WidgetRole = FWidgetPathIndex::GetRole(WidgetType); WidgetRole != EWidgetRole::Unclassified)
 		{
-			Button = ThisWidget.ToSharedPtr();
+			return WidgetPathIndex.FindFurthest(WidgetRole);
 		}
-	}
-	// Disabled buttons *contain* the menu entry block.
-	if (!Button.IsValid() && WidgetPath.GetLastWidget()->GetChildren()->Num() > 0)
-	{
-		for (int32 ChildIdx = 0; ChildIdx < WidgetPath.GetLastWidget()->GetChildren()->Num(); ChildIdx++)
+		for (int32 WidgetIndex = 0; WidgetIndex < WidgetPathIndex.Num(); ++WidgetIndex)
 		{
-			TSharedRef<SWidget> ThisWidget = WidgetPath.GetLastWidget()->GetChildren()->GetChildAt(ChildIdx);
-			if (ButtonTypes.Contains(ThisWidget->GetType()))
+			if (WidgetPathIndex.GetTypeAt(WidgetIndex) == WidgetType)
 			{
-				Button = ThisWidget.ToSharedPtr();
+				return WidgetIndex;
 			}
 		}
+		return INDEX_NONE;
+	}
+
+	/*virtual*/ const FText& GetToolTipText() const /*override*/
+	{
+		return SlateQueryContext.CurrentToolTipText;
+	}
+
+	/*virtual*/ FText FindChildText(const TSharedRef<SWidget>& Widget) /*override*/
+	{
+		return FindChildWidgetWithText(Widget, SlateQueryContext.SearchBudget);
+	}
+
+	/*virtual*/ TSharedPtr<SWidget> FindChildWidget(const TSharedRef<SWidget>& Widget, FName WidgetType) /*override*/
+	{
+		const TSharedRef<SWidget> ChildWidget = FindChildWidgetOfType(Widget, WidgetType, SlateQueryContext.SearchBudget);
+		return ChildWidget->GetType() != "SNullWidgetContent" ? ChildWidget.ToSharedPtr() : TSharedPtr<SWidget>();
 	}
-	if (Button.IsValid())
+
+private:
+	const FWidgetPath& WidgetPath;
+	const FWidgetPathIndex& WidgetPathIndex;
+	FAIAssistantSlateQueryContext& SlateQueryContext;
+};
+
+
+//
+// Slate Item Extractors
+//
+// The built-in extractors that describe the item under the cursor, in the order they're run. Each can override what the
+// ones before it found.
+//
+
+
+static TArray<FDelegateHandle> AIAssistantSlateQuerierItemExtractorHandles;
+
+
+/**
+ * @param Query The widgets under the cursor.
+ * @param Match Where a widget of one of the types was found.
+ * @param PreferredWidgetTypes Widget types in order of preference.
+ * @return The closest widget of the most preferred type in the path, or the matched child of the hovered widget.
+ */
+static TSharedRef<SWidget> GetPreferredSlateItemWidget(const UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, std::initializer_list<FName> PreferredWidgetTypes)
+{
+	if (Match.WidgetIndex != INDEX_NONE)
 	{
-		ChildText = FindChildWidgetWithText(Button);
-		if (!ChildText.IsEmpty() || !SlateQueryContext.CurrentToolTipText.IsEmpty())
+		for (const FName& WidgetType : PreferredWidgetTypes)
 		{
-			if (!ChildText.IsEmpty())
+			if (const int32 WidgetIndex = Query.FindClosestWidget(WidgetType); WidgetIndex != INDEX_NONE)
 			{
-				OutName = ChildText;
+				return Query.GetWidgetAt(WidgetIndex);
 			}
-			else
-			{
-				// The tool tip can be used in this case.
-				OutName = SlateQueryContext.CurrentToolTipText;
-			}
-			OutDescriptor = LOCTEXT("ItemDescriptor_Button", "button");
-			SlateQueryContext.LastPickedWidget = Button;
-			SlateQueryContext.bIsUIWidget = true;
 		}
 	}
+	return Match.Widget;
+}
 
 
-	// Is it a toolbar button? Look for an SToolbarButtonBlock.
-	TSharedRef<SWidget> ToolbarItemBlock = FindClosestWidgetOfType(WidgetPath, "SToolBarButtonBlock");
-	if (ToolbarItemBlock->GetType() == "SNullWidgetContent")
+/**
+ * Describes a UI widget by the text below it, or by the open tool tip if it has no text.
+ */
+static bool DescribeSlateItemByTextOrToolTip(UE::AIAssistant::ISlateItemQuery& Query, const TSharedRef<SWidget>& Widget, const FText& Descriptor, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const FText ChildText = Query.FindChildText(Widget);
+	if (ChildText.IsEmpty() && Query.GetToolTipText().IsEmpty())
 	{
-		ToolbarItemBlock = FindClosestWidgetOfType(WidgetPath, "SToolBarComboButtonBlock");
+		return false;
 	}
-	// Disabled items *contain* the entry block.
-	if (ToolbarItemBlock->GetType() == "SNullWidgetContent")
+
+	// The tool tip can be used if there's no text.
+	InOutItem.Name = !ChildText.IsEmpty() ? ChildText : Query.GetToolTipText();
+	InOutItem.Descriptor = Descriptor;
+	InOutItem.Widget = Widget;
+	InOutItem.bIsUIWidget = true;
+	return true;
+}
+
+
+// Is it a graph node?
+// Look up for an SGraphEditor and then down for an SGraphPanel. Whatever is the child of that SGraphPanel is our SGraphNode.
+// Note that this rests on the assumption that SGraphPanel only contains children that are SGraphNodes. This assumption is also
+// made in the code of SGraphPanel itself.
+// When panels are nested the deepest SGraphPanel below the outermost SGraphEditor is used.
+static bool ExtractGraphNodeSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& /*Match*/, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const int32 GraphEditorIndex = Query.FindFurthestWidget("SGraphEditor");
+	for (int32 WidgetIndex = Query.GetNumWidgets() - 2; WidgetIndex >= GraphEditorIndex; --WidgetIndex)
 	{
-		if (WidgetPath.GetLastWidget()->GetChildren()->Num() > 0)
+		if (Query.GetWidgetTypeAt(WidgetIndex) != "SGraphPanel")
 		{
-			for (int32 ChildIdx = 0; ChildIdx < WidgetPath.GetLastWidget()->GetChildren()->Num(); ChildIdx++)
-			{
-				TSharedRef<SWidget> ThisWidget = WidgetPath.GetLastWidget()->GetChildren()->GetChildAt(ChildIdx);
-				if (ThisWidget->GetType() == "SToolBarButtonBlock" || ThisWidget->GetType() == "SToolBarComboButtonBlock")
-				{
-					ToolbarItemBlock = ThisWidget;
-				}
-			}
+			continue;
 		}
+		if (Query.GetWidgetTypeAt(WidgetIndex + 1) == "SNiagaraOverviewStackNode")
+		{
+			// Niagara emitters don't typically have useful node names
+			continue;
+		}
+		const TSharedRef<SWidget> ThisNodeWidget = Query.GetWidgetAt(WidgetIndex + 1);
+		const TSharedRef<SGraphNode> AsGraphNode = StaticCastSharedRef<SGraphNode>(ThisNodeWidget);
+		InOutItem.Name = AsGraphNode->GetNodeObj()->GetNodeTitle(ENodeTitleType::MenuTitle);
+		InOutItem.Descriptor = LOCTEXT("ItemDescriptor_GraphNode", "graph node");
+		InOutItem.Widget = ThisNodeWidget;
+		return true;
 	}
-	if (ToolbarItemBlock->GetType() != "SNullWidgetContent")
+	return false;
+}
+
+
+// Is it a button? Look up for the button furthest up and then down for the text.
+// Disabled buttons *contain* the menu entry block.
+static bool ExtractButtonSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	TSharedRef<SWidget> Button = Match.Widget;
+	if (Match.WidgetIndex != INDEX_NONE)
 	{
-		ChildText = FindChildWidgetWithText(ToolbarItemBlock);
-		if (!ChildText.IsEmpty() || !SlateQueryContext.CurrentToolTipText.IsEmpty())
+		int32 ButtonIndex = INDEX_NONE;
+		for (const FName ButtonType : { FName("SButton"), FName("SPrimaryButton"), FName("SCheckbox") })
 		{
-			if (!ChildText.IsEmpty())
-			{
-				OutName = ChildText;
-			}
-			else
+			const int32 ThisButtonIndex = Query.FindFurthestWidget(ButtonType);
+			if (ThisButtonIndex != INDEX_NONE && (ButtonIndex == INDEX_NONE || ThisButtonIndex < ButtonIndex))
 			{
-				// The tool tip can be used in this case.
-				OutName = SlateQueryContext.CurrentToolTipText;
+				ButtonIndex = ThisButtonIndex;
 			}
-			OutDescriptor = LOCTEXT("ItemDescriptor_ToolbarButton", "toolbar button");
-			SlateQueryContext.LastPickedWidget = ToolbarItemBlock.ToSharedPtr();
-			SlateQueryContext.bIsUIWidget = true;
 		}
+		Button = Query.GetWidgetAt(ButtonIndex);
 	}
+	return DescribeSlateItemByTextOrToolTip(Query, Button, LOCTEXT("ItemDescriptor_Button", "button"), InOutItem);
+}
+
+
+// Is it a toolbar button? Look for an SToolbarButtonBlock.
+// Disabled items *contain* the entry block.
+static bool ExtractToolBarButtonSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const TSharedRef<SWidget> ToolbarItemBlock = GetPreferredSlateItemWidget(Query, Match, { "SToolBarButtonBlock", "SToolBarComboButtonBlock" });
+	return DescribeSlateItemByTextOrToolTip(Query, ToolbarItemBlock, LOCTEXT("ItemDescriptor_ToolbarButton", "toolbar button"), InOutItem);
+}
 
 
-	// Is it a search/filter field?
+// Is it a search/filter field?
+static bool ExtractSearchBoxSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
 	FText HintText;
-	TSharedRef<SWidget> SearchBox = FindClosestWidgetOfType(WidgetPath, "SSearchBox");
-	if (SearchBox->GetType() != "SNullWidgetContent")
+	const TSharedRef<SWidget> SearchBox = GetPreferredSlateItemWidget(Query, Match, { "SSearchBox", "SFilterSearchBox" });
+	if (SearchBox->GetType() == "SSearchBox")
 	{
 		TSharedRef<SSearchBox> ThisSearchBoxCast = StaticCastSharedRef<SSearchBox>(SearchBox);
 		HintText = ThisSearchBoxCast->GetHintText();
 	}
-	else
+	else if (const TSharedPtr<SWidget> EditableText = Query.FindChildWidget(SearchBox, "SEditableText"))
 	{
-		SearchBox = FindClosestWidgetOfType(WidgetPath, "SFilterSearchBox");
-		if (SearchBox->GetType() != "SNullWidgetContent")
-		{
-			TSharedRef<SWidget> EditableText = FindChildWidgetOfType(SearchBox, "SEditableText");
-			if (EditableText->GetType() != "SNullWidgetContent")
-			{
-				TSharedRef<SEditableText> ThisEditableTextCast = StaticCastSharedRef<SEditableText>(EditableText);
-				HintText = ThisEditableTextCast->GetHintText();
-			}
-		}
+		TSharedPtr<SEditableText> ThisEditableTextCast = StaticCastSharedPtr<SEditableText>(EditableText);
+		HintText = ThisEditableTextCast->GetHintText();
 	}
-	if (SearchBox->GetType() != "SNullWidgetContent")
+	InOutItem.Name = FText::Format(LOCTEXT("SearchBoxFormat", "{0}"), (HintText.IsEmpty()) ? LOCTEXT("SearchBoxDefaultName", "default") : HintText);
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_SearchBox", "search box");
+	InOutItem.Widget = SearchBox;
+	InOutItem.bIsUIWidget = true;
+	return true;
+}
+
+
+// Is it a console input box?
+static bool ExtractConsoleInputBoxSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	FText HintText;
+	if (const TSharedPtr<SWidget> EditableText = Query.FindChildWidget(Match.Widget, "SMultiLineEditableTextBox"))
 	{
-		OutName = FText::Format(LOCTEXT("SearchBoxFormat", "{0}"), (HintText.IsEmpty()) ? LOCTEXT("SearchBoxDefaultName", "default") : HintText);
-		OutDescriptor = LOCTEXT("ItemDescriptor_SearchBox", "search box");
-		SlateQueryContext.LastPickedWidget = SearchBox.ToSharedPtr();
-		SlateQueryContext.bIsUIWidget = true;
+		TSharedPtr<SMultiLineEditableTextBox> ThisMultiLineEditableTextBoxCast = StaticCastSharedPtr<SMultiLineEditableTextBox>(EditableText);
+		HintText = ThisMultiLineEditableTextBoxCast->GetHintText();
 	}
+	InOutItem.Name = FText::Format(LOCTEXT("ConsoleInputBoxFormat", "{0}"), (HintText.IsEmpty() ? LOCTEXT("ConsoleInputBoxDefaultName","Console") : HintText));
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_ConsoleInputBox", "input box");
+	InOutItem.Widget = Match.Widget;
+	InOutItem.bIsUIWidget = true;
+	return true;
+}
+
 
-	// Is it a console input box?
-	TSharedRef<SWidget> ConsoleInputBox = FindClosestWidgetOfType(WidgetPath, "SConsoleInputBox");
-	if (ConsoleInputBox->GetType() != "SNullWidgetContent")
+// Is it a menu item? Look up for an SMenuEntryBlock or SWidgetBlock and then down for the text.
+// Disabled menu items *contain* the menu entry block.
+static bool ExtractMenuItemSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const TSharedRef<SWidget> MenuItemBlock = GetPreferredSlateItemWidget(Query, Match, { "SMenuEntryBlock", "SWidgetBlock" });
+	const FText ChildText = Query.FindChildText(MenuItemBlock);
+	if (ChildText.IsEmpty())
 	{
-		TSharedRef<SWidget> EditableText = FindChildWidgetOfType(ConsoleInputBox, "SMultiLineEditableTextBox");
-		if (EditableText->GetType() != "SNullWidgetContent")
-		{
-			TSharedRef<SMultiLineEditableTextBox> ThisMultiLineEditableTextBoxCast = StaticCastSharedRef<SMultiLineEditableTextBox>(EditableText);
-			HintText = ThisMultiLineEditableTextBoxCast->GetHintText();
-		}
-		OutName = FText::Format(LOCTEXT("ConsoleInputBoxFormat", "{0}"), (HintText.IsEmpty() ? LOCTEXT("ConsoleInputBoxDefaultName","Console") : HintText));
-		OutDescriptor = LOCTEXT("ItemDescriptor_ConsoleInputBox", "input box");
-		SlateQueryContext.LastPickedWidget = ConsoleInputBox.ToSharedPtr();
-		SlateQueryContext.bIsUIWidget = true;
+		return false;
 	}
+	InOutItem.Name = ChildText;
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_Menu", "menu item");
+	InOutItem.Widget = MenuItemBlock;
+	InOutItem.bIsUIWidget = true;
+	return true;
+}
+
 
-	// Is it a menu item? Look up for an SMenuEntryBlock or SWidgetBlock and then down for the text.
-	TSharedRef<SWidget> MenuItemBlock = FindClosestMenuItem(WidgetPath);
-	if (MenuItemBlock->GetType() != "SNullWidgetContent")
+// Is it a details panel property? Look up for an SDetailSingleItemRow [could be others?] then down through the SPropertyNameWidget.
+static bool ExtractPropertySlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const TSharedPtr<SWidget> PropertyNameWidget = Query.FindChildWidget(Match.Widget, "SPropertyNameWidget");
+	if (!PropertyNameWidget.IsValid())
 	{
-		ChildText = FindChildWidgetWithText(MenuItemBlock);
-		if (!ChildText.IsEmpty())
-		{
-			OutName = ChildText;
-			OutDescriptor = LOCTEXT("ItemDescriptor_Menu", "menu item");
-			SlateQueryContext.LastPickedWidget = MenuItemBlock.ToSharedPtr();
-			SlateQueryContext.bIsUIWidget = true;
-		}
+		return false;
 	}
+	const FText ChildText = Query.FindChildText(PropertyNameWidget.ToSharedRef());
+	if (ChildText.IsEmpty())
+	{
+		return false;
+	}
+	InOutItem.Name = ChildText;
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_Property", "setting");
+	InOutItem.Widget = Match.Widget;
+	return true;
+}
 
-	// Is it a details panel property? Look up for an SDetailSingleItemRow [could be others?] then down through the SPropertyNameWidget.
-	TSharedRef<SWidget> PropertyRow = FindClosestWidgetOfType(WidgetPath, "SDetailSingleItemRow");
-	if (PropertyRow->GetType() != "SNullWidgetContent")
+
+// Is it a breadcrumb trail button?
+static bool ExtractBreadcrumbSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& /*Match*/, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	const int32 BreadcrumbButtonIndex = Query.FindClosestWidget("SButton");
+	if (BreadcrumbButtonIndex == INDEX_NONE)
 	{
-		TSharedRef<SWidget> PropertyNameWidget = FindChildWidgetOfType(PropertyRow, "SPropertyNameWidget");
-		if (PropertyNameWidget->GetType() != "SNullWidgetContent")
-		{
-			ChildText = FindChildWidgetWithText(PropertyNameWidget);
-			if (!ChildText.IsEmpty())
-			{
-				OutName = ChildText;
-				OutDescriptor = LOCTEXT("ItemDescriptor_Property", "setting");
-				SlateQueryContext.LastPickedWidget = PropertyRow.ToSharedPtr();
-			}
-		}
+		return false;
+	}
+	const TSharedRef<SWidget> BreadcrumbButton = Query.GetWidgetAt(BreadcrumbButtonIndex);
+	const FText ChildText = Query.FindChildText(BreadcrumbButton);
+	if (ChildText.IsEmpty())
+	{
+		return false;
 	}
+	InOutItem.Name = ChildText;
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_Breadcrumb", "navigation breadcrumb");
+	InOutItem.Widget = BreadcrumbButton;
+	InOutItem.bIsUIWidget = true;
+	return true;
+}
+
 
-	// Is it a breadcrumb trail button?
-	TSharedRef<SWidget> BreadcrumbTrail = FindClosestWidgetOfType(WidgetPath, "SBreadcrumbTrail<FNavigationCrumb>");
-	if (BreadcrumbTrail->GetType() != "SNullWidgetContent")
+// Is it an asset tile item?
+static bool ExtractAssetTileSlateItem(UE::AIAssistant::ISlateItemQuery& Query, const UE::AIAssistant::FSlateItemMatch& Match, UE::AIAssistant::FSlateItem& InOutItem)
+{
+	if (const int32 AssetThumbnailIndex = Query.FindClosestWidget("SAssetThumbnail"); AssetThumbnailIndex != INDEX_NONE)
 	{
-		TSharedRef<SWidget> BreadcrumbButton = FindClosestWidgetOfType(WidgetPath, "SButton");
-		ChildText = FindChildWidgetWithText(BreadcrumbButton);
+		const TSharedRef<SWidget> AssetThumbnail = Query.GetWidgetAt(AssetThumbnailIndex);
+		const FText ChildText = Query.FindChildText(AssetThumbnail); // This returns TYPE of asset instead of name
 		if (!ChildText.IsEmpty())
 		{
-			OutName = ChildText;
-			OutDescriptor = LOCTEXT("ItemDescriptor_Breadcrumb", "navigation breadcrumb");
-			SlateQueryContext.LastPickedWidget = BreadcrumbButton.ToSharedPtr();
-			SlateQueryContext.bIsUIWidget = true;
+			FFormatNamedArguments Args;
+			Args.Add(TEXT("AssetType"), ChildText);
+			InOutItem.Descriptor = FText::Format(LOCTEXT("ItemDescriptor_Asset", "{AssetType} asset"), Args);
+		}
+
+		if (!Query.GetToolTipText().IsEmpty())
+		{
+			// We can use the tooltip for the asset's name.
+			InOutItem.Name = Query.GetToolTipText();
 		}
+		InOutItem.Widget = AssetThumbnail;
+		InOutItem.bIsObject = true;
+		return true;
 	}
 
-	// Is it an asset tile item?
-	TSharedRef<SWidget> AssetTileItem = FindClosestWidgetOfType(WidgetPath, "SAssetTileItem");
-	if (AssetTileItem->GetType() != "SNullWidgetContent")
+	const FText ChildText = Query.FindChildText(Match.Widget);
+	if (ChildText.IsEmpty())
 	{
-		TSharedRef<SWidget> AssetThumbnail = FindClosestWidgetOfType(WidgetPath, "SAssetThumbnail");
-		if (AssetThumbnail->GetType() != "SNullWidgetContent")
-		{
-			ChildText = FindChildWidgetWithText(AssetThumbnail); // This returns TYPE of asset instead of name
-			if (!ChildText.IsEmpty())
-			{
-				FFormatNamedArguments Args;
-				Args.Add(TEXT("AssetType"), ChildText);
-				OutDescriptor = FText::Format(LOCTEXT("ItemDescriptor_Asset", "{AssetType} asset"), Args);
-			}
+		return false;
+	}
+	InOutItem.Name = ChildText;
+	InOutItem.Descriptor = LOCTEXT("ItemDescriptor_Folder", "asset folder");
+	InOutItem.Widget = Match.Widget;
+	InOutItem.bIsObject = true;
+	return true;
+}
 
-			if (!SlateQueryContext.CurrentToolTipText.IsEmpty())
-			{
-				// We can use the tooltip for the asset's name.
-				OutName = SlateQueryContext.CurrentToolTipText;
-			}
-			SlateQueryContext.LastPickedWidget = AssetThumbnail.ToSharedPtr();
-			SlateQueryContext.bIsObject = true;
-		}
-		else
-		{
-			ChildText = FindChildWidgetWithText(AssetTileItem);
-			if (!ChildText.IsEmpty())
-			{
-				OutName = ChildText;
-				OutDescriptor = LOCTEXT("ItemDescriptor_Folder", "asset folder");
-				SlateQueryContext.LastPickedWidget = AssetTileItem.ToSharedPtr();
-				SlateQueryContext.bIsObject = true;
-			}
-		}
+
+static FText FindItemName(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex, FAIAssistantSlateQueryContext& SlateQueryContext)
+{
+	if (!WidgetPath.IsValid())
+	{
+		return FText();
+	}
+
+	// Let the registered extractors describe the item, from the widget types in the path.
+	UE::AIAssistant::FSlateItem Item;
+	Item.Descriptor = LOCTEXT("ItemDescriptor_Generic", "control");
+	FAIAssistantSlateItemQuery ItemQuery(WidgetPath, WidgetPathIndex, SlateQueryContext);
+	// Precomputed queries may never be used so they're kept out of the extractor stats.
+	UE::AIAssistant::FSlateItemExtractorRegistry::Get().Extract(ItemQuery, Item, !SlateQueryContext.bIsPrecompute);
+	if (Item.Widget.IsValid())
+	{
+		SlateQueryContext.LastPickedWidget = Item.Widget;
 	}
+	SlateQueryContext.bIsUIWidget |= Item.bIsUIWidget;
+	SlateQueryContext.bIsObject |= Item.bIsObject;
 
 	// If in Outliner, treat unnamed widgets as actor instances.
-	TSharedRef<SWidget> Outliner = FindClosestWidgetOfType(WidgetPath, "SSceneOutliner");
+	TSharedRef<SWidget> Outliner = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::SceneOutliner);
 	if (Outliner->GetType() != "SNullWidgetContent")
 	{
 		SlateQueryContext.bInOutliner = true;
 	}
 	// If in SubobjectInstanceEditor, treat unnamed widgets as actor instances.
-	TSharedRef<SWidget> SubobjectInstanceEditor = FindClosestWidgetOfType(WidgetPath, "SSubobjectInstanceEditor");
+	TSharedRef<SWidget> SubobjectInstanceEditor = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::SubobjectInstanceEditor);
 	if (SubobjectInstanceEditor->GetType() != "SNullWidgetContent")
 	{
 		SlateQueryContext.bInOutliner = true;
 	}
 
-	if (!OutName.IsEmpty())
+	if (!Item.Name.IsEmpty())
 	{
 		FFormatNamedArguments Args;
-		Args.Add(TEXT("ItemName"), OutName);
-		Args.Add(TEXT("ItemDescriptor"), OutDescriptor);
+		Args.Add(TEXT("ItemName"), Item.Name);
+		Args.Add(TEXT("ItemDescriptor"), Item.Descriptor);
 		return FText::Format(LOCTEXT("ItemName_Format", " the \"{ItemName}\" {ItemDescriptor}"), Args);
 	}
 
-	return OutName;
+	return FText();
 }
 
 
-static FText FindTabName(const FWidgetPath& WidgetPath, FAIAssistantSlateQueryContext& SlateQueryContext)
+static FText FindTabName(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex, FAIAssistantSlateQueryContext& SlateQueryContext)
 {
 	FText OutName = FText();
 
-	TSharedRef<SWidget> TabStack = FindClosestWidgetOfType(WidgetPath, "SDockingTabStack");
+	TSharedRef<SWidget> TabStack = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::DockingTabStack);
 	if (TabStack->GetType() != "SNullWidgetContent")
 	{
 		TArray<TSharedRef<SWidget>> DockTabs;
-		FindChildWidgetsOfType(DockTabs, TabStack.ToSharedPtr(), "SDockTab");
+		FindChildWidgetsOfType(DockTabs, TabStack.ToSharedPtr(), "SDockTab", SlateQueryContext.SearchBudget);
 		for (auto& ThisTab : DockTabs)
 		{
 			TSharedRef<SDockTab> ThisTabCast = StaticCastSharedRef<SDockTab>(ThisTab);
@@ -594,12 +785,12 @@ static FText FindTabName(const FWidgetPath& WidgetPath, FAIAssistantSlateQueryCo
 }
 
 
-static FText GenerateDetailsViewContext(const FWidgetPath& WidgetPath, FAIAssistantSlateQueryContext& SlateQueryContext)
+static FText GenerateDetailsViewContext(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex, FAIAssistantSlateQueryContext& SlateQueryContext)
 {
 	FText OutContext = FText();
 
 	// if we're in a details panel, include the class of actor or object that we're editing
-	const TSharedRef<SWidget> DetailsView = FindClosestWidgetOfType(WidgetPath, "SDetailsView");
+	const TSharedRef<SWidget> DetailsView = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::DetailsView);
 	if (DetailsView->GetType() != "SNullWidgetContent")
 	{
 		const TSharedRef<IDetailsView> DetailsViewCast = StaticCastSharedRef<IDetailsView>(DetailsView);
@@ -627,7 +818,7 @@ static FText GenerateDetailsViewContext(const FWidgetPath& WidgetPath, FAIAssist
 }
 
 
-static FText FindEditorName(const FWidgetPath& WidgetPath, FAIAssistantSlateQueryContext& SlateQueryContext)
+static FText FindEditorName(const FWidgetPath& WidgetPath, const FWidgetPathIndex& WidgetPathIndex, FAIAssistantSlateQueryContext& SlateQueryContext)
 {
 	FText OutName = FText();
 
@@ -637,7 +828,7 @@ static FText FindEditorName(const FWidgetPath& WidgetPath, FAIAssistantSlateQuer
 	}
 
 	// is it in the status bar?
-	TSharedRef<SWidget> StatusBar = FindClosestWidgetOfType(WidgetPath, "SStatusBar");
+	TSharedRef<SWidget> StatusBar = FindClosestWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::StatusBar);
 	if (StatusBar->GetType() != "SNullWidgetContent")
 	{
 		SlateQueryContext.LastPickedWidget = StatusBar.ToSharedPtr();
@@ -649,14 +840,14 @@ static FText FindEditorName(const FWidgetPath& WidgetPath, FAIAssistantSlateQuer
 		"EditMode.SubTrackEditMode"
 		});
 
-	TSharedRef<SWidget> DockingArea = FindFirstWidgetOfType(WidgetPath, "SDockingArea");
+	TSharedRef<SWidget> DockingArea = FindFirstWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::DockingArea);
 	if (DockingArea->GetType() != "SNullWidgetContent")
 	{
-		TSharedRef<SWidget> TabStack = FindChildWidgetOfType(DockingArea.ToSharedPtr(), "SDockingTabStack");
+		TSharedRef<SWidget> TabStack = FindChildWidgetOfType(DockingArea.ToSharedPtr(), "SDockingTabStack", SlateQueryContext.SearchBudget);
 		if (TabStack->GetType() != "SNullWidgetContent")
 		{
 			// are we in the level editor?
-			TSharedRef<SWidget> LevelEditor = FindChildWidgetOfType(TabStack, "SLevelEditor");
+			TSharedRef<SWidget> LevelEditor = FindChildWidgetOfType(TabStack, "SLevelEditor", SlateQueryContext.SearchBudget);
 			if (LevelEditor->GetType() != "SNullWidgetContent")
 			{
 				FText ModeString;
@@ -690,7 +881,7 @@ static FText FindEditorName(const FWidgetPath& WidgetPath, FAIAssistantSlateQuer
 
 			// if not, are we in a different asset editor?
 			TArray<TSharedRef<SWidget>> DockTabs;
-			FindChildWidgetsOfType(DockTabs, TabStack.ToSharedPtr(), "SDockTab");
+			FindChildWidgetsOfType(DockTabs, TabStack.ToSharedPtr(), "SDockTab", SlateQueryContext.SearchBudget);
 			for (auto& ThisTab : DockTabs)
 			{
 				TSharedRef<SDockTab> ThisTabCast = StaticCastSharedRef<SDockTab>(ThisTab);
@@ -720,19 +911,19 @@ static FText FindEditorName(const FWidgetPath& WidgetPath, FAIAssistantSlateQuer
 	}
 
 	// Is it in a drawer overlay?
-	TSharedRef<SWidget> DrawerOverlay = FindFirstWidgetOfType(WidgetPath, "SDrawerOverlay");
+	TSharedRef<SWidget> DrawerOverlay = FindFirstWidgetOfType(WidgetPath, WidgetPathIndex, EWidgetRole::DrawerOverlay);
 	if (DrawerOverlay->GetType() != "SNullWidgetContent")
 	{
 		FText DrawerName;
 
-		TSharedRef<SWidget> DrawerWidget = FindChildWidgetOfType(DrawerOverlay, "SContentBrowser");
+		TSharedRef<SWidget> DrawerWidget = FindChildWidgetOfType(DrawerOverlay, "SContentBrowser", SlateQueryContext.SearchBudget);
 		if (DrawerWidget->GetType() != "SNullWidgetContent")
 		{
 			DrawerName = LOCTEXT("DrawerName_ContentBrowser", "ContentBrowser");
 		}
 		else
 		{
-			DrawerWidget = FindChildWidgetOfType(DrawerOverlay, "SOutputLog");
+			DrawerWidget = FindChildWidgetOfType(DrawerOverlay, "SOutputLog", SlateQueryContext.SearchBudget);
 			if (DrawerWidget->GetType() != "SNullWidgetContent")
 			{
 				DrawerName = LOCTEXT("DrawerName_OutputLog", "OutputLog");
@@ -781,7 +972,6 @@ static FText FindTextUnderCursor(const FWidgetPath& WidgetPath, FAIAssistantSlat
 
 	if (WidgetPath.IsValid())
 	{
-		const FRegexPattern AlphaPattern(TEXT("[A-Za-z]+"));
 		TSharedRef<SWidget> WidgetToTest = WidgetPath.GetLastWidget();
 		FText WidgetText;
 		if (WidgetToTest->GetType() == "STextBlock")
@@ -794,13 +984,9 @@ static FText FindTextUnderCursor(const FWidgetPath& WidgetPath, FAIAssistantSlat
 			TSharedRef<SRichTextBlock> TextBlock = StaticCastSharedRef<SRichTextBlock>(WidgetToTest);
 			WidgetText = TextBlock->GetText();
 		}
-		if (!WidgetText.IsEmpty())
+		if (UE::AIAssistant::ContainsAsciiLetter(WidgetText))
 		{
-			FRegexMatcher AlphaMatcher(AlphaPattern, WidgetText.ToString());
-			if (AlphaMatcher.FindNext())
-			{
-				OutText = WidgetText;
-			}
+			OutText = WidgetText;
 		}
 
 		if (!OutText.IsEmpty())
@@ -813,65 +999,75 @@ static FText FindTextUnderCursor(const FWidgetPath& WidgetPath, FAIAssistantSlat
 }
 
 
-static FString CleanExtraWhiteSpaceFromString(const FString& InString)
+static FWidgetPath LocateWidgetPathUnderCursor()
 {
-	FString CleanString = "";
-	static const FRegexPattern WhiteSpacePattern(TEXT("(\\S+)"));
-	FRegexMatcher Matcher(WhiteSpacePattern, InString);
-	while (Matcher.FindNext())
+	const FVector2f CursorPos = FSlateApplication::Get().GetCursorPos();
+	const TArray<TSharedRef<SWindow>>& Windows = FSlateApplication::Get().GetTopLevelWindows();
+	return FSlateApplication::Get().LocateWindowUnderMouse(CursorPos, Windows, true);
+}
+
+
+static bool HasVisibleToolTipWindow()
+{
+	for (const TSharedRef<SWindow>& ThisWindow : FSlateApplication::Get().GetTopLevelWindows())
 	{
-		if (!CleanString.IsEmpty())
+		if (ThisWindow->GetType() == EWindowType::ToolTip && ThisWindow->IsVisible())
 		{
-			CleanString += " ";
+			return true;
 		}
-		
-		CleanString += Matcher.GetCaptureGroup(1);
 	}
 
-	return MoveTemp(CleanString);
+	return false;
 }
 
 
-//
-// UE::AIAssistant::SlateQuerier
-//
-
-
-void UE::AIAssistant::SlateQuerier::QueryAIAssistantAboutSlateWidgetUnderCursor()
+/**
+ * Generates the query about the widget at the end of a widget path.
+ * @param WidgetPath Path to the widget to query about.
+ * @param bIsPrecompute Whether the query is generated while the cursor rests, before the hotkey is pressed.
+ * @param bOutIsComplete Optionally set to whether the searches finished within their budget.
+ * @return The query, unset if nothing identifiable was found.
+ */
+static TOptional<FAIAssistantSlateQuery> GenerateSlateQuery(const FWidgetPath& WidgetPath, const bool bIsPrecompute = false,
+	bool* bOutIsComplete = nullptr)
 {
-	// Get the path to the widget under the cursor.
-
-	FWidgetPath WidgetPath;
-	{
-		const FVector2f CursorPos = FSlateApplication::Get().GetCursorPos();
-		const TArray<TSharedRef<SWindow>>& Windows = FSlateApplication::Get().GetTopLevelWindows();
-		WidgetPath = FSlateApplication::Get().LocateWindowUnderMouse(CursorPos, Windows, true);
-	}
-
-
 	// We build this up, below.
 	
 	FAIAssistantSlateQueryContext SlateQueryContext;
+	SlateQueryContext.bIsPrecompute = bIsPrecompute;
+	if (bIsPrecompute)
+	{
+		// This runs in a single frame whenever the cursor rests, so it gives up quickly rather than hitching.
+		SlateQueryContext.SearchBudget = FTreeSearchBudget(
+			AIAssistantSlateQuerierMaxSearchWidgets, AIAssistantSlateQuerierPrecomputeMaxSearchMilliseconds / 1000.0);
+	}
 
 	// Is there a current tool-tip?
-	SlateQueryContext.CurrentToolTipText = FindCurrentToolTipText();
+	SlateQueryContext.CurrentToolTipText = FindCurrentToolTipText(SlateQueryContext.SearchBudget);
+
+	// Classify the widgets in the path once, the searches below look them up by role.
+	const FWidgetPathIndex WidgetPathIndex(WidgetPath);
 
 	// For menu items, we want to generate the context based on the root widget that spawned the menu,
 	// not on the actual menu item itself.
-	const FWidgetPath ContextWidgetPath = FindContextWidgetPath(WidgetPath);
+	const TOptional<FWidgetPath> MenuHostWidgetPath = FindMenuHostWidgetPath(WidgetPath, WidgetPathIndex);
+	const TOptional<FWidgetPathIndex> MenuHostWidgetPathIndex =
+		MenuHostWidgetPath.IsSet() ? TOptional<FWidgetPathIndex>(FWidgetPathIndex(*MenuHostWidgetPath)) : TOptional<FWidgetPathIndex>();
+	const FWidgetPath& ContextWidgetPath = MenuHostWidgetPath.IsSet() ? *MenuHostWidgetPath : WidgetPath;
+	const FWidgetPathIndex& ContextWidgetPathIndex = MenuHostWidgetPathIndex.IsSet() ? *MenuHostWidgetPathIndex : WidgetPathIndex;
 
 	// Is there an identifiable asset editor, mode, or window?
-	const FText WindowName = FindEditorName(ContextWidgetPath, SlateQueryContext);
+	const FText WindowName = FindEditorName(ContextWidgetPath, ContextWidgetPathIndex, SlateQueryContext);
 
 	// Is there an identifiable tab?
 	// Look up the chain for an SDockingTabStack, then look down to find an SDockTab.
-	const FText TabName = FindTabName(ContextWidgetPath, SlateQueryContext);
+	const FText TabName = FindTabName(ContextWidgetPath, ContextWidgetPathIndex, SlateQueryContext);
 
 	// Is there text under the cursor??
 	const FText TextUnderCursor = FindTextUnderCursor(WidgetPath, SlateQueryContext);
 
 	// Is there an identifiable item?
-	const FText ItemName = FindItemName(WidgetPath, SlateQueryContext);
+	const FText ItemName = FindItemName(WidgetPath, WidgetPathIndex, SlateQueryContext);
 
 	// Special case for actor listings in Outliner.
 	if (ItemName.IsEmpty() && SlateQueryContext.bInOutliner && !SlateQueryContext.bIsUIWidget)
@@ -941,8 +1137,11 @@ void UE::AIAssistant::SlateQuerier::QueryAIAssistantAboutSlateWidgetUnderCursor(
 
 		if (SlateQueryContext.GeneratedQuery.IsEmpty())
 		{
-			UE_LOG(LogAIAssistant, Warning, TEXT("Could not generate query for widget."));
-			return;
+			if (bOutIsComplete)
+			{
+				*bOutIsComplete = !SlateQueryContext.SearchBudget.IsExhausted();
+			}
+			return TOptional<FAIAssistantSlateQuery>();
 		}
 	}
 
@@ -963,14 +1162,14 @@ void UE::AIAssistant::SlateQuerier::QueryAIAssistantAboutSlateWidgetUnderCursor(
 				SlateQueryContext.GeneratedContextItems.Add(FText::Format(LOCTEXT("QueryContextTabOrWindowLocation", "I am working in {MaybeEmptyTabName}{MaybeEmptyWindowName}."), Args));
 			}
 
-			if (const FText ModeToolContext = GenerateModeToolContext(WidgetPath);
+			if (const FText ModeToolContext = GenerateModeToolContext(WidgetPath, WidgetPathIndex);
 				!ModeToolContext.IsEmpty())
 			{
 				SlateQueryContext.GeneratedContextItems.Add(ModeToolContext);
 			}
 		}
 
-		if (const FText DetailsViewContext = GenerateDetailsViewContext(WidgetPath, SlateQueryContext);
+		if (const FText DetailsViewContext = GenerateDetailsViewContext(WidgetPath, WidgetPathIndex, SlateQueryContext);
 			!DetailsViewContext.IsEmpty())
 		{
 			SlateQueryContext.GeneratedContextItems.Add(DetailsViewContext);
@@ -997,26 +1196,186 @@ void UE::AIAssistant::SlateQuerier::QueryAIAssistantAboutSlateWidgetUnderCursor(
 		}
 	}
 
-	// OPTIONAL - We're done using these members. We can clear them to reduce size as they're
-	// not used below.
-	SlateQueryContext.LastPickedWidget.Reset();
-	SlateQueryContext.GeneratedContextItems.Empty();
+	// Precomputing runs on every rest of the cursor, so it only reports this verbosely.
+	if (SlateQueryContext.SearchBudget.IsExhausted() && SlateQueryContext.bIsPrecompute)
+	{
+		UE_LOG(LogAIAssistant, Verbose, TEXT("Stopped searching widgets for the precomputed AI assistant query after %d widgets, the query will be generated when it's requested."),
+			SlateQueryContext.SearchBudget.GetNumNodes());
+	}
+	else if (SlateQueryContext.SearchBudget.IsExhausted())
+	{
+		UE_LOG(LogAIAssistant, Log, TEXT("Stopped searching widgets for the AI assistant query after %d widgets, the query's context may be incomplete."),
+			SlateQueryContext.SearchBudget.GetNumNodes());
+	}
+
+	if (bOutIsComplete)
+	{
+		*bOutIsComplete = !SlateQueryContext.SearchBudget.IsExhausted();
+	}
+
+	FAIAssistantSlateQuery SlateQuery;
+	SlateQuery.VisiblePrompt = UE::AIAssistant::CollapseWhiteSpace(SlateQueryContext.GeneratedQuery.ToString());
+	SlateQuery.HiddenContext =
+		UE::AIAssistant::CollapseWhiteSpace(SlateQueryContext.GeneratedQueryInstructions.ToString()) +
+		FText(LOCTEXT("ContextPrefix", "(Context: ")).ToString() +
+		UE::AIAssistant::CollapseWhiteSpace(SlateQueryContext.GeneratedContext.ToString()) +
+		FText(LOCTEXT("ContextPostfix", ")")).ToString();
+	return SlateQuery;
+}
+
+
+//
+// UE::AIAssistant::SlateQuerier
+//
+
+
+void UE::AIAssistant::SlateQuerier::QueryAIAssistantAboutSlateWidgetUnderCursor()
+{
+	// Get the path to the widget under the cursor.
+
+	const FWidgetPath WidgetPath = LocateWidgetPathUnderCursor();
+
+
+	// Use the query generated while the cursor rested on the widget, if it's still for this widget.
+
+	TOptional<FAIAssistantSlateQuery> SlateQuery;
+	if (AIAssistantSlateQuerierPrecomputedQuery.IsSet() && AIAssistantSlateQuerierPrecomputedQuery->bIsComplete && WidgetPath.IsValid() &&
+		AIAssistantSlateQuerierPrecomputedQuery->HoveredWidget.Pin() == WidgetPath.GetLastWidget().ToSharedPtr() &&
+		AIAssistantSlateQuerierPrecomputedQuery->bHadToolTip == HasVisibleToolTipWindow())
+	{
+		UE_LOG(LogAIAssistant, Verbose, TEXT("Using the AI assistant query generated %.3f seconds ago."),
+			FPlatformTime::Seconds() - AIAssistantSlateQuerierPrecomputedQuery->Seconds);
+		SlateQuery = AIAssistantSlateQuerierPrecomputedQuery->Query;
+	}
+	else
+	{
+		SlateQuery = GenerateSlateQuery(WidgetPath);
+	}
+
+	if (!SlateQuery.IsSet())
+	{
+		UE_LOG(LogAIAssistant, Warning, TEXT("Could not generate query for widget."));
+		return;
+	}
 
 	// Send widget query to AI Assistant.
 	TSharedPtr<SAIAssistantWebBrowser> WebBrowser =
 		UAIAssistantSubsystem::GetAIAssistantWebBrowserWidget();
 	WebBrowser->CreateConversation();
-				
-	const FString VisiblePromptString =
-		CleanExtraWhiteSpaceFromString(SlateQueryContext.GeneratedQuery.ToString());
+	WebBrowser->AddUserMessageToConversation(SlateQuery->VisiblePrompt, SlateQuery->HiddenContext);
+}
 
-	const FString HiddenContextString = 
-		CleanExtraWhiteSpaceFromString(SlateQueryContext.GeneratedQueryInstructions.ToString()) +
-		FText(LOCTEXT("ContextPrefix", "(Context: ")).ToString() +
-		CleanExtraWhiteSpaceFromString(SlateQueryContext.GeneratedContext.ToString()) +
-		FText(LOCTEXT("ContextPostfix", ")")).ToString();
 
-	WebBrowser->AddUserMessageToConversation(VisiblePromptString, HiddenContextString);
+void UE::AIAssistant::SlateQuerier::UpdateHoverQuery()
+{
+	if (!bAIAssistantSlateQuerierPrecompute)
+	{
+		AIAssistantSlateQuerierPrecomputedQuery.Reset();
+		return;
+	}
+
+	if (AIAssistantSlateQuerierHoverDwell.GetSettings().DwellSeconds != AIAssistantSlateQuerierPrecomputeDwellSeconds)
+	{
+		UE::AIAssistant::FHoverDwell::FSettings Settings;
+		Settings.DwellSeconds = AIAssistantSlateQuerierPrecomputeDwellSeconds;
+		AIAssistantSlateQuerierHoverDwell = UE::AIAssistant::FHoverDwell(Settings);
+	}
+
+	// While the cursor moves this is all that's done.
+	FSlateApplication& SlateApp = FSlateApplication::Get();
+	const double NowSeconds = FPlatformTime::Seconds();
+	if (!AIAssistantSlateQuerierHoverDwell.Update(SlateApp.GetCursorPos(), NowSeconds))
+	{
+		if (!AIAssistantSlateQuerierHoverDwell.HasDwelled())
+		{
+			AIAssistantSlateQuerierPrecomputedQuery.Reset();
+			return;
+		}
+		// A tool tip opening or closing while resting changes the query, so it's generated again.
+		if (!AIAssistantSlateQuerierPrecomputedQuery.IsSet() ||
+			AIAssistantSlateQuerierPrecomputedQuery->bHadToolTip == HasVisibleToolTipWindow())
+		{
+			return;
+		}
+	}
+
+	// Leave the editor alone while it's in the background or the user is dragging.
+	if (!SlateApp.IsActive() || SlateApp.IsDragDropping() || !SlateApp.GetPressedMouseButtons().IsEmpty())
+	{
+		return;
+	}
+
+	const FWidgetPath WidgetPath = LocateWidgetPathUnderCursor();
+	if (!WidgetPath.IsValid())
+	{
+		return;
+	}
+
+	FAIAssistantPrecomputedSlateQuery& PrecomputedQuery = AIAssistantSlateQuerierPrecomputedQuery.Emplace();
+	PrecomputedQuery.HoveredWidget = WidgetPath.GetLastWidget();
+	PrecomputedQuery.bHadToolTip = HasVisibleToolTipWindow();
+	PrecomputedQuery.Seconds = NowSeconds;
+	// If this runs out of time the query isn't used, but it's kept so it isn't generated again until the cursor moves.
+	PrecomputedQuery.Query = GenerateSlateQuery(WidgetPath, true, &PrecomputedQuery.bIsComplete);
+}
+
+
+void UE::AIAssistant::SlateQuerier::InvalidateHoverQuery()
+{
+	if (!bAIAssistantSlateQuerierPrecompute)
+	{
+		return;
+	}
+
+	AIAssistantSlateQuerierPrecomputedQuery.Reset();
+	AIAssistantSlateQuerierHoverDwell.Restart(FPlatformTime::Seconds());
+}
+
+
+void UE::AIAssistant::SlateQuerier::RegisterItemExtractors()
+{
+	struct FBuiltInExtractor
+	{
+		const TCHAR* Name;
+		TArray<FName> WidgetTypes;
+		bool bMatchHoveredWidgetChildren;
+		bool (*Extract)(ISlateItemQuery&, const FSlateItemMatch&, FSlateItem&);
+	};
+	const FBuiltInExtractor BuiltInExtractors[] = {
+		{ TEXT("GraphNode"), { "SGraphEditor" }, false, &ExtractGraphNodeSlateItem },
+		{ TEXT("Button"), { "SButton", "SPrimaryButton", "SCheckbox" }, true, &ExtractButtonSlateItem },
+		{ TEXT("ToolBarButton"), { "SToolBarButtonBlock", "SToolBarComboButtonBlock" }, true, &ExtractToolBarButtonSlateItem },
+		{ TEXT("SearchBox"), { "SSearchBox", "SFilterSearchBox" }, false, &ExtractSearchBoxSlateItem },
+		{ TEXT("ConsoleInputBox"), { "SConsoleInputBox" }, false, &ExtractConsoleInputBoxSlateItem },
+		{ TEXT("MenuItem"), { "SMenuEntryBlock", "SWidgetBlock" }, true, &ExtractMenuItemSlateItem },
+		{ TEXT("Property"), { "SDetailSingleItemRow" }, false, &ExtractPropertySlateItem },
+		{ TEXT("Breadcrumb"), { "SBreadcrumbTrail<FNavigationCrumb>" }, false, &ExtractBreadcrumbSlateItem },
+		{ TEXT("AssetTile"), { "SAssetTileItem" }, false, &ExtractAssetTileSlateItem },
+	};
+
+	UnregisterItemExtractors();
+	for (int32 ExtractorIndex = 0; ExtractorIndex < int32(UE_ARRAY_COUNT(BuiltInExtractors)); ++ExtractorIndex)
+	{
+		const FBuiltInExtractor& BuiltInExtractor = BuiltInExtractors[ExtractorIndex];
+		FSlateItemExtractor Extractor;
+		Extractor.Name = BuiltInExtractor.Name;
+		Extractor.WidgetTypes = BuiltInExtractor.WidgetTypes;
+		// Leave gaps between the built-in extractors so that other modules can run theirs in between.
+		Extractor.Order = (ExtractorIndex + 1) * 100;
+		Extractor.bMatchHoveredWidgetChildren = BuiltInExtractor.bMatchHoveredWidgetChildren;
+		Extractor.Extract = BuiltInExtractor.Extract;
+		AIAssistantSlateQuerierItemExtractorHandles.Add(FSlateItemExtractorRegistry::Get().Register(MoveTemp(Extractor)));
+	}
+}
+
+
+void UE::AIAssistant::SlateQuerier::UnregisterItemExtractors()
+{
+	for (const FDelegateHandle& Handle : AIAssistantSlateQuerierItemExtractorHandles)
+	{
+		FSlateItemExtractorRegistry::Get().Unregister(Handle);
+	}
+	AIAssistantSlateQuerierItemExtractorHandles.Reset();
 }
 
 
@@ -18,4 +18,25 @@ namespace UE::AIAssistant::SlateQuerier
 	 * Initiates an AI Assistant query to describe a Slate widget.
 	 */
 	void QueryAIAssistantAboutSlateWidgetUnderCursor();
+
+	/**
+	 * Generates the query about the widget under the cursor once the cursor rests on it, when enabled by
+	 * ai.assistant.slatequerier.precompute. Call every frame, while the cursor moves it only samples the cursor.
+	 */
+	void UpdateHoverQuery();
+
+	/**
+	 * Discards the query generated by UpdateHoverQuery(), for input that may change what it describes.
+	 */
+	void InvalidateHoverQuery();
+
+	/**
+	 * Registers the built-in extractors that describe the item under the cursor with FSlateItemExtractorRegistry.
+	 */
+	void RegisterItemExtractors();
+
+	/**
+	 * Unregisters the extractors added by RegisterItemExtractors().
+	 */
+	void UnregisterItemExtractors();
 };
@@ -4,15 +4,22 @@
 #include "AIAssistantWebBrowser.h"
 
 #include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "WebBrowserModule.h"
 #include "Internationalization/Culture.h"
-#include "Internationalization/Regex.h"
 #include "IWebBrowserWindow.h"
 #include "Misc/AssertionMacros.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
 
+#include "AIAssistant.h"
 #include "Core/AIAssistantLog.h"
+#include "Core/AIAssistantStartupTimeline.h"
+#include "Core/AIAssistantSubsystem.h"
+#include "WebAPI/AIAssistantWebApiMetrics.h"
 
 using namespace UE::AIAssistant;
 
@@ -26,6 +33,81 @@ using namespace UE::AIAssistant;
 #define UE_AIA_SET_INITIAL_URL_VIA_WEB_BROWSER_SLATE_ARG 0
 
 
+//
+// Statics.
+//
+
+
+// Frame rate of the browser while it's rendering.
+static int32 AIAssistantWebBrowserFrameRate = 60;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserFrameRateConsoleVariableRef(
+	TEXT("ai.assistant.browser.framerate"), AIAssistantWebBrowserFrameRate,
+	TEXT("Frame rate of the AI assistant web browser while it's rendering. Applies to browsers created after it's changed."));
+
+// Whether the browser stops rendering when it's hidden, in the background or idle.
+static bool bAIAssistantWebBrowserPauseRendering = true;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserPauseRenderingConsoleVariableRef(
+	TEXT("ai.assistant.browser.pauserendering"), bAIAssistantWebBrowserPauseRendering,
+	TEXT("Whether the AI assistant web browser stops rendering while it isn't visible, the editor isn't the active application or ")
+	TEXT("it's idle. Applies to browsers created after it's changed."));
+
+// Seconds without activity before the browser stops rendering.
+static float AIAssistantWebBrowserIdlePauseSeconds = 0.0f;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserIdlePauseSecondsConsoleVariableRef(
+	TEXT("ai.assistant.browser.idlepauseseconds"), AIAssistantWebBrowserIdlePauseSeconds,
+	TEXT("Seconds the visible AI assistant web browser has to be without input, page loads or web API calls before it stops ")
+	TEXT("rendering, 0 to always render while visible. Animations started by the page itself don't count as activity. Applies to ")
+	TEXT("browsers created after it's changed."));
+
+// How often the browser's activity is sampled.
+static constexpr float AIAssistantWebBrowserFrameRateUpdateSeconds = 0.25f;
+
+// How long after the widget was last ticked it's considered hidden.
+static constexpr double AIAssistantWebBrowserHiddenAfterSeconds = 1.0;
+
+// Messages of each severity from the page's JavaScript console written to the output log per second.
+static float AIAssistantWebBrowserConsoleMaxLinesPerSecond = 10.0f;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserConsoleMaxLinesPerSecondConsoleVariableRef(
+	TEXT("ai.assistant.browser.console.maxlinespersecond"), AIAssistantWebBrowserConsoleMaxLinesPerSecond,
+	TEXT("Messages of each severity from the AI assistant page's JavaScript console written to the output log per second. All ")
+	TEXT("messages are kept for ai.assistant.browser.console.dump. Applies to browsers created after it's changed."));
+
+static FAutoConsoleCommandWithArgsAndOutputDevice AIAssistantWebBrowserConsoleDumpConsoleCommand(
+	TEXT("ai.assistant.browser.console.dump"),
+	TEXT("Print the recent JavaScript console messages of the AI assistant page, including those that weren't written to the ")
+	TEXT("output log. Pass \"reset\" to remove them after printing."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda(
+		[](const TArray<FString>& Args, FOutputDevice& Output) -> void
+		{
+			// NOTE: UAIAssistantSubsystem::GetAIAssistantWebBrowserWidget() asserts if the tab was never opened.
+			const TSharedPtr<SAIAssistantWebBrowser> WebBrowser =
+				UAIAssistantSubsystem::GetAIAssistantModule().GetAIAssistantWebBrowserWidget();
+			const bool bReset = Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase);
+			Output.Log(
+				LogAIAssistant.GetCategoryName(), ELogVerbosity::Display,
+				WebBrowser.IsValid() ? *WebBrowser->DumpConsoleMessages(bReset) : TEXT("The AI assistant web browser isn't open."));
+		}));
+
+static FAutoConsoleCommandWithArgsAndOutputDevice AIAssistantWebBrowserFrameRateStatsConsoleCommand(
+	TEXT("ai.assistant.browser.framerate.stats"),
+	TEXT("Print the rendering state of the AI assistant web browser and the time it spent in each state."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda(
+		[](const TArray<FString>& Args, FOutputDevice& Output) -> void
+		{
+			// NOTE: UAIAssistantSubsystem::GetAIAssistantWebBrowserWidget() asserts if the tab was never opened.
+			const TSharedPtr<SAIAssistantWebBrowser> WebBrowser =
+				UAIAssistantSubsystem::GetAIAssistantModule().GetAIAssistantWebBrowserWidget();
+			const FString Stats = WebBrowser.IsValid() ? WebBrowser->GetFrameRateStats() : FString();
+			Output.Log(
+				LogAIAssistant.GetCategoryName(), ELogVerbosity::Display,
+				Stats.IsEmpty() ? TEXT("The AI assistant web browser's frame rate isn't governed.") : *Stats);
+		}));
+
+
 //
 // SAIAssistantWebBrowser
 //
@@ -41,15 +123,35 @@ void SAIAssistantWebBrowser::Construct(const FArguments& InArgs)
 	// NOTE - We have not enabled the WebBrowserWidget for this plugin. If we had, then this would not be necessary, and this would have been taken
 	// care of for us.
 
-	TSharedPtr<IWebBrowserWindow> WebBrowserWindow;
 	{
 		FCreateBrowserWindowSettings WindowSettings;
 		WindowSettings.bUseTransparency = true;
-		WindowSettings.BrowserFrameRate = 60;
+		WindowSettings.BrowserFrameRate = FMath::Max(AIAssistantWebBrowserFrameRate, 1);
 
 		IWebBrowserModule& WebBrowserModule = FModuleManager::LoadModuleChecked<IWebBrowserModule>("WebBrowser");
 		IWebBrowserSingleton* WebBrowserSingleton = WebBrowserModule.GetSingleton();
 		WebBrowserWindow = WebBrowserSingleton->CreateBrowserWindow(WindowSettings);
+		(void)FStartupTimeline::Get().MarkMilestone(FStartupTimeline::EMilestone::BrowserWindowCreated);
+
+		// The frame rate can't be changed once the browser is created, so rendering is paused instead while the browser isn't needed.
+		if (WebBrowserWindow.IsValid() && bAIAssistantWebBrowserPauseRendering)
+		{
+			FFrameRateGovernor::FSettings GovernorSettings;
+			GovernorSettings.ActiveFrameRate = WindowSettings.BrowserFrameRate;
+			GovernorSettings.IdlePauseSeconds = FMath::Max(AIAssistantWebBrowserIdlePauseSeconds, 0.0f);
+			LastTickSeconds = FPlatformTime::Seconds();
+			FrameRateGovernor.Emplace(GovernorSettings, LastTickSeconds);
+			FrameRateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateSP(this, &SAIAssistantWebBrowser::UpdateFrameRate), AIAssistantWebBrowserFrameRateUpdateSeconds);
+		}
+	}
+	
+	// JavaScript console capture.
+
+	{
+		FConsoleMessageLog::FSettings ConsoleMessageLogSettings;
+		ConsoleMessageLogSettings.MaxLinesPerSecond = AIAssistantWebBrowserConsoleMaxLinesPerSecond;
+		ConsoleMessageLog.Emplace(ConsoleMessageLogSettings);
 	}
 	
 	// Web Browser.
@@ -100,33 +202,23 @@ void SAIAssistantWebBrowser::Construct(const FArguments& InArgs)
 
 			return true; // ..means block navigation in THIS browser
 		})
-		.OnConsoleMessage_Lambda([](const FString& Message, const FString& Source, int32 Line, EWebBrowserConsoleLogSeverity WebBrowserConsoleLogSeverity) -> void
-		{
-			// Logs messages from JavaScript.
-								
-			if (WebBrowserConsoleLogSeverity == EWebBrowserConsoleLogSeverity::Error || WebBrowserConsoleLogSeverity == EWebBrowserConsoleLogSeverity::Fatal)
-			{
-				UE_LOG(LogAIAssistant, Error, TEXT("JavaScript Error - '%s' @ %s:%d"), *Message, *Source, Line);
-			}
-			else if (WebBrowserConsoleLogSeverity == EWebBrowserConsoleLogSeverity::Warning)
-			{
-				UE_LOG(LogAIAssistant, Warning, TEXT("JavaScript Warning - '%s' @ %s:%d"), *Message, *Source, Line);
-			}
-			else
-			{
-				UE_LOG(LogAIAssistant, Display, TEXT("JavaScript - '%s' @ %s:%d"), *Message, *Source, Line);
-			}
-		})
+		.OnConsoleMessage(this, &SAIAssistantWebBrowser::OnConsoleMessage)
 		.OnLoadStarted_Lambda([this]() -> void
 		{
+			(void)FStartupTimeline::Get().MarkMilestone(FStartupTimeline::EMilestone::LoadStarted);
 			UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadStarted);
 		})
 		.OnLoadError_Lambda([this]() -> void
 		{
+			// The page's console usually explains why it failed to load.
+			UE_LOG(LogAIAssistant, Display, TEXT("JavaScript console when the page failed to load:\n%s"), *DumpConsoleMessages());
+
 			UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadError);
 		})
 		.OnLoadCompleted_Lambda([this]() -> void
 		{
+			(void)FStartupTimeline::Get().MarkMilestone(FStartupTimeline::EMilestone::LoadCompleted);
+
 			// If UEFN mode changes aren't being monitored, subscribe to updates.
 			if (!UefnModeSubscription.IsSet())
 			{
@@ -150,6 +242,7 @@ void SAIAssistantWebBrowser::Construct(const FArguments& InArgs)
 	InitializeConversationReadyExecutor();
 
 	FInternationalization::Get().OnCultureChanged().AddSP(SharedThis(this), &SAIAssistantWebBrowser::OnCultureChanged);
+	FConfigService::Get().OnConfigChanged().AddSP(SharedThis(this), &SAIAssistantWebBrowser::OnConfigChanged);
 	
 #if !UE_AIA_SET_INITIAL_URL_VIA_WEB_BROWSER_SLATE_ARG
 
@@ -169,10 +262,23 @@ void SAIAssistantWebBrowser::Construct(const FArguments& InArgs)
 }
 
 
+SAIAssistantWebBrowser::~SAIAssistantWebBrowser()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(FrameRateTickerHandle);
+}
+
+
 void SAIAssistantWebBrowser::OnClosed()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(FrameRateTickerHandle);
+	FrameRateTickerHandle.Reset();
 	WebBrowserLoadState = EWebBrowserLoadState::Default;
 	ConversationReadyExecutor.Reset();
+	// A closed browser can still be referenced, stop it reloading the page when the config changes.
+	FConfigService::Get().OnConfigChanged().RemoveAll(this);
+	// Messages being sent by this page may not have been received, send them from the next page
+	// with the same IDs so the web app discards any it already added.
+	FMessageOutbox::Get().ReleaseAll();
 }
 
 
@@ -180,17 +286,90 @@ void SAIAssistantWebBrowser::UpdateWebBrowserLoadState(const EWebBrowserLoadStat
 {
 	WebBrowserLoadState = InWebBrowserLoadState; // ..set this first
 
-	ConversationReadyExecutor->UpdateExecuteWhenReady();
+	// Loads that finish after the browser was closed have nothing to notify.
+	if (!ConversationReadyExecutor.IsSet())
+	{
+		return;
+	}
+
+	ConversationReadyExecutor->SetPageState(GetExecuteWhenReadyState());
+	// Rejected messages are still in the outbox so wait for the page to load again.
+	FlushMessageOutboxWhenReady();
 }
 
 
 void SAIAssistantWebBrowser::InitializeConversationReadyExecutor()
 {
-	ConversationReadyExecutor.Emplace(
-		[this]() -> UE::AIAssistant::FExecuteWhenReady::EExecuteWhenReadyState
+	ConversationReadyExecutor.Emplace(GetExecuteWhenReadyState());
+	FlushMessageOutboxWhenReady();
+}
+
+
+void SAIAssistantWebBrowser::FlushMessageOutboxWhenReady()
+{
+	static const FName FlushMessageOutboxCoalescingKey(TEXT("FlushMessageOutbox"));
+	// Once the page has closed the next page flushes the outbox.
+	if (!ConversationReadyExecutor.IsSet() || FMessageOutbox::Get().NumUnclaimed() == 0)
+	{
+		return;
+	}
+	const bool bQueued = ConversationReadyExecutor->ExecuteWhenReady(
+		[this]() -> void
 		{
-			return GetExecuteWhenReadyState();
-		});
+			for (FMessageOutboxEntry& Entry : FMessageOutbox::Get().Claim())
+			{
+				// The outbox outlives the page so the result only references it weakly.
+				GetWebApi().AddMessageToConversation(Entry.Options).Then(
+					[WeakThis = TWeakPtr<SAIAssistantWebBrowser>(SharedThis(this)),
+						MessageId = MoveTemp(Entry.MessageId)](
+						const TFuture<TValueOrError<void, FString>>& ResultFuture) -> void
+					{
+						const TValueOrError<void, FString>& Result = ResultFuture.Get();
+						if (Result.HasError())
+						{
+							UE_LOG(
+								LogAIAssistant, Warning, TEXT("Failed to send message %s: %s"),
+								*MessageId, *Result.GetError());
+							// The page may have received the message, it's sent again with the
+							// same ID so the web app can discard the duplicate.
+							const TSharedPtr<SAIAssistantWebBrowser> This = WeakThis.Pin();
+							if (FMessageOutbox::Get().Release(MessageId) && This.IsValid())
+							{
+								This->FlushMessageOutboxAfterDelay();
+							}
+						}
+						else
+						{
+							FMessageOutbox::Get().Acknowledge(MessageId);
+							(void)FStartupTimeline::Get().MarkMilestone(
+								FStartupTimeline::EMilestone::FirstMessageAccepted);
+						}
+					});
+			}
+		},
+		FlushMessageOutboxCoalescingKey);
+	if (!bQueued)
+	{
+		// Messages stay in the outbox so they're sent by the next flush.
+		UE_LOG(
+			LogAIAssistant, Warning,
+			TEXT("Unable to send %d messages as too many operations are waiting for the conversation."),
+			FMessageOutbox::Get().NumUnclaimed());
+	}
+}
+
+
+void SAIAssistantWebBrowser::FlushMessageOutboxAfterDelay()
+{
+	(void)FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSPLambda(
+			this,
+			[this](float UnusedDeltaTime) -> bool
+			{
+				FlushMessageOutboxWhenReady();
+				return false;
+			}),
+		FMessageOutbox::RetryDelaySeconds);
 }
 
 void SAIAssistantWebBrowser::UpdateAgentEnvironment(bool bUseUefnMode)
@@ -205,32 +384,117 @@ void SAIAssistantWebBrowser::UpdateAgentEnvironment(bool bUseUefnMode)
 		FAgentEnvironment AgentEnvironment;
 		AgentEnvironment.Descriptor.EnvironmentName = bUseUefnMode ? TEXT("UEFN") : TEXT("UE");
 		AgentEnvironment.Descriptor.EnvironmentVersion = FEngineVersion::Current().ToString();
-		GetWebApi().AddAgentEnvironment(AgentEnvironment).Then(
-			[this, bUseUefnMode](const auto& ResultFuture) mutable -> void
+
+		if (FAgentEnvironmentCache::IsEnabled())
+		{
+			// Cached handles belong to the assistant user, which only the page knows, so a
+			// handle is never sent on behalf of another user sharing this machine.
+			GetWebApi().GetCurrentUser().Then(
+				[this, AgentEnvironment = MoveTemp(AgentEnvironment)](
+					const TFuture<TValueOrError<FAssistantUser, FString>>& ResultFuture) -> void
+				{
+					// The browser closed while waiting for the user.
+					if (!ConversationReadyExecutor.IsSet())
+					{
+						return;
+					}
+					const TValueOrError<FAssistantUser, FString>& Result = ResultFuture.Get();
+					FString User;
+					if (Result.HasError() || Result.GetValue().Id.IsEmpty())
+					{
+						UE_LOG(
+							LogAIAssistant, Verbose,
+							TEXT("Not caching the agent environment as the assistant user is unknown: %s"),
+							Result.HasError() ? *Result.GetError() : TEXT("not signed in"));
+					}
+					else
+					{
+						User = FAgentEnvironmentCache::GetCacheUser(Result.GetValue().Id, Config.MainUrl);
+					}
+					AddAgentEnvironment(AgentEnvironment, User);
+				});
+		}
+		else
+		{
+			AddAgentEnvironment(AgentEnvironment, FString());
+		}
+		SAIAssistantWebBrowser::OnCultureChanged();
+	}
+	else
+	{
+		UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadComplete);
+	}
+}
+
+
+void SAIAssistantWebBrowser::AddAgentEnvironment(const FAgentEnvironment& AgentEnvironment, const FString& User)
+{
+	// If the environment was added in a previous session, set it immediately so that queued
+	// messages don't wait for the round trip to add it, which then verifies the cached handle.
+	const FString EnvironmentHash = FAgentEnvironmentCache::HashAgentEnvironment(AgentEnvironment);
+	TOptional<FAgentEnvironmentHandle> CachedHandle;
+	if (!User.IsEmpty())
+	{
+		CachedHandle = AgentEnvironmentCache.Find(EnvironmentHash, User);
+	}
+	if (CachedHandle.IsSet())
+	{
+		GetWebApi().SetAgentEnvironment(CachedHandle->Id);
+
+		ConversationReadyExecutor->NotifyAgentEnvironmentConfigured();
+		(void)FStartupTimeline::Get().MarkMilestone(
+			FStartupTimeline::EMilestone::AgentEnvironmentConfigured);
+		UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadComplete);
+	}
+
+	GetWebApi().AddAgentEnvironment(AgentEnvironment).Then(
+		[this, EnvironmentHash, User, CachedHandle](
+			const auto& ResultFuture) mutable -> void
+		{
+			const auto& Result = ResultFuture.Get();
+			if (Result.HasError())
 			{
-				const auto& Result = ResultFuture.Get();
-				if (Result.HasError())
+				UE_LOG(LogAIAssistant, Error, TEXT("%s"), *Result.GetError());
+				if (!User.IsEmpty())
 				{
-					UE_LOG(LogAIAssistant, Error, TEXT("%s"), *Result.GetError());
-					bAgentEnvironmentIsUefn.Reset();
-					InitializeConversationReadyExecutor();
+					(void)AgentEnvironmentCache.Remove(EnvironmentHash, User);
+				}
+				bAgentEnvironmentIsUefn.Reset();
+				InitializeConversationReadyExecutor();
 
-					UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadError);
+				UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadError);
+			}
+			else
+			{
+				(void)FStartupTimeline::Get().MarkMilestone(
+					FStartupTimeline::EMilestone::AgentEnvironmentAdded);
+				const FAgentEnvironmentHandle& Handle = Result.GetValue();
+				if (CachedHandle.IsSet() && CachedHandle->Id.Id == Handle.Id.Id)
+				{
+					return;
 				}
-				else
+				if (!User.IsEmpty())
 				{
-					GetWebApi().SetAgentEnvironment(Result.GetValue().Id);
+					AgentEnvironmentCache.Add(EnvironmentHash, User, Handle);
+				}
+				GetWebApi().SetAgentEnvironment(Handle.Id);
 
+				if (CachedHandle.IsSet())
+				{
+					UE_LOG(
+						LogAIAssistant, Display,
+						TEXT("Replaced stale agent environment %s with %s."),
+						*CachedHandle->Id.Id, *Handle.Id.Id);
+				}
+				else
+				{
 					ConversationReadyExecutor->NotifyAgentEnvironmentConfigured();
+					(void)FStartupTimeline::Get().MarkMilestone(
+						FStartupTimeline::EMilestone::AgentEnvironmentConfigured);
 					UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadComplete);
 				}
-			});
-		SAIAssistantWebBrowser::OnCultureChanged();
-	}
-	else
-	{
-		UpdateWebBrowserLoadState(EWebBrowserLoadState::LoadComplete);
-	}
+			}
+		});
 }
 
 
@@ -279,22 +543,36 @@ void SAIAssistantWebBrowser::UnbindUObject(const FString& Name, UObject* Object,
 }
 
 
-bool SAIAssistantWebBrowser::CanLoadUrl(const FString& Url) const
+bool SAIAssistantWebBrowser::CanLoadUrl(const FString& Url)
 {
-	for (const FRegexPattern& Pattern : AllowedUrlRegexPatterns)
-	{
-		if (FRegexMatcher(Pattern, Url).FindNext()) return true;
-	}
-	return false;
+	return AllowedUrls->IsAllowed(Url);
 }
 
 
 void SAIAssistantWebBrowser::LoadConfig()
 {
-	Config = FAIAssistantConfig::Load();
+	// The config file is found and parsed once and shared by all browsers.
+	Config = FConfigService::Get().GetConfig();
 	
-	// Cache regex patterns to avoid reallocation / compilation.
-	AllowedUrlRegexPatterns = Config.GetAllowedUrlRegexPatterns();
+	// Compile the allow-list once rather than on each navigation.
+	AllowedUrls.Emplace(Config.GetAllAllowedUrlRegexes());
+}
+
+
+void SAIAssistantWebBrowser::OnConfigChanged(const FAIAssistantConfig& InConfig, const FConfigChange& Change)
+{
+	Config = InConfig;
+
+	// The main URL is part of the allow-list so it changes when either field changes.
+	const int32 NumCompiled = AllowedUrls->Update(Config.GetAllAllowedUrlRegexes());
+	UE_LOG(LogAIAssistant, Verbose, TEXT("Compiled %d changed AI assistant URL patterns."), NumCompiled);
+
+	if (Change.bMainUrlChanged)
+	{
+		// Loading the page resets its state, so the agent environment is configured again when it completes.
+		bAgentEnvironmentIsUefn.Reset();
+		(void) LoadUrl(Config.MainUrl, false);
+	}
 }
 
 
@@ -302,6 +580,8 @@ void SAIAssistantWebBrowser::CreateConversation()
 {
 	if (!ConversationReadyExecutor->SetCreatingConversation(true))
 	{
+		// Messages for the previous conversation are discarded.
+		(void)FMessageOutbox::Get().DiscardUnclaimed();
 		GetWebApi().CreateConversation().Then(
 			[this](const TFuture<TValueOrError<void, FString>>& UnusedResult) -> void
 			{
@@ -334,11 +614,8 @@ void SAIAssistantWebBrowser::AddUserMessageToConversation(
 		MessageContentItem.Content.Get<FTextMessageContent>().Text = Prompt;
 	}
 
-	ConversationReadyExecutor->ExecuteWhenReady(
-		[this, Options = MoveTemp(Options)]() -> void
-		{
-			GetWebApi().AddMessageToConversation(Options);
-		});
+	(void)FMessageOutbox::Get().Add(Options);
+	FlushMessageOutboxWhenReady();
 }
 
 FWebApi& SAIAssistantWebBrowser::GetWebApi()
@@ -384,3 +661,83 @@ void SAIAssistantWebBrowser::OnCultureChanged()
 	FString LanguageCode = FInternationalization::Get().GetCurrentLanguage()->GetName();
 	WebApi->UpdateGlobalLocale(LanguageCode);
 }
+
+
+void SAIAssistantWebBrowser::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	LastTickSeconds = FPlatformTime::Seconds();
+}
+
+
+bool SAIAssistantWebBrowser::UpdateFrameRate(float DeltaTime)
+{
+	if (!FrameRateGovernor.IsSet() || !WebBrowserWindow.IsValid())
+	{
+		return false; // ..means remove the ticker
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	FFrameRateGovernor::FInputs Inputs;
+	Inputs.bIsVisible = NowSeconds - LastTickSeconds < AIAssistantWebBrowserHiddenAfterSeconds;
+	Inputs.bIsApplicationActive = FSlateApplication::IsInitialized() && FSlateApplication::Get().IsActive();
+	Inputs.bHasUserInput = IsHovered() || HasFocusedDescendants();
+	// Web API calls in flight are streaming a response, which the page renders as it arrives.
+	Inputs.bIsBusy = WebBrowserLoadState == EWebBrowserLoadState::LoadStarted || FWebApiMetrics::Get().GetNumInFlight() > 0;
+
+	if (FrameRateGovernor->Update(Inputs, NowSeconds))
+	{
+		UE_LOG(
+			LogAIAssistant, Verbose, TEXT("AI assistant web browser is %s, rendering at %d fps."),
+			FFrameRateGovernor::GetStateName(FrameRateGovernor->GetState()), FrameRateGovernor->GetFrameRate());
+
+		WebBrowserWindow->SetIsHidden(FrameRateGovernor->GetFrameRate() == 0);
+	}
+
+	return true; // ..means keep ticking
+}
+
+
+FString SAIAssistantWebBrowser::GetFrameRateStats() const
+{
+	return FrameRateGovernor.IsSet() ? FrameRateGovernor->FormatStats(FPlatformTime::Seconds()) : FString();
+}
+
+
+FString SAIAssistantWebBrowser::DumpConsoleMessages(bool bReset)
+{
+	const FString Messages = ConsoleMessageLog->Format();
+	if (bReset)
+	{
+		ConsoleMessageLog->Reset();
+	}
+	return Messages;
+}
+
+
+void SAIAssistantWebBrowser::OnConsoleMessage(
+	const FString& Message, const FString& Source, int32 Line, EWebBrowserConsoleLogSeverity Severity)
+{
+	// Repeated messages and messages over the rate limit are only kept in the console message log.
+	if (!ConsoleMessageLog->Add(Severity, Message, Source, Line, FPlatformTime::Seconds()))
+	{
+		return;
+	}
+
+	// Logs messages from JavaScript.
+
+	if (Severity == EWebBrowserConsoleLogSeverity::Error || Severity == EWebBrowserConsoleLogSeverity::Fatal)
+	{
+		UE_LOG(LogAIAssistant, Error, TEXT("JavaScript Error - '%s' @ %s:%d"), *Message, *Source, Line);
+	}
+	else if (Severity == EWebBrowserConsoleLogSeverity::Warning)
+	{
+		UE_LOG(LogAIAssistant, Warning, TEXT("JavaScript Warning - '%s' @ %s:%d"), *Message, *Source, Line);
+	}
+	else
+	{
+		UE_LOG(LogAIAssistant, Display, TEXT("JavaScript - '%s' @ %s:%d"), *Message, *Source, Line);
+	}
+}
@@ -4,13 +4,20 @@
 #pragma once
 
 
+#include "Containers/Ticker.h"
 #include "Misc/Optional.h"
 #include "SWebBrowser.h"
 
 #include "Core/AIAssistantConfig.h"
+#include "Core/AIAssistantConfigService.h"
 #include "Core/AIAssistantConsole.h"
 #include "Core/AIAssistantConversationReadyExecutor.h"
 #include "Core/AIAssistantExecuteWhenReady.h"
+#include "Core/AIAssistantUrlAllowList.h"
+#include "UI/AIAssistantConsoleMessageLog.h"
+#include "UI/AIAssistantFrameRateGovernor.h"
+#include "WebAPI/AIAssistantAgentEnvironmentCache.h"
+#include "WebAPI/AIAssistantMessageOutbox.h"
 #include "WebAPI/AIAssistantWebJavaScriptDelegateBinder.h"
 #include "WebAPI/AIAssistantWebApi.h"
 
@@ -38,12 +45,28 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SAIAssistantWebBrowser() override;
 
 	
 	/**
 	 * Called when widget becomes closed.
 	 */
 	void OnClosed();
+
+
+	/**
+	 * Describe the browser's rendering state and the time spent in each state.
+	 * @return Frame rate statistics, empty if the frame rate isn't governed.
+	 */
+	FString GetFrameRateStats() const;
+
+
+	/**
+	 * Get the JavaScript console messages captured from the page.
+	 * @param bReset Whether to remove the captured messages.
+	 * @return Captured messages, one per line.
+	 */
+	FString DumpConsoleMessages(bool bReset = false);
 	
 	
 	/** Loads a URL.
@@ -65,6 +88,8 @@ public:
 	// Treat all keys as handled by this widget when it has focus. This prevents hotkeys from firing when users chat with the assistant.
 	virtual FReply OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override { return FReply::Handled(); }
 	virtual FReply OnKeyUp(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override { return FReply::Handled(); }
+	// Slate only ticks widgets that are painted, which is used to detect whether the browser is visible.
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 
 	// High level conversation API.
@@ -72,15 +97,16 @@ public:
 	// Asynchronously create a new conversation.
 	void CreateConversation();
 
-	// Add a message to the existing conversation.
-	// If a new conversation is being currently being created, clear enqueued messages and
-	// enqueue the specified message.
+	// Add a message to the existing conversation, or to the conversation being created.
+	// Messages are held in the message outbox until they're sent so they survive the page
+	// reloading and the tab being closed. Only CreateConversation() discards messages that
+	// haven't been sent yet.
 	void AddUserMessageToConversation(
 		const FString& VisiblePrompt, const FString& HiddenContext = FString());
 	
 private:
 
-	// FExecuteWhenReady interface
+	// Get the state of the assistant page pushed to the conversation ready executor.
 	UE::AIAssistant::FExecuteWhenReady::EExecuteWhenReadyState GetExecuteWhenReadyState() const;
 
 	enum class EWebBrowserLoadState : uint8
@@ -94,12 +120,18 @@ private:
 	// Current load state of web browser page.
 	EWebBrowserLoadState WebBrowserLoadState = EWebBrowserLoadState::Default;
 	
+	// Capture a JavaScript console message and write it to the output log unless it's suppressed.
+	void OnConsoleMessage(const FString& Message, const FString& Source, int32 Line, EWebBrowserConsoleLogSeverity Severity);
+
 	// Determine whether a URL can be loaded.
-	bool CanLoadUrl(const FString& Url) const;
+	bool CanLoadUrl(const FString& Url);
 	
 	// Load or reload the assistant configuration.
 	void LoadConfig();
 
+	// Apply a configuration that changed on disk.
+	void OnConfigChanged(const FAIAssistantConfig& InConfig, const UE::AIAssistant::FConfigChange& Change);
+
 	// Initialize conversation ready executor.
 	void InitializeConversationReadyExecutor();
 
@@ -118,18 +150,42 @@ private:
 	// Set / update the agent environment.
 	void UpdateAgentEnvironment(bool bUseUefnMode);
 
+	// Add the agent environment and set it, using the handle cached for User if there is one.
+	// User is empty if the assistant user isn't known, in which case the cache isn't used.
+	void AddAgentEnvironment(const UE::AIAssistant::FAgentEnvironment& AgentEnvironment, const FString& User);
+
 	// Update the current browser state.
 	void UpdateWebBrowserLoadState(const EWebBrowserLoadState InWebBrowserLoadState);
 
+	// Send the messages in the message outbox when the conversation is ready.
+	void FlushMessageOutboxWhenReady();
+
+	// Send messages that failed to send again after FMessageOutbox::RetryDelaySeconds.
+	void FlushMessageOutboxAfterDelay();
+
 	// Handle language / culture changed notification.
 	void OnCultureChanged();
+
+	// Sample the browser's activity and pause or resume rendering.
+	bool UpdateFrameRate(float DeltaTime);
 	
 	// Widgets.
 	TSharedPtr<SWebBrowser> WebBrowserWidget;
+	// Recent JavaScript console messages.
+	TOptional<UE::AIAssistant::FConsoleMessageLog> ConsoleMessageLog;
+	// Browser window rendering the page.
+	TSharedPtr<IWebBrowserWindow> WebBrowserWindow;
+
+	// Decides when the browser renders, unset if rendering isn't paused.
+	TOptional<UE::AIAssistant::FFrameRateGovernor> FrameRateGovernor;
+	// Periodically updates FrameRateGovernor.
+	FTSTicker::FDelegateHandle FrameRateTickerHandle;
+	// When this widget was last ticked.
+	double LastTickSeconds = 0.0;
 	
 	// Configuration.
 	FAIAssistantConfig Config;
-	TArray<FRegexPattern> AllowedUrlRegexPatterns;
+	TOptional<UE::AIAssistant::FUrlAllowList> AllowedUrls;
 
 	// Previously opened URL.
 	FString LastOpenedUrl;
@@ -141,6 +197,8 @@ private:
 	TOptional<UE::AIAssistant::FWebApi> WebApi;
 	// Whether the agent environment has been configured since loading the page.
 	TOptional<bool> bAgentEnvironmentIsUefn;
+	// Handles of agent environments added in previous sessions.
+	UE::AIAssistant::FAgentEnvironmentCache AgentEnvironmentCache;
 	// Subscription to a cvar that controls the mode of the assistant.
 	TOptional<UE::AIAssistant::FUefnModeSubscription> UefnModeSubscription;
 	// Handles deferring adding messages until a conversation is ready.
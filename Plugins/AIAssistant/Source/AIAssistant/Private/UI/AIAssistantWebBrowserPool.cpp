@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "AIAssistantWebBrowserPool.h"
+
+#include "CoreGlobals.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+
+#include "Core/AIAssistantLog.h"
+#include "Core/AIAssistantStartupTimeline.h"
+#include "UI/AIAssistantWebBrowser.h"
+
+
+//
+// Statics.
+//
+
+
+// Whether closed browsers are parked for reuse.
+static bool bAIAssistantWebBrowserPoolEnabled = true;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserPoolConsoleVariableRef(
+	TEXT("ai.assistant.browser.pool"), bAIAssistantWebBrowserPoolEnabled,
+	TEXT("Whether the AI assistant web browser is kept alive when its tab is closed, so reopening the tab doesn't reload the web ")
+	TEXT("application."));
+
+// Whether a browser is created when the engine finishes initializing.
+static bool bAIAssistantWebBrowserPrewarmEnabled = false;
+
+static FAutoConsoleVariableRef AIAssistantWebBrowserPrewarmConsoleVariableRef(
+	TEXT("ai.assistant.browser.prewarm"), bAIAssistantWebBrowserPrewarmEnabled,
+	TEXT("Whether the AI assistant web browser is created, hidden, when the editor starts so the web application has loaded when the ")
+	TEXT("tab is first opened. Requires ai.assistant.browser.pool."));
+
+
+//
+// FAIAssistantWebBrowserPool
+//
+
+
+FAIAssistantWebBrowserPool::FAIAssistantWebBrowserPool()
+{
+	auto PrewarmIfEnabled = [this]() -> void
+	{
+		if (bAIAssistantWebBrowserPoolEnabled && bAIAssistantWebBrowserPrewarmEnabled)
+		{
+			Prewarm();
+		}
+	};
+
+	// The browser needs the engine to be initialized, which it is if the plugin was enabled while the editor is running.
+	if (GIsRunning)
+	{
+		PrewarmIfEnabled();
+	}
+	else
+	{
+		EngineLoopInitCompleteHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddLambda(MoveTemp(PrewarmIfEnabled));
+	}
+
+	// The parked browser holds a CEF window and the web application, give them back when memory is low.
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddLambda([this]() -> void
+	{
+		if (HasPooled())
+		{
+			UE_LOG(LogAIAssistant, Display, TEXT("Closing the pooled AI assistant web browser to trim memory."));
+			ClosePooled();
+		}
+	});
+}
+
+
+FAIAssistantWebBrowserPool::~FAIAssistantWebBrowserPool()
+{
+	FCoreDelegates::OnFEngineLoopInitComplete.Remove(EngineLoopInitCompleteHandle);
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+
+	ClosePooled();
+}
+
+
+TSharedRef<SAIAssistantWebBrowser> FAIAssistantWebBrowserPool::Acquire()
+{
+	if (PooledWebBrowser.IsValid())
+	{
+		ActiveWebBrowser = MoveTemp(PooledWebBrowser);
+		bPooledIsPrewarmed = false;
+	}
+	else
+	{
+		ActiveWebBrowser = SNew(SAIAssistantWebBrowser);
+	}
+
+	return ActiveWebBrowser.ToSharedRef();
+}
+
+
+void FAIAssistantWebBrowserPool::Release(const TSharedRef<SAIAssistantWebBrowser>& WebBrowser)
+{
+	if (ActiveWebBrowser == WebBrowser)
+	{
+		ActiveWebBrowser.Reset();
+	}
+
+	if (!bAIAssistantWebBrowserPoolEnabled)
+	{
+		WebBrowser->OnClosed();
+
+		return;
+	}
+
+	// Only one browser is kept, a tab is only spawned once at a time so this is only replaced if pooling was toggled.
+	ClosePooled();
+	PooledWebBrowser = WebBrowser;
+	bPooledIsPrewarmed = false;
+}
+
+
+void FAIAssistantWebBrowserPool::Prewarm()
+{
+	// Some scenarios, like commandlets, don't have slate initialized.
+	if (!PooledWebBrowser.IsValid() && FSlateApplication::IsInitialized())
+	{
+		// The session continues when the tab is spawned, see FAIAssistantModule::OnSpawnPluginTab().
+		UE::AIAssistant::FStartupTimeline::Get().BeginSession();
+		PooledWebBrowser = SNew(SAIAssistantWebBrowser);
+		bPooledIsPrewarmed = true;
+	}
+}
+
+
+void FAIAssistantWebBrowserPool::ClosePooled()
+{
+	if (PooledWebBrowser.IsValid())
+	{
+		PooledWebBrowser->OnClosed();
+		PooledWebBrowser.Reset();
+		bPooledIsPrewarmed = false;
+	}
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#pragma once
+
+
+#include "Delegates/IDelegateInstance.h"
+#include "Templates/SharedPointer.h"
+
+
+class SAIAssistantWebBrowser;
+
+
+//
+// FAIAssistantWebBrowserPool
+//
+// Keeps the AI Assistant web browser alive while its tab is closed. Creating a web browser creates a CEF window and loads the whole web
+// application, which takes seconds, so instead a closed tab parks its browser here and the next tab reuses it with the web application's state
+// and bound objects intact.
+//
+// Controlled by console variables -
+//		- ai.assistant.browser.pool - whether closed browsers are parked, otherwise they're closed as before
+//		- ai.assistant.browser.prewarm - whether a parked browser is created, hidden, when the engine finishes initializing
+//
+// A parked browser is closed when the pool is destroyed or the application is asked to trim memory.
+// The browser shown in the tab is available from GetActive() while the tab is open.
+//
+
+
+class FAIAssistantWebBrowserPool
+{
+public:
+
+
+	FAIAssistantWebBrowserPool();
+	~FAIAssistantWebBrowserPool();
+
+	// Prevent copy.
+	FAIAssistantWebBrowserPool(const FAIAssistantWebBrowserPool&) = delete;
+	FAIAssistantWebBrowserPool& operator=(const FAIAssistantWebBrowserPool&) = delete;
+
+
+	/**
+	 * Get a browser for a tab, reusing the parked browser if there is one.
+	 * @return Browser to show in the tab.
+	 */
+	TSharedRef<SAIAssistantWebBrowser> Acquire();
+
+	/**
+	 * Return a browser whose tab closed. The browser is parked if pooling is enabled, otherwise it's closed.
+	 * @param WebBrowser Browser returned by Acquire().
+	 */
+	void Release(const TSharedRef<SAIAssistantWebBrowser>& WebBrowser);
+
+	/**
+	 * Create a parked browser if there isn't one, so the page starts loading before the tab is opened.
+	 */
+	void Prewarm();
+
+	/**
+	 * Whether the parked browser was created by Prewarm() and hasn't been shown in a tab yet.
+	 * @return Whether the parked browser is prewarmed.
+	 */
+	bool HasPrewarmed() const { return PooledWebBrowser.IsValid() && bPooledIsPrewarmed; }
+
+	/**
+	 * Close the parked browser, if any.
+	 */
+	void ClosePooled();
+
+	/**
+	 * Get the browser shown in a tab.
+	 * @return Browser returned by Acquire() that hasn't been released, if any.
+	 */
+	TSharedPtr<SAIAssistantWebBrowser> GetActive() const { return ActiveWebBrowser; }
+
+	/**
+	 * Whether there is a parked browser.
+	 * @return Whether a browser is parked.
+	 */
+	bool HasPooled() const { return PooledWebBrowser.IsValid(); }
+
+
+private:
+
+
+	// Browser that isn't shown in a tab.
+	TSharedPtr<SAIAssistantWebBrowser> PooledWebBrowser;
+
+	// Whether PooledWebBrowser was created by Prewarm().
+	bool bPooledIsPrewarmed = false;
+
+	// Browser shown in a tab. Other than the tab, the pool is the only owner of its browsers so closing one destroys it.
+	TSharedPtr<SAIAssistantWebBrowser> ActiveWebBrowser;
+
+	// Handles for engine callbacks.
+	FDelegateHandle EngineLoopInitCompleteHandle;
+	FDelegateHandle MemoryTrimHandle;
+};
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantWidgetPathIndex.h"
+
+#include "Containers/Map.h"
+
+namespace UE::AIAssistant
+{
+	// Widget type of each role, in the order of EWidgetRole.
+	static const TCHAR* const WidgetPathIndexWidgetTypes[] = {
+		TEXT("SMenuEntryBlock"),
+		TEXT("SWidgetBlock"),
+		TEXT("SToolBarButtonBlock"),
+		TEXT("SToolBarComboButtonBlock"),
+		TEXT("SButton"),
+		TEXT("SPrimaryButton"),
+		TEXT("SCheckbox"),
+		TEXT("SGraphEditor"),
+		TEXT("SGraphPanel"),
+		TEXT("SNiagaraOverviewStackNode"),
+		TEXT("SLevelEditor"),
+		TEXT("SSearchBox"),
+		TEXT("SFilterSearchBox"),
+		TEXT("SConsoleInputBox"),
+		TEXT("SDetailSingleItemRow"),
+		TEXT("SBreadcrumbTrail<FNavigationCrumb>"),
+		TEXT("SAssetTileItem"),
+		TEXT("SAssetThumbnail"),
+		TEXT("SSceneOutliner"),
+		TEXT("SSubobjectInstanceEditor"),
+		TEXT("SDockingTabStack"),
+		TEXT("SDetailsView"),
+		TEXT("SStatusBar"),
+		TEXT("SDockingArea"),
+		TEXT("SDrawerOverlay"),
+	};
+	static_assert(UE_ARRAY_COUNT(WidgetPathIndexWidgetTypes) == int32(EWidgetRole::Unclassified));
+
+	FWidgetPathIndex::FWidgetPathIndex(const FWidgetPath& WidgetPath) :
+		ClosestIndices(InPlace, INDEX_NONE), FurthestIndices(InPlace, INDEX_NONE)
+	{
+		Types.Reserve(WidgetPath.Widgets.Num());
+		Roles.Reserve(WidgetPath.Widgets.Num());
+		for (int32 WidgetIndex = 0; WidgetIndex < WidgetPath.Widgets.Num(); ++WidgetIndex)
+		{
+			Add(WidgetPath.Widgets[WidgetIndex].Widget->GetType());
+		}
+	}
+
+	FWidgetPathIndex::FWidgetPathIndex(TConstArrayView<FName> WidgetTypes) :
+		ClosestIndices(InPlace, INDEX_NONE), FurthestIndices(InPlace, INDEX_NONE)
+	{
+		Types.Reserve(WidgetTypes.Num());
+		Roles.Reserve(WidgetTypes.Num());
+		for (const FName& WidgetType : WidgetTypes)
+		{
+			Add(WidgetType);
+		}
+	}
+
+	int32 FWidgetPathIndex::FindClosest(EWidgetRole Role) const
+	{
+		return Role == EWidgetRole::Unclassified ? INDEX_NONE : ClosestIndices[int32(Role)];
+	}
+
+	int32 FWidgetPathIndex::FindFurthest(EWidgetRole Role) const
+	{
+		return Role == EWidgetRole::Unclassified ? INDEX_NONE : FurthestIndices[int32(Role)];
+	}
+
+	EWidgetRole FWidgetPathIndex::GetRole(FName WidgetType)
+	{
+		static const TMap<FName, EWidgetRole> RolesByWidgetType = []()
+		{
+			TMap<FName, EWidgetRole> Roles;
+			for (int32 RoleIndex = 0; RoleIndex < NumRoles; ++RoleIndex)
+			{
+				Roles.Add(WidgetPathIndexWidgetTypes[RoleIndex], EWidgetRole(RoleIndex));
+			}
+			return Roles;
+		}();
+		const EWidgetRole* Role = RolesByWidgetType.Find(WidgetType);
+		return Role ? *Role : EWidgetRole::Unclassified;
+	}
+
+	FName FWidgetPathIndex::GetWidgetType(EWidgetRole Role)
+	{
+		return Role == EWidgetRole::Unclassified ? NAME_None
+												 : FName(WidgetPathIndexWidgetTypes[int32(Role)]);
+	}
+
+	void FWidgetPathIndex::Add(FName WidgetType)
+	{
+		Types.Add(WidgetType);
+		const int32 WidgetIndex = Roles.Add(GetRole(WidgetType));
+		const EWidgetRole Role = Roles[WidgetIndex];
+		if (Role == EWidgetRole::Unclassified)
+		{
+			return;
+		}
+		ClosestIndices[int32(Role)] = WidgetIndex;
+		if (FurthestIndices[int32(Role)] == INDEX_NONE)
+		{
+			FurthestIndices[int32(Role)] = WidgetIndex;
+		}
+	}
+}
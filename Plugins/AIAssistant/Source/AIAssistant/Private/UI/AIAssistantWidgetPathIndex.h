@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StaticArray.h"
+#include "Layout/WidgetPath.h"
+#include "UObject/NameTypes.h"
+
+namespace UE::AIAssistant
+{
+	// Widget types the Slate querier looks for in a widget path.
+	enum class EWidgetRole : uint8
+	{
+		MenuEntryBlock = 0,
+		WidgetBlock,
+		ToolBarButtonBlock,
+		ToolBarComboButtonBlock,
+		Button,
+		PrimaryButton,
+		CheckBox,
+		GraphEditor,
+		GraphPanel,
+		NiagaraOverviewStackNode,
+		LevelEditor,
+		SearchBox,
+		FilterSearchBox,
+		ConsoleInputBox,
+		DetailSingleItemRow,
+		BreadcrumbTrail,
+		AssetTileItem,
+		AssetThumbnail,
+		SceneOutliner,
+		SubobjectInstanceEditor,
+		DockingTabStack,
+		DetailsView,
+		StatusBar,
+		DockingArea,
+		DrawerOverlay,
+		// A widget type that isn't looked for.
+		Unclassified,
+	};
+
+	// Classifies each widget in a widget path by its type in a single pass.
+	//
+	// The closest (deepest) and furthest (nearest to the window) index of each role are recorded
+	// so that looking up a widget of a role doesn't walk the path and call SWidget::GetType()
+	// again.
+	class FWidgetPathIndex
+	{
+	public:
+		explicit FWidgetPathIndex(const FWidgetPath& WidgetPath);
+		explicit FWidgetPathIndex(TConstArrayView<FName> WidgetTypes);
+
+		// Get the number of widgets in the path.
+		int32 Num() const { return Roles.Num(); }
+
+		// Get the role of the widget at an index in the path.
+		EWidgetRole GetRoleAt(int32 WidgetIndex) const { return Roles[WidgetIndex]; }
+
+		// Get the type of the widget at an index in the path.
+		FName GetTypeAt(int32 WidgetIndex) const { return Types[WidgetIndex]; }
+
+		// Get the index of the deepest widget of a role, INDEX_NONE if there is none.
+		int32 FindClosest(EWidgetRole Role) const;
+
+		// Get the index of the widget of a role nearest to the window, INDEX_NONE if there is none.
+		int32 FindFurthest(EWidgetRole Role) const;
+
+		// Get the role of a widget type.
+		static EWidgetRole GetRole(FName WidgetType);
+
+		// Get the widget type of a role.
+		static FName GetWidgetType(EWidgetRole Role);
+
+	private:
+		void Add(FName WidgetType);
+
+	private:
+		static constexpr int32 NumRoles = int32(EWidgetRole::Unclassified);
+
+		TArray<FName, TInlineAllocator<64>> Types;
+		TArray<EWidgetRole, TInlineAllocator<64>> Roles;
+		TStaticArray<int32, NumRoles> ClosestIndices;
+		TStaticArray<int32, NumRoles> FurthestIndices;
+	};
+}
@@ -0,0 +1,570 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantJsonPullReader.h"
+
+#include "Misc/AssertionMacros.h"
+#include "Misc/Char.h"
+#include "Misc/CString.h"
+#include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
+
+namespace UE::AIAssistant
+{
+	FJsonPullReader::FJsonPullReader(FStringView InJson) : Json(InJson)
+	{
+	}
+
+	FJsonPullReader::EValueType FJsonPullReader::PeekValueType()
+	{
+		if (HasError())
+		{
+			return EValueType::None;
+		}
+		switch (SkipWhitespace())
+		{
+			case TEXT('{'):
+				return EValueType::Object;
+			case TEXT('['):
+				return EValueType::Array;
+			case TEXT('"'):
+				return EValueType::String;
+			case TEXT('t'):
+			case TEXT('f'):
+				return EValueType::Boolean;
+			case TEXT('n'):
+				return EValueType::Null;
+			case TEXT('-'):
+			case TEXT('0'):
+			case TEXT('1'):
+			case TEXT('2'):
+			case TEXT('3'):
+			case TEXT('4'):
+			case TEXT('5'):
+			case TEXT('6'):
+			case TEXT('7'):
+			case TEXT('8'):
+			case TEXT('9'):
+				return EValueType::Number;
+			default:
+				return EValueType::None;
+		}
+	}
+
+	bool FJsonPullReader::BeginObject()
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (!TryConsume(TEXT('{')))
+		{
+			SetError(TEXT("Expected object"));
+			return false;
+		}
+		return PushContainer();
+	}
+
+	bool FJsonPullReader::NextField(FStringView& OutFieldName)
+	{
+		if (HasError() || ContainerHasElements.IsEmpty())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (TryConsume(TEXT('}')))
+		{
+			ContainerHasElements.Pop(EAllowShrinking::No);
+			return false;
+		}
+		if (ContainerHasElements.Last())
+		{
+			if (!TryConsume(TEXT(',')))
+			{
+				SetError(TEXT("Expected ',' or '}'"));
+				return false;
+			}
+			SkipWhitespace();
+		}
+		ContainerHasElements.Last() = true;
+		if (!ConsumeStringView(OutFieldName, FieldNameBuffer))
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (!TryConsume(TEXT(':')))
+		{
+			SetError(TEXT("Expected ':'"));
+			return false;
+		}
+		return true;
+	}
+
+	bool FJsonPullReader::BeginArray()
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (!TryConsume(TEXT('[')))
+		{
+			SetError(TEXT("Expected array"));
+			return false;
+		}
+		return PushContainer();
+	}
+
+	bool FJsonPullReader::NextElement()
+	{
+		if (HasError() || ContainerHasElements.IsEmpty())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (TryConsume(TEXT(']')))
+		{
+			ContainerHasElements.Pop(EAllowShrinking::No);
+			return false;
+		}
+		if (ContainerHasElements.Last())
+		{
+			if (!TryConsume(TEXT(',')))
+			{
+				SetError(TEXT("Expected ',' or ']'"));
+				return false;
+			}
+		}
+		ContainerHasElements.Last() = true;
+		return true;
+	}
+
+	bool FJsonPullReader::ReadString(FString& OutValue)
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		OutValue.Reset();
+		return ConsumeString(&OutValue);
+	}
+
+	bool FJsonPullReader::ReadNumber(double& OutValue)
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		int32 Start;
+		if (!ConsumeNumber(Start))
+		{
+			return false;
+		}
+		// Numbers are short so they're converted from a stack buffer.
+		TStringBuilder<64> Number;
+		Number.Append(Json.Mid(Start, Position - Start));
+		OutValue = FCString::Atod(*Number);
+		return true;
+	}
+
+	bool FJsonPullReader::ReadBool(bool& OutValue)
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		switch (SkipWhitespace())
+		{
+			case TEXT('t'):
+				OutValue = true;
+				return ConsumeLiteral(TEXTVIEW("true"));
+			case TEXT('f'):
+				OutValue = false;
+				return ConsumeLiteral(TEXTVIEW("false"));
+			default:
+				SetError(TEXT("Expected boolean"));
+				return false;
+		}
+	}
+
+	bool FJsonPullReader::ReadNull()
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		SkipWhitespace();
+		return ConsumeLiteral(TEXTVIEW("null"));
+	}
+
+	bool FJsonPullReader::TryReadNull()
+	{
+		return PeekValueType() == EValueType::Null && ReadNull();
+	}
+
+	bool FJsonPullReader::SkipValue()
+	{
+		return !HasError() && SkipValueAtDepth(ContainerHasElements.Num());
+	}
+
+	bool FJsonPullReader::ReadEnd()
+	{
+		if (HasError())
+		{
+			return false;
+		}
+		if (SkipWhitespace() != TEXT('\0') || Position < Json.Len())
+		{
+			SetError(TEXT("Unexpected data after value"));
+			return false;
+		}
+		return true;
+	}
+
+	void FJsonPullReader::Seek(int32 Offset)
+	{
+		check(Offset >= 0 && Offset <= Json.Len());
+		Position = Offset;
+	}
+
+	void FJsonPullReader::SetError(const TCHAR* Message, int32 Offset)
+	{
+		if (!HasError())
+		{
+			ErrorOffset = Offset;
+			ErrorMessage = Message;
+		}
+	}
+
+	TCHAR FJsonPullReader::SkipWhitespace()
+	{
+		while (Position < Json.Len())
+		{
+			const TCHAR Character = Json[Position];
+			if (Character != TEXT(' ') && Character != TEXT('\t') && Character != TEXT('\n') &&
+				Character != TEXT('\r'))
+			{
+				return Character;
+			}
+			++Position;
+		}
+		return TEXT('\0');
+	}
+
+	bool FJsonPullReader::TryConsume(TCHAR Character)
+	{
+		if (Position < Json.Len() && Json[Position] == Character)
+		{
+			++Position;
+			return true;
+		}
+		return false;
+	}
+
+	bool FJsonPullReader::ConsumeLiteral(FStringView Literal)
+	{
+		if (!Json.RightChop(Position).StartsWith(Literal, ESearchCase::CaseSensitive))
+		{
+			SetError(*FString::Printf(TEXT("Expected '%s'"), *FString(Literal)));
+			return false;
+		}
+		Position += Literal.Len();
+		return true;
+	}
+
+	bool FJsonPullReader::ConsumeString(FString* OutValue)
+	{
+		if (!TryConsume(TEXT('"')))
+		{
+			SetError(TEXT("Expected string"));
+			return false;
+		}
+		while (Position < Json.Len())
+		{
+			// Copy runs of unescaped characters in one go.
+			const int32 RunStart = Position;
+			while (Position < Json.Len() && Json[Position] != TEXT('"') &&
+				Json[Position] != TEXT('\\') && uint32(Json[Position]) >= 0x20)
+			{
+				++Position;
+			}
+			if (OutValue && Position > RunStart)
+			{
+				OutValue->AppendChars(Json.GetData() + RunStart, Position - RunStart);
+			}
+			if (Position >= Json.Len())
+			{
+				break;
+			}
+
+			const TCHAR Character = Json[Position];
+			if (Character == TEXT('"'))
+			{
+				++Position;
+				return true;
+			}
+			if (Character != TEXT('\\'))
+			{
+				SetError(TEXT("Unescaped control character in string"));
+				return false;
+			}
+
+			const int32 EscapeOffset = Position++;
+			if (Position >= Json.Len())
+			{
+				break;
+			}
+			TCHAR Unescaped;
+			switch (Json[Position++])
+			{
+				case TEXT('"'): Unescaped = TEXT('"'); break;
+				case TEXT('\\'): Unescaped = TEXT('\\'); break;
+				case TEXT('/'): Unescaped = TEXT('/'); break;
+				case TEXT('b'): Unescaped = TEXT('\b'); break;
+				case TEXT('f'): Unescaped = TEXT('\f'); break;
+				case TEXT('n'): Unescaped = TEXT('\n'); break;
+				case TEXT('r'): Unescaped = TEXT('\r'); break;
+				case TEXT('t'): Unescaped = TEXT('\t'); break;
+				case TEXT('u'):
+				{
+					uint32 CodeUnit;
+					if (!ConsumeHexDigits(CodeUnit))
+					{
+						return false;
+					}
+					uint32 CodePoint = CodeUnit;
+					// Combine surrogate pairs, lone surrogates are passed through.
+					if (CodeUnit >= 0xD800 && CodeUnit <= 0xDBFF &&
+						Json.RightChop(Position).StartsWith(TEXTVIEW("\\u")))
+					{
+						const int32 LowSurrogateOffset = Position;
+						Position += 2;
+						uint32 LowSurrogate;
+						if (!ConsumeHexDigits(LowSurrogate))
+						{
+							return false;
+						}
+						if (LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+						{
+							CodePoint = 0x10000 + ((CodeUnit - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						}
+						else
+						{
+							Position = LowSurrogateOffset;
+						}
+					}
+					if (OutValue)
+					{
+						if constexpr (sizeof(TCHAR) == 2)
+						{
+							if (CodePoint >= 0x10000)
+							{
+								OutValue->AppendChar(TCHAR(0xD800 + ((CodePoint - 0x10000) >> 10)));
+								OutValue->AppendChar(TCHAR(0xDC00 + ((CodePoint - 0x10000) & 0x3FF)));
+								continue;
+							}
+						}
+						OutValue->AppendChar(TCHAR(CodePoint));
+					}
+					continue;
+				}
+				default:
+					SetError(TEXT("Invalid escape sequence"), EscapeOffset);
+					return false;
+			}
+			if (OutValue)
+			{
+				OutValue->AppendChar(Unescaped);
+			}
+		}
+		SetError(TEXT("Unterminated string"));
+		return false;
+	}
+
+	bool FJsonPullReader::ConsumeStringView(FStringView& OutValue, FString& Buffer)
+	{
+		const int32 Start = Position;
+		if (!ConsumeString(nullptr))
+		{
+			return false;
+		}
+		const FStringView Quoted = Json.Mid(Start + 1, Position - Start - 2);
+		int32 UnusedIndex;
+		if (!Quoted.FindChar(TEXT('\\'), UnusedIndex))
+		{
+			OutValue = Quoted;
+			return true;
+		}
+		// Only strings with escapes are copied.
+		const int32 End = Position;
+		Position = Start;
+		Buffer.Reset();
+		verify(ConsumeString(&Buffer));
+		check(Position == End);
+		OutValue = Buffer;
+		return true;
+	}
+
+	bool FJsonPullReader::ConsumeHexDigits(uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index, ++Position)
+		{
+			const TCHAR Character = Position < Json.Len() ? Json[Position] : TEXT('\0');
+			if (!FChar::IsHexDigit(Character))
+			{
+				SetError(TEXT("Expected hex digit"));
+				return false;
+			}
+			OutValue = (OutValue << 4) | uint32(FParse::HexDigit(Character));
+		}
+		return true;
+	}
+
+	bool FJsonPullReader::ConsumeNumber(int32& OutStart)
+	{
+		OutStart = Position;
+		auto ConsumeDigits = [this]() -> int32
+		{
+			const int32 Start = Position;
+			while (Position < Json.Len() && FChar::IsDigit(Json[Position]))
+			{
+				++Position;
+			}
+			return Position - Start;
+		};
+
+		(void)TryConsume(TEXT('-'));
+		if (TryConsume(TEXT('0')))
+		{
+			// Leading zeros are not permitted.
+		}
+		else if (ConsumeDigits() == 0)
+		{
+			SetError(TEXT("Expected number"));
+			return false;
+		}
+		if (TryConsume(TEXT('.')) && ConsumeDigits() == 0)
+		{
+			SetError(TEXT("Expected digit after '.'"));
+			return false;
+		}
+		if (TryConsume(TEXT('e')) || TryConsume(TEXT('E')))
+		{
+			if (!TryConsume(TEXT('+')))
+			{
+				(void)TryConsume(TEXT('-'));
+			}
+			if (ConsumeDigits() == 0)
+			{
+				SetError(TEXT("Expected exponent"));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool FJsonPullReader::SkipValueAtDepth(int32 Depth)
+	{
+		switch (PeekValueType())
+		{
+			case EValueType::Object:
+			{
+				if (Depth >= MaxDepth)
+				{
+					SetError(TEXT("Maximum depth exceeded"));
+					return false;
+				}
+				++Position;
+				if (SkipWhitespace() == TEXT('}'))
+				{
+					++Position;
+					return true;
+				}
+				do
+				{
+					SkipWhitespace();
+					if (!ConsumeString(nullptr))
+					{
+						return false;
+					}
+					SkipWhitespace();
+					if (!TryConsume(TEXT(':')))
+					{
+						SetError(TEXT("Expected ':'"));
+						return false;
+					}
+					if (!SkipValueAtDepth(Depth + 1))
+					{
+						return false;
+					}
+					SkipWhitespace();
+				} while (TryConsume(TEXT(',')));
+				if (!TryConsume(TEXT('}')))
+				{
+					SetError(TEXT("Expected ',' or '}'"));
+					return false;
+				}
+				return true;
+			}
+			case EValueType::Array:
+			{
+				if (Depth >= MaxDepth)
+				{
+					SetError(TEXT("Maximum depth exceeded"));
+					return false;
+				}
+				++Position;
+				if (SkipWhitespace() == TEXT(']'))
+				{
+					++Position;
+					return true;
+				}
+				do
+				{
+					if (!SkipValueAtDepth(Depth + 1))
+					{
+						return false;
+					}
+					SkipWhitespace();
+				} while (TryConsume(TEXT(',')));
+				if (!TryConsume(TEXT(']')))
+				{
+					SetError(TEXT("Expected ',' or ']'"));
+					return false;
+				}
+				return true;
+			}
+			case EValueType::String:
+				return ConsumeString(nullptr);
+			case EValueType::Number:
+			{
+				int32 UnusedStart;
+				return ConsumeNumber(UnusedStart);
+			}
+			case EValueType::Boolean:
+			{
+				bool UnusedValue;
+				return ReadBool(UnusedValue);
+			}
+			case EValueType::Null:
+				return ReadNull();
+			default:
+				SetError(TEXT("Expected value"));
+				return false;
+		}
+	}
+
+	bool FJsonPullReader::PushContainer()
+	{
+		if (ContainerHasElements.Num() >= MaxDepth)
+		{
+			SetError(TEXT("Maximum depth exceeded"));
+			return false;
+		}
+		ContainerHasElements.Add(false);
+		return true;
+	}
+}
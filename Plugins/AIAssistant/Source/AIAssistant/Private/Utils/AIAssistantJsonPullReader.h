@@ -0,0 +1,193 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+
+namespace UE::AIAssistant
+{
+	// Pull parser that reads JSON directly from a string without building a DOM.
+	//
+	// Values are consumed in document order, objects are walked with BeginObject() / NextField()
+	// and arrays with BeginArray() / NextElement(). Values that are not needed are skipped with
+	// SkipValue() which validates them without allocating. Parsing stops at the first error and
+	// the offset of the character that caused the error is available from GetErrorOffset().
+	//
+	// For example, to read {"id": "abc", "tags": ["a", "b"]}:
+	//   FJsonPullReader Reader(Json);
+	//   FStringView FieldName;
+	//   if (Reader.BeginObject())
+	//   {
+	//     while (Reader.NextField(FieldName))
+	//     {
+	//       if (FieldName == TEXTVIEW("id")) Reader.ReadString(Id);
+	//       else Reader.SkipValue();
+	//     }
+	//   }
+	//   bool bSuccess = Reader.ReadEnd();
+	class FJsonPullReader
+	{
+	public:
+		// Type of the next value.
+		enum class EValueType : uint8
+		{
+			// No value, the end of the input or a character that can't start a value.
+			None,
+			Object,
+			Array,
+			String,
+			Number,
+			Boolean,
+			Null,
+		};
+
+		// Maximum depth of nested objects and arrays.
+		static constexpr int32 MaxDepth = 256;
+
+	public:
+		// Read from Json which must outlive this object.
+		explicit FJsonPullReader(FStringView InJson);
+
+		// Get the type of the next value without consuming it.
+		EValueType PeekValueType();
+
+		// Consume the start of an object.
+		bool BeginObject();
+
+		// Consume the name of the next field in the current object, the field's value must be
+		// consumed before calling this method again. Returns false at the end of the object or on
+		// error. OutFieldName is only valid until the next call to this method.
+		bool NextField(FStringView& OutFieldName);
+
+		// Consume the start of an array.
+		bool BeginArray();
+
+		// Move to the next element in the current array, the element must be consumed before
+		// calling this method again. Returns false at the end of the array or on error.
+		bool NextElement();
+
+		// Consume a string value.
+		bool ReadString(FString& OutValue);
+
+		// Consume a number value.
+		bool ReadNumber(double& OutValue);
+
+		// Consume a boolean value.
+		bool ReadBool(bool& OutValue);
+
+		// Consume a null value.
+		bool ReadNull();
+
+		// Consume a null value if it's the next value returning whether it was consumed.
+		bool TryReadNull();
+
+		// Consume the next value whatever its type.
+		bool SkipValue();
+
+		// Check that nothing other than whitespace follows the values that have been consumed.
+		bool ReadEnd();
+
+		// Get the offset of the next character to read.
+		int32 GetOffset() const { return Position; }
+
+		// Move to an offset previously returned by GetOffset() at the start of a value. This allows
+		// a value to be read after later values, for example when its type depends upon a field
+		// that follows it. The value at Offset must be consumed before moving back.
+		void Seek(int32 Offset);
+
+		// Stop parsing reporting Message at Offset, only the first error is recorded.
+		void SetError(const TCHAR* Message, int32 Offset);
+
+		// Stop parsing reporting Message at the current offset.
+		void SetError(const TCHAR* Message) { SetError(Message, Position); }
+
+		bool HasError() const { return ErrorOffset != INDEX_NONE; }
+
+		// Get the offset of the first error or INDEX_NONE if no error occurred.
+		int32 GetErrorOffset() const { return ErrorOffset; }
+
+		// Get the message describing the first error.
+		const FString& GetErrorMessage() const { return ErrorMessage; }
+
+		// Read an object calling ReadField(FStringView FieldName) for each field. ReadField must
+		// consume the field's value and return false on error.
+		template<typename ReadFieldFunctionType>
+		bool ReadObject(ReadFieldFunctionType&& ReadField)
+		{
+			if (!BeginObject())
+			{
+				return false;
+			}
+			FStringView FieldName;
+			while (NextField(FieldName))
+			{
+				if (!ReadField(FieldName))
+				{
+					if (!HasError())
+					{
+						SetError(TEXT("Failed to read field"));
+					}
+					return false;
+				}
+			}
+			return !HasError();
+		}
+
+	private:
+		// Skip whitespace returning the next character or zero at the end of the input.
+		TCHAR SkipWhitespace();
+
+		// Consume Character if it's the next character.
+		bool TryConsume(TCHAR Character);
+
+		// Consume a literal such as "true" reporting an error if it doesn't match.
+		bool ConsumeLiteral(FStringView Literal);
+
+		// Consume a string, unescaping into OutValue if it's not null.
+		bool ConsumeString(FString* OutValue);
+
+		// Consume a string that doesn't contain escapes returning it in OutValue, otherwise
+		// unescape it into Buffer.
+		bool ConsumeStringView(FStringView& OutValue, FString& Buffer);
+
+		// Consume four hex digits.
+		bool ConsumeHexDigits(uint32& OutValue);
+
+		// Consume a number returning the range of characters it occupies.
+		bool ConsumeNumber(int32& OutStart);
+
+		// Consume a value of any type without storing it.
+		bool SkipValueAtDepth(int32 Depth);
+
+		// Start a nested object or array.
+		bool PushContainer();
+
+	private:
+		FStringView Json;
+		int32 Position = 0;
+		int32 ErrorOffset = INDEX_NONE;
+		FString ErrorMessage;
+		// Storage for field names that contain escapes.
+		FString FieldNameBuffer;
+		// For each object or array being read, whether an element has been read.
+		TArray<bool, TInlineAllocator<16>> ContainerHasElements;
+	};
+
+	// Whether ReadJson(FJsonPullReader&, T&) is defined for T.
+	template<typename T, typename = void>
+	struct THasJsonPullReader : std::false_type
+	{
+	};
+
+	template<typename T>
+	struct THasJsonPullReader<
+		T, std::void_t<decltype(ReadJson(std::declval<FJsonPullReader&>(), std::declval<T&>()))>> :
+		std::true_type
+	{
+	};
+}
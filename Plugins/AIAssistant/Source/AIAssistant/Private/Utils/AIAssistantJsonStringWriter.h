@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/Archive.h"
+#include "Serialization/JsonSerializable.h"
+#include "Serialization/JsonWriter.h"
+#include "Templates/SharedPointer.h"
+
+namespace UE::AIAssistant
+{
+	// Archive that receives the characters written by a TJsonWriter and appends them to a
+	// string. If no string is specified, characters are only counted.
+	class FJsonStringAppendArchive : public FArchive
+	{
+	public:
+		explicit FJsonStringAppendArchive(FString* InOutput) : Output(InOutput)
+		{
+			SetIsSaving(true);
+		}
+
+		void Serialize(void* Data, int64 NumBytes) override
+		{
+			const int32 NumChars = int32(NumBytes / sizeof(TCHAR));
+			NumCharsWritten += NumChars;
+			if (Output)
+			{
+				Output->AppendChars(static_cast<const TCHAR*>(Data), NumChars);
+			}
+		}
+
+		FString GetArchiveName() const override { return TEXT("FJsonStringAppendArchive"); }
+
+		// Get the number of characters written to this archive.
+		int32 GetNumCharsWritten() const { return NumCharsWritten; }
+
+	private:
+		FString* Output;
+		int32 NumCharsWritten = 0;
+	};
+
+	// Serialize an object as condensed JSON to an archive without building a JSON object or an
+	// intermediate string. This produces the same output as FJsonSerializable::ToJson(false).
+	inline void WriteJsonToArchive(const FJsonSerializable& Serializable, FArchive& Archive)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Archive);
+		Serializable.ToJson(JsonWriter, false);
+		(void)JsonWriter->Close();
+	}
+
+	// Append an object as condensed JSON to Output, escaping strings as they're written.
+	inline void AppendJson(FString& Output, const FJsonSerializable& Serializable)
+	{
+		FJsonStringAppendArchive Archive(&Output);
+		WriteJsonToArchive(Serializable, Archive);
+	}
+
+	// Get the number of characters in the condensed JSON representation of an object, this can
+	// be used to size a buffer before calling AppendJson().
+	inline int32 GetJsonLength(const FJsonSerializable& Serializable)
+	{
+		FJsonStringAppendArchive Archive(nullptr);
+		WriteJsonToArchive(Serializable, Archive);
+		return Archive.GetNumCharsWritten();
+	}
+}
@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantTextUtils.h"
+
+#include "Misc/Char.h"
+
+namespace UE::AIAssistant
+{
+	bool ContainsAsciiLetter(FStringView Text)
+	{
+		for (const TCHAR Character : Text)
+		{
+			// Fold to lower case, only letters are then in 'a' to 'z'.
+			if (TCHAR(Character | 0x20) >= TEXT('a') && TCHAR(Character | 0x20) <= TEXT('z'))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FString CollapseWhiteSpace(FStringView Text)
+	{
+		FString Collapsed;
+		Collapsed.Reserve(Text.Len());
+		bool bPendingSpace = false;
+		for (const TCHAR Character : Text)
+		{
+			if (FChar::IsWhitespace(Character))
+			{
+				bPendingSpace = !Collapsed.IsEmpty();
+				continue;
+			}
+			if (bPendingSpace)
+			{
+				Collapsed.AppendChar(TEXT(' '));
+				bPendingSpace = false;
+			}
+			Collapsed.AppendChar(Character);
+		}
+		return Collapsed;
+	}
+}
@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Internationalization/Text.h"
+
+namespace UE::AIAssistant
+{
+	// Whether text contains an ASCII letter, i.e matches the regular expression [A-Za-z].
+	// Used to ignore text that is only a value such as a number.
+	bool ContainsAsciiLetter(FStringView Text);
+
+	// Whether the display string of text contains an ASCII letter.
+	inline bool ContainsAsciiLetter(const FText& Text)
+	{
+		return ContainsAsciiLetter(FStringView(Text.ToString()));
+	}
+
+	// Remove leading and trailing white space and replace each run of white space in between
+	// with a single space.
+	FString CollapseWhiteSpace(FStringView Text);
+}
@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantTreeSearch.h"
+
+#include "HAL/PlatformTime.h"
+
+namespace UE::AIAssistant
+{
+	FTreeSearchBudget::FTreeSearchBudget(int32 InMaxNodes, double InMaxSeconds) :
+		MaxNodes(InMaxNodes),
+		DeadlineSeconds(InMaxSeconds > 0.0 ? FPlatformTime::Seconds() + InMaxSeconds : 0.0)
+	{
+	}
+
+	bool FTreeSearchBudget::TryConsumeNode()
+	{
+		if (bIsExhausted)
+		{
+			return false;
+		}
+		if ((MaxNodes > 0 && NumNodes >= MaxNodes) ||
+			(DeadlineSeconds > 0.0 && NumNodes % NodesPerTimeCheck == 0 &&
+			 FPlatformTime::Seconds() >= DeadlineSeconds))
+		{
+			bIsExhausted = true;
+			return false;
+		}
+		++NumNodes;
+		return true;
+	}
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace UE::AIAssistant
+{
+	// Limits the number of nodes visited and the time taken by one or more tree searches.
+	//
+	// The same budget can be shared by several searches so that they're limited as a whole. Once
+	// the budget is exhausted it stays exhausted and searches using it stop immediately.
+	class FTreeSearchBudget
+	{
+	public:
+		// A limit of zero or less is disabled. Time is measured from construction.
+		explicit FTreeSearchBudget(int32 InMaxNodes = 0, double InMaxSeconds = 0.0);
+
+		// Account for visiting a node, returns false if the budget is exhausted.
+		bool TryConsumeNode();
+
+		// Whether a search stopped as the budget is exhausted.
+		bool IsExhausted() const { return bIsExhausted; }
+
+		// Get the number of nodes visited.
+		int32 GetNumNodes() const { return NumNodes; }
+
+	private:
+		// Number of nodes visited between checks of the time.
+		static constexpr int32 NodesPerTimeCheck = 32;
+
+		int32 MaxNodes;
+		// Time the budget is exhausted, zero if there is no time limit.
+		double DeadlineSeconds;
+		int32 NumNodes = 0;
+		bool bIsExhausted = false;
+	};
+
+	// What a tree search does after visiting a node.
+	enum class ETreeSearchVisit : uint8
+	{
+		// Visit the node's children then continue with its siblings.
+		Continue,
+		// Continue without visiting the node's children, e.g. for a culled subtree.
+		SkipChildren,
+		// End the search, e.g. when the node searched for is found.
+		Stop,
+	};
+
+	// How a tree search ended.
+	enum class ETreeSearchResult : uint8
+	{
+		// All nodes that weren't skipped were visited.
+		Completed,
+		// The visitor stopped the search.
+		Stopped,
+		// The budget was exhausted before the search ended.
+		BudgetExhausted,
+	};
+
+	// Visit a tree depth first in pre-order, i.e the same order as a recursive search, using an
+	// explicit stack so that deep trees can't overflow the call stack.
+	//
+	// GetNumChildren(const NodeType&) returns the number of children of a node,
+	// GetChild(const NodeType&, int32) returns a child of a node and
+	// Visit(const NodeType&) returns an ETreeSearchVisit.
+	template <typename NodeType, typename GetNumChildrenType, typename GetChildType, typename VisitType>
+	ETreeSearchResult SearchTree(
+		NodeType Root, FTreeSearchBudget& Budget, GetNumChildrenType&& GetNumChildren,
+		GetChildType&& GetChild, VisitType&& Visit)
+	{
+		TArray<NodeType, TInlineAllocator<64>> NodesToVisit;
+		NodesToVisit.Add(MoveTemp(Root));
+		while (!NodesToVisit.IsEmpty())
+		{
+			if (!Budget.TryConsumeNode())
+			{
+				return ETreeSearchResult::BudgetExhausted;
+			}
+			const NodeType Node = NodesToVisit.Pop(EAllowShrinking::No);
+			const ETreeSearchVisit NextStep = Visit(Node);
+			if (NextStep == ETreeSearchVisit::Stop)
+			{
+				return ETreeSearchResult::Stopped;
+			}
+			if (NextStep == ETreeSearchVisit::SkipChildren)
+			{
+				continue;
+			}
+			// Push children in reverse so that the first child is visited next.
+			for (int32 ChildIndex = GetNumChildren(Node) - 1; ChildIndex >= 0; --ChildIndex)
+			{
+				NodesToVisit.Add(GetChild(Node, ChildIndex));
+			}
+		}
+		return ETreeSearchResult::Completed;
+	}
+}
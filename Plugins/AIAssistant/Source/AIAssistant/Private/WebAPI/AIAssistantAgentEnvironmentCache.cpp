@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantAgentEnvironmentCache.h"
+
+#include "Async/UniqueLock.h"
+#include "Containers/StringConv.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	// Whether FAgentEnvironmentCache::IsEnabled().
+	bool AgentEnvironmentCacheConsoleVariableValue = true;
+
+	FAutoConsoleVariableRef AgentEnvironmentCacheConsoleVariableRef(
+		TEXT("ai.assistant.webapi.agentenvironmentcache"), AgentEnvironmentCacheConsoleVariableValue,
+		TEXT("Whether the AI assistant sets the agent environment from the handle cached by a ")
+		TEXT("previous session while the environment is added in the background."));
+
+	FAgentEnvironmentCache::FAgentEnvironmentCache(const FString& InFilename) :
+		Filename(InFilename)
+	{
+		FString Json;
+		if (Filename.IsEmpty() || !FFileHelper::LoadFileToString(Json, *Filename))
+		{
+			return;
+		}
+		if (!CacheFile.FromJson(Json))
+		{
+			UE_LOG(
+				LogAIAssistant, Warning,
+				TEXT("Ignoring invalid agent environment cache \"%s\"."), *Filename);
+			CacheFile.Entries.Reset();
+		}
+	}
+
+	TOptional<FAgentEnvironmentHandle> FAgentEnvironmentCache::Find(
+		const FString& EnvironmentHash, const FString& User) const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		const int32 Index = FindIndex(EnvironmentHash, User);
+		return Index == INDEX_NONE
+			? TOptional<FAgentEnvironmentHandle>()
+			: TOptional<FAgentEnvironmentHandle>(CacheFile.Entries[Index].Handle);
+	}
+
+	void FAgentEnvironmentCache::Add(
+		const FString& EnvironmentHash, const FString& User, const FAgentEnvironmentHandle& Handle)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		const int32 Index = FindIndex(EnvironmentHash, User);
+		if (Index != INDEX_NONE)
+		{
+			CacheFile.Entries.RemoveAt(Index);
+		}
+		else if (CacheFile.Entries.Num() >= MaxEntries)
+		{
+			CacheFile.Entries.RemoveAt(0);
+		}
+		FAgentEnvironmentCacheEntry& Entry = CacheFile.Entries.AddDefaulted_GetRef();
+		Entry.EnvironmentHash = EnvironmentHash;
+		Entry.User = User;
+		Entry.Handle = Handle;
+		Save();
+	}
+
+	bool FAgentEnvironmentCache::Remove(const FString& EnvironmentHash, const FString& User)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		const int32 Index = FindIndex(EnvironmentHash, User);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		CacheFile.Entries.RemoveAt(Index);
+		Save();
+		return true;
+	}
+
+	int32 FAgentEnvironmentCache::Num() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return CacheFile.Entries.Num();
+	}
+
+	FString FAgentEnvironmentCache::HashAgentEnvironment(const FAgentEnvironment& AgentEnvironment)
+	{
+		const FTCHARToUTF8 Json(*AgentEnvironment.ToJson(false));
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Json.Get(), Json.Length(), Hash.Hash);
+		return Hash.ToString();
+	}
+
+	FString FAgentEnvironmentCache::GetCacheUser(
+		const FString& AssistantUserId, const FString& BackendUrl)
+	{
+		return FString::Printf(TEXT("%s@%s"), *AssistantUserId, *BackendUrl);
+	}
+
+	FString FAgentEnvironmentCache::GetDefaultFilename()
+	{
+		return FPaths::Combine(
+			FPaths::ProjectSavedDir(), TEXT("AIAssistant"), TEXT("AgentEnvironmentCache.json"));
+	}
+
+	bool FAgentEnvironmentCache::IsEnabled()
+	{
+		return AgentEnvironmentCacheConsoleVariableValue;
+	}
+
+	int32 FAgentEnvironmentCache::FindIndex(const FString& EnvironmentHash, const FString& User) const
+	{
+		return CacheFile.Entries.IndexOfByPredicate(
+			[&EnvironmentHash, &User](const FAgentEnvironmentCacheEntry& Entry) -> bool
+			{
+				return Entry.EnvironmentHash == EnvironmentHash && Entry.User == User;
+			});
+	}
+
+	void FAgentEnvironmentCache::Save() const
+	{
+		if (Filename.IsEmpty())
+		{
+			return;
+		}
+		if (!FFileHelper::SaveStringToFile(CacheFile.ToJson(false), *Filename))
+		{
+			UE_LOG(
+				LogAIAssistant, Warning, TEXT("Failed to write agent environment cache \"%s\"."),
+				*Filename);
+		}
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/Optional.h"
+#include "Serialization/JsonSerializable.h"
+#include "Serialization/JsonSerializerMacros.h"
+
+#include "AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	// Cached agent environment handle.
+	struct FAgentEnvironmentCacheEntry : public FJsonSerializable
+	{
+		// Hash of the agent environment, see FAgentEnvironmentCache::HashAgentEnvironment().
+		FString EnvironmentHash;
+		// User the environment was registered by, see FAgentEnvironmentCache::GetCacheUser().
+		FString User;
+		// Handle returned by the assistant backend when the environment was added.
+		FAgentEnvironmentHandle Handle;
+
+		BEGIN_JSON_SERIALIZER
+			JSON_SERIALIZE("environmentHash", EnvironmentHash);
+			JSON_SERIALIZE("user", User);
+			JSON_SERIALIZE_OBJECT_SERIALIZABLE("handle", Handle);
+		END_JSON_SERIALIZER
+	};
+
+	// Contents of the agent environment cache file.
+	struct FAgentEnvironmentCacheFile : public FJsonSerializable
+	{
+		// Entries with the most recently added last.
+		TArray<FAgentEnvironmentCacheEntry> Entries;
+
+		BEGIN_JSON_SERIALIZER
+			JSON_SERIALIZE_ARRAY_SERIALIZABLE("entries", Entries, FAgentEnvironmentCacheEntry);
+		END_JSON_SERIALIZER
+	};
+
+	// On-disk cache of the handles returned by FWebApi::AddAgentEnvironment().
+	//
+	// Adding an environment is an upsert that returns the same handle for the same environment
+	// and user so the handle from a previous session can be used to set the environment as soon
+	// as the assistant page loads, while the upsert is verified in the background.
+	//
+	// All methods are thread safe, the file is loaded on construction and written on each change.
+	class FAgentEnvironmentCache
+	{
+	public:
+		// Maximum number of entries, the least recently added entries are evicted.
+		static constexpr int32 MaxEntries = 16;
+
+	public:
+		// Load the cache from Filename, if the file is missing or invalid the cache is empty.
+		// If Filename is empty the cache is only held in memory.
+		explicit FAgentEnvironmentCache(const FString& InFilename = GetDefaultFilename());
+
+		// Prevent copy.
+		FAgentEnvironmentCache(const FAgentEnvironmentCache&) = delete;
+		FAgentEnvironmentCache& operator=(const FAgentEnvironmentCache&) = delete;
+
+		// Find the handle for an environment hash and user.
+		TOptional<FAgentEnvironmentHandle> Find(
+			const FString& EnvironmentHash, const FString& User) const;
+
+		// Add or replace the handle for an environment hash and user and save the cache.
+		void Add(
+			const FString& EnvironmentHash, const FString& User,
+			const FAgentEnvironmentHandle& Handle);
+
+		// Remove the handle for an environment hash and user and save the cache if it was present.
+		bool Remove(const FString& EnvironmentHash, const FString& User);
+
+		// Get the number of cached handles.
+		int32 Num() const;
+
+		// Get the file the cache is stored in.
+		const FString& GetFilename() const { return Filename; }
+
+		// Get the hash of an environment used to key the cache. This is computed locally from
+		// the environment's JSON representation so it's available before the backend responds.
+		static FString HashAgentEnvironment(const FAgentEnvironment& AgentEnvironment);
+
+		// Get a string that identifies the assistant user AssistantUserId, as reported by
+		// FWebApi::GetCurrentUser(), of the assistant backend at BackendUrl. Handles are only
+		// cached per assistant user as different users sharing a local account have different
+		// environments.
+		static FString GetCacheUser(const FString& AssistantUserId, const FString& BackendUrl);
+
+		// Get the default location of the cache file.
+		static FString GetDefaultFilename();
+
+		// Whether cached handles should be used, controlled by the
+		// ai.assistant.webapi.agentenvironmentcache console variable.
+		static bool IsEnabled();
+
+	private:
+		// Find the index of an entry. Lock must be held.
+		int32 FindIndex(const FString& EnvironmentHash, const FString& User) const;
+
+		// Write the cache to Filename. Lock must be held.
+		void Save() const;
+
+	private:
+		const FString Filename;
+		mutable UE::FMutex Lock;  // Guards CacheFile
+		FAgentEnvironmentCacheFile CacheFile;
+	};
+}
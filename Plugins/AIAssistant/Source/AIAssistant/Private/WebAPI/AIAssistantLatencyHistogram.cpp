@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantLatencyHistogram.h"
+
+#include "Math/UnrealMathUtility.h"
+#include "Misc/AssertionMacros.h"
+
+namespace UE::AIAssistant
+{
+	FLatencyHistogram::FLatencyHistogram()
+	{
+		Reset();
+	}
+
+	void FLatencyHistogram::Record(uint64 Value)
+	{
+		Value = FMath::Min(Value, MaxValue);
+		Buckets[GetBucketIndex(Value)].fetch_add(1, std::memory_order_relaxed);
+		Sum.fetch_add(Value, std::memory_order_relaxed);
+		uint64 CurrentMax = Max.load(std::memory_order_relaxed);
+		while (Value > CurrentMax &&
+			!Max.compare_exchange_weak(CurrentMax, Value, std::memory_order_relaxed))
+		{
+		}
+		// Count is incremented last so that readers that use it see the rest of the sample.
+		Count.fetch_add(1, std::memory_order_release);
+	}
+
+	void FLatencyHistogram::Reset()
+	{
+		for (std::atomic<uint64>& Bucket : Buckets)
+		{
+			Bucket.store(0, std::memory_order_relaxed);
+		}
+		Sum.store(0, std::memory_order_relaxed);
+		Max.store(0, std::memory_order_relaxed);
+		Count.store(0, std::memory_order_release);
+	}
+
+	uint64 FLatencyHistogram::GetCount() const
+	{
+		return Count.load(std::memory_order_acquire);
+	}
+
+	uint64 FLatencyHistogram::GetMax() const
+	{
+		return Max.load(std::memory_order_relaxed);
+	}
+
+	double FLatencyHistogram::GetMean() const
+	{
+		const uint64 NumSamples = GetCount();
+		return NumSamples ? double(Sum.load(std::memory_order_relaxed)) / double(NumSamples) : 0.0;
+	}
+
+	uint64 FLatencyHistogram::GetValueAtPercentile(double Percentile) const
+	{
+		// Take a copy of the buckets so the total is consistent with the counts that are searched.
+		uint64 BucketCounts[NumBuckets];
+		uint64 Total = 0;
+		for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+		{
+			BucketCounts[BucketIndex] = Buckets[BucketIndex].load(std::memory_order_relaxed);
+			Total += BucketCounts[BucketIndex];
+		}
+		if (Total == 0)
+		{
+			return 0;
+		}
+
+		const uint64 Rank = FMath::Clamp<uint64>(
+			uint64(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * double(Total))),
+			1, Total);
+		uint64 CumulativeCount = 0;
+		for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+		{
+			CumulativeCount += BucketCounts[BucketIndex];
+			if (CumulativeCount >= Rank)
+			{
+				return FMath::Min(GetBucketUpperBound(BucketIndex), GetMax());
+			}
+		}
+		return GetMax();
+	}
+
+	int32 FLatencyHistogram::GetBucketIndex(uint64 Value)
+	{
+		Value = FMath::Min(Value, MaxValue);
+		// Values in the first two power of two ranges map directly to a bucket.
+		if (Value < uint64(SubBucketHalfCount * 2))
+		{
+			return int32(Value);
+		}
+		// Otherwise the bucket is selected by the most significant bits of the value.
+		const int32 Shift = int32(FMath::FloorLog2_64(Value)) - SubBucketHalfCountLog2;
+		return Shift * SubBucketHalfCount + int32(Value >> Shift);
+	}
+
+	uint64 FLatencyHistogram::GetBucketLowerBound(int32 BucketIndex)
+	{
+		check(BucketIndex >= 0 && BucketIndex < NumBuckets);
+		if (BucketIndex < SubBucketHalfCount * 2)
+		{
+			return uint64(BucketIndex);
+		}
+		const int32 Shift = BucketIndex / SubBucketHalfCount - 1;
+		const uint64 SubBucket = uint64(BucketIndex % SubBucketHalfCount + SubBucketHalfCount);
+		return SubBucket << Shift;
+	}
+
+	uint64 FLatencyHistogram::GetBucketUpperBound(int32 BucketIndex)
+	{
+		return BucketIndex + 1 < NumBuckets
+			? GetBucketLowerBound(BucketIndex + 1) - 1
+			: MaxValue;
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Templates/UnrealTemplate.h"
+
+#include <atomic>
+
+namespace UE::AIAssistant
+{
+	// Histogram of latency samples with a bounded relative error, in the style of an HDR
+	// histogram.
+	//
+	// Values are stored in log-linear buckets: each power of two range is split into
+	// SubBucketHalfCount linear sub-buckets so the width of a bucket is at most 1 /
+	// SubBucketHalfCount of the values it holds. Values larger than MaxValue are clamped.
+	//
+	// Recording is lock-free and can be performed from any thread, reads are not synchronized
+	// with concurrent writes so they may observe a partially recorded sample.
+	class FLatencyHistogram : public FNoncopyable
+	{
+	public:
+		// Number of linear sub-buckets in each power of two range.
+		static constexpr int32 SubBucketHalfCountLog2 = 4;
+		static constexpr int32 SubBucketHalfCount = 1 << SubBucketHalfCountLog2;
+		// Largest value that can be recorded.
+		static constexpr int32 MaxValueLog2 = 32;
+		static constexpr uint64 MaxValue = (uint64(1) << MaxValueLog2) - 1;
+		// Total number of buckets.
+		static constexpr int32 NumBuckets =
+			(MaxValueLog2 - SubBucketHalfCountLog2 + 1) * SubBucketHalfCount;
+
+	public:
+		FLatencyHistogram();
+
+		// Record a sample.
+		void Record(uint64 Value);
+
+		// Remove all samples.
+		void Reset();
+
+		// Get the number of recorded samples.
+		uint64 GetCount() const;
+
+		// Get the largest recorded sample.
+		uint64 GetMax() const;
+
+		// Get the average of all recorded samples.
+		double GetMean() const;
+
+		// Get the value that Percentile (0 - 100) of recorded samples are less than or equal to,
+		// rounded up to the end of the bucket that holds the value. Returns 0 if the histogram
+		// is empty.
+		uint64 GetValueAtPercentile(double Percentile) const;
+
+		// Get the index of the bucket that holds Value.
+		static int32 GetBucketIndex(uint64 Value);
+
+		// Get the smallest value held by a bucket.
+		static uint64 GetBucketLowerBound(int32 BucketIndex);
+
+		// Get the largest value held by a bucket.
+		static uint64 GetBucketUpperBound(int32 BucketIndex);
+
+	private:
+		std::atomic<uint64> Buckets[NumBuckets];
+		std::atomic<uint64> Count;
+		std::atomic<uint64> Sum;
+		std::atomic<uint64> Max;
+	};
+}
@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantMessageOutbox.h"
+
+#include "Async/UniqueLock.h"
+#include "Misc/Guid.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	FMessageOutbox& FMessageOutbox::Get()
+	{
+		static FMessageOutbox Outbox;
+		return Outbox;
+	}
+
+	FString FMessageOutbox::Add(const FAddMessageToConversationOptions& Options)
+	{
+		const FString MessageId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+		verify(Add(MessageId, Options));
+		return MessageId;
+	}
+
+	bool FMessageOutbox::Add(
+		const FString& MessageId, const FAddMessageToConversationOptions& Options)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		if (FindIndex(MessageId) != INDEX_NONE || AcknowledgedMessageIds.Contains(MessageId))
+		{
+			return false;
+		}
+		if (Entries.Num() >= MaxEntries)
+		{
+			UE_LOG(
+				LogAIAssistant, Warning,
+				TEXT("Discarding message %s as %d messages are waiting to be sent."),
+				*Entries[0].MessageId, MaxEntries);
+			(void)ClaimedMessageIds.Remove(Entries[0].MessageId);
+			Entries.RemoveAt(0);
+		}
+		FMessageOutboxEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.MessageId = MessageId;
+		Entry.Options = Options;
+		Entry.Options.MessageId = MessageId;
+		return true;
+	}
+
+	TArray<FMessageOutboxEntry> FMessageOutbox::Claim()
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		TArray<FMessageOutboxEntry> Claimed;
+		for (FMessageOutboxEntry& Entry : Entries)
+		{
+			bool bIsAlreadyClaimed = false;
+			ClaimedMessageIds.Add(Entry.MessageId, &bIsAlreadyClaimed);
+			if (!bIsAlreadyClaimed)
+			{
+				++Entry.NumSendAttempts;
+				Claimed.Add(Entry);
+			}
+		}
+		return Claimed;
+	}
+
+	void FMessageOutbox::Acknowledge(const FString& MessageId)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		(void)ClaimedMessageIds.Remove(MessageId);
+		const int32 Index = FindIndex(MessageId);
+		if (Index != INDEX_NONE)
+		{
+			Entries.RemoveAt(Index);
+		}
+		// The message may have been released, e.g. when the page that sent it closed, remember
+		// it was sent so it isn't added again.
+		if (!AcknowledgedMessageIds.Contains(MessageId))
+		{
+			if (AcknowledgedMessageIds.Num() >= MaxAcknowledgedMessageIds)
+			{
+				AcknowledgedMessageIds.RemoveAt(0);
+			}
+			AcknowledgedMessageIds.Add(MessageId);
+		}
+	}
+
+	bool FMessageOutbox::Release(const FString& MessageId)
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		(void)ClaimedMessageIds.Remove(MessageId);
+		const int32 Index = FindIndex(MessageId);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		if (Entries[Index].NumSendAttempts >= MaxSendAttempts)
+		{
+			UE_LOG(
+				LogAIAssistant, Warning, TEXT("Discarding message %s after %d attempts to send it."),
+				*MessageId, MaxSendAttempts);
+			Entries.RemoveAt(Index);
+			return false;
+		}
+		return true;
+	}
+
+	void FMessageOutbox::ReleaseAll()
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		ClaimedMessageIds.Reset();
+	}
+
+	int32 FMessageOutbox::DiscardUnclaimed()
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return Entries.RemoveAll(
+			[this](const FMessageOutboxEntry& Entry) -> bool
+			{
+				return !ClaimedMessageIds.Contains(Entry.MessageId);
+			});
+	}
+
+	int32 FMessageOutbox::Num() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return Entries.Num();
+	}
+
+	int32 FMessageOutbox::NumUnclaimed() const
+	{
+		UE::TUniqueLock ScopeLock(Lock);
+		return Entries.Num() - ClaimedMessageIds.Num();
+	}
+
+	int32 FMessageOutbox::FindIndex(const FString& MessageId) const
+	{
+		return Entries.IndexOfByPredicate(
+			[&MessageId](const FMessageOutboxEntry& Entry) -> bool
+			{
+				return Entry.MessageId == MessageId;
+			});
+	}
+}
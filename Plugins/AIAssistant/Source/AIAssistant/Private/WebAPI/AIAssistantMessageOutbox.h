@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+
+#include "AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	// Message waiting to be added to a conversation.
+	struct FMessageOutboxEntry
+	{
+		// Unique ID of the message, also sent as Options.MessageId so the web app only adds the
+		// message once if it's sent again.
+		FString MessageId;
+		// Message to add.
+		FAddMessageToConversationOptions Options;
+		// Number of times the message has been claimed for sending.
+		int32 NumSendAttempts = 0;
+	};
+
+	// Queue of messages to add to a conversation.
+	//
+	// Messages stay in the outbox until the web API acknowledges them so they survive the
+	// assistant page reloading or failing to load and the assistant tab being closed, they're
+	// sent again when the page is ready. Messages claimed for sending aren't claimed again until
+	// they're released. A released message may have been received by the page, so each message is
+	// sent with its ID for the web app to discard duplicates.
+	//
+	// NOTE: Only sending a message once relies on window.eda.addMessageToConversation() ignoring
+	// a messageId it already added. The outbox remembers the IDs of recently acknowledged
+	// messages so an acknowledgement that arrives after the message was released, for example
+	// from a page that closed, stops it being added or sent again, but a message claimed again
+	// before that acknowledgement is still sent twice.
+	//
+	// The outbox is only held in memory, so messages are never written to disk or replayed into
+	// the conversation of a later editor session.
+	//
+	// All methods are thread safe.
+	class FMessageOutbox
+	{
+	public:
+		// Maximum number of messages, the oldest messages are discarded.
+		static constexpr int32 MaxEntries = 32;
+		// Number of times a message is claimed before it's discarded when it fails to send.
+		static constexpr int32 MaxSendAttempts = 5;
+		// Seconds to wait before sending messages that failed to send again.
+		static constexpr float RetryDelaySeconds = 1.0f;
+		// Number of acknowledged message IDs remembered.
+		static constexpr int32 MaxAcknowledgedMessageIds = 128;
+
+	public:
+		FMessageOutbox() = default;
+
+		// Prevent copy.
+		FMessageOutbox(const FMessageOutbox&) = delete;
+		FMessageOutbox& operator=(const FMessageOutbox&) = delete;
+
+		// Get the outbox shared by all assistant pages.
+		static FMessageOutbox& Get();
+
+		// Add a message with a new ID returning the ID.
+		FString Add(const FAddMessageToConversationOptions& Options);
+
+		// Add a message with an ID, returns false if the message is already in the outbox or was
+		// recently acknowledged.
+		bool Add(const FString& MessageId, const FAddMessageToConversationOptions& Options);
+
+		// Claim all messages that aren't being sent, oldest first.
+		TArray<FMessageOutboxEntry> Claim();
+
+		// Remove a message that was sent, whether or not it's still claimed.
+		void Acknowledge(const FString& MessageId);
+
+		// Release a claimed message that failed to send so it's claimed again. Returns false if
+		// the message was discarded as it reached MaxSendAttempts.
+		bool Release(const FString& MessageId);
+
+		// Release all claimed messages, for example when the page that was sending them closed.
+		void ReleaseAll();
+
+		// Discard messages that aren't being sent returning the number of messages discarded.
+		int32 DiscardUnclaimed();
+
+		// Get the number of messages in the outbox.
+		int32 Num() const;
+
+		// Get the number of messages that can be claimed.
+		int32 NumUnclaimed() const;
+
+	private:
+		// Find the index of an entry. Lock must be held.
+		int32 FindIndex(const FString& MessageId) const;
+
+	private:
+		mutable UE::FMutex Lock;  // Guards all members
+		// Messages that haven't been acknowledged, oldest first.
+		TArray<FMessageOutboxEntry> Entries;
+		// IDs of messages being sent.
+		TSet<FString> ClaimedMessageIds;
+		// IDs of the last MaxAcknowledgedMessageIds messages that were acknowledged, oldest first.
+		TArray<FString> AcknowledgedMessageIds;
+	};
+}
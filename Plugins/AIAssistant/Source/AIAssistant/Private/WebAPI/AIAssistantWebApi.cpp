@@ -3,20 +3,43 @@
 #include "AIAssistantWebApi.h"
 
 #include "Async/Future.h"
+#include "Async/UniqueLock.h"
+#include "Containers/Ticker.h"
 #include "Containers/UnrealString.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/UnrealMathUtility.h"
 #include "Misc/AssertionMacros.h"
 #include "Templates/SharedPointer.h"
 #include "Templates/UnrealTemplate.h"
 #include "UObject/Object.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 namespace UE::AIAssistant
 {
 	UE_ENUM_METADATA_DEFINE(EMessageRole, UE_AI_ASSISTANT_MESSAGE_ROLE_ENUM);
 	UE_ENUM_METADATA_DEFINE(EMessageContentType, UE_AI_ASSISTANT_MESSAGE_CONTENT_TYPE_ENUM);
 
+	// Default FWebApi::EFlushPolicy for all FWebApi instances.
+	int32 WebApiFlushPolicyConsoleVariableValue =
+		static_cast<int32>(FWebApi::EFlushPolicy::Immediate);
+
+	FAutoConsoleVariableRef WebApiFlushPolicyConsoleVariableRef(
+		TEXT("ai.assistant.webapi.flushpolicy"), WebApiFlushPolicyConsoleVariableValue,
+		TEXT("Controls when AI assistant web API calls are sent to the browser. ")
+		TEXT("0: Execute each call immediately. ")
+		TEXT("1: Batch calls made during a frame into a single script."));
+
+	// Default FWebApiCallOptions::TimeoutSeconds for all FWebApi instances.
+	float WebApiTimeoutConsoleVariableValue = 120.0f;
+
+	FAutoConsoleVariableRef WebApiTimeoutConsoleVariableRef(
+		TEXT("ai.assistant.webapi.timeout"), WebApiTimeoutConsoleVariableValue,
+		TEXT("Time in seconds after which AI assistant web API calls fail if the browser has not ")
+		TEXT("responded. Values <= 0 disable the timeout."));
+
 	const FString FWebApi::WebApiObjectName = TEXT("window.eda");
 
-	const FString FWebApi::FunctionCallFormatTemplate = TEXT(R"js(
+	const TCHAR* const FWebApi::FunctionCallTemplateText = TEXT(R"js(
 try {
   Promise.resolve({WebApiObjectName}.{FunctionName}({Arguments})).then(
     (result) => {
@@ -30,16 +53,123 @@ try {
 }
 )js");
 
+	// Names of FWebApi::EFunctionCallSlot values.
+	static const TCHAR* const WebApiFunctionCallSlotNames[] =
+	{
+		TEXT("WebApiObjectName"),
+		TEXT("FunctionName"),
+		TEXT("Arguments"),
+		TEXT("NotifyHandlerOfResult"),
+		TEXT("NotifyHandlerOfError"),
+		TEXT("StreamKey"),
+		TEXT("NotifyHandlerOfChunk"),
+	};
+
+	const FWebApiCallTemplate FWebApi::FunctionCallTemplate(
+		FunctionCallTemplateText, WebApiFunctionCallSlotNames);
+
+	const TCHAR* const FWebApi::StreamingFunctionCallTemplateText = TEXT(R"js(
+(() => {
+  const streams = window.aiassistantstreams = window.aiassistantstreams || {};
+  const stream = {
+    paused: false,
+    cancelled: false,
+    resumeWaiters: [],
+    write(chunk) {
+      if (stream.cancelled) return false;
+      {NotifyHandlerOfChunk}
+      return true;
+    },
+    ready() {
+      return stream.paused && !stream.cancelled
+        ? new Promise((resolve) => stream.resumeWaiters.push(resolve))
+        : Promise.resolve();
+    },
+    setPaused(paused) {
+      stream.paused = paused;
+      if (!paused) stream.resumeWaiters.splice(0).forEach((resolve) => resolve());
+    },
+    cancel() {
+      stream.cancelled = true;
+      stream.setPaused(false);
+    },
+  };
+  streams["{StreamKey}"] = stream;
+  try {
+    Promise.resolve({WebApiObjectName}.{FunctionName}({Arguments})).then(
+      (result) => {
+        delete streams["{StreamKey}"];
+        {NotifyHandlerOfResult}
+      },
+      (error) => {
+        delete streams["{StreamKey}"];
+        {NotifyHandlerOfError}
+      });
+  } catch (error) {
+    delete streams["{StreamKey}"];
+    {NotifyHandlerOfError}
+  }
+})();
+)js");
+
+	const FWebApiCallTemplate FWebApi::StreamingFunctionCallTemplate(
+		StreamingFunctionCallTemplateText, WebApiFunctionCallSlotNames);
+
 	FWebApi::FWebApi(ICodeExecutor& InCodeExecutor, IWebJavaScriptDelegateBinder& JavaScriptDelegateBinder) :
 		CodeExecutor(InCodeExecutor),
 		WebJavaScriptDelegateBinder(JavaScriptDelegateBinder),
-		WebJavaScriptResultDelegate(NewObject<UAIAssistantWebJavaScriptResultDelegate>())
+		WebJavaScriptResultDelegate(NewObject<UAIAssistantWebJavaScriptResultDelegate>()),
+		TimerWheel(MakeShared<FTimerWheel>())
 	{
 		WebJavaScriptResultDelegate->Bind(*this);
+		TimerWheelTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateLambda(
+				[WeakTimerWheel = TWeakPtr<FTimerWheel>(TimerWheel)](float DeltaTime) -> bool
+				{
+					if (TSharedPtr<FTimerWheel> PinnedTimerWheel = WeakTimerWheel.Pin())
+					{
+						(void)PinnedTimerWheel->Advance(DeltaTime);
+						return true;
+					}
+					return false;
+				}));
 	}
 
 	FWebApi::~FWebApi()
 	{
+		FTSTicker::RemoveTicker(TimerWheelTickerHandle);
+
+		// Complete all streams as they can no longer be controlled.
+		TArray<TWeakPtr<FWebApiStream>> StreamsToDetach;
+		{
+			UE::TUniqueLock Lock(StreamsLock);
+			StreamsToDetach = MoveTemp(Streams);
+		}
+		for (const TWeakPtr<FWebApiStream>& Stream : StreamsToDetach)
+		{
+			if (TSharedPtr<FWebApiStream> PinnedStream = Stream.Pin())
+			{
+				PinnedStream->Detach();
+			}
+		}
+
+		FTSTicker::FDelegateHandle FlushTickerHandleToRemove;
+		{
+			UE::TUniqueLock Lock(BatchLock);
+			FlushTickerHandleToRemove = FlushTickerHandle;
+			FlushTickerHandle.Reset();
+			// Any batched calls are dropped as the result delegate is about to be unbound.
+			PendingBatch.Empty();
+			NumPendingBatchCalls = 0;
+		}
+		// NOTE: The ticker is removed without holding BatchLock as RemoveTicker() waits for the
+		// flush delegate if it's running on another thread, and the delegate takes the lock. Once
+		// removed the delegate can't run again so it's safe for it to capture this.
+		if (FlushTickerHandleToRemove.IsValid())
+		{
+			FTSTicker::RemoveTicker(FlushTickerHandleToRemove);
+		}
+
 		// Unfortunately on shutdown the delegate can be garbage collected even though a strong
 		// reference to it is held.
 		if (WebJavaScriptResultDelegate.IsValid())
@@ -48,21 +178,32 @@ try {
 		}
 	}
 
-	void FWebApi::AddMessageToConversation(const FAddMessageToConversationOptions& Options)
+	TFuture<TValueOrError<void, FString>> FWebApi::AddMessageToConversation(
+		const FAddMessageToConversationOptions& Options, const FWebApiCallOptions& CallOptions)
+	{
+		return ExecutionFunctionParseJson<void>(
+			TEXT("addMessageToConversation"), Options, CallOptions);
+	}
+
+	TSharedRef<FWebApiStream> FWebApi::AddMessageToConversationWithStream(
+		const FAddMessageToConversationOptions& Options,
+		const FWebApiStreamOptions& StreamOptions)
 	{
-		(void)ExecuteFunctionWithJsonArgument(TEXT("addMessageToConversation"), Options);
+		return ExecuteStreamingFunction(
+			TEXT("addMessageToConversation"), FWebApiArguments(Options), StreamOptions);
 	}
 
-	TFuture<TValueOrError<void, FString>> FWebApi::CreateConversation()
+	TFuture<TValueOrError<void, FString>> FWebApi::CreateConversation(
+		const FWebApiCallOptions& CallOptions)
 	{
-		return ExecutionFunctionParseJson<void>(TEXT("createConversation"));
+		return ExecutionFunctionParseJson<void>(TEXT("createConversation"), CallOptions);
 	}
 
 	TFuture<TValueOrError<FAgentEnvironmentHandle, FString>> FWebApi::AddAgentEnvironment(
-		const FAgentEnvironment& AgentEnvironment)
+		const FAgentEnvironment& AgentEnvironment, const FWebApiCallOptions& CallOptions)
 	{
 		return ExecutionFunctionParseJson<FAgentEnvironmentHandle>(
-			TEXT("addAgentEnvironment"), AgentEnvironment);
+			TEXT("addAgentEnvironment"), AgentEnvironment, CallOptions);
 	}
 
 	void FWebApi::SetAgentEnvironment(const FAgentEnvironmentId& AgentEnvironmentId)
@@ -70,53 +211,401 @@ try {
 		(void)ExecuteFunctionWithJsonArgument(TEXT("setAgentEnvironment"), AgentEnvironmentId);
 	}
 
+	TFuture<TValueOrError<FAssistantUser, FString>> FWebApi::GetCurrentUser(
+		const FWebApiCallOptions& CallOptions)
+	{
+		return ExecutionFunctionParseJson<FAssistantUser>(TEXT("getCurrentUser"), CallOptions);
+	}
+
 	void FWebApi::UpdateGlobalLocale(const FString& LocaleString)
 	{
 		(void)ExecuteFunction(TEXT("updateGlobalLocale"), *FString::Printf(TEXT("\"%s\""), *LocaleString));
 	}
 
 	FString FWebApi::FormatFunctionCall(
-		const TCHAR* FunctionName, const TCHAR* Arguments, const FString& HandlerId)
+		const TCHAR* FunctionName, const TCHAR* Arguments, const FHandlerId& HandlerId)
+	{
+		FString Script;
+		AppendFunctionCall(Script, FunctionName, Arguments, HandlerId);
+		return Script;
+	}
+
+	void FWebApi::AppendFunctionCall(
+		FString& Script, const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+		const FHandlerId& HandlerId) const
+	{
+		AppendCall(Script, FunctionCallTemplate, FunctionName, Arguments, HandlerId, nullptr);
+	}
+
+	void FWebApi::AppendStreamingFunctionCall(
+		FString& Script, const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+		const FWebApiStream& Stream) const
+	{
+		AppendCall(
+			Script, StreamingFunctionCallTemplate, FunctionName, Arguments,
+			Stream.GetCompletionHandlerId(), &Stream);
+	}
+
+	void FWebApi::AppendCall(
+		FString& Script, const FWebApiCallTemplate& CallTemplate, const TCHAR* FunctionName,
+		const FWebApiArguments& Arguments, const FHandlerId& HandlerId,
+		const FWebApiStream* Stream) const
 	{
 		check(FunctionName);
-		check(Arguments);
-		auto Handlers = FormatResultAndErrorHandlers(HandlerId);
-		return FString::Format(
-			*FunctionCallFormatTemplate,
+		static const TCHAR* const ResultValue = TEXT("result");
+		static const TCHAR* const ErrorValue = TEXT("error");
+		static const TCHAR* const ChunkValue = TEXT("chunk");
+		// Stream argument appended to the arguments of a streamed call.
+		static const TCHAR* const StreamArgument = TEXT("stream");
+		static const TCHAR* const StreamArgumentSeparator = TEXT(", ");
+
+		const int32 FunctionNameLength = FCString::Strlen(FunctionName);
+		const int32 ArgumentsLength = Arguments.Len();
+		const bool bHasHandler = HandlerId.IsValid();
+		auto GetSlotLength = [&CallTemplate](EFunctionCallSlot Slot, int32 Length) -> int32
+			{
+				return CallTemplate.GetSlotCount(static_cast<int32>(Slot)) * Length;
+			};
+		auto GetHandlerLength = [](const TCHAR* Value) -> int32
+			{
+				return UAIAssistantWebJavaScriptResultDelegate::GetJavaScriptHandlerLength(
+					FCString::Strlen(Value));
+			};
+		Script.Reserve(
+			Script.Len() +
+			CallTemplate.GetLiteralLength() +
+			GetSlotLength(EFunctionCallSlot::WebApiObjectName, WebApiObjectName.Len()) +
+			GetSlotLength(EFunctionCallSlot::FunctionName, FunctionNameLength) +
+			GetSlotLength(
+				EFunctionCallSlot::Arguments,
+				ArgumentsLength +
+				(Stream
+					? FCString::Strlen(StreamArgumentSeparator) + FCString::Strlen(StreamArgument)
+					: 0)) +
+			(bHasHandler
+				? GetSlotLength(
+					EFunctionCallSlot::NotifyHandlerOfResult, GetHandlerLength(ResultValue)) +
+				GetSlotLength(
+					EFunctionCallSlot::NotifyHandlerOfError, GetHandlerLength(ErrorValue))
+				: 0) +
+			(Stream
+				? GetSlotLength(EFunctionCallSlot::StreamKey, Stream->GetStreamKey().Len()) +
+				GetSlotLength(
+					EFunctionCallSlot::NotifyHandlerOfChunk, GetHandlerLength(ChunkValue))
+				: 0));
+
+		CallTemplate.Render(
+			Script,
+			[&](FString& Output, int32 SlotIndex) -> void
+			{
+				switch (static_cast<EFunctionCallSlot>(SlotIndex))
+				{
+				case EFunctionCallSlot::WebApiObjectName:
+					Output.Append(WebApiObjectName);
+					break;
+				case EFunctionCallSlot::FunctionName:
+					Output.AppendChars(FunctionName, FunctionNameLength);
+					break;
+				case EFunctionCallSlot::Arguments:
+					Arguments.AppendTo(Output);
+					if (Stream)
+					{
+						if (ArgumentsLength > 0)
+						{
+							Output.Append(StreamArgumentSeparator);
+						}
+						Output.Append(StreamArgument);
+					}
+					break;
+				case EFunctionCallSlot::NotifyHandlerOfResult:
+					if (bHasHandler)
+					{
+						UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+							Output, HandlerId, ResultValue, false);
+					}
+					break;
+				case EFunctionCallSlot::NotifyHandlerOfError:
+					if (bHasHandler)
+					{
+						UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+							Output, HandlerId, ErrorValue, true);
+					}
+					break;
+				case EFunctionCallSlot::StreamKey:
+					if (Stream)
+					{
+						Output.Append(Stream->GetStreamKey());
+					}
+					break;
+				case EFunctionCallSlot::NotifyHandlerOfChunk:
+					if (Stream)
+					{
+						UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+							Output, Stream->GetChunkHandlerId(), ChunkValue, false);
+					}
+					break;
+				}
+			});
+	}
+
+	TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult> FWebApi::ExecuteFunction(
+		const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+		const FWebApiCallOptions& CallOptions)
+	{
+		using FResult = UAIAssistantWebJavaScriptResultDelegate::FResult;
+
+		auto HandlerIdAndFuture = WebJavaScriptResultDelegate->RegisterResultHandlerForFuture();
+		const FHandlerId HandlerId = HandlerIdAndFuture.Key;
+		// Removing the handler completes the future with the specified error.
+		auto FailCall =
+			[WeakResultDelegate = TWeakObjectPtr<UAIAssistantWebJavaScriptResultDelegate>(
+				WebJavaScriptResultDelegate.Get()), HandlerId](const FString& ErrorJson) -> void
+			{
+				if (UAIAssistantWebJavaScriptResultDelegate* ResultDelegate =
+					WeakResultDelegate.Get())
+				{
+					(void)ResultDelegate->UnregisterResultHandler(HandlerId, ErrorJson);
+				}
+			};
+
+		FWebApiMetrics::FFunctionMetrics& FunctionMetrics =
+			FWebApiMetrics::Get().FindOrAdd(FunctionName);
+		const TSharedPtr<FCancellationToken>& CancellationToken = CallOptions.CancellationToken;
+		FCancellationToken::FCallbackId CancellationCallbackId = 0;
+		if (CancellationToken)
+		{
+			CancellationCallbackId = CancellationToken->OnCanceled(
+				[FailCall]() -> void
+				{
+					FailCall(UAIAssistantWebJavaScriptResultDelegate::CanceledError);
+				});
+			// Don't send a call that has already been canceled.
+			if (!CancellationCallbackId)
+			{
+				return MoveTemp(HandlerIdAndFuture.Value);
+			}
+		}
+
+		const double TimeoutSeconds =
+			CallOptions.TimeoutSeconds.Get(double(WebApiTimeoutConsoleVariableValue));
+		FTimerWheel::FTimerId TimerId = 0;
+		if (TimeoutSeconds > 0.0)
+		{
+			TimerId = TimerWheel->Schedule(
+				TimeoutSeconds,
+				[FailCall]() -> void
+				{
+					FailCall(UAIAssistantWebJavaScriptResultDelegate::TimedOutError);
+				});
+		}
+
+		const uint64 StartCycles = FunctionMetrics.BeginCall();
+		ExecuteAsyncFunction(FunctionName, Arguments, HandlerId);
+
+		// Record the round trip time and release the timer and cancellation callback when the
+		// call completes.
+		return HandlerIdAndFuture.Value.Then(
+			[FunctionMetrics = &FunctionMetrics, StartCycles,
+				WeakTimerWheel = TWeakPtr<FTimerWheel>(TimerWheel), TimerId, CancellationToken,
+				CancellationCallbackId](TFuture<FResult> ResultFuture) -> FResult
 			{
-				{ TEXT("WebApiObjectName"), WebApiObjectName },
-				{ TEXT("FunctionName"), FunctionName },
-				{ TEXT("Arguments"), Arguments },
-				{ TEXT("NotifyHandlerOfResult"), Handlers.Key },
-				{ TEXT("NotifyHandlerOfError"), Handlers.Value },
+				FResult Result = ResultFuture.Get();
+				FunctionMetrics->EndCall(StartCycles, Result.bJsonIsError);
+				if (TimerId)
+				{
+					if (TSharedPtr<FTimerWheel> PinnedTimerWheel = WeakTimerWheel.Pin())
+					{
+						(void)PinnedTimerWheel->Cancel(TimerId);
+					}
+				}
+				if (CancellationToken)
+				{
+					CancellationToken->RemoveOnCanceled(CancellationCallbackId);
+				}
+				return Result;
 			});
 	}
 
-	TPair<FString, FString> FWebApi::FormatResultAndErrorHandlers(const FString& HandlerId)
+	void FWebApi::ExecuteAsyncFunction(
+		const TCHAR* FunctionName, const FWebApiArguments& Arguments, const FHandlerId& HandlerId)
 	{
-		if (!HandlerId.IsEmpty())
+		ExecuteOrBatchScript(
+			[this, FunctionName, &Arguments, &HandlerId](FString& Script) -> void
+			{
+				AppendFunctionCall(Script, FunctionName, Arguments, HandlerId);
+			});
+	}
+
+	TSharedRef<FWebApiStream> FWebApi::ExecuteStreamingFunction(
+		const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+		const FWebApiStreamOptions& StreamOptions)
+	{
+		TSharedRef<FWebApiStream> Stream = MakeShared<FWebApiStream>(*this, StreamOptions);
+		TWeakPtr<FWebApiStream> WeakStream = Stream;
+		const FHandlerId ChunkHandlerId = WebJavaScriptResultDelegate->RegisterResultHandler(
+			[WeakStream](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&& Context)
+			-> bool
+			{
+				TSharedPtr<FWebApiStream> PinnedStream = WeakStream.Pin();
+				if (!PinnedStream)
+				{
+					return true;
+				}
+				PinnedStream->HandleChunk(MoveTemp(Context.Json));
+				// Keep receiving chunks until the completion handler is called.
+				return false;
+			});
+		const FHandlerId CompletionHandlerId = WebJavaScriptResultDelegate->RegisterResultHandler(
+			[WeakStream](UAIAssistantWebJavaScriptResultDelegate::FResultHandlerContext&& Context)
+			-> bool
+			{
+				if (TSharedPtr<FWebApiStream> PinnedStream = WeakStream.Pin())
+				{
+					PinnedStream->Finish(
+						Context.bJsonIsError
+						? TValueOrError<void, FString>(MakeError(MoveTemp(Context.Json)))
+						: TValueOrError<void, FString>(MakeValue()),
+						false);
+				}
+				return true;
+			});
+		Stream->SetHandlerIds(ChunkHandlerId, CompletionHandlerId);
 		{
-			FString HandlerFormat =
-				WebJavaScriptResultDelegate->FormatJavaScriptHandler(HandlerId);
-			return TPair<FString, FString>(
-				FString::Format(*HandlerFormat, { TEXT("result"), TEXT("false") }),
-				FString::Format(*HandlerFormat, { TEXT("error"), TEXT("true") }));
+			UE::TUniqueLock Lock(StreamsLock);
+			Streams.RemoveAllSwap(
+				[](const TWeakPtr<FWebApiStream>& ExistingStream) -> bool
+				{
+					return !ExistingStream.IsValid();
+				});
+			Streams.Add(Stream);
 		}
-		return TPair<FString, FString>();
+
+		FWebApiMetrics::FFunctionMetrics& FunctionMetrics =
+			FWebApiMetrics::Get().FindOrAdd(FunctionName);
+		Stream->SetCallMetrics(FunctionMetrics, FunctionMetrics.BeginCall());
+		ExecuteOrBatchScript(
+			[this, FunctionName, &Arguments, &Stream](FString& Script) -> void
+			{
+				AppendStreamingFunctionCall(Script, FunctionName, Arguments, *Stream);
+			});
+		return Stream;
 	}
 
-	TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult> FWebApi::ExecuteFunction(
-		const TCHAR* FunctionName, const TCHAR* Arguments)
+	void FWebApi::SendStreamControl(const FString& StreamKey, const TCHAR* Control)
 	{
-		auto HandlerIdAndFuture = WebJavaScriptResultDelegate->RegisterResultHandlerForFuture();
-		ExecuteAsyncFunction(FunctionName, Arguments, *HandlerIdAndFuture.Key);
-		return MoveTemp(HandlerIdAndFuture.Value);
+		ExecuteOrBatchScript(
+			[&StreamKey, Control](FString& Script) -> void
+			{
+				Script.Appendf(
+					TEXT("window.aiassistantstreams?.[\"%s\"]?.%s;\n"), *StreamKey, Control);
+			});
+	}
+
+	void FWebApi::UnregisterStreamHandlers(const FWebApiStream& Stream)
+	{
+		if (WebJavaScriptResultDelegate.IsValid())
+		{
+			WebJavaScriptResultDelegate->UnregisterResultHandler(Stream.GetChunkHandlerId());
+			WebJavaScriptResultDelegate->UnregisterResultHandler(Stream.GetCompletionHandlerId());
+		}
+	}
+
+	void FWebApi::SetFlushPolicyOverride(TOptional<EFlushPolicy> FlushPolicy)
+	{
+		{
+			UE::TUniqueLock Lock(BatchLock);
+			FlushPolicyOverride = FlushPolicy;
+		}
+		// Don't leave calls waiting if batching was disabled.
+		if (GetFlushPolicy() == EFlushPolicy::Immediate)
+		{
+			Flush();
+		}
+	}
+
+	FWebApi::EFlushPolicy FWebApi::GetFlushPolicy() const
+	{
+		{
+			UE::TUniqueLock Lock(BatchLock);
+			if (FlushPolicyOverride.IsSet())
+			{
+				return FlushPolicyOverride.GetValue();
+			}
+		}
+		return WebApiFlushPolicyConsoleVariableValue ==
+			static_cast<int32>(EFlushPolicy::Immediate)
+			? EFlushPolicy::Immediate
+			: EFlushPolicy::EndOfFrame;
+	}
+
+	void FWebApi::ExecuteOrBatchScript(TFunctionRef<void(FString& Script)> AppendScript)
+	{
+		if (GetFlushPolicy() == EFlushPolicy::Immediate)
+		{
+			// Calls batched before the policy changed are executed first to preserve the call
+			// order.
+			FString Script;
+			{
+				UE::TUniqueLock Lock(BatchLock);
+				Script = MoveTemp(PendingBatch);
+				RecordFlush(NumPendingBatchCalls + 1);
+				NumPendingBatchCalls = 0;
+			}
+			AppendScript(Script);
+			CodeExecutor.Execute(Script);
+			return;
+		}
+
+		UE::TUniqueLock Lock(BatchLock);
+		AppendScript(PendingBatch);
+		++NumPendingBatchCalls;
+		if (!FlushTickerHandle.IsValid())
+		{
+			FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateLambda(
+					[this](float UnusedDeltaTime) -> bool
+					{
+						{
+							UE::TUniqueLock Lock(BatchLock);
+							FlushTickerHandle.Reset();
+						}
+						Flush();
+						// Only run once, the ticker is registered again by the next call.
+						return false;
+					}));
+		}
+	}
+
+	void FWebApi::Flush()
+	{
+		FString Script;
+		{
+			UE::TUniqueLock Lock(BatchLock);
+			if (NumPendingBatchCalls == 0)
+			{
+				return;
+			}
+			Script = MoveTemp(PendingBatch);
+			RecordFlush(NumPendingBatchCalls);
+			NumPendingBatchCalls = 0;
+		}
+		// NOTE: The lock is released before executing the script as the executor can synchronously
+		// call back into this object.
+		CodeExecutor.Execute(Script);
+	}
+
+	FWebApi::FBatchStats FWebApi::GetBatchStats() const
+	{
+		UE::TUniqueLock Lock(BatchLock);
+		return BatchStats;
 	}
 
-	void FWebApi::ExecuteAsyncFunction(const TCHAR* FunctionName, const TCHAR* Arguments, const TCHAR* HandlerId)
+	void FWebApi::RecordFlush(int32 NumCalls)
 	{
-		CodeExecutor.Execute(
-			FormatFunctionCall(FunctionName, Arguments, HandlerId));
+		++BatchStats.NumFlushes;
+		BatchStats.NumCallsFlushed += NumCalls;
+		BatchStats.LastCallsPerFlush = NumCalls;
+		BatchStats.MaxCallsPerFlush = FMath::Max(BatchStats.MaxCallsPerFlush, NumCalls);
 	}
 
 	void FWebApi::BindUObject(const FString& Name, UObject* Object, bool bIsPermanent)
@@ -2,7 +2,9 @@
 #pragma once
 
 #include "Async/Future.h"
+#include "Async/Mutex.h"
 #include "Containers/Array.h"
+#include "Containers/Ticker.h"
 #include "Containers/UnrealString.h"
 #include "Misc/DateTime.h"
 #include "Misc/Optional.h"
@@ -16,11 +18,18 @@
 #include "Templates/ValueOrError.h"
 #include "UObject/StrongObjectPtr.h"
 
+#include "Core/AIAssistantCancellationToken.h"
+#include "Core/AIAssistantTimerWheel.h"
 #include "Utils/AIAssistantEnum.h"
+#include "Utils/AIAssistantJsonPullReader.h"
 #include "Utils/AIAssistantJsonVariantSerializer.h"
 #include "AIAssistantWebJavaScriptDelegateBinder.h"
 #include "AIAssistantWebJavaScriptResultDelegate.h"
 #include "Utils/ICodeExecutor.h"
+#include "AIAssistantWebApiArguments.h"
+#include "AIAssistantWebApiCallTemplate.h"
+#include "AIAssistantWebApiMetrics.h"
+#include "AIAssistantWebApiStream.h"
 
 
 namespace UE::AIAssistant
@@ -120,10 +129,16 @@ namespace UE::AIAssistant
 		TOptional<FConversationId> ConversationId;
 		// Message to add to the conversation.
 		FMessage Message;
+		// Unique ID of the message. A message sent again with the same ID, for example after the
+		// page that was sending it reloaded, is only added to the conversation once.
+		// NOTE: This relies on the web application ignoring IDs it already added, older versions
+		// ignore this field and add the message again.
+		TOptional<FString> MessageId;
 
 		BEGIN_JSON_SERIALIZER
 			JSON_SERIALIZE_OPTIONAL_OBJECT_SERIALIZABLE("conversationId", ConversationId);
 			JSON_SERIALIZE_OBJECT_SERIALIZABLE("message", Message);
+			JSON_SERIALIZE_OPTIONAL("messageId", MessageId);
 		END_JSON_SERIALIZER
 	};
 
@@ -199,12 +214,86 @@ namespace UE::AIAssistant
 		END_JSON_SERIALIZER
 	};
 
+	// Assistant user signed in to the web application.
+	struct FAssistantUser : public FJsonSerializable
+	{
+		// ID of the user, empty if no user is signed in.
+		FString Id;
+
+		BEGIN_JSON_SERIALIZER
+			JSON_SERIALIZE("id", Id);
+		END_JSON_SERIALIZER
+	};
+
+	// Read the types above directly from JSON using a pull parser, see FJsonPullReader.
+	// These read the same fields as the JSON serializers and, like FromJson(), ignore unknown
+	// fields and values of the wrong type, including null. Only invalid JSON is an error.
+	// AI.Assistant.WebApi.ParseJson.Parity checks that both read the same values.
+	bool ReadJson(FJsonPullReader& Reader, FTextMessageContent& Value);
+	bool ReadJson(FJsonPullReader& Reader, FMessageContent& Value);
+	bool ReadJson(FJsonPullReader& Reader, FMessage& Value);
+	bool ReadJson(FJsonPullReader& Reader, FConversationId& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAddMessageToConversationOptions& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentDescriptor& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironment& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentId& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentHash& Value);
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentHandle& Value);
+
+	// Options that control how long a call can remain pending.
+	struct FWebApiCallOptions
+	{
+		// Time after which the call fails with
+		// UAIAssistantWebJavaScriptResultDelegate::TimedOutError. If this isn't set the timeout
+		// is read from the ai.assistant.webapi.timeout console variable. Values <= 0 disable the
+		// timeout.
+		TOptional<double> TimeoutSeconds;
+		// Token that fails the call with UAIAssistantWebJavaScriptResultDelegate::CanceledError
+		// when it's canceled.
+		TSharedPtr<FCancellationToken> CancellationToken;
+	};
+
 	class FWebApiAccessor;
 
 	// API to communicate with the web assistant.
 	class FWebApi : private IWebJavaScriptDelegateBinder, public FNoncopyable
 	{
 		friend class FWebApiAccessor;
+		friend class FWebApiStream;
+
+	public:
+		// Controls when formatted calls are sent to the code executor.
+		enum class EFlushPolicy : uint8
+		{
+			// Each call is executed as soon as it's made.
+			Immediate = 0,
+			// Calls made during a frame are concatenated and executed as a single script on the
+			// next core ticker update. Each call keeps its own try / Promise wrapper so a failing
+			// call does not prevent the rest of the batch from running.
+			EndOfFrame = 1,
+		};
+
+		// Counters that describe how calls have been batched.
+		struct FBatchStats
+		{
+			// Number of scripts sent to the code executor.
+			uint64 NumFlushes = 0;
+			// Number of calls sent to the code executor across all flushes.
+			uint64 NumCallsFlushed = 0;
+			// Number of calls sent by the most recent flush.
+			int32 LastCallsPerFlush = 0;
+			// Largest number of calls sent by a single flush.
+			int32 MaxCallsPerFlush = 0;
+
+			// Average number of calls sent per flush.
+			double GetAverageCallsPerFlush() const
+			{
+				return NumFlushes ? double(NumCallsFlushed) / double(NumFlushes) : 0.0;
+			}
+		};
+
+		// ID of a result handler registered with the JavaScript result delegate.
+		using FHandlerId = UAIAssistantWebJavaScriptResultDelegate::FHandlerId;
 
 	public:
 		FWebApi(ICodeExecutor& CodeExecutor, IWebJavaScriptDelegateBinder& JavaScriptDelegateBinder);
@@ -216,48 +305,97 @@ namespace UE::AIAssistant
 
 		virtual ~FWebApi();
 
-		// Add a message to a conversation.
-		void AddMessageToConversation(const FAddMessageToConversationOptions& Options);
+		// Add a message to a conversation returning whether the message was added.
+		TFuture<TValueOrError<void, FString>> AddMessageToConversation(
+			const FAddMessageToConversationOptions& Options,
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions());
+
+		// Add a message to a conversation receiving the agent's response as a stream of chunks.
+		// If the web assistant doesn't stream responses, the stream completes without chunks
+		// when the message has been added.
+		TSharedRef<FWebApiStream> AddMessageToConversationWithStream(
+			const FAddMessageToConversationOptions& Options,
+			const FWebApiStreamOptions& StreamOptions = FWebApiStreamOptions());
 
 		// Create a new conversation.
-		TFuture<TValueOrError<void, FString>> CreateConversation();
+		TFuture<TValueOrError<void, FString>> CreateConversation(
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions());
 
 		// Add an agent environment for the currently logged in user
 		// returning the ID. If a matching environment already exists for the
 		// user, this should return the existing environment (i.e upsert).
 		TFuture<TValueOrError<FAgentEnvironmentHandle, FString>> AddAgentEnvironment(
-			const FAgentEnvironment& AgentEnvironment);
+			const FAgentEnvironment& AgentEnvironment,
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions());
 
 		// Set agent environment for the conversational UI.
 		void SetAgentEnvironment(const FAgentEnvironmentId& AgentEnvironmentId);
 
+		// Get the user signed in to the web application.
+		TFuture<TValueOrError<FAssistantUser, FString>> GetCurrentUser(
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions());
+
 		void UpdateGlobalLocale(const FString& LocaleString);
 
+		// Override the flush policy selected by the ai.assistant.webapi.flushpolicy console
+		// variable. Resetting the override reverts to the console variable.
+		void SetFlushPolicyOverride(TOptional<EFlushPolicy> FlushPolicy);
+
+		// Get the flush policy applied to new calls.
+		EFlushPolicy GetFlushPolicy() const;
+
+		// Execute all batched calls now as a single script.
+		void Flush();
+
+		// Get batching counters.
+		FBatchStats GetBatchStats() const;
+
 	protected:
 		// Format a function call of a member with result handling.
 		FString FormatFunctionCall(
 			const TCHAR* FunctionName, const TCHAR* Arguments = TEXT(""),
-			const FString& HandlerId = FString());
+			const FHandlerId& HandlerId = FHandlerId());
 
-		// Format JavaScript for result and error handler function calls.
-		TPair<FString, FString> FormatResultAndErrorHandlers(const FString& HandlerId);
+		// Append a function call of a member with result handling to Script.
+		// Script is grown once to fit the call before the call template is rendered into it, JSON
+		// arguments are serialized directly into Script.
+		void AppendFunctionCall(
+			FString& Script, const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+			const FHandlerId& HandlerId) const;
 
 		// Execute a javascript function getting the result as a JSON encoded string.
+		// The result is an error if the call times out or is canceled, see FWebApiCallOptions.
+		// The round trip time of the call is recorded in FWebApiMetrics.
 		TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult> ExecuteFunction(
-			const TCHAR* FunctionName, const TCHAR* Arguments = TEXT(""));
+			const TCHAR* FunctionName, const FWebApiArguments& Arguments = FWebApiArguments(),
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions());
 
 		// Execute a javascript function handling the result with the specified handler.
 		// NOTE: This is virtual so tests can capture the function, arguments and handler ID before
 		// they're inserted into a script.
 		virtual void ExecuteAsyncFunction(
-			const TCHAR* FunctionName, const TCHAR* Arguments, const TCHAR* HandlerId);
-
-		// Execute a javascript function converting an argument to JSON.
+			const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+			const FHandlerId& HandlerId);
+
+		// Execute a javascript function passing a stream object as the last argument that the
+		// function can use to send incremental results. See FWebApiStream.
+		TSharedRef<FWebApiStream> ExecuteStreamingFunction(
+			const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+			const FWebApiStreamOptions& StreamOptions);
+
+		// Append a function call of a member that is passed a stream object to Script.
+		void AppendStreamingFunctionCall(
+			FString& Script, const TCHAR* FunctionName, const FWebApiArguments& Arguments,
+			const FWebApiStream& Stream) const;
+
+		// Execute a javascript function converting an argument to JSON. The argument is serialized
+		// directly into the script that makes the call.
 		template<typename JsonSerializableArgType>
 		TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult> ExecuteFunctionWithJsonArgument(
-			const TCHAR* FunctionName, const JsonSerializableArgType& Argument)
+			const TCHAR* FunctionName, const JsonSerializableArgType& Argument,
+			const FWebApiCallOptions& CallOptions = FWebApiCallOptions())
 		{
-			return ExecuteFunction(FunctionName, *Argument.ToJson(false));
+			return ExecuteFunction(FunctionName, FWebApiArguments(Argument), CallOptions);
 		}
 
 		// Create a promise and handler for the execution of a JavaScript function that optionally
@@ -293,10 +431,13 @@ namespace UE::AIAssistant
 		// setting an error.
 		template<typename JsonSerializableReturnType>
 		TFuture<TValueOrError<JsonSerializableReturnType, FString>>
-			ExecutionFunctionParseJson(const TCHAR* FunctionName)
+			ExecutionFunctionParseJson(
+				const TCHAR* FunctionName,
+				const FWebApiCallOptions& CallOptions = FWebApiCallOptions())
 		{
 			auto ResultAndHandler = CreatePromiseAndHandlerForFunction<JsonSerializableReturnType>();
-			ExecuteFunction(FunctionName).Then(MoveTemp(ResultAndHandler.Value));
+			ExecuteFunction(FunctionName, TEXT(""), CallOptions).Then(
+				MoveTemp(ResultAndHandler.Value));
 			return ResultAndHandler.Key->GetFuture();
 		}
 
@@ -306,20 +447,33 @@ namespace UE::AIAssistant
 		TFuture<TValueOrError<JsonSerializableReturnType, FString>>
 			ExecutionFunctionParseJson(
 				const TCHAR* FunctionName,
-				const JsonSerializableArgType& Argument)
+				const JsonSerializableArgType& Argument,
+				const FWebApiCallOptions& CallOptions = FWebApiCallOptions())
 		{
 			auto ResultAndHandler = CreatePromiseAndHandlerForFunction<JsonSerializableReturnType>();
-			ExecuteFunctionWithJsonArgument(FunctionName, Argument).Then(
+			ExecuteFunctionWithJsonArgument(FunctionName, Argument, CallOptions).Then(
 				MoveTemp(ResultAndHandler.Value));
 			return ResultAndHandler.Key->GetFuture();
 		}
 
 		// Parse a JSON string if JsonSerializableReturnType is not void otherwise return an empty value.
+		// Types with a ReadJson() overload are filled directly from the string, other types are
+		// parsed with FromJson().
 		template<typename JsonSerializableReturnType>
 		static TValueOrError<JsonSerializableReturnType, FString> ParseJsonIfNotVoid(const FString& Json)
 		{
 			JsonSerializableReturnType Parsed;
-			if (!Parsed.FromJson(Json))
+			if constexpr (THasJsonPullReader<JsonSerializableReturnType>::value)
+			{
+				FJsonPullReader Reader(Json);
+				if (!ReadJson(Reader, Parsed) || !Reader.ReadEnd())
+				{
+					return MakeError(FString::Printf(
+						TEXT("Failed to parse at offset %d (%s): %s"), Reader.GetErrorOffset(),
+						*Reader.GetErrorMessage(), *Json));
+				}
+			}
+			else if (!Parsed.FromJson(Json))
 			{
 				return MakeError(FString(TEXT("Failed to parse: ")) + Json);
 			}
@@ -334,6 +488,27 @@ namespace UE::AIAssistant
 		}
 
 	private:
+		// Send a call to the code executor or append it to the current batch depending upon the
+		// flush policy. When batching, AppendScript writes the call directly to the pending batch.
+		void ExecuteOrBatchScript(TFunctionRef<void(FString& Script)> AppendScript);
+
+		// Update batch counters after sending NumCalls in a single script.
+		// BatchLock must be held.
+		void RecordFlush(int32 NumCalls);
+
+		// Append a call rendered from CallTemplate to Script. Stream is only required for
+		// StreamingFunctionCallTemplate.
+		void AppendCall(
+			FString& Script, const FWebApiCallTemplate& CallTemplate, const TCHAR* FunctionName,
+			const FWebApiArguments& Arguments, const FHandlerId& HandlerId,
+			const FWebApiStream* Stream) const;
+
+		// Call a method (Control) of the JavaScript object of a stream.
+		void SendStreamControl(const FString& StreamKey, const TCHAR* Control);
+
+		// Unregister the result handlers of a stream.
+		void UnregisterStreamHandlers(const FWebApiStream& Stream);
+
 		// Call the underlying binder.
 		void BindUObject(const FString& Name, UObject* Object, bool bIsPermanent = true) override;
 
@@ -347,10 +522,44 @@ namespace UE::AIAssistant
 		TStrongObjectPtr<UAIAssistantWebJavaScriptResultDelegate> WebJavaScriptResultDelegate;
 
 	private:
+		mutable UE::FMutex BatchLock;  // Guards all batch state below.
+		// Calls waiting to be sent to the code executor.
+		FString PendingBatch;
+		// Number of calls in PendingBatch.
+		int32 NumPendingBatchCalls = 0;
+		// Batching counters.
+		FBatchStats BatchStats;
+		// Ticker registered to flush PendingBatch.
+		FTSTicker::FDelegateHandle FlushTickerHandle;
+		// Flush policy that takes precedence over the console variable, if set.
+		TOptional<EFlushPolicy> FlushPolicyOverride;
+
+		// Expires call timeouts, this is advanced by the core ticker.
+		TSharedRef<FTimerWheel> TimerWheel;
+		// Ticker that advances TimerWheel.
+		FTSTicker::FDelegateHandle TimerWheelTickerHandle;
+
+		UE::FMutex StreamsLock;  // Guards Streams
+		// Streams that have been created by this object, these are detached on destruction.
+		TArray<TWeakPtr<FWebApiStream>> Streams;
+
+	private:
+		// Slots in FunctionCallTemplate.
+		enum class EFunctionCallSlot : int32
+		{
+			WebApiObjectName,
+			FunctionName,
+			Arguments,
+			NotifyHandlerOfResult,
+			NotifyHandlerOfError,
+			StreamKey,
+			NotifyHandlerOfChunk,
+		};
+
 		// Name of the global object that implements the web API.
 		static const FString WebApiObjectName;
 
-		// FString::Format() template that requires:
+		// Call template with the following slots, named after EFunctionCallSlot:
 		// * WebApiObjectName: Should be FWebApi::WebApiObjectName.
 		// * FunctionName: Name of the function to call on WebApiObjectName.
 		// * Arguments: String that contains the arguments to pass to the function.
@@ -358,6 +567,19 @@ namespace UE::AIAssistant
 		//   the result of the function.
 		// * NotifyHandlerOfError: JavaScript snippet that is called with "error" to handle
 		//   a function error.
-		static const FString FunctionCallFormatTemplate;
+		static const TCHAR* const FunctionCallTemplateText;
+
+		// FunctionCallTemplateText parsed on startup.
+		static const FWebApiCallTemplate FunctionCallTemplate;
+
+		// Call template for a streamed function call. This has the same slots as
+		// FunctionCallTemplateText with the stream appended to Arguments and:
+		// * StreamKey: Key of the stream in the window.aiassistantstreams registry.
+		// * NotifyHandlerOfChunk: JavaScript snippet that is called with "chunk" to send a chunk
+		//   to the stream.
+		static const TCHAR* const StreamingFunctionCallTemplateText;
+
+		// StreamingFunctionCallTemplateText parsed on startup.
+		static const FWebApiCallTemplate StreamingFunctionCallTemplate;
 	};
 }
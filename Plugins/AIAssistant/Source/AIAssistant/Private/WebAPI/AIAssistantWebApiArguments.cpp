@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantWebApiArguments.h"
+
+#include "Misc/AssertionMacros.h"
+
+#include "Utils/AIAssistantJsonStringWriter.h"
+
+namespace UE::AIAssistant
+{
+	int32 FWebApiArguments::Len() const
+	{
+		if (Length == INDEX_NONE)
+		{
+			Length = Json ? GetJsonLength(*Json) : FCString::Strlen(Text);
+		}
+		return Length;
+	}
+
+	void FWebApiArguments::AppendTo(FString& Output) const
+	{
+		if (Json)
+		{
+			AppendJson(Output, *Json);
+		}
+		else
+		{
+			check(Text);
+			Output.AppendChars(Text, Len());
+		}
+	}
+
+	FString FWebApiArguments::ToString() const
+	{
+		FString Output;
+		Output.Reserve(Len());
+		AppendTo(Output);
+		return Output;
+	}
+}
@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include "Serialization/JsonSerializable.h"
+
+namespace UE::AIAssistant
+{
+	// Arguments of a JavaScript function call.
+	//
+	// This is either JavaScript text or an object that is serialized as JSON directly into the
+	// script that makes the call, so large payloads aren't converted to a JSON object or an
+	// intermediate string first. The referenced text or object must outlive this object.
+	class FWebApiArguments
+	{
+	public:
+		// Arguments specified as JavaScript text.
+		FWebApiArguments(const TCHAR* InText = TEXT("")) : Text(InText) {}
+
+		// A single argument serialized as JSON.
+		explicit FWebApiArguments(const FJsonSerializable& InJson) : Json(&InJson) {}
+
+		// Get the number of characters in the arguments. For JSON arguments this serializes the
+		// object without storing the result, the length is cached.
+		int32 Len() const;
+
+		// Append the arguments to Output.
+		void AppendTo(FString& Output) const;
+
+		// Get the arguments as a string.
+		FString ToString() const;
+
+	private:
+		const TCHAR* Text = nullptr;
+		const FJsonSerializable* Json = nullptr;
+		mutable int32 Length = INDEX_NONE;
+	};
+}
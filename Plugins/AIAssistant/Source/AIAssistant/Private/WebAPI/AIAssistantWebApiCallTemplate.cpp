@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantWebApiCallTemplate.h"
+
+#include "Containers/StringView.h"
+#include "Misc/AssertionMacros.h"
+
+namespace UE::AIAssistant
+{
+	FWebApiCallTemplate::FWebApiCallTemplate(
+		const TCHAR* TemplateText, TConstArrayView<const TCHAR*> SlotNames) :
+		Text(TemplateText)
+	{
+		check(TemplateText);
+		SlotCounts.SetNumZeroed(SlotNames.Num());
+
+		const FStringView TextView(Text);
+		int32 LiteralStart = 0;
+		int32 Position = 0;
+		while (Position < TextView.Len())
+		{
+			int32 SlotStart;
+			if (!TextView.RightChop(Position).FindChar(TEXT('{'), SlotStart))
+			{
+				break;
+			}
+			SlotStart += Position;
+
+			int32 SlotEnd;
+			if (!TextView.RightChop(SlotStart).FindChar(TEXT('}'), SlotEnd))
+			{
+				break;
+			}
+			SlotEnd += SlotStart;
+
+			const FStringView SlotName = TextView.Mid(SlotStart + 1, SlotEnd - SlotStart - 1);
+			const int32 SlotIndex = SlotNames.IndexOfByPredicate(
+				[&SlotName](const TCHAR* Name) -> bool { return SlotName.Equals(Name); });
+			if (SlotIndex == INDEX_NONE)
+			{
+				// Not a slot, keep the opening brace as a literal and continue after it.
+				Position = SlotStart + 1;
+				continue;
+			}
+
+			AddLiteral(LiteralStart, SlotStart - LiteralStart);
+			Segments.Add(FSegment{ SlotIndex });
+			++SlotCounts[SlotIndex];
+			LiteralStart = SlotEnd + 1;
+			Position = LiteralStart;
+		}
+		AddLiteral(LiteralStart, TextView.Len() - LiteralStart);
+		Segments.Shrink();
+	}
+
+	void FWebApiCallTemplate::AddLiteral(int32 Offset, int32 Length)
+	{
+		if (Length <= 0)
+		{
+			return;
+		}
+		LiteralLength += Length;
+		if (!Segments.IsEmpty() && Segments.Last().SlotIndex == INDEX_NONE)
+		{
+			Segments.Last().LiteralLength += Length;
+			return;
+		}
+		Segments.Add(FSegment{ INDEX_NONE, Offset, Length });
+	}
+
+	void FWebApiCallTemplate::Render(FString& Output, FAppendSlot AppendSlot) const
+	{
+		const TCHAR* TextData = *Text;
+		for (const FSegment& Segment : Segments)
+		{
+			if (Segment.SlotIndex == INDEX_NONE)
+			{
+				Output.AppendChars(TextData + Segment.LiteralOffset, Segment.LiteralLength);
+			}
+			else
+			{
+				AppendSlot(Output, Segment.SlotIndex);
+			}
+		}
+	}
+}
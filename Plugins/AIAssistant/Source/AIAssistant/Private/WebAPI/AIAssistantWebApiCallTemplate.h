@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Function.h"
+
+namespace UE::AIAssistant
+{
+	// JavaScript snippet template that is parsed once into a list of literal and slot segments so
+	// that it can be rendered repeatedly without scanning or formatting the template text.
+	//
+	// Slots are written as "{SlotName}" in the template text and are mapped to indices using the
+	// slot names supplied on construction. Braces that do not enclose a known slot name are
+	// treated as literal text.
+	class FWebApiCallTemplate
+	{
+	public:
+		// Appends the value of the slot SlotIndex to Output.
+		using FAppendSlot = TFunctionRef<void(FString& Output, int32 SlotIndex)>;
+
+	public:
+		FWebApiCallTemplate(const TCHAR* TemplateText, TConstArrayView<const TCHAR*> SlotNames);
+
+		// Append the rendered template to Output calling AppendSlot for each slot.
+		void Render(FString& Output, FAppendSlot AppendSlot) const;
+
+		// Number of characters in the template excluding slots.
+		int32 GetLiteralLength() const { return LiteralLength; }
+
+		// Number of times the slot SlotIndex appears in the template.
+		int32 GetSlotCount(int32 SlotIndex) const
+		{
+			return SlotCounts.IsValidIndex(SlotIndex) ? SlotCounts[SlotIndex] : 0;
+		}
+
+		// Number of literal and slot segments.
+		int32 GetNumSegments() const { return Segments.Num(); }
+
+	private:
+		// Literal text or a slot.
+		struct FSegment
+		{
+			// Index of the slot or INDEX_NONE if this is a literal.
+			int32 SlotIndex = INDEX_NONE;
+			// Offset of the literal in Text.
+			int32 LiteralOffset = 0;
+			// Length of the literal in Text.
+			int32 LiteralLength = 0;
+		};
+
+		// Add a literal segment, merging it with the previous segment if that is also a literal.
+		void AddLiteral(int32 Offset, int32 Length);
+
+	private:
+		FString Text;
+		TArray<FSegment> Segments;
+		TArray<int32> SlotCounts;
+		int32 LiteralLength = 0;
+	};
+}
@@ -0,0 +1,340 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Misc/DateTime.h"
+
+#include "Core/AIAssistantLog.h"
+#include "Utils/AIAssistantJsonPullReader.h"
+#include "WebAPI/AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	// Whether FieldName matches Name, FJsonObject field lookups are case insensitive so this is
+	// too.
+	static bool IsWebApiJsonField(FStringView FieldName, const TCHAR* Name)
+	{
+		return FieldName.Equals(Name, ESearchCase::IgnoreCase);
+	}
+
+	// Whether the next value has the type a field is read from. FromJson() ignores values of
+	// other types, including null, so they're skipped leaving the field unmodified.
+	static bool IsWebApiJsonValueOfType(FJsonPullReader& Reader, FJsonPullReader::EValueType ValueType)
+	{
+		return Reader.PeekValueType() == ValueType;
+	}
+
+	// Read a string field, values of other types leave the field unmodified.
+	static bool ReadWebApiJsonField(FJsonPullReader& Reader, FString& Value)
+	{
+		return IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::String)
+			? Reader.ReadString(Value)
+			: Reader.SkipValue();
+	}
+
+	// Read a boolean field, values of other types leave the field unmodified.
+	static bool ReadWebApiJsonField(FJsonPullReader& Reader, bool& Value)
+	{
+		return IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::Boolean)
+			? Reader.ReadBool(Value)
+			: Reader.SkipValue();
+	}
+
+	// Read an object field, values of other types leave the field unmodified.
+	template<typename T>
+	static bool ReadWebApiJsonObjectField(FJsonPullReader& Reader, T& Value)
+	{
+		return IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::Object)
+			? ReadJson(Reader, Value)
+			: Reader.SkipValue();
+	}
+
+	// Read an enum field, values that aren't strings or don't match an enum member leave the
+	// field unmodified consistent with LexFromString(). Returns false on error and sets bOutIsSet
+	// to whether the field was set.
+	template<typename EnumType, auto Size>
+	static bool ReadWebApiJsonEnumField(
+		FJsonPullReader& Reader,
+		const TStaticArray<EnumValueDescription<EnumType>, Size>& Descriptions, EnumType& Value,
+		bool& bOutIsSet)
+	{
+		bOutIsSet = false;
+		if (!IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::String))
+		{
+			return Reader.SkipValue();
+		}
+		FString Description;
+		if (!Reader.ReadString(Description))
+		{
+			return false;
+		}
+		const TOptional<EnumType> MaybeValue = GetEnumValueFromDescription(Descriptions, Description);
+		if (MaybeValue.IsSet())
+		{
+			Value = *MaybeValue;
+			bOutIsSet = true;
+		}
+		return true;
+	}
+
+	// Read the variant content of a message based upon its type.
+	static bool ReadWebApiJsonMessageContentVariant(
+		FJsonPullReader& Reader, FMessageContent& Value)
+	{
+		switch (Value.ContentType)
+		{
+			case EMessageContentType::Text:
+				Value.Content.Emplace<FTextMessageContent>();
+				return ReadJson(Reader, Value.Content.Get<FTextMessageContent>());
+		}
+		return Reader.SkipValue();
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FTextMessageContent& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("text")))
+				{
+					return ReadWebApiJsonField(Reader, Value.Text);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FMessageContent& Value)
+	{
+		bool bHasContentType = false;
+		// Offset of content that precedes the content type so must be read once the type is known
+		// or the object ends.
+		int32 DeferredContentOffset = INDEX_NONE;
+		bool bHasContent = false;
+		const bool bSuccess = Reader.ReadObject(
+			[&Reader, &Value, &bHasContentType, &DeferredContentOffset, &bHasContent](
+				FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("contentType")))
+				{
+					return ReadWebApiJsonEnumField(
+						Reader, EMessageContentTypeDescriptions, Value.ContentType, bHasContentType);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("content")))
+				{
+					// Content that isn't an object is treated as missing.
+					if (!IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::Object))
+					{
+						return Reader.SkipValue();
+					}
+					bHasContent = true;
+					if (bHasContentType)
+					{
+						return ReadWebApiJsonMessageContentVariant(Reader, Value);
+					}
+					DeferredContentOffset = Reader.GetOffset();
+					return Reader.SkipValue();
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("visibleToUser")))
+				{
+					return ReadWebApiJsonField(Reader, Value.bVisibleToUser);
+				}
+				return Reader.SkipValue();
+			});
+		if (!bSuccess)
+		{
+			return false;
+		}
+		if (!bHasContent)
+		{
+			if (Value.ContentType == EMessageContentType::Text)
+			{
+				UE_LOG(LogAIAssistant, Warning,
+					TEXT("Failed to load variant from field '%s' as it is missing."), TEXT("content"));
+			}
+			return true;
+		}
+		// Like FromJson() if the JSON doesn't contain a valid type the content is read using the type
+		// the message already had.
+		if (DeferredContentOffset != INDEX_NONE)
+		{
+			const int32 EndOffset = Reader.GetOffset();
+			Reader.Seek(DeferredContentOffset);
+			if (!ReadWebApiJsonMessageContentVariant(Reader, Value))
+			{
+				return false;
+			}
+			Reader.Seek(EndOffset);
+		}
+		return true;
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FMessage& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("date")))
+				{
+					if (!IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::String))
+					{
+						return Reader.SkipValue();
+					}
+					FString DateString;
+					if (!Reader.ReadString(DateString))
+					{
+						return false;
+					}
+					// A date that can't be parsed is left unset.
+					FDateTime Date;
+					if (FDateTime::ParseIso8601(*DateString, Date))
+					{
+						Value.Date = Date;
+					}
+					return true;
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("messageRole")))
+				{
+					bool bUnusedIsSet;
+					return ReadWebApiJsonEnumField(
+						Reader, EMessageRoleDescriptions, Value.MessageRole, bUnusedIsSet);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("messageContent")))
+				{
+					if (!IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::Array))
+					{
+						return Reader.SkipValue();
+					}
+					if (!Reader.BeginArray())
+					{
+						return false;
+					}
+					Value.MessageContent.Reset();
+					while (Reader.NextElement())
+					{
+						// Like FromJson() elements that aren't objects are added with default values.
+						if (!ReadWebApiJsonObjectField(Reader, Value.MessageContent.AddDefaulted_GetRef()))
+						{
+							return false;
+						}
+					}
+					return !Reader.HasError();
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FConversationId& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("id")))
+				{
+					return ReadWebApiJsonField(Reader, Value.Id);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAddMessageToConversationOptions& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("conversationId")))
+				{
+					return IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::Object)
+						? ReadJson(Reader, Value.ConversationId.Emplace())
+						: Reader.SkipValue();
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("message")))
+				{
+					return ReadWebApiJsonObjectField(Reader, Value.Message);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("messageId")))
+				{
+					return IsWebApiJsonValueOfType(Reader, FJsonPullReader::EValueType::String)
+						? Reader.ReadString(Value.MessageId.Emplace())
+						: Reader.SkipValue();
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentDescriptor& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("environmentName")))
+				{
+					return ReadWebApiJsonField(Reader, Value.EnvironmentName);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("environmentVersion")))
+				{
+					return ReadWebApiJsonField(Reader, Value.EnvironmentVersion);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironment& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("descriptor")))
+				{
+					return ReadWebApiJsonObjectField(Reader, Value.Descriptor);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentId& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("id")))
+				{
+					return ReadWebApiJsonField(Reader, Value.Id);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentHash& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("algorithm")))
+				{
+					return ReadWebApiJsonField(Reader, Value.Algorithm);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("hash")))
+				{
+					return ReadWebApiJsonField(Reader, Value.Hash);
+				}
+				return Reader.SkipValue();
+			});
+	}
+
+	bool ReadJson(FJsonPullReader& Reader, FAgentEnvironmentHandle& Value)
+	{
+		return Reader.ReadObject(
+			[&Reader, &Value](FStringView FieldName) -> bool
+			{
+				if (IsWebApiJsonField(FieldName, TEXT("id")))
+				{
+					return ReadWebApiJsonObjectField(Reader, Value.Id);
+				}
+				if (IsWebApiJsonField(FieldName, TEXT("hash")))
+				{
+					return ReadWebApiJsonObjectField(Reader, Value.Hash);
+				}
+				return Reader.SkipValue();
+			});
+	}
+}
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantWebApiMetrics.h"
+
+#include "Async/UniqueLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#include "Core/AIAssistantLog.h"
+
+namespace UE::AIAssistant
+{
+	// Convert a latency in microseconds to milliseconds.
+	static double WebApiMicrosecondsToMilliseconds(uint64 Microseconds)
+	{
+		return double(Microseconds) / 1000.0;
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice WebApiStatsConsoleCommand(
+		TEXT("ai.assistant.webapi.stats"),
+		TEXT("Print the latency (p50 / p95 / p99), error rate and calls in flight of each AI ")
+		TEXT("assistant web API function. Pass \"reset\" to clear the counters."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda(
+			[](const TArray<FString>& Args, FOutputDevice& Output) -> void
+			{
+				if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+				{
+					FWebApiMetrics::Get().Reset();
+					return;
+				}
+				Output.Log(
+					LogAIAssistant.GetCategoryName(), ELogVerbosity::Display,
+					FWebApiMetrics::FormatSummaries(FWebApiMetrics::Get().GetSummaries()));
+			}));
+
+	FWebApiMetrics::FFunctionMetrics::FFunctionMetrics(const FString& InFunctionName) :
+		FunctionName(InFunctionName)
+#if COUNTERSTRACE_ENABLED
+		,
+		InFlightCounterName(
+			FString::Printf(TEXT("AIAssistant/WebApi/%s/InFlight"), *InFunctionName)),
+		LatencyCounterName(
+			FString::Printf(TEXT("AIAssistant/WebApi/%s/LatencyMs"), *InFunctionName)),
+		InFlightCounter(*InFlightCounterName, TraceCounterDisplayHint_None),
+		LatencyCounter(*LatencyCounterName, TraceCounterDisplayHint_None)
+#endif  // COUNTERSTRACE_ENABLED
+	{
+	}
+
+	uint64 FWebApiMetrics::FFunctionMetrics::BeginCall()
+	{
+#if COUNTERSTRACE_ENABLED
+		InFlightCounter.Set(++NumInFlight);
+#else
+		++NumInFlight;
+#endif  // COUNTERSTRACE_ENABLED
+		return FPlatformTime::Cycles64();
+	}
+
+	void FWebApiMetrics::FFunctionMetrics::EndCall(uint64 StartCycles, bool bIsError)
+	{
+		const uint64 Microseconds = uint64(
+			FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6);
+		LatencyMicroseconds.Record(Microseconds);
+		++NumCalls;
+		if (bIsError)
+		{
+			++NumErrors;
+		}
+#if COUNTERSTRACE_ENABLED
+		InFlightCounter.Set(--NumInFlight);
+		LatencyCounter.Set(WebApiMicrosecondsToMilliseconds(Microseconds));
+#else
+		--NumInFlight;
+#endif  // COUNTERSTRACE_ENABLED
+	}
+
+	void FWebApiMetrics::FFunctionMetrics::Reset()
+	{
+		LatencyMicroseconds.Reset();
+		NumCalls = 0;
+		NumErrors = 0;
+	}
+
+	FWebApiMetrics& FWebApiMetrics::Get()
+	{
+		static FWebApiMetrics Metrics;
+		return Metrics;
+	}
+
+	FWebApiMetrics::FFunctionMetrics& FWebApiMetrics::FindOrAdd(const TCHAR* FunctionName)
+	{
+		const FString Name(FunctionName);
+		UE::TUniqueLock Lock(FunctionMetricsLock);
+		if (TUniquePtr<FFunctionMetrics>* ExistingMetrics = FunctionMetrics.Find(Name))
+		{
+			return **ExistingMetrics;
+		}
+		return *FunctionMetrics.Add(Name, MakeUnique<FFunctionMetrics>(Name));
+	}
+
+	TArray<FWebApiMetrics::FFunctionSummary> FWebApiMetrics::GetSummaries() const
+	{
+		TArray<FFunctionSummary> Summaries;
+		{
+			UE::TUniqueLock Lock(FunctionMetricsLock);
+			Summaries.Reserve(FunctionMetrics.Num());
+			for (const auto& NameAndMetrics : FunctionMetrics)
+			{
+				const FFunctionMetrics& Metrics = *NameAndMetrics.Value;
+				const FLatencyHistogram& Latency = Metrics.LatencyMicroseconds;
+				FFunctionSummary& Summary = Summaries.Emplace_GetRef();
+				Summary.FunctionName = Metrics.FunctionName;
+				Summary.NumCalls = Metrics.NumCalls.load();
+				Summary.NumErrors = Metrics.NumErrors.load();
+				Summary.NumInFlight = Metrics.NumInFlight.load();
+				Summary.MeanMilliseconds = Latency.GetMean() / 1000.0;
+				Summary.P50Milliseconds =
+					WebApiMicrosecondsToMilliseconds(Latency.GetValueAtPercentile(50.0));
+				Summary.P95Milliseconds =
+					WebApiMicrosecondsToMilliseconds(Latency.GetValueAtPercentile(95.0));
+				Summary.P99Milliseconds =
+					WebApiMicrosecondsToMilliseconds(Latency.GetValueAtPercentile(99.0));
+				Summary.MaxMilliseconds = WebApiMicrosecondsToMilliseconds(Latency.GetMax());
+			}
+		}
+		Summaries.Sort(
+			[](const FFunctionSummary& Lhs, const FFunctionSummary& Rhs) -> bool
+			{
+				return Lhs.FunctionName < Rhs.FunctionName;
+			});
+		return Summaries;
+	}
+
+	int32 FWebApiMetrics::GetNumInFlight() const
+	{
+		int32 NumInFlight = 0;
+		UE::TUniqueLock Lock(FunctionMetricsLock);
+		for (const auto& NameAndMetrics : FunctionMetrics)
+		{
+			NumInFlight += NameAndMetrics.Value->NumInFlight.load();
+		}
+		return NumInFlight;
+	}
+
+	void FWebApiMetrics::Reset()
+	{
+		UE::TUniqueLock Lock(FunctionMetricsLock);
+		for (auto& NameAndMetrics : FunctionMetrics)
+		{
+			NameAndMetrics.Value->Reset();
+		}
+	}
+
+	FString FWebApiMetrics::FormatSummaries(const TArray<FFunctionSummary>& Summaries)
+	{
+		FString Table = FString::Printf(
+			TEXT("%-32s %8s %8s %8s %10s %10s %10s %10s %10s\n"),
+			TEXT("Function"), TEXT("Calls"), TEXT("Errors%"), TEXT("InFlight"), TEXT("Mean(ms)"),
+			TEXT("P50(ms)"), TEXT("P95(ms)"), TEXT("P99(ms)"), TEXT("Max(ms)"));
+		for (const FFunctionSummary& Summary : Summaries)
+		{
+			Table += FString::Printf(
+				TEXT("%-32s %8llu %8.1f %8d %10.2f %10.2f %10.2f %10.2f %10.2f\n"),
+				*Summary.FunctionName, Summary.NumCalls, Summary.GetErrorRate() * 100.0,
+				Summary.NumInFlight, Summary.MeanMilliseconds, Summary.P50Milliseconds,
+				Summary.P95Milliseconds, Summary.P99Milliseconds, Summary.MaxMilliseconds);
+		}
+		return Table;
+	}
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Mutex.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Templates/UniquePtr.h"
+#include "Templates/UnrealTemplate.h"
+
+#include "AIAssistantLatencyHistogram.h"
+
+#include <atomic>
+
+namespace UE::AIAssistant
+{
+	// Latency and error counters of the JavaScript functions called by FWebApi.
+	//
+	// Each call is timed from when it's sent to the browser until its result is handled. The data
+	// is available through the ai.assistant.webapi.stats console command and as Unreal Insights
+	// trace counters named "AIAssistant/WebApi/<FunctionName>/...".
+	class FWebApiMetrics : public FNoncopyable
+	{
+	public:
+		// Counters of a single function.
+		class FFunctionMetrics : public FNoncopyable
+		{
+		public:
+			explicit FFunctionMetrics(const FString& FunctionName);
+
+			// Start timing a call returning the start time to pass to EndCall().
+			uint64 BeginCall();
+
+			// Finish timing a call started at StartCycles.
+			void EndCall(uint64 StartCycles, bool bIsError);
+
+			// Remove all samples, calls in flight are still counted.
+			void Reset();
+
+			const FString FunctionName;
+			// Round trip time of completed calls in microseconds.
+			FLatencyHistogram LatencyMicroseconds;
+			// Number of completed calls.
+			std::atomic<uint64> NumCalls = 0;
+			// Number of calls that completed with an error.
+			std::atomic<uint64> NumErrors = 0;
+			// Number of calls waiting for a result.
+			std::atomic<int32> NumInFlight = 0;
+
+		private:
+#if COUNTERSTRACE_ENABLED
+			const FString InFlightCounterName;
+			const FString LatencyCounterName;
+			FCountersTrace::TCounter<int64, TraceCounterType_Int> InFlightCounter;
+			FCountersTrace::TCounter<double, TraceCounterType_Float> LatencyCounter;
+#endif  // COUNTERSTRACE_ENABLED
+		};
+
+		// Snapshot of the counters of a function.
+		struct FFunctionSummary
+		{
+			FString FunctionName;
+			uint64 NumCalls = 0;
+			uint64 NumErrors = 0;
+			int32 NumInFlight = 0;
+			double MeanMilliseconds = 0.0;
+			double P50Milliseconds = 0.0;
+			double P95Milliseconds = 0.0;
+			double P99Milliseconds = 0.0;
+			double MaxMilliseconds = 0.0;
+
+			// Fraction of completed calls that failed.
+			double GetErrorRate() const
+			{
+				return NumCalls ? double(NumErrors) / double(NumCalls) : 0.0;
+			}
+		};
+
+	public:
+		FWebApiMetrics() = default;
+
+		// Get the metrics shared by all FWebApi instances.
+		static FWebApiMetrics& Get();
+
+		// Get the counters for a function, creating them if they don't exist. The returned
+		// reference remains valid for the lifetime of this object.
+		FFunctionMetrics& FindOrAdd(const TCHAR* FunctionName);
+
+		// Get a snapshot of the counters of all functions sorted by name.
+		TArray<FFunctionSummary> GetSummaries() const;
+
+		// Get the number of calls in flight across all functions.
+		int32 GetNumInFlight() const;
+
+		// Remove all samples.
+		void Reset();
+
+		// Format the summaries as a table.
+		static FString FormatSummaries(const TArray<FFunctionSummary>& Summaries);
+
+	private:
+		mutable UE::FMutex FunctionMetricsLock;  // Guards FunctionMetrics
+		TMap<FString, TUniquePtr<FFunctionMetrics>> FunctionMetrics;
+	};
+}
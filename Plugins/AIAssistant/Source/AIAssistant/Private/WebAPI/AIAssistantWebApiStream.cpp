@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIAssistantWebApiStream.h"
+
+#include "Async/Async.h"
+#include "Async/UniqueLock.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/AssertionMacros.h"
+
+#include "AIAssistantWebApi.h"
+
+namespace UE::AIAssistant
+{
+	const FString FWebApiStream::OverflowError(TEXT(R"json("overflow")json"));
+
+	FWebApiStream::FWebApiStream(FWebApi& InWebApi, const FWebApiStreamOptions& InOptions) :
+		Options(InOptions),
+		WebApi(&InWebApi)
+	{
+		check(Options.Capacity > 0);
+		check(Options.ResumeThreshold <= Options.PauseThreshold);
+	}
+
+	FWebApiStream::~FWebApiStream()
+	{
+		Finish(MakeError(UAIAssistantWebJavaScriptResultDelegate::CanceledError), true);
+	}
+
+	void FWebApiStream::SetHandlerIds(
+		const FHandlerId& InChunkHandlerId, const FHandlerId& InCompletionHandlerId)
+	{
+		ChunkHandlerId = InChunkHandlerId;
+		CompletionHandlerId = InCompletionHandlerId;
+		StreamKey = FString::Printf(TEXT("%d_%d"), ChunkHandlerId.Index, ChunkHandlerId.Generation);
+	}
+
+	void FWebApiStream::SetCallMetrics(
+		FWebApiMetrics::FFunctionMetrics& FunctionMetrics, uint64 StartCycles)
+	{
+		CallMetrics = &FunctionMetrics;
+		CallStartCycles = StartCycles;
+	}
+
+	bool FWebApiStream::TryDequeueChunk(FString& OutChunkJson)
+	{
+		bool bResume = false;
+		{
+			UE::TUniqueLock Lock(BufferLock);
+			if (Chunks.IsEmpty())
+			{
+				return false;
+			}
+			OutChunkJson = MoveTemp(Chunks.First());
+			Chunks.PopFirst();
+			if (bIsPaused && Chunks.Num() <= Options.ResumeThreshold)
+			{
+				bIsPaused = false;
+				bResume = !bIsComplete;
+			}
+		}
+		if (bResume)
+		{
+			if (IsInGameThread())
+			{
+				SendPaused(false);
+			}
+			else
+			{
+				AsyncTask(
+					ENamedThreads::GameThread,
+					[WeakThis = TWeakPtr<FWebApiStream>(AsShared())]()
+					{
+						if (TSharedPtr<FWebApiStream> This = WeakThis.Pin())
+						{
+							This->SendResume();
+						}
+					});
+			}
+		}
+		return true;
+	}
+
+	int32 FWebApiStream::GetNumBufferedChunks() const
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		return Chunks.Num();
+	}
+
+	void FWebApiStream::SetOnChunkAvailable(FOnChunkAvailable&& InOnChunkAvailable)
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		OnChunkAvailable = MakeShared<FOnChunkAvailable>(MoveTemp(InOnChunkAvailable));
+	}
+
+	TFuture<TValueOrError<void, FString>> FWebApiStream::GetCompletionFuture()
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		return CompletionPromise.GetFuture();
+	}
+
+	bool FWebApiStream::IsComplete() const
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		return bIsComplete;
+	}
+
+	bool FWebApiStream::IsPaused() const
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		return bIsPaused;
+	}
+
+	void FWebApiStream::Cancel()
+	{
+		Finish(MakeError(UAIAssistantWebJavaScriptResultDelegate::CanceledError), true);
+	}
+
+	FWebApiStream::FStats FWebApiStream::GetStats() const
+	{
+		UE::TUniqueLock Lock(BufferLock);
+		return Stats;
+	}
+
+	void FWebApiStream::HandleChunk(FString&& ChunkJson)
+	{
+		bool bPause = false;
+		bool bOverflow = false;
+		TSharedPtr<FOnChunkAvailable> OnChunkAvailableToCall;
+		{
+			UE::TUniqueLock Lock(BufferLock);
+			if (bIsComplete)
+			{
+				return;
+			}
+			if (Chunks.Num() >= Options.Capacity)
+			{
+				bOverflow = true;
+			}
+			else
+			{
+				Chunks.PushLast(MoveTemp(ChunkJson));
+				++Stats.NumChunksReceived;
+				Stats.MaxBufferedChunks = FMath::Max(Stats.MaxBufferedChunks, Chunks.Num());
+				if (!bIsPaused && Chunks.Num() >= Options.PauseThreshold)
+				{
+					bIsPaused = true;
+					bPause = true;
+					++Stats.NumPauses;
+				}
+				OnChunkAvailableToCall = OnChunkAvailable;
+			}
+		}
+
+		if (bOverflow)
+		{
+			Finish(MakeError(OverflowError), true);
+			return;
+		}
+		if (bPause)
+		{
+			SendPaused(true);
+		}
+		if (OnChunkAvailableToCall)
+		{
+			(*OnChunkAvailableToCall)(*this);
+		}
+	}
+
+	void FWebApiStream::Finish(TValueOrError<void, FString>&& Result, bool bCancelProducer)
+	{
+		{
+			UE::TUniqueLock Lock(BufferLock);
+			if (bIsComplete)
+			{
+				return;
+			}
+			bIsComplete = true;
+			bIsPaused = false;
+		}
+		if (CallMetrics)
+		{
+			CallMetrics->EndCall(CallStartCycles, Result.HasError());
+		}
+		{
+			UE::TUniqueLock Lock(WebApiLock);
+			if (WebApi)
+			{
+				if (bCancelProducer)
+				{
+					WebApi->SendStreamControl(StreamKey, TEXT("cancel()"));
+				}
+				WebApi->UnregisterStreamHandlers(*this);
+			}
+		}
+		// NOTE: This is set without holding any locks as continuations can call back into the
+		// stream.
+		CompletionPromise.SetValue(MoveTemp(Result));
+	}
+
+	void FWebApiStream::Detach()
+	{
+		{
+			UE::TUniqueLock Lock(WebApiLock);
+			WebApi = nullptr;
+		}
+		Finish(MakeError(UAIAssistantWebJavaScriptResultDelegate::CanceledError), false);
+	}
+
+	void FWebApiStream::SendPaused(bool bPaused)
+	{
+		UE::TUniqueLock Lock(WebApiLock);
+		if (WebApi)
+		{
+			WebApi->SendStreamControl(
+				StreamKey, bPaused ? TEXT("setPaused(true)") : TEXT("setPaused(false)"));
+		}
+	}
+
+	void FWebApiStream::SendResume()
+	{
+		{
+			UE::TUniqueLock Lock(BufferLock);
+			if (bIsPaused || bIsComplete)
+			{
+				return;
+			}
+		}
+		SendPaused(false);
+	}
+}
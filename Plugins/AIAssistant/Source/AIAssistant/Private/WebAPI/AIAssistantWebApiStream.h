@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Async/Future.h"
+#include "Async/Mutex.h"
+#include "Async/RecursiveMutex.h"
+#include "Containers/Deque.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UnrealTemplate.h"
+#include "Templates/ValueOrError.h"
+
+#include "AIAssistantWebApiMetrics.h"
+#include "AIAssistantWebJavaScriptResultDelegate.h"
+
+namespace UE::AIAssistant
+{
+	class FWebApi;
+
+	// Buffering options of a streamed call.
+	struct FWebApiStreamOptions
+	{
+		// Maximum number of chunks that can be buffered. If the JavaScript producer ignores the
+		// request to pause and the buffer overflows, the stream fails with
+		// FWebApiStream::OverflowError.
+		int32 Capacity = 256;
+		// Ask the JavaScript producer to pause when this number of chunks are buffered.
+		int32 PauseThreshold = 192;
+		// Ask the JavaScript producer to resume when the number of buffered chunks drops to this.
+		int32 ResumeThreshold = 64;
+	};
+
+	// Receives incremental results (chunks) of a JavaScript function call made with
+	// FWebApi::ExecuteStreamingFunction().
+	//
+	// The JavaScript function is passed a stream object as its last argument with the following
+	// interface:
+	// * write(chunk): Send a chunk (any object that can be serialized as JSON) to this stream.
+	//   Returns false if the stream was canceled.
+	// * ready(): Returns a promise that resolves when the producer should continue writing. This
+	//   is pending while the stream is paused because the consumer has too many buffered chunks.
+	// * paused / cancelled: Current state of the stream.
+	// The stream completes when the promise returned by the function resolves or rejects.
+	//
+	// Chunks are received on the thread that handles JavaScript results (the game thread) and
+	// can be dequeued from any thread. As the producer can only be controlled from the game
+	// thread, a resume caused by dequeuing on another thread is sent on the next game thread
+	// tick.
+	class FWebApiStream : public FNoncopyable, public TSharedFromThis<FWebApiStream>
+	{
+		friend class FWebApi;
+
+	public:
+		using FHandlerId = UAIAssistantWebJavaScriptResultDelegate::FHandlerId;
+
+		// Called after a chunk is added to the buffer.
+		using FOnChunkAvailable = TFunction<void(FWebApiStream& Stream)>;
+
+		// Counters that describe the flow of chunks through the stream.
+		struct FStats
+		{
+			// Number of chunks received from JavaScript.
+			uint64 NumChunksReceived = 0;
+			// Largest number of chunks buffered at once.
+			int32 MaxBufferedChunks = 0;
+			// Number of times the producer was asked to pause.
+			int32 NumPauses = 0;
+		};
+
+	public:
+		// NOTE: Streams are created by FWebApi::ExecuteStreamingFunction().
+		FWebApiStream(FWebApi& WebApi, const FWebApiStreamOptions& Options);
+
+		// Cancels the stream if it hasn't completed.
+		~FWebApiStream();
+
+		// Remove the oldest buffered chunk returning it as JSON in OutChunkJson.
+		// Returns false if no chunks are buffered.
+		bool TryDequeueChunk(FString& OutChunkJson);
+
+		// Get the number of buffered chunks.
+		int32 GetNumBufferedChunks() const;
+
+		// Set the function to call when a chunk is available.
+		void SetOnChunkAvailable(FOnChunkAvailable&& OnChunkAvailable);
+
+		// Get a future that is completed when the stream completes. The future contains an error
+		// if the JavaScript function failed, the stream was canceled (CanceledError) or the buffer
+		// overflowed (OverflowError).
+		// NOTE: This can only be called once.
+		TFuture<TValueOrError<void, FString>> GetCompletionFuture();
+
+		// Whether the stream has completed, buffered chunks can still be dequeued.
+		bool IsComplete() const;
+
+		// Whether the producer has been asked to pause.
+		bool IsPaused() const;
+
+		// Stop receiving chunks and ask the JavaScript producer to stop.
+		void Cancel();
+
+		// Get the stream counters.
+		FStats GetStats() const;
+
+		// IDs of the handlers that receive chunks and the completion of the function.
+		const FHandlerId& GetChunkHandlerId() const { return ChunkHandlerId; }
+		const FHandlerId& GetCompletionHandlerId() const { return CompletionHandlerId; }
+
+		// Key of the stream object in the JavaScript stream registry.
+		const FString& GetStreamKey() const { return StreamKey; }
+
+	public:
+		// Error set when the stream buffer overflows.
+		static const FString OverflowError;
+
+	private:
+		// Set the handlers used to receive chunks and completion.
+		void SetHandlerIds(const FHandlerId& InChunkHandlerId, const FHandlerId& InCompletionHandlerId);
+
+		// Record the round trip time of the call in FunctionMetrics when the stream completes.
+		void SetCallMetrics(FWebApiMetrics::FFunctionMetrics& FunctionMetrics, uint64 StartCycles);
+
+		// Add a chunk to the buffer.
+		void HandleChunk(FString&& ChunkJson);
+
+		// Complete the stream, optionally asking the producer to stop.
+		void Finish(TValueOrError<void, FString>&& Result, bool bCancelProducer);
+
+		// Called by FWebApi when it's destroyed, this completes the stream with CanceledError.
+		void Detach();
+
+		// Ask the producer to pause or resume.
+		void SendPaused(bool bPaused);
+
+		// Ask the producer to resume if the stream is still running and wasn't paused again
+		// since the resume was requested.
+		void SendResume();
+
+	private:
+		const FWebApiStreamOptions Options;
+
+		UE::FRecursiveMutex WebApiLock;  // Guards WebApi
+		// API used to control the producer, this is reset when the API is destroyed.
+		FWebApi* WebApi;
+
+		mutable UE::FMutex BufferLock;  // Guards all state below
+		TDeque<FString> Chunks;
+		TSharedPtr<FOnChunkAvailable> OnChunkAvailable;
+		TPromise<TValueOrError<void, FString>> CompletionPromise;
+		bool bIsComplete = false;
+		bool bIsPaused = false;
+		FStats Stats;
+
+		// Metrics of the function that produces the stream.
+		FWebApiMetrics::FFunctionMetrics* CallMetrics = nullptr;
+		uint64 CallStartCycles = 0;
+
+		FHandlerId ChunkHandlerId;
+		FHandlerId CompletionHandlerId;
+		FString StreamKey;
+	};
+}
@@ -3,7 +3,29 @@
 #include "AIAssistantWebJavaScriptResultDelegate.h"
 
 #include "Async/UniqueLock.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/Guid.h"
+#include "ProfilingDebugging/CountersTrace.h"
 #include "Templates/SharedPointer.h"
+#include <atomic>
+
+// Number of handlers registered across all delegates.
+TRACE_DECLARE_INT_COUNTER(
+	AIAssistantOutstandingResultHandlers, TEXT("AIAssistant/OutstandingResultHandlers"));
+static std::atomic<int32> NumOutstandingResultHandlers = 0;
+
+// Generate a random positive handler generation that differs from PreviousGeneration.
+// NOTE: This uses the GUID generator rather than FMath::Rand() as the sequence of IDs must not be
+// predictable from the IDs the page has seen.
+static int32 GenerateResultHandlerGeneration(int32 PreviousGeneration)
+{
+	int32 Generation;
+	do
+	{
+		Generation = static_cast<int32>(FGuid::NewGuid().A & MAX_int32);
+	} while (Generation == 0 || Generation == PreviousGeneration);
+	return Generation;
+}
 
 // Name of this object when registered with the JavaScript binder.
 // NOTE: This is lower case as FCEFJSScripting::GetBindingName() will silently change the name
@@ -12,6 +34,9 @@ const FString UAIAssistantWebJavaScriptResultDelegate::Name(TEXT("aiassistantres
 // Result set when a promise is canceled.
 const FString UAIAssistantWebJavaScriptResultDelegate::CanceledError(
 	TEXT(R"json("canceled")json"));
+// Result set when a promise times out.
+const FString UAIAssistantWebJavaScriptResultDelegate::TimedOutError(
+	TEXT(R"json("timedout")json"));
 
 void UAIAssistantWebJavaScriptResultDelegate::Bind(
 	UE::AIAssistant::IWebJavaScriptDelegateBinder& WebJavaScriptDelegateBinder)
@@ -26,113 +51,203 @@ void UAIAssistantWebJavaScriptResultDelegate::Unbind()
 	CompleteAllPendingPromises();
 }
 
-FString UAIAssistantWebJavaScriptResultDelegate::CreateHandlerId()
+UAIAssistantWebJavaScriptResultDelegate::FHandlerId
+UAIAssistantWebJavaScriptResultDelegate::AllocateHandlerSlot()
+{
+	const int32 Index = FreeHandlerSlots.IsEmpty()
+		? HandlerSlots.AddDefaulted()
+		: FreeHandlerSlots.Pop(EAllowShrinking::No);
+	FHandlerSlot& Slot = HandlerSlots[Index];
+	check(!Slot.bIsRegistered);
+	Slot.bIsRegistered = true;
+	// Generations are always positive so that a default FHandlerId never matches a slot.
+	Slot.Generation = GenerateResultHandlerGeneration(Slot.Generation);
+	++NumRegisteredHandlers;
+	TRACE_COUNTER_SET(AIAssistantOutstandingResultHandlers, ++NumOutstandingResultHandlers);
+	return FHandlerId{ Index, Slot.Generation };
+}
+
+UAIAssistantWebJavaScriptResultDelegate::FHandlerSlot*
+UAIAssistantWebJavaScriptResultDelegate::FindRegisteredHandlerSlot(const FHandlerId& HandlerId)
 {
-	return FGuid::NewGuid().ToString();
+	if (!HandlerSlots.IsValidIndex(HandlerId.Index))
+	{
+		return nullptr;
+	}
+	FHandlerSlot& Slot = HandlerSlots[HandlerId.Index];
+	return Slot.bIsRegistered && Slot.Generation == HandlerId.Generation ? &Slot : nullptr;
 }
 
-void UAIAssistantWebJavaScriptResultDelegate::RegisterResultHandlerWithId(
-	FResultHandler&& Handler, const FString& HandlerId)
+void UAIAssistantWebJavaScriptResultDelegate::ReleaseHandlerSlot(
+	int32 Index, TOptional<TPromise<FResult>>& PromiseToComplete)
 {
-	UE::TUniqueLock Lock(ResultHandlersByIdLock);
-	ResultHandlersById.Emplace(HandlerId, MakeShared<FResultHandler>(MoveTemp(Handler)));
+	FHandlerSlot& Slot = HandlerSlots[Index];
+	check(Slot.bIsRegistered);
+	PromiseToComplete = MoveTemp(Slot.Promise);
+	Slot.Promise.Reset();
+	Slot.Handler.Reset();
+	Slot.bIsRegistered = false;
+	FreeHandlerSlots.Push(Index);
+	--NumRegisteredHandlers;
+	TRACE_COUNTER_SET(AIAssistantOutstandingResultHandlers, --NumOutstandingResultHandlers);
 }
 
-FString UAIAssistantWebJavaScriptResultDelegate::RegisterResultHandler(FResultHandler&& Handler)
+UAIAssistantWebJavaScriptResultDelegate::FHandlerId
+UAIAssistantWebJavaScriptResultDelegate::RegisterResultHandler(FResultHandler&& Handler)
 {
-	FString HandlerId = CreateHandlerId();
-	RegisterResultHandlerWithId(MoveTemp(Handler), HandlerId);
+	TSharedPtr<FResultHandler> SharedHandler = MakeShared<FResultHandler>(MoveTemp(Handler));
+	UE::TUniqueLock Lock(HandlerSlotsLock);
+	FHandlerId HandlerId = AllocateHandlerSlot();
+	HandlerSlots[HandlerId.Index].Handler = MoveTemp(SharedHandler);
 	return HandlerId;
 }
 
-TPair<FString, TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>>
+TPair<UAIAssistantWebJavaScriptResultDelegate::FHandlerId,
+	TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>>
 UAIAssistantWebJavaScriptResultDelegate::RegisterResultHandlerForFuture()
 {
-	FString HandlerId = CreateHandlerId();
-	TFuture<FResult> Future = CreatePromiseAndGetFuture(HandlerId);
-	RegisterResultHandlerWithId(
-		[this](FResultHandlerContext&& ResultHandlerContext) mutable -> bool
+	UE::TUniqueLock Lock(HandlerSlotsLock);
+	FHandlerId HandlerId = AllocateHandlerSlot();
+	TFuture<FResult> Future = HandlerSlots[HandlerId.Index].Promise.Emplace().GetFuture();
+	return TPair<FHandlerId, TFuture<FResult>>(HandlerId, MoveTemp(Future));
+}
+
+bool UAIAssistantWebJavaScriptResultDelegate::UnregisterResultHandler(
+	const FHandlerId& HandlerId, const FString& ErrorJson)
+{
+	TOptional<TPromise<FResult>> PromiseToComplete;
+	{
+		UE::TUniqueLock Lock(HandlerSlotsLock);
+		if (!FindRegisteredHandlerSlot(HandlerId))
 		{
-			TryCompletePendingPromise(MoveTemp(ResultHandlerContext));
-			return true;
-		},
-		HandlerId);
-	return TPair<FString, TFuture<FResult>>(MoveTemp(HandlerId), MoveTemp(Future));
+			return false;
+		}
+		ReleaseHandlerSlot(HandlerId.Index, PromiseToComplete);
+	}
+	if (PromiseToComplete.IsSet())
+	{
+		PromiseToComplete->SetValue(FResult{ ErrorJson, true });
+	}
+	return true;
+}
+
+int32 UAIAssistantWebJavaScriptResultDelegate::GetNumRegisteredHandlers() const
+{
+	UE::TUniqueLock Lock(HandlerSlotsLock);
+	return NumRegisteredHandlers;
+}
+
+int32 UAIAssistantWebJavaScriptResultDelegate::GetNumOutstandingResultHandlers()
+{
+	return NumOutstandingResultHandlers.load();
 }
 
 void UAIAssistantWebJavaScriptResultDelegate::HandleResult(
-	const FString& HandlerId, const FString& ResultJson, bool bResultJsonIsError)
+	int32 HandlerIndex, int32 HandlerGeneration, const FString& ResultJson,
+	bool bResultJsonIsError)
 {
+	const FHandlerId HandlerId{ HandlerIndex, HandlerGeneration };
 	TSharedPtr<FResultHandler> Handler;
+	TOptional<TPromise<FResult>> PromiseToComplete;
 	{
-		UE::TUniqueLock Lock(ResultHandlersByIdLock);
-		TSharedPtr<FResultHandler>* HandlerPtrPtr = ResultHandlersById.Find(HandlerId);
-		if (!HandlerPtrPtr) return;
-		Handler = *HandlerPtrPtr;
+		UE::TUniqueLock Lock(HandlerSlotsLock);
+		FHandlerSlot* Slot = FindRegisteredHandlerSlot(HandlerId);
+		// Ignore stale or unknown IDs.
+		if (!Slot) return;
+
+		if (Slot->Promise.IsSet())
+		{
+			ReleaseHandlerSlot(HandlerId.Index, PromiseToComplete);
+		}
+		else
+		{
+			Handler = Slot->Handler;
+		}
 	}
+	if (PromiseToComplete.IsSet())
+	{
+		// NOTE: If HandlerSlotsLock is held when this is set any continuation that registers
+		// handlers will attempt to acquire HandlerSlotsLock and deadlock.
+		PromiseToComplete->SetValue(FResult{ ResultJson, bResultJsonIsError });
+		return;
+	}
+
 	bool RemoveHandler =
 		(*Handler)(FResultHandlerContext{ { ResultJson, bResultJsonIsError }, HandlerId });
 	if (RemoveHandler)
 	{
-		UE::TUniqueLock Lock(ResultHandlersByIdLock);
-		ResultHandlersById.Remove(HandlerId);
+		UE::TUniqueLock Lock(HandlerSlotsLock);
+		// The handler may have unregistered itself.
+		if (FindRegisteredHandlerSlot(HandlerId))
+		{
+			ReleaseHandlerSlot(HandlerId.Index, PromiseToComplete);
+		}
 	}
 }
 
-FString UAIAssistantWebJavaScriptResultDelegate::FormatJavaScriptHandler(const FString& HandlerId) const
+void UAIAssistantWebJavaScriptResultDelegate::AppendJavaScriptHandler(
+	FString& Output, const FHandlerId& HandlerId, const TCHAR* Value, bool bIsError)
 {
-	return FString::Printf(
-		TEXT(R"js(window.ue.%s.%s("%s", JSON.stringify({0}), {1});)js"),
-		*Name,
-		*GET_FUNCTION_NAME_CHECKED(
-			UAIAssistantWebJavaScriptResultDelegate, HandleResult).ToString().ToLower(),
-		*HandlerId);
+	check(Value);
+	// Must match GetJavaScriptHandlerLength().
+	Output.Append(TEXT("window.ue."));
+	Output.Append(Name);
+	Output.AppendChar(TEXT('.'));
+	Output.Append(GetJavaScriptHandleResultFunctionName());
+	Output.AppendChar(TEXT('('));
+	Output.AppendInt(HandlerId.Index);
+	Output.Append(TEXT(", "));
+	Output.AppendInt(HandlerId.Generation);
+	Output.Append(TEXT(", JSON.stringify("));
+	Output.Append(Value);
+	Output.Append(bIsError ? TEXT("), true);") : TEXT("), false);"));
 }
 
-void UAIAssistantWebJavaScriptResultDelegate::BeginDestroy()
+int32 UAIAssistantWebJavaScriptResultDelegate::GetJavaScriptHandlerLength(int32 ValueLength)
 {
-	Super::BeginDestroy();
-	Unbind();
+	// Maximum number of characters in a formatted int32.
+	static constexpr int32 MaxIntegerLength = 11;
+	static const int32 FixedLength =
+		UE_ARRAY_COUNT(TEXT("window.ue.")) - 1 + Name.Len() + 1 +
+		GetJavaScriptHandleResultFunctionName().Len() +
+		1 + MaxIntegerLength + UE_ARRAY_COUNT(TEXT(", ")) - 1 + MaxIntegerLength +
+		UE_ARRAY_COUNT(TEXT(", JSON.stringify(")) - 1 +
+		UE_ARRAY_COUNT(TEXT("), false);")) - 1;
+	return FixedLength + ValueLength;
 }
 
-void UAIAssistantWebJavaScriptResultDelegate::CompleteAllPendingPromises()
+const FString& UAIAssistantWebJavaScriptResultDelegate::GetJavaScriptHandleResultFunctionName()
 {
-	UE::TUniqueLock Lock(PendingPromisesByIdLock);
-	for (auto& HandlerIdAndPromise : PendingPromisesById)
-	{
-		HandlerIdAndPromise.Value.SetValue(FResult{ CanceledError, true });
-	}
-	PendingPromisesById.Empty();
+	static const FString FunctionName =
+		GET_FUNCTION_NAME_CHECKED(
+			UAIAssistantWebJavaScriptResultDelegate, HandleResult).ToString().ToLower();
+	return FunctionName;
 }
 
-TFuture<UAIAssistantWebJavaScriptResultDelegate::FResult>
-UAIAssistantWebJavaScriptResultDelegate::CreatePromiseAndGetFuture(
-	const FString& HandlerId)
+void UAIAssistantWebJavaScriptResultDelegate::BeginDestroy()
 {
-	UE::TUniqueLock Lock(PendingPromisesByIdLock);
-	return PendingPromisesById.Add(HandlerId).GetFuture();
+	Super::BeginDestroy();
+	Unbind();
 }
 
-void UAIAssistantWebJavaScriptResultDelegate::TryCompletePendingPromise(
-	FResultHandlerContext&& ResultHandlerContext)
+void UAIAssistantWebJavaScriptResultDelegate::CompleteAllPendingPromises()
 {
-	bool bFulfillPromise = false;
-	TPromise<FResult> PromiseToFulfill;
+	TArray<TPromise<FResult>> PromisesToComplete;
 	{
-		UE::TUniqueLock Lock(PendingPromisesByIdLock);
-		FString HandlerId = ResultHandlerContext.HandlerId;
-		auto* Promise = PendingPromisesById.Find(HandlerId);
-		if (Promise)
+		UE::TUniqueLock Lock(HandlerSlotsLock);
+		for (int32 Index = 0; Index < HandlerSlots.Num(); ++Index)
 		{
-			PromiseToFulfill = MoveTemp(*Promise);
-			bFulfillPromise = true;
-			PendingPromisesById.Remove(HandlerId);
+			FHandlerSlot& Slot = HandlerSlots[Index];
+			if (Slot.bIsRegistered && Slot.Promise.IsSet())
+			{
+				TOptional<TPromise<FResult>> PromiseToComplete;
+				ReleaseHandlerSlot(Index, PromiseToComplete);
+				PromisesToComplete.Emplace(MoveTemp(*PromiseToComplete));
+			}
 		}
 	}
-	if (bFulfillPromise)
+	for (TPromise<FResult>& Promise : PromisesToComplete)
 	{
-		// NOTE: If PendingPromisesByIdLock is held when this is set any calls to register
-		// handlers will attempt to acquire PendingPromisesByIdLock and deadlock.
-		PromiseToFulfill.SetValue(MoveTemp(ResultHandlerContext));
+		Promise.SetValue(FResult{ CanceledError, true });
 	}
-}
\ No newline at end of file
+}
@@ -3,8 +3,9 @@
 
 #include "Async/Mutex.h"
 #include "Async/Future.h"
+#include "Containers/Array.h"
 #include "Containers/UnrealString.h"
-#include "Misc/Guid.h"
+#include "Misc/Optional.h"
 #include "Templates/Function.h"
 #include "Templates/SharedPointer.h"
 #include "Templates/Tuple.h"
@@ -43,12 +44,35 @@ public:
 		bool bJsonIsError;
 	};
 
+	// ID of a registered handler.
+	// Index is the handler's slot in the handler table and Generation is a random positive number
+	// drawn each time a handler is allocated a slot. An ID of a handler that has been removed never
+	// matches a handler that later reuses the slot, and page script can't complete another call's
+	// handler by guessing its ID from the IDs it has seen.
+	struct FHandlerId
+	{
+		int32 Index = INDEX_NONE;
+		int32 Generation = 0;
+
+		// Whether this refers to a handler, it may have been removed since.
+		bool IsValid() const { return Index != INDEX_NONE; }
+
+		bool operator==(const FHandlerId& Other) const
+		{
+			return Index == Other.Index && Generation == Other.Generation;
+		}
+
+		bool operator!=(const FHandlerId& Other) const { return !(*this == Other); }
+
+		FString ToString() const { return FString::Printf(TEXT("%d:%d"), Index, Generation); }
+	};
+
 	// Context passed to a result handler.
 	struct FResultHandlerContext : public FResult
 	{
 		// ID of the handler, this is used internally by
 		// UAIAssistantWebJavaScriptResultDelegate.
-		FString HandlerId;
+		FHandlerId HandlerId;
 	};
 
 	// Handles a JavaScript execution result.
@@ -68,58 +92,99 @@ public:
 
 	// Register a handler for a JavaScript execution returning the ID that should be passed to this
 	// delegate.
-	FString RegisterResultHandler(FResultHandler&& Handler);
+	FHandlerId RegisterResultHandler(FResultHandler&& Handler);
 
 	// Register a handler that completes a future when it's executed.
 	// This handler will always only be executed once.
-	TPair<FString, TFuture<FResult>> RegisterResultHandlerForFuture();
+	TPair<FHandlerId, TFuture<FResult>> RegisterResultHandlerForFuture();
+
+	// Remove a handler, completing its future with ErrorJson if it was registered with
+	// RegisterResultHandlerForFuture(). Returns false if the handler was already removed.
+	bool UnregisterResultHandler(
+		const FHandlerId& HandlerId, const FString& ErrorJson = CanceledError);
+
+	// Get the number of registered handlers.
+	int32 GetNumRegisteredHandlers() const;
 
-	// Generate a FString::Format() format string to call the JavaScript function associated with
-	// the handler using the specified ID. The returned format string has two arguments "{0}"
-	// that expects to accept an object that can be serialized as JSON to pass to the
-	// ResultHandler and "{1}" which should be truthy if the result is an error, falsey otherwise.
-	FString FormatJavaScriptHandler(const FString& HandlerId) const;
+	// Get the number of registered handlers across all delegates. This is also reported as the
+	// "AIAssistant/OutstandingResultHandlers" trace counter so that leaked handlers are visible.
+	static int32 GetNumOutstandingResultHandlers();
+
+	// Append JavaScript that calls the function associated with the handler using the specified ID
+	// to Output. Value is a JavaScript expression that evaluates to an object that can be
+	// serialized as JSON to pass to the ResultHandler and bIsError indicates whether the object is
+	// an error.
+	static void AppendJavaScriptHandler(
+		FString& Output, const FHandlerId& HandlerId, const TCHAR* Value, bool bIsError);
+
+	// Get the maximum number of characters appended by AppendJavaScriptHandler() for a value of
+	// the specified length.
+	static int32 GetJavaScriptHandlerLength(int32 ValueLength);
 
 protected:
 	// Handle the result of an execution.
-	// HandlerId is the unique ID of the execution, ResultJson is the result of the execution or
-	// an error as JSON and bResultJsonIsError is true if ResultJson is an error.
+	// HandlerIndex and HandlerGeneration identify the handler (see FHandlerId), ResultJson is the
+	// result of the execution or an error as JSON and bResultJsonIsError is true if ResultJson is
+	// an error. Results for handlers that are not registered are ignored.
 	UFUNCTION(BlueprintCallable, Category = "JavaScript", meta = (BlueprintInternalUseOnly))
 	void HandleResult(
-		const FString& HandlerId, const FString& ResultJson, bool bResultJsonIsError);
+		int32 HandlerIndex, int32 HandlerGeneration, const FString& ResultJson,
+		bool bResultJsonIsError);
 
 	// Called when the object starts being destroyed, this unbinds and cancels all pending
 	// promises.
 	void BeginDestroy() override;
 
 private:
-	// Register a handler for a JavaScript execution with the specified ID.
-	void RegisterResultHandlerWithId(FResultHandler&& Handler, const FString& HandlerId);
+	// Entry in the handler table.
+	struct FHandlerSlot
+	{
+		// Generation of the handler in this slot or of the last handler to use the slot if it's
+		// free, 0 if the slot has never been used.
+		int32 Generation = 0;
+		// Whether a handler is registered in this slot.
+		bool bIsRegistered = false;
+		// Handler registered with RegisterResultHandler().
+		TSharedPtr<FResultHandler> Handler;
+		// Promise registered with RegisterResultHandlerForFuture().
+		TOptional<TPromise<FResult>> Promise;
+	};
 
-	// Complete all pending promises.
-	void CompleteAllPendingPromises();
+	// Allocate a slot returning the ID of the handler that occupies it.
+	// HandlerSlotsLock must be held.
+	FHandlerId AllocateHandlerSlot();
+
+	// Get the slot for a registered handler or nullptr if the ID doesn't refer to a registered
+	// handler. HandlerSlotsLock must be held.
+	FHandlerSlot* FindRegisteredHandlerSlot(const FHandlerId& HandlerId);
 
-	// Create a promise for a handler and get a future from the promise.
-	TFuture<FResult> CreatePromiseAndGetFuture(const FString& HandlerId);
+	// Release a slot so that it can be reused, any promise in the slot is moved to
+	// PromiseToComplete. HandlerSlotsLock must be held.
+	void ReleaseHandlerSlot(int32 Index, TOptional<TPromise<FResult>>& PromiseToComplete);
 
-	// Complete a pending promise if the handler associated with the result is still available.
-	void TryCompletePendingPromise(FResultHandlerContext&& ResultContext);
+	// Complete all pending promises.
+	void CompleteAllPendingPromises();
 
 private:
-	UE::FMutex ResultHandlersByIdLock;  // Guards ResultHandlersById
-	TMap<FString, TSharedPtr<FResultHandler>> ResultHandlersById;
+	mutable UE::FMutex HandlerSlotsLock;  // Guards HandlerSlots, FreeHandlerSlots
+	// Handler table indexed by FHandlerId::Index.
+	TArray<FHandlerSlot> HandlerSlots;
+	// Indices of free slots in HandlerSlots.
+	TArray<int32> FreeHandlerSlots;
+	// Number of registered handlers.
+	int32 NumRegisteredHandlers = 0;
 	TOptional<UE::AIAssistant::FScopedWebJavaScriptDelegateBinder>
 		ScopedWebJavaScriptDelegateBinder;
-	UE::FMutex PendingPromisesByIdLock; // Guards PendingPromisesById
-	TMap<FString, TPromise<FResult>> PendingPromisesById;
 
 private:
-	// Create a handler ID.
-	static FString CreateHandlerId();
+	// Get the name of the HandleResult() function as seen by JavaScript.
+	static const FString& GetJavaScriptHandleResultFunctionName();
 
 public:
 	// Name of this object when registered with the JavaScript binder.
 	static const FString Name;
 	// JSON result when a promise / future is canceled.
 	static const FString CanceledError;
-};
\ No newline at end of file
+	// JSON result when a promise / future times out.
+	static const FString TimedOutError;
+};
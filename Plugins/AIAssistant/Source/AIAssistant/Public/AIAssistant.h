@@ -6,10 +6,12 @@
 
 #include "Modules/ModuleInterface.h"
 #include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
 #include "Framework/Commands/UICommandList.h"
 
 
 class FAIAssistantInputProcessor;
+class FAIAssistantWebBrowserPool;
 class FSpawnTabArgs;
 class SAIAssistantWebBrowser;
 class SDockTab;
@@ -72,5 +74,5 @@ private:
 
 	TSharedPtr<FUICommandList> PluginCommands;
 	TSharedPtr<FAIAssistantInputProcessor> InputProcessor;
-	TSharedPtr<SAIAssistantWebBrowser> AIAssistantWebBrowserWidget;
+	TUniquePtr<FAIAssistantWebBrowserPool> WebBrowserPool;
 };
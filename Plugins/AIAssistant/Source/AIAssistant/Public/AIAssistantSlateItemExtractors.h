@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Delegates/IDelegateInstance.h"
+#include "Internationalization/Text.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/NameTypes.h"
+
+class SWidget;
+
+namespace UE::AIAssistant
+{
+	// The item under the cursor that the AI assistant is asked about.
+	struct FSlateItem
+	{
+		// Name of the item, the item is only described if it's set.
+		FText Name;
+		// What kind of item it is, e.g "button".
+		FText Descriptor;
+		// Widget the description came from.
+		TSharedPtr<SWidget> Widget;
+		// Whether the item is part of the editor's UI, e.g a button.
+		bool bIsUIWidget = false;
+		// Whether the item is an object the user works on, e.g an asset.
+		bool bIsObject = false;
+	};
+
+	// The widgets under the cursor as seen by an extractor.
+	class ISlateItemQuery
+	{
+	public:
+		virtual ~ISlateItemQuery() = default;
+
+		// Get the number of widgets in the path from the window to the hovered widget.
+		virtual int32 GetNumWidgets() const = 0;
+
+		// Get a widget in the path, the hovered widget is the last.
+		virtual TSharedRef<SWidget> GetWidgetAt(int32 WidgetIndex) const = 0;
+
+		// Get the type of a widget in the path.
+		virtual FName GetWidgetTypeAt(int32 WidgetIndex) const = 0;
+
+		// Get the index of the deepest widget of a type in the path, INDEX_NONE if there is none.
+		virtual int32 FindClosestWidget(FName WidgetType) const = 0;
+
+		// Get the index of the widget of a type nearest to the window, INDEX_NONE if there is none.
+		virtual int32 FindFurthestWidget(FName WidgetType) const = 0;
+
+		// Get the text of the tool tip that is open, empty if there is none.
+		virtual const FText& GetToolTipText() const = 0;
+
+		// Find the first text below a widget, including the widget, that contains a letter.
+		virtual FText FindChildText(const TSharedRef<SWidget>& Widget) = 0;
+
+		// Find the first widget of a type below a widget.
+		virtual TSharedPtr<SWidget> FindChildWidget(const TSharedRef<SWidget>& Widget, FName WidgetType) = 0;
+	};
+
+	// Where the widget an extractor is registered for was found.
+	struct FSlateItemMatch
+	{
+		TSharedRef<SWidget> Widget;
+		// Index of the widget in the path, INDEX_NONE if it's a child of the hovered widget.
+		int32 WidgetIndex = INDEX_NONE;
+	};
+
+	// Describes the item under the cursor when a widget of a registered type is under it.
+	struct FSlateItemExtractor
+	{
+		// Name shown in the stats.
+		FName Name;
+		// Widget types the extractor is run for.
+		TArray<FName> WidgetTypes;
+		// Extractors run in ascending order, each can override what earlier extractors set. The
+		// built-in extractors use multiples of 100.
+		int32 Order = 0;
+		// Whether the children of the hovered widget are matched when there's no widget of the
+		// types in the path, e.g as disabled menu entries contain their block.
+		bool bMatchHoveredWidgetChildren = false;
+		// Update the item from the matched widget, returns whether it described the item.
+		TFunction<bool(ISlateItemQuery& Query, const FSlateItemMatch& Match, FSlateItem& InOutItem)> Extract;
+	};
+
+	// Extractors that describe the item under the cursor for the Slate query hotkey.
+	//
+	// Other modules can register extractors for their own widgets. The widget types in the path
+	// are looked up once each to find the deepest match of every extractor, then the matched
+	// extractors run in order. The time taken by each extractor is recorded.
+	//
+	// Extractors can register and unregister extractors, the changes are applied once all of the
+	// matched extractors have run.
+	//
+	// Only use the registry on the game thread.
+	class AIASSISTANT_API FSlateItemExtractorRegistry
+	{
+	public:
+		// Calls and time of an extractor.
+		struct FStats
+		{
+			FName Name;
+			int32 NumCalls = 0;
+			// Calls that described the item.
+			int32 NumDescribed = 0;
+			double TotalSeconds = 0.0;
+			double MaxSeconds = 0.0;
+		};
+
+	public:
+		// Get the registry used by the Slate querier.
+		static FSlateItemExtractorRegistry& Get();
+
+		// Add an extractor, returns the handle to remove it. While extracting the extractor is
+		// added once the extractors have run.
+		FDelegateHandle Register(FSlateItemExtractor Extractor);
+
+		// Remove an extractor. While extracting the extractor is removed once the extractors have
+		// run.
+		void Unregister(FDelegateHandle Handle);
+
+		// Run the extractors matching the widgets of a query. bRecordStats is false for queries
+		// that may not be used, such as those generated ahead of the hotkey.
+		void Extract(ISlateItemQuery& Query, FSlateItem& InOutItem, bool bRecordStats = true);
+
+		// Get the stats of each extractor in order.
+		TArray<FStats> GetStats() const;
+
+		// Clear the stats of all extractors.
+		void ResetStats();
+
+		// Format the stats, one extractor per line.
+		FString FormatStats() const;
+
+	private:
+		struct FRegisteredExtractor
+		{
+			FDelegateHandle Handle;
+			FSlateItemExtractor Extractor;
+			FStats Stats;
+		};
+
+		// Run the matched extractors, Extractors must not change.
+		void ExtractMatches(ISlateItemQuery& Query, FSlateItem& InOutItem, bool bRecordStats);
+
+		// Add or remove the extractors registered or unregistered while extracting.
+		void ApplyDeferredChanges();
+
+		// Map the widget types to the extractors after they changed.
+		void UpdateExtractorsByWidgetType();
+
+	private:
+		// Sorted by order then registration.
+		TArray<FRegisteredExtractor> Extractors;
+		// Indices in Extractors of the extractors of each widget type.
+		TMap<FName, TArray<int32>> ExtractorsByWidgetType;
+		// Whether extractors are running so changes to Extractors are deferred.
+		bool bIsExtracting = false;
+		// Extractors registered while extracting.
+		TArray<FRegisteredExtractor> DeferredRegistrations;
+		// Handles of extractors unregistered while extracting.
+		TArray<FDelegateHandle> DeferredUnregistrations;
+	};
+}